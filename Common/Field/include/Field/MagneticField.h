@@ -107,6 +107,13 @@ class MagneticField : public FairField
   /// Main interface from TVirtualMagField used in simulation
   void Field(const Double_t* __restrict__ point, Double_t* __restrict__ bField) override;
 
+  /// Method to calculate the field at a batch of points, with the same result as Field for each point.
+  /// The points covered by the measured map are evaluated together with its batched parameterization
+  /// \param npoints number of points
+  /// \param xyz coordinates of the points, 3 per point
+  /// \param b output field, 3 components per point
+  void Field(Int_t npoints, const Double_t* xyz, Double_t* b);
+
   /// 3d field query alias for Alias Method to calculate the field at point xyz
   void GetBxyz(const Double_t p[3], Double_t* b) override { MagneticField::Field(p, b); }
 
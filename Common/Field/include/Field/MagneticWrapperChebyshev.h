@@ -49,6 +49,8 @@ namespace field
 ///  getTPCIntegral(double* xyz, double* bxyz);  for cartesian frame
 ///  or getTPCIntegralCylindrical(Double_t *rphiz, Double_t *b); for cylindrical frame
 ///  The units are kiloGauss and cm.
+///  The parameterization is read only during the field queries, which can be done concurrently by several threads.
+///  Each thread caches the last solenoid and dipole pieces it used.
 class MagneticWrapperChebyshev : public TNamed
 {
 
@@ -210,6 +212,14 @@ class MagneticWrapperChebyshev : public TNamed
   /// it gets it at closest valid point
   virtual void Field(const Double_t* xyz, Double_t* b) const;
 
+  /// Computes field in cartesian coordinates for a batch of points, with the same result as Field for each point.
+  /// The points are sorted by the parameterization piece containing them and each piece is evaluated once for all
+  /// its points with the batched Chebyshev evaluation
+  /// \param npoints number of points
+  /// \param xyz coordinates of the points, 3 per point
+  /// \param b output field, 3 components per point
+  void Field(Int_t npoints, const Double_t* xyz, Double_t* b) const;
+
   /// Computes Bz for the point in cartesian coordinates. If point is outside of the parameterized region
   /// it gets it at closest valid point
   Double_t getBz(const Double_t* xyz) const;
@@ -21,6 +21,7 @@
 #include "FairParamList.h"
 #include "FairRun.h"
 #include "FairRuntimeDb.h"
+#include <vector>
 
 using namespace o2::field;
 
@@ -280,6 +281,41 @@ void MagneticField::Field(const Double_t* __restrict__ xyz, Double_t* __restrict
   }
 }
 
+void MagneticField::Field(Int_t npoints, const Double_t* xyz, Double_t* b)
+{
+  /*
+   * query field values at a batch of points
+   */
+
+  // points which are not covered by the fast parameterization but by the measured map are evaluated together
+  std::vector<Int_t> mapped;
+  std::vector<Double_t> mappedXYZ;
+  for (int ip = 0; ip < npoints; ip++) {
+    const Double_t* point = xyz + 3 * ip;
+    if (mFastField && mFastField->Field(point, b + 3 * ip)) {
+      continue;
+    }
+    if (mMeasuredMap && point[2] > mMeasuredMap->getMinZ() && point[2] < mMeasuredMap->getMaxZ()) {
+      mapped.push_back(ip);
+      mappedXYZ.insert(mappedXYZ.end(), point, point + 3);
+    } else {
+      MachineField(point, b + 3 * ip);
+    }
+  }
+  if (mapped.empty()) {
+    return;
+  }
+  std::vector<Double_t> mappedB(mappedXYZ.size());
+  mMeasuredMap->Field(mapped.size(), mappedXYZ.data(), mappedB.data());
+  for (size_t im = 0; im < mapped.size(); im++) {
+    const int ip = mapped[im];
+    const Double_t factor = (xyz[3 * ip + 2] > sSolenoidToDipoleZ || mDipoleOnOffFlag) ? mMultipicativeFactorSolenoid : mMultipicativeFactorDipole;
+    for (int i = 3; i--;) {
+      b[3 * ip + i] = mappedB[3 * im + i] * factor;
+    }
+  }
+}
+
 Double_t MagneticField::getBz(const Double_t* xyz) const
 {
   /*
@@ -25,10 +25,47 @@
 #include "TNamed.h"     // for TNamed
 #include "TObjArray.h"  // for TObjArray
 #include "TString.h"    // for TString
+#include <algorithm>    // for std::copy, std::fill
+#include <vector>       // for std::vector
 
 using namespace o2::field;
 using namespace o2::math_utils;
 
+namespace
+{
+/// Parameterization pieces found last by this thread. Consecutive queries, e.g. along a track, are mostly in the same
+/// piece, so it is checked before the lookup tables. It is used only if the point is inside of the cached piece and not
+/// close to its boundaries, where the lookup may select the neighbouring piece. The parameterization stays read only.
+/// The pieces belong to the field which found them, the queries of another field start from its own lookup tables.
+struct LastPieces {
+  const MagneticWrapperChebyshev* owner = nullptr;
+  int solenoid = -1;
+  int dipole = -1;
+};
+thread_local LastPieces sLastPieces;
+
+LastPieces& getLastPieces(const MagneticWrapperChebyshev* field)
+{
+  if (sLastPieces.owner != field) {
+    sLastPieces = LastPieces{field};
+  }
+  return sLastPieces;
+}
+
+/// Checks if the point is inside of the piece by more than the precision of the lookup tables, which search the Z bin
+/// with single precision coordinates and accept a point up to 3.e-5 before the Z bin
+bool isWellInside(const Chebyshev3D* par, const Double_t* x)
+{
+  for (int i = 3; i--;) {
+    const double margin = 3.e-5 + 1.e-6 * TMath::Abs(x[i]);
+    if (x[i] - par->getBoundMin(i) <= margin || par->getBoundMax(i) - x[i] <= margin) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 ClassImp(MagneticWrapperChebyshev);
 
 MagneticWrapperChebyshev::MagneticWrapperChebyshev()
@@ -445,6 +482,84 @@ void MagneticWrapperChebyshev::Field(const Double_t* xyz, Double_t* b) const
   par->Eval(xyz, b);
 }
 
+void MagneticWrapperChebyshev::Field(Int_t npoints, const Double_t* xyz, Double_t* b) const
+{
+  // find the parameterization piece of each point: the solenoid pieces are followed by the dipole pieces,
+  // -1 if the point is not covered
+  std::vector<Int_t> pieces(npoints);
+  std::vector<Double_t> coordinates(3 * npoints); // cylindrical coordinates for the solenoid, cartesian for the dipole
+  for (int ip = 0; ip < npoints; ip++) {
+    const Double_t* point = xyz + 3 * ip;
+    Double_t* crd = &coordinates[3 * ip];
+    int id = -1;
+    if (point[2] > mMinZSolenoid) {
+      cartesianToCylindrical(point, crd);
+      id = findSolenoidSegment(crd);
+#ifndef _BRING_TO_BOUNDARY_ // exact matching to fitted volume is requested
+      if (id >= 0 && !getParameterSolenoid(id)->isInside(crd)) {
+        id = -1;
+      }
+#endif
+    } else {
+      std::copy(point, point + 3, crd);
+      id = findDipoleSegment(crd);
+#ifndef _BRING_TO_BOUNDARY_
+      if (id >= 0 && !getParameterDipole(id)->isInside(crd)) {
+        id = -1;
+      }
+#endif
+      if (id >= 0) {
+        id += mNumberOfParameterizationSolenoid;
+      }
+    }
+    pieces[ip] = id;
+  }
+
+  // counting sort of the points by piece
+  const int npieces = mNumberOfParameterizationSolenoid + mNumberOfParameterizationDipole;
+  std::vector<Int_t> firstPoint(npieces + 1, 0);
+  for (int ip = 0; ip < npoints; ip++) {
+    if (pieces[ip] < 0) {
+      std::fill(b + 3 * ip, b + 3 * ip + 3, 0.);
+    } else {
+      firstPoint[pieces[ip] + 1]++;
+    }
+  }
+  for (int id = 0; id < npieces; id++) {
+    firstPoint[id + 1] += firstPoint[id];
+  }
+  std::vector<Int_t> order(firstPoint[npieces]);
+  std::vector<Double_t> sorted(3 * order.size()), bsorted(3 * order.size());
+  std::vector<Int_t> next(firstPoint.begin(), firstPoint.end() - 1);
+  for (int ip = 0; ip < npoints; ip++) {
+    if (pieces[ip] >= 0) {
+      const int is = next[pieces[ip]]++;
+      order[is] = ip;
+      std::copy(&coordinates[3 * ip], &coordinates[3 * ip] + 3, &sorted[3 * is]);
+    }
+  }
+
+  // evaluate each piece for all its points
+  for (int id = 0; id < npieces; id++) {
+    const int first = firstPoint[id], n = firstPoint[id + 1] - first;
+    if (n == 0) {
+      continue;
+    }
+    const Chebyshev3D* par = id < mNumberOfParameterizationSolenoid ? getParameterSolenoid(id) : getParameterDipole(id - mNumberOfParameterizationSolenoid);
+    par->Eval(n, &sorted[3 * first], &bsorted[3 * first]);
+  }
+
+  for (size_t is = 0; is < order.size(); is++) {
+    const int ip = order[is];
+    if (xyz[3 * ip + 2] > mMinZSolenoid) {
+      // convert field to cartesian system
+      cylindricalToCartesianCylB(&sorted[3 * is], &bsorted[3 * is], b + 3 * ip);
+    } else {
+      std::copy(&bsorted[3 * is], &bsorted[3 * is] + 3, b + 3 * ip);
+    }
+  }
+}
+
 Double_t MagneticWrapperChebyshev::getBz(const Double_t* xyz) const
 {
   Double_t rphiz[3];
@@ -513,6 +628,11 @@ Int_t MagneticWrapperChebyshev::findDipoleSegment(const Double_t* xyz) const
   if (!mNumberOfParameterizationDipole) {
     return -1;
   }
+  auto& lastPieces = getLastPieces(this);
+  const int last = lastPieces.dipole;
+  if (last >= 0 && last < mNumberOfParameterizationDipole && isWellInside(getParameterDipole(last), xyz)) {
+    return last;
+  }
   int xid, yid, zid = TMath::BinarySearch(mNumberOfDistinctZSegmentsDipole, mCoordinatesSegmentsZDipole,
                                           (Float_t)xyz[2]); // find zsegment
 
@@ -551,7 +671,7 @@ Int_t MagneticWrapperChebyshev::findDipoleSegment(const Double_t* xyz) const
     }
     break;
   }
-  return mSegmentIdDipole[xid];
+  return lastPieces.dipole = mSegmentIdDipole[xid];
 }
 
 Int_t MagneticWrapperChebyshev::findSolenoidSegment(const Double_t* rpz) const
@@ -559,6 +679,11 @@ Int_t MagneticWrapperChebyshev::findSolenoidSegment(const Double_t* rpz) const
   if (!mNumberOfParameterizationSolenoid) {
     return -1;
   }
+  auto& lastPieces = getLastPieces(this);
+  const int last = lastPieces.solenoid;
+  if (last >= 0 && last < mNumberOfParameterizationSolenoid && isWellInside(getParameterSolenoid(last), rpz)) {
+    return last;
+  }
   int rid, pid, zid = TMath::BinarySearch(mNumberOfDistinctZSegmentsSolenoid, mCoordinatesSegmentsZSolenoid,
                                           (Float_t)rpz[2]); // find zsegment
 
@@ -595,7 +720,7 @@ Int_t MagneticWrapperChebyshev::findSolenoidSegment(const Double_t* rpz) const
     }
     break;
   }
-  return mSegmentIdSolenoid[rid];
+  return lastPieces.solenoid = mSegmentIdSolenoid[rid];
 }
 
 Int_t MagneticWrapperChebyshev::findTPCSegment(const Double_t* rpz) const
@@ -0,0 +1,153 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  benchMagneticField.cxx
+/// \brief Evaluation of the Chebyshev parameterization of the 5 kG field point by point and in batches of
+///        different size, compared to the fast parameterization. The maximum deviation of the batched from the
+///        point by point evaluation and of the fast parameterization from the Chebyshev one are reported as counters.
+///        The shared field is also queried concurrently by up to 64 threads along straight tracks.
+
+#include "benchmark/benchmark.h"
+#include "Field/MagneticField.h"
+#include "Field/MagFieldFast.h"
+#include <TRandom.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using namespace o2::field;
+
+struct Setup {
+  std::unique_ptr<MagneticField> field = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., MagFieldParam::k5kG);
+  std::unique_ptr<MagFieldFast> fastField = std::make_unique<MagFieldFast>(1.f, 5);
+  std::vector<double> xyz;
+
+  Setup()
+  {
+    // points in the volume of the central barrel
+    const int npoints = 100000;
+    for (int ip = 0; ip < npoints; ip++) {
+      const double r = gRandom->Uniform(0., 400.), phi = gRandom->Uniform(-TMath::Pi(), TMath::Pi());
+      xyz.push_back(r * TMath::Cos(phi));
+      xyz.push_back(r * TMath::Sin(phi));
+      xyz.push_back(gRandom->Uniform(-250., 250.));
+    }
+  }
+};
+
+Setup& getSetup()
+{
+  static Setup setup;
+  return setup;
+}
+
+static void BM_FieldScalar(benchmark::State& state)
+{
+  auto& setup = getSetup();
+  const int npoints = setup.xyz.size() / 3;
+  std::vector<double> b(3 * npoints);
+  for (auto _ : state) {
+    for (int ip = 0; ip < npoints; ip++) {
+      setup.field->Field(&setup.xyz[3 * ip], &b[3 * ip]);
+    }
+    benchmark::DoNotOptimize(b.data());
+  }
+  state.SetItemsProcessed(state.iterations() * npoints);
+}
+
+static void BM_FieldBatch(benchmark::State& state)
+{
+  auto& setup = getSetup();
+  const int npoints = setup.xyz.size() / 3;
+  const int batchSize = state.range(0);
+  std::vector<double> b(3 * npoints);
+  for (auto _ : state) {
+    for (int first = 0; first < npoints; first += batchSize) {
+      setup.field->Field(std::min(batchSize, npoints - first), &setup.xyz[3 * first], &b[3 * first]);
+    }
+    benchmark::DoNotOptimize(b.data());
+  }
+  state.SetItemsProcessed(state.iterations() * npoints);
+
+  double maxDeviation = 0.;
+  for (int ip = 0; ip < npoints; ip++) {
+    double bScalar[3];
+    setup.field->Field(&setup.xyz[3 * ip], bScalar);
+    for (int i = 3; i--;) {
+      maxDeviation = std::max(maxDeviation, std::abs(b[3 * ip + i] - bScalar[i]));
+    }
+  }
+  state.counters["max_deviation_kG"] = maxDeviation;
+}
+
+static void BM_FieldFast(benchmark::State& state)
+{
+  auto& setup = getSetup();
+  const int npoints = setup.xyz.size() / 3;
+  std::vector<double> b(3 * npoints);
+  for (auto _ : state) {
+    for (int ip = 0; ip < npoints; ip++) {
+      setup.fastField->Field(&setup.xyz[3 * ip], &b[3 * ip]);
+    }
+    benchmark::DoNotOptimize(b.data());
+  }
+  state.SetItemsProcessed(state.iterations() * npoints);
+
+  // only the points covered by the fast parameterization are compared
+  double maxDeviation = 0.;
+  for (int ip = 0; ip < npoints; ip++) {
+    double bCheb[3];
+    if (!setup.fastField->Field(&setup.xyz[3 * ip], &b[3 * ip])) {
+      continue;
+    }
+    setup.field->Field(&setup.xyz[3 * ip], bCheb);
+    for (int i = 3; i--;) {
+      maxDeviation = std::max(maxDeviation, std::abs(b[3 * ip + i] - bCheb[i]));
+    }
+  }
+  state.counters["max_deviation_kG"] = maxDeviation;
+}
+
+// every thread walks along its own straight tracks from the vertex, all threads query the same field object
+static void BM_FieldThreads(benchmark::State& state)
+{
+  auto& setup = getSetup();
+  const int ntracks = 100, nsteps = 200;
+  std::vector<double> xyz;
+  static std::atomic<int> seed{0};
+  TRandom rnd(++seed);
+  for (int it = 0; it < ntracks; it++) {
+    const double phi = rnd.Uniform(-TMath::Pi(), TMath::Pi()), tgl = rnd.Uniform(-1., 1.);
+    for (int is = 0; is < nsteps; is++) {
+      const double r = 2. * (is + 1);
+      xyz.push_back(r * TMath::Cos(phi));
+      xyz.push_back(r * TMath::Sin(phi));
+      xyz.push_back(r * tgl);
+    }
+  }
+  const int npoints = xyz.size() / 3;
+  double b[3];
+  for (auto _ : state) {
+    for (int ip = 0; ip < npoints; ip++) {
+      setup.field->Field(&xyz[3 * ip], b);
+      benchmark::DoNotOptimize(b);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * npoints);
+}
+
+BENCHMARK(BM_FieldScalar)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FieldBatch)->RangeMultiplier(4)->Range(16, 16384)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FieldFast)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FieldThreads)->ThreadRange(1, 64)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -16,10 +16,15 @@
 #include <iostream>
 #include "Field/MagneticField.h"
 #include "Field/MagFieldFast.h"
+#include "Field/MagneticWrapperChebyshev.h"
+#include "MathUtils/Chebyshev3D.h"
 #include <memory>
 #include "FairLogger.h" // for FairLogger
 #include <TStopwatch.h>
 #include <TRandom.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
 
 using namespace o2::field;
 
@@ -98,3 +103,129 @@ BOOST_AUTO_TEST_CASE(MagneticField_test)
     BOOST_CHECK(TMath::Abs(rms[i] / nomBz) < 1.e-3);
   }
 }
+
+BOOST_AUTO_TEST_CASE(MagneticFieldBatch_test)
+{
+  std::unique_ptr<MagneticField> fld = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+
+  // points in the solenoid and in the dipole region, including points outside of the parameterization
+  const int ntst = 10000;
+  std::vector<double> xyz(3 * ntst), bBatch(3 * ntst);
+  for (int it = ntst; it--;) {
+    const double r = gRandom->Uniform(0., 600.), phi = gRandom->Uniform(-TMath::Pi(), TMath::Pi());
+    xyz[3 * it] = r * TMath::Cos(phi);
+    xyz[3 * it + 1] = r * TMath::Sin(phi);
+    xyz[3 * it + 2] = gRandom->Uniform(-1500., 600.);
+  }
+
+  for (bool fast : {false, true}) {
+    fld->AllowFastField(fast);
+    fld->Field(ntst, xyz.data(), bBatch.data());
+    double maxDiff = 0.;
+    for (int it = ntst; it--;) {
+      double b[3];
+      fld->Field(&xyz[3 * it], b);
+      for (int i = 3; i--;) {
+        maxDiff = std::max(maxDiff, TMath::Abs(b[i] - bBatch[3 * it + i]));
+      }
+    }
+    LOG(INFO) << "Max. difference between batched and single point field (fast field " << fast << "): " << maxDiff << " kG";
+    BOOST_CHECK(maxDiff < 1.e-4);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MagneticFieldConcurrent_test)
+{
+  std::unique_ptr<MagneticField> fld = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+
+  // straight tracks from the vertex, each thread walks along its own tracks
+  const int nthreads = 8, ntracks = 100, nsteps = 200;
+  std::vector<double> xyz(3 * nthreads * ntracks * nsteps);
+  for (int it = 0; it < nthreads * ntracks; it++) {
+    const double phi = gRandom->Uniform(-TMath::Pi(), TMath::Pi()), tgl = gRandom->Uniform(-1., 1.);
+    for (int is = 0; is < nsteps; is++) {
+      const double r = 2. * (is + 1);
+      const int ip = it * nsteps + is;
+      xyz[3 * ip] = r * TMath::Cos(phi);
+      xyz[3 * ip + 1] = r * TMath::Sin(phi);
+      xyz[3 * ip + 2] = r * tgl;
+    }
+  }
+  const int npoints = xyz.size() / 3;
+  std::vector<double> bRef(3 * npoints), b(3 * npoints);
+  for (int ip = 0; ip < npoints; ip++) {
+    fld->Field(&xyz[3 * ip], &bRef[3 * ip]);
+  }
+
+  std::vector<std::thread> threads;
+  const int npointsThread = npoints / nthreads;
+  for (int ith = 0; ith < nthreads; ith++) {
+    threads.emplace_back([&, ith]() {
+      for (int ip = ith * npointsThread; ip < (ith + 1) * npointsThread; ip++) {
+        fld->Field(&xyz[3 * ip], &b[3 * ip]);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  double maxDiff = 0.;
+  for (int i = 0; i < 3 * npoints; i++) {
+    maxDiff = std::max(maxDiff, TMath::Abs(b[i] - bRef[i]));
+  }
+  LOG(INFO) << "Max. difference between field evaluated by " << nthreads << " threads and by a single thread: " << maxDiff << " kG";
+  BOOST_CHECK(maxDiff < 1.e-4);
+}
+
+// Finds two parameterization pieces with a common Z boundary and checks that a point on this boundary is assigned to the
+// same piece whichever of the two pieces was used for the previous query
+void checkPieceBoundary(const MagneticWrapperChebyshev& map, int npieces,
+                        o2::math_utils::Chebyshev3D* (MagneticWrapperChebyshev::*piece)(Int_t) const,
+                        Int_t (MagneticWrapperChebyshev::*find)(const Double_t*) const)
+{
+  for (int i = 0; i < npieces; i++) {
+    const auto below = (map.*piece)(i);
+    for (int j = 0; j < npieces; j++) {
+      const auto above = (map.*piece)(j);
+      if (i == j || TMath::Abs(below->getBoundMax(2) - above->getBoundMin(2)) > 1.e-3) {
+        continue;
+      }
+      double boundary[3], inBelow[3], inAbove[3];
+      bool overlap = true;
+      for (int k = 0; k < 2; k++) {
+        const double lo = std::max(below->getBoundMin(k), above->getBoundMin(k));
+        const double hi = std::min(below->getBoundMax(k), above->getBoundMax(k));
+        overlap &= hi > lo;
+        boundary[k] = inBelow[k] = inAbove[k] = 0.5 * (lo + hi);
+      }
+      if (!overlap) {
+        continue;
+      }
+      boundary[2] = below->getBoundMax(2);
+      inBelow[2] = 0.5 * (below->getBoundMin(2) + below->getBoundMax(2));
+      inAbove[2] = 0.5 * (above->getBoundMin(2) + above->getBoundMax(2));
+
+      // the piece found by the lookup tables, in a new thread which has no piece cached
+      int reference = -1;
+      std::thread([&]() { reference = (map.*find)(boundary); }).join();
+      BOOST_REQUIRE(reference == i || reference == j);
+
+      BOOST_CHECK_EQUAL((map.*find)(inBelow), i);
+      BOOST_CHECK_EQUAL((map.*find)(boundary), reference);
+      BOOST_CHECK_EQUAL((map.*find)(inAbove), j);
+      BOOST_CHECK_EQUAL((map.*find)(boundary), reference);
+      BOOST_CHECK_EQUAL((map.*find)(inBelow), i);
+      BOOST_CHECK_EQUAL((map.*find)(boundary), reference);
+      return;
+    }
+  }
+  BOOST_FAIL("no pieces with a common boundary found");
+}
+
+BOOST_AUTO_TEST_CASE(MagneticFieldPieceBoundary_test)
+{
+  std::unique_ptr<MagneticField> fld = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+  const auto& map = *fld->getMeasuredMap();
+  checkPieceBoundary(map, map.getNumberOfParametersSol(), &MagneticWrapperChebyshev::getParameterSolenoid, &MagneticWrapperChebyshev::findSolenoidSegment);
+  checkPieceBoundary(map, map.getNumberOfParametersDip(), &MagneticWrapperChebyshev::getParameterDipole, &MagneticWrapperChebyshev::findDipoleSegment);
+}
@@ -128,25 +128,32 @@ class Chebyshev3D : public TNamed
 
   Chebyshev3D& operator=(const Chebyshev3D& rhs);
 
-  void Eval(const Float_t* par, Float_t* res);
+  void Eval(const Float_t* par, Float_t* res) const;
 
-  Float_t Eval(const Float_t* par, int idim);
+  Float_t Eval(const Float_t* par, int idim) const;
 
-  void Eval(const Double_t* par, Double_t* res);
+  void Eval(const Double_t* par, Double_t* res) const;
 
-  Double_t Eval(const Double_t* par, int idim);
+  Double_t Eval(const Double_t* par, int idim) const;
 
-  void evaluateDerivative(int dimd, const Float_t* par, Float_t* res);
+  /// Evaluates Chebyshev parameterization for a batch of points of the 3d->DimOut function,
+  /// using the batched evaluation of Chebyshev3DCalc
+  /// \param npoints number of points
+  /// \param par arguments of the points, 3 per point
+  /// \param res output, DimOut values per point
+  void Eval(Int_t npoints, const Double_t* par, Double_t* res) const;
 
-  void evaluateDerivative2(int dimd1, int dimd2, const Float_t* par, Float_t* res);
+  void evaluateDerivative(int dimd, const Float_t* par, Float_t* res) const;
 
-  Float_t evaluateDerivative(int dimd, const Float_t* par, int idim);
+  void evaluateDerivative2(int dimd1, int dimd2, const Float_t* par, Float_t* res) const;
 
-  Float_t evaluateDerivative2(int dimd1, int dimd2, const Float_t* par, int idim);
+  Float_t evaluateDerivative(int dimd, const Float_t* par, int idim) const;
 
-  void evaluateDerivative3D(const Float_t* par, Float_t dbdr[3][3]);
+  Float_t evaluateDerivative2(int dimd1, int dimd2, const Float_t* par, int idim) const;
 
-  void evaluateDerivative3D2(const Float_t* par, Float_t dbdrdr[3][3][3]);
+  void evaluateDerivative3D(const Float_t* par, Float_t dbdr[3][3]) const;
+
+  void evaluateDerivative3D2(const Float_t* par, Float_t dbdrdr[3][3][3]) const;
 
   void Print(const Option_t* opt = "") const override;
 
@@ -280,68 +287,74 @@ inline Bool_t Chebyshev3D::isInside(const Double_t* par) const
 }
 
 /// Evaluates Chebyshev parameterization for 3d->DimOut function
-inline void Chebyshev3D::Eval(const Float_t* par, Float_t* res)
+inline void Chebyshev3D::Eval(const Float_t* par, Float_t* res) const
 {
+  Float_t mapped[3];
   for (int i = 3; i--;) {
-    mTemporaryCoefficient[i] = mapToInternal(par[i], i);
+    mapped[i] = mapToInternal(par[i], i);
   }
   for (int i = mOutputArrayDimension; i--;) {
-    res[i] = getChebyshevCalc(i)->Eval(mTemporaryCoefficient);
+    res[i] = getChebyshevCalc(i)->Eval(mapped);
   }
 }
 
 /// Evaluates Chebyshev parameterization for 3d->DimOut function
-inline void Chebyshev3D::Eval(const Double_t* par, Double_t* res)
+inline void Chebyshev3D::Eval(const Double_t* par, Double_t* res) const
 {
+  Float_t mapped[3];
   for (int i = 3; i--;) {
-    mTemporaryCoefficient[i] = mapToInternal(par[i], i);
+    mapped[i] = mapToInternal(par[i], i);
   }
   for (int i = mOutputArrayDimension; i--;) {
-    res[i] = getChebyshevCalc(i)->Eval(mTemporaryCoefficient);
+    res[i] = getChebyshevCalc(i)->Eval(mapped);
   }
 }
 
 /// Evaluates Chebyshev parameterization for idim-th output dimension of 3d->DimOut function
-inline Double_t Chebyshev3D::Eval(const Double_t* par, int idim)
+inline Double_t Chebyshev3D::Eval(const Double_t* par, int idim) const
 {
+  Float_t mapped[3];
   for (int i = 3; i--;) {
-    mTemporaryCoefficient[i] = mapToInternal(par[i], i);
+    mapped[i] = mapToInternal(par[i], i);
   }
-  return getChebyshevCalc(idim)->Eval(mTemporaryCoefficient);
+  return getChebyshevCalc(idim)->Eval(mapped);
 }
 
 /// Evaluates Chebyshev parameterization for idim-th output dimension of 3d->DimOut function
-inline Float_t Chebyshev3D::Eval(const Float_t* par, int idim)
+inline Float_t Chebyshev3D::Eval(const Float_t* par, int idim) const
 {
+  Float_t mapped[3];
   for (int i = 3; i--;) {
-    mTemporaryCoefficient[i] = mapToInternal(par[i], i);
+    mapped[i] = mapToInternal(par[i], i);
   }
-  return getChebyshevCalc(idim)->Eval(mTemporaryCoefficient);
+  return getChebyshevCalc(idim)->Eval(mapped);
 }
 
 /// Returns the gradient matrix
-inline void Chebyshev3D::evaluateDerivative3D(const Float_t* par, Float_t dbdr[3][3])
+inline void Chebyshev3D::evaluateDerivative3D(const Float_t* par, Float_t dbdr[3][3]) const
 {
+  Float_t mapped[3];
   for (int i = 3; i--;) {
-    mTemporaryCoefficient[i] = mapToInternal(par[i], i);
+    mapped[i] = mapToInternal(par[i], i);
   }
   for (int ib = 3; ib--;) {
     for (int id = 3; id--;) {
-      dbdr[ib][id] = getChebyshevCalc(ib)->evaluateDerivative(id, mTemporaryCoefficient) * mBoundaryMappingScale[id];
+      dbdr[ib][id] = getChebyshevCalc(ib)->evaluateDerivative(id, mapped) * mBoundaryMappingScale[id];
     }
   }
 }
 
 /// Returns the gradient matrix
-inline void Chebyshev3D::evaluateDerivative3D2(const Float_t* par, Float_t dbdrdr[3][3][3])
+inline void Chebyshev3D::evaluateDerivative3D2(const Float_t* par, Float_t dbdrdr[3][3][3]) const
 {
+  Float_t mapped[3];
   for (int i = 3; i--;) {
-    mTemporaryCoefficient[i] = mapToInternal(par[i], i);
+    mapped[i] = mapToInternal(par[i], i);
   }
   for (int ib = 3; ib--;) {
     for (int id = 3; id--;) {
       for (int id1 = 3; id1--;) {
-        dbdrdr[ib][id][id1] = getChebyshevCalc(ib)->evaluateDerivative2(id, id1, mTemporaryCoefficient) *
+        dbdrdr[ib][id][id1] = getChebyshevCalc(ib)->evaluateDerivative2(id, id1, mapped) *
                               mBoundaryMappingScale[id] * mBoundaryMappingScale[id1];
       }
     }
@@ -349,46 +362,50 @@ inline void Chebyshev3D::evaluateDerivative3D2(const Float_t* par, Float_t dbdrd
 }
 
 // Evaluates Chebyshev parameterization derivative for 3d->DimOut function
-inline void Chebyshev3D::evaluateDerivative(int dimd, const Float_t* par, Float_t* res)
+inline void Chebyshev3D::evaluateDerivative(int dimd, const Float_t* par, Float_t* res) const
 {
+  Float_t mapped[3];
   for (int i = 3; i--;) {
-    mTemporaryCoefficient[i] = mapToInternal(par[i], i);
+    mapped[i] = mapToInternal(par[i], i);
   }
   for (int i = mOutputArrayDimension; i--;) {
-    res[i] = getChebyshevCalc(i)->evaluateDerivative(dimd, mTemporaryCoefficient) * mBoundaryMappingScale[dimd];
+    res[i] = getChebyshevCalc(i)->evaluateDerivative(dimd, mapped) * mBoundaryMappingScale[dimd];
   };
 }
 
 // Evaluates Chebyshev parameterization 2nd derivative over dimd1 and dimd2 dimensions for 3d->DimOut function
-inline void Chebyshev3D::evaluateDerivative2(int dimd1, int dimd2, const Float_t* par, Float_t* res)
+inline void Chebyshev3D::evaluateDerivative2(int dimd1, int dimd2, const Float_t* par, Float_t* res) const
 {
+  Float_t mapped[3];
   for (int i = 3; i--;) {
-    mTemporaryCoefficient[i] = mapToInternal(par[i], i);
+    mapped[i] = mapToInternal(par[i], i);
   }
   for (int i = mOutputArrayDimension; i--;) {
-    res[i] = getChebyshevCalc(i)->evaluateDerivative2(dimd1, dimd2, mTemporaryCoefficient) *
+    res[i] = getChebyshevCalc(i)->evaluateDerivative2(dimd1, dimd2, mapped) *
              mBoundaryMappingScale[dimd1] * mBoundaryMappingScale[dimd2];
   }
 }
 
 /// Evaluates Chebyshev parameterization derivative over dimd dimention for idim-th output dimension of 3d->DimOut
 /// function
-inline Float_t Chebyshev3D::evaluateDerivative(int dimd, const Float_t* par, int idim)
+inline Float_t Chebyshev3D::evaluateDerivative(int dimd, const Float_t* par, int idim) const
 {
+  Float_t mapped[3];
   for (int i = 3; i--;) {
-    mTemporaryCoefficient[i] = mapToInternal(par[i], i);
+    mapped[i] = mapToInternal(par[i], i);
   }
-  return getChebyshevCalc(idim)->evaluateDerivative(dimd, mTemporaryCoefficient) * mBoundaryMappingScale[dimd];
+  return getChebyshevCalc(idim)->evaluateDerivative(dimd, mapped) * mBoundaryMappingScale[dimd];
 }
 
 /// Evaluates Chebyshev parameterization 2ns derivative over dimd1 and dimd2 dimensions for idim-th output dimension of
 /// 3d->DimOut function
-inline Float_t Chebyshev3D::evaluateDerivative2(int dimd1, int dimd2, const Float_t* par, int idim)
+inline Float_t Chebyshev3D::evaluateDerivative2(int dimd1, int dimd2, const Float_t* par, int idim) const
 {
+  Float_t mapped[3];
   for (int i = 3; i--;) {
-    mTemporaryCoefficient[i] = mapToInternal(par[i], i);
+    mapped[i] = mapToInternal(par[i], i);
   }
-  return getChebyshevCalc(idim)->evaluateDerivative2(dimd1, dimd2, mTemporaryCoefficient) *
+  return getChebyshevCalc(idim)->evaluateDerivative2(dimd1, dimd2, mapped) *
          mBoundaryMappingScale[dimd1] * mBoundaryMappingScale[dimd2];
 }
 
@@ -169,6 +169,19 @@ class Chebyshev3DCalc : public TNamed
 
   Double_t Eval(const Double_t* par) const;
 
+  /// Evaluates Chebyshev parameterization for a batch of points of the 3D function.
+  /// The Clenshaw recursions are done for sBatchSize points at once with the loop over the points innermost, so that
+  /// they are vectorized by the compiler. The temporary coefficients are local to the call.
+  /// VERY IMPORTANT: par0, par1, par2 must contain the function arguments ALREADY MAPPED to [-1:1] interval
+  /// \param npoints number of points
+  /// \param par0 first argument of each point
+  /// \param par1 second argument of each point
+  /// \param par2 third argument of each point
+  /// \param res output value of each point
+  void Eval(int npoints, const Float_t* par0, const Float_t* par1, const Float_t* par2, Float_t* res) const;
+
+  static constexpr int sBatchSize = 16; ///< number of points evaluated together in the batched Eval
+
  private:
   Int_t mNumberOfCoefficients;    ///< total number of coeeficients
   Int_t mNumberOfRows;            ///< number of significant rows in the 3D coeffs matrix
@@ -187,8 +200,8 @@ class Chebyshev3DCalc : public TNamed
   // coeffs for col/row
   Float_t* mCoefficients; //[mNumberOfCoefficients] array of Chebyshev coefficients
 
-  Float_t* mTemporaryCoefficients2D; //[mNumberOfColumns] temp. coeffs for 2d summation
-  Float_t* mTemporaryCoefficients1D; //[mNumberOfRows] temp. coeffs for 1d summation
+  Float_t* mTemporaryCoefficients2D; //[mNumberOfColumns] temp. coeffs for 2d summation, no longer used by the evaluation
+  Float_t* mTemporaryCoefficients1D; //[mNumberOfRows] temp. coeffs for 1d summation, no longer used by the evaluation
 
   ClassDefOverride(o2::math_utils::Chebyshev3DCalc,
                    2) // Class for interpolation of 3D->1 function by Chebyshev parametrization
@@ -215,34 +228,36 @@ inline Float_t Chebyshev3DCalc::chebyshevEvaluation1D(Float_t x, const Float_t*
 
 /// Evaluates Chebyshev parameterization for 3D function.
 /// VERY IMPORTANT: par must contain the function arguments ALREADY MAPPED to [-1:1] interval
+/// The recursions over the columns and rows consume the coefficients in the order in which they are computed, so no
+/// temporary arrays are needed and the parameterization can be evaluated concurrently
 inline Float_t Chebyshev3DCalc::Eval(const Float_t* par) const
 {
+  const Float_t x02 = par[0] + par[0], x12 = par[1] + par[1];
+  Float_t b0 = 0, b1 = 0, b2;
   for (int id0 = mNumberOfRows; id0--;) {
     int nCLoc = mNumberOfColumnsAtRow[id0]; // number of significant coefs on this row
     int col0 = mColumnAtRowBeginning[id0];  // beginning of local column in the 2D boundary matrix
+    Float_t c0 = 0, c1 = 0, c2;
     for (int id1 = nCLoc; id1--;) {
       int id = id1 + col0;
-      mTemporaryCoefficients2D[id1] = chebyshevEvaluation1D(par[2], mCoefficients + mCoefficientBound2D1[id], mCoefficientBound2D0[id]);
+      c2 = c1;
+      c1 = c0;
+      c0 = chebyshevEvaluation1D(par[2], mCoefficients + mCoefficientBound2D1[id], mCoefficientBound2D0[id]) + x12 * c1 - c2;
     }
-    mTemporaryCoefficients1D[id0] = chebyshevEvaluation1D(par[1], mTemporaryCoefficients2D, nCLoc);
+    const Float_t row = c0 - par[1] * c1;
+    b2 = b1;
+    b1 = b0;
+    b0 = row + x02 * b1 - b2;
   }
-  return chebyshevEvaluation1D(par[0], mTemporaryCoefficients1D, mNumberOfRows);
+  return b0 - par[0] * b1;
 }
 
 /// Evaluates Chebyshev parameterization for 3D function.
 /// VERY IMPORTANT: par must contain the function arguments ALREADY MAPPED to [-1:1] interval
 inline Double_t Chebyshev3DCalc::Eval(const Double_t* par) const
 {
-  for (int id0 = mNumberOfRows; id0--;) {
-    int nCLoc = mNumberOfColumnsAtRow[id0]; // number of significant coefs on this row
-    int col0 = mColumnAtRowBeginning[id0];  // beginning of local column in the 2D boundary matrix
-    for (int id1 = nCLoc; id1--;) {
-      int id = id1 + col0;
-      mTemporaryCoefficients2D[id1] = chebyshevEvaluation1D(par[2], mCoefficients + mCoefficientBound2D1[id], mCoefficientBound2D0[id]);
-    }
-    mTemporaryCoefficients1D[id0] = chebyshevEvaluation1D(par[1], mTemporaryCoefficients2D, nCLoc);
-  }
-  return chebyshevEvaluation1D(par[0], mTemporaryCoefficients1D, mNumberOfRows);
+  const Float_t parF[3] = {Float_t(par[0]), Float_t(par[1]), Float_t(par[2])};
+  return Eval(parF);
 }
 } // namespace math_utils
 } // namespace o2
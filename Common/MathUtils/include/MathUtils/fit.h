@@ -141,9 +141,10 @@ TFitResultPtr fit(const size_t nBins, const T* arr, const T xMin, const T xMax,
 template <typename T>
 Double_t fitGaus(const size_t nBins, const T* arr, const T xMin, const T xMax, std::vector<T>& param)
 {
-  static TLinearFitter fitter(3, "pol2");
-  static TMatrixD mat(3, 3);
-  static Double_t kTol = mat.GetTol();
+  // one fitter per thread, e.g. for calibrations preparing their slots in several threads
+  static thread_local TLinearFitter fitter(3, "pol2");
+  static thread_local TMatrixD mat(3, 3);
+  static thread_local Double_t kTol = mat.GetTol();
   fitter.StoreData(kFALSE);
   fitter.ClearPoints();
   TVectorD par(3);
@@ -27,6 +27,7 @@
 #include "TMathBase.h"                 // for Max, Abs
 #include "TNamed.h"                    // for TNamed
 #include "TObjArray.h"                 // for TObjArray
+#include <vector>                      // for std::vector
 
 using namespace o2::math_utils;
 
@@ -288,6 +289,23 @@ Chebyshev3D& Chebyshev3D::operator=(const Chebyshev3D& rhs)
   return *this;
 }
 
+void Chebyshev3D::Eval(Int_t npoints, const Double_t* par, Double_t* res) const
+{
+  // map the arguments of all points to [-1:1] and evaluate each output dimension for all points at once
+  std::vector<Float_t> mapped(3 * npoints), val(npoints);
+  for (int ip = 0; ip < npoints; ip++) {
+    for (int i = 3; i--;) {
+      mapped[i * npoints + ip] = mapToInternal(par[3 * ip + i], i);
+    }
+  }
+  for (int i = mOutputArrayDimension; i--;) {
+    getChebyshevCalc(i)->Eval(npoints, &mapped[0], &mapped[npoints], &mapped[2 * npoints], val.data());
+    for (int ip = 0; ip < npoints; ip++) {
+      res[mOutputArrayDimension * ip + i] = val[ip];
+    }
+  }
+}
+
 void Chebyshev3D::Clear(const Option_t*)
 {
   // clear all dynamic structures
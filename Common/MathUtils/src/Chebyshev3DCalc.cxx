@@ -17,9 +17,67 @@
 #include <TSystem.h> // for TSystem, gSystem
 #include "TNamed.h"  // for TNamed
 #include "TString.h" // for TString, TString::EStripType::kBoth
+#include <algorithm> // for std::min
+#include <vector>    // for std::vector
 
 using namespace o2::math_utils;
 
+namespace
+{
+constexpr int BatchSize = Chebyshev3DCalc::sBatchSize;
+
+/// Evaluates 1D Chebyshev parameterization with the same coefficients for a batch of points
+inline void chebyshevEvaluation1DBatch(const Float_t* x, const Float_t* array, int ncf, Float_t* res)
+{
+  if (ncf <= 0) {
+    std::fill(res, res + BatchSize, 0);
+    return;
+  }
+  Float_t b0[BatchSize], b1[BatchSize], b2[BatchSize];
+  --ncf;
+  for (int ip = 0; ip < BatchSize; ip++) {
+    b0[ip] = array[ncf];
+    b1[ip] = 0;
+  }
+  for (int i = ncf; i--;) {
+    for (int ip = 0; ip < BatchSize; ip++) {
+      b2[ip] = b1[ip];
+      b1[ip] = b0[ip];
+      b0[ip] = array[i] + (x[ip] + x[ip]) * b1[ip] - b2[ip];
+    }
+  }
+  for (int ip = 0; ip < BatchSize; ip++) {
+    res[ip] = b0[ip] - x[ip] * b1[ip];
+  }
+}
+
+/// Evaluates 1D Chebyshev parameterization for a batch of points with different coefficients for each point,
+/// the i-th coefficient of the point ip is array[i * BatchSize + ip]
+inline void chebyshevEvaluation1DBatchPointCoefficients(const Float_t* x, const Float_t* array, int ncf, Float_t* res)
+{
+  if (ncf <= 0) {
+    std::fill(res, res + BatchSize, 0);
+    return;
+  }
+  Float_t b0[BatchSize], b1[BatchSize], b2[BatchSize];
+  --ncf;
+  for (int ip = 0; ip < BatchSize; ip++) {
+    b0[ip] = array[ncf * BatchSize + ip];
+    b1[ip] = 0;
+  }
+  for (int i = ncf; i--;) {
+    for (int ip = 0; ip < BatchSize; ip++) {
+      b2[ip] = b1[ip];
+      b1[ip] = b0[ip];
+      b0[ip] = array[i * BatchSize + ip] + (x[ip] + x[ip]) * b1[ip] - b2[ip];
+    }
+  }
+  for (int ip = 0; ip < BatchSize; ip++) {
+    res[ip] = b0[ip] - x[ip] * b1[ip];
+  }
+}
+} // namespace
+
 ClassImp(Chebyshev3DCalc);
 
 Chebyshev3DCalc::Chebyshev3DCalc()
@@ -205,11 +263,12 @@ void Chebyshev3DCalc::Print(const Option_t*) const
 
 Float_t Chebyshev3DCalc::evaluateDerivative(int dim, const Float_t* par) const
 {
+  std::vector<Float_t> coefs2D(mNumberOfColumns), coefs1D(mNumberOfRows); // local, to allow concurrent evaluation
   int ncfRC;
   for (int id0 = mNumberOfRows; id0--;) {
     int nCLoc = mNumberOfColumnsAtRow[id0]; // number of significant coefs on this row
     if (!nCLoc) {
-      mTemporaryCoefficients1D[id0] = 0;
+      coefs1D[id0] = 0;
       continue;
     }
     //
@@ -217,62 +276,62 @@ Float_t Chebyshev3DCalc::evaluateDerivative(int dim, const Float_t* par) const
     for (int id1 = nCLoc; id1--;) {
       int id = id1 + col0;
       if (!(ncfRC = mCoefficientBound2D0[id])) {
-        mTemporaryCoefficients2D[id1] = 0;
+        coefs2D[id1] = 0;
         continue;
       }
       if (dim == 2) {
-        mTemporaryCoefficients2D[id1] =
-          chebyshevEvaluation1Derivative(par[2], mCoefficients + mCoefficientBound2D1[id], ncfRC);
+        coefs2D[id1] = chebyshevEvaluation1Derivative(par[2], mCoefficients + mCoefficientBound2D1[id], ncfRC);
       } else {
-        mTemporaryCoefficients2D[id1] = chebyshevEvaluation1D(par[2], mCoefficients + mCoefficientBound2D1[id], ncfRC);
+        coefs2D[id1] = chebyshevEvaluation1D(par[2], mCoefficients + mCoefficientBound2D1[id], ncfRC);
       }
     }
     if (dim == 1) {
-      mTemporaryCoefficients1D[id0] = chebyshevEvaluation1Derivative(par[1], mTemporaryCoefficients2D, nCLoc);
+      coefs1D[id0] = chebyshevEvaluation1Derivative(par[1], coefs2D.data(), nCLoc);
     } else {
-      mTemporaryCoefficients1D[id0] = chebyshevEvaluation1D(par[1], mTemporaryCoefficients2D, nCLoc);
+      coefs1D[id0] = chebyshevEvaluation1D(par[1], coefs2D.data(), nCLoc);
     }
   }
-  return (dim == 0) ? chebyshevEvaluation1Derivative(par[0], mTemporaryCoefficients1D, mNumberOfRows)
-                    : chebyshevEvaluation1D(par[0], mTemporaryCoefficients1D, mNumberOfRows);
+  return (dim == 0) ? chebyshevEvaluation1Derivative(par[0], coefs1D.data(), mNumberOfRows)
+                    : chebyshevEvaluation1D(par[0], coefs1D.data(), mNumberOfRows);
 }
 
 Float_t Chebyshev3DCalc::evaluateDerivative2(int dim1, int dim2, const Float_t* par) const
 {
+  std::vector<Float_t> coefs2D(mNumberOfColumns), coefs1D(mNumberOfRows); // local, to allow concurrent evaluation
   Bool_t same = dim1 == dim2;
   int ncfRC;
   for (int id0 = mNumberOfRows; id0--;) {
     int nCLoc = mNumberOfColumnsAtRow[id0]; // number of significant coefs on this row
     if (!nCLoc) {
-      mTemporaryCoefficients1D[id0] = 0;
+      coefs1D[id0] = 0;
       continue;
     }
     int col0 = mColumnAtRowBeginning[id0]; // beginning of local column in the 2D boundary matrix
     for (int id1 = nCLoc; id1--;) {
       int id = id1 + col0;
       if (!(ncfRC = mCoefficientBound2D0[id])) {
-        mTemporaryCoefficients2D[id1] = 0;
+        coefs2D[id1] = 0;
         continue;
       }
       if (dim1 == 2 || dim2 == 2) {
-        mTemporaryCoefficients2D[id1] =
+        coefs2D[id1] =
           same ? chebyshevEvaluation1Derivative2(par[2], mCoefficients + mCoefficientBound2D1[id], ncfRC)
                : chebyshevEvaluation1Derivative(par[2], mCoefficients + mCoefficientBound2D1[id], ncfRC);
       } else {
-        mTemporaryCoefficients2D[id1] = chebyshevEvaluation1D(par[2], mCoefficients + mCoefficientBound2D1[id], ncfRC);
+        coefs2D[id1] = chebyshevEvaluation1D(par[2], mCoefficients + mCoefficientBound2D1[id], ncfRC);
       }
     }
     if (dim1 == 1 || dim2 == 1) {
-      mTemporaryCoefficients1D[id0] = same ? chebyshevEvaluation1Derivative2(par[1], mTemporaryCoefficients2D, nCLoc)
-                                           : chebyshevEvaluation1Derivative(par[1], mTemporaryCoefficients2D, nCLoc);
+      coefs1D[id0] = same ? chebyshevEvaluation1Derivative2(par[1], coefs2D.data(), nCLoc)
+                          : chebyshevEvaluation1Derivative(par[1], coefs2D.data(), nCLoc);
     } else {
-      mTemporaryCoefficients1D[id0] = chebyshevEvaluation1D(par[1], mTemporaryCoefficients2D, nCLoc);
+      coefs1D[id0] = chebyshevEvaluation1D(par[1], coefs2D.data(), nCLoc);
     }
   }
   return (dim1 == 0 || dim2 == 0)
-           ? (same ? chebyshevEvaluation1Derivative2(par[0], mTemporaryCoefficients1D, mNumberOfRows)
-                   : chebyshevEvaluation1Derivative(par[0], mTemporaryCoefficients1D, mNumberOfRows))
-           : chebyshevEvaluation1D(par[0], mTemporaryCoefficients1D, mNumberOfRows);
+           ? (same ? chebyshevEvaluation1Derivative2(par[0], coefs1D.data(), mNumberOfRows)
+                   : chebyshevEvaluation1Derivative(par[0], coefs1D.data(), mNumberOfRows))
+           : chebyshevEvaluation1D(par[0], coefs1D.data(), mNumberOfRows);
 }
 
 #ifdef _INC_CREATION_Chebyshev3D_
@@ -530,6 +589,32 @@ Float_t Chebyshev3DCalc::chebyshevEvaluation1Derivative2(Float_t x, const Float_
   return b0 - x * b1 - ddcf0 / 2;
 }
 
+void Chebyshev3DCalc::Eval(int npoints, const Float_t* par0, const Float_t* par1, const Float_t* par2, Float_t* res) const
+{
+  Float_t x0[BatchSize], x1[BatchSize], x2[BatchSize], val[BatchSize];
+  std::vector<Float_t> coefs2D(mNumberOfColumns * BatchSize), coefs1D(mNumberOfRows * BatchSize);
+  for (int first = 0; first < npoints; first += BatchSize) {
+    // the last batch is padded with points at the origin
+    const int n = std::min(BatchSize, npoints - first);
+    for (int ip = 0; ip < BatchSize; ip++) {
+      x0[ip] = ip < n ? par0[first + ip] : 0;
+      x1[ip] = ip < n ? par1[first + ip] : 0;
+      x2[ip] = ip < n ? par2[first + ip] : 0;
+    }
+    for (int id0 = mNumberOfRows; id0--;) {
+      int nCLoc = mNumberOfColumnsAtRow[id0]; // number of significant coefs on this row
+      int col0 = mColumnAtRowBeginning[id0];  // beginning of local column in the 2D boundary matrix
+      for (int id1 = nCLoc; id1--;) {
+        int id = id1 + col0;
+        chebyshevEvaluation1DBatch(x2, mCoefficients + mCoefficientBound2D1[id], mCoefficientBound2D0[id], &coefs2D[id1 * BatchSize]);
+      }
+      chebyshevEvaluation1DBatchPointCoefficients(x1, coefs2D.data(), nCLoc, &coefs1D[id0 * BatchSize]);
+    }
+    chebyshevEvaluation1DBatchPointCoefficients(x0, coefs1D.data(), mNumberOfRows, val);
+    std::copy(val, val + n, res + first);
+  }
+}
+
 Int_t Chebyshev3DCalc::getMaxColumnsAtRow() const
 {
   int nmax3d = 0;
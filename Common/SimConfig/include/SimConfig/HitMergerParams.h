@@ -0,0 +1,36 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+
+#ifndef O2_SIMCONFIG_HITMERGERPARAMS_H_
+#define O2_SIMCONFIG_HITMERGERPARAMS_H_
+
+#include "CommonUtils/ConfigurableParam.h"
+#include "CommonUtils/ConfigurableParamHelper.h"
+
+namespace o2
+{
+namespace conf
+{
+// parameters steering the buffering and flushing of the hit merger process (O2HitMerger)
+struct HitMergerParams : public o2::conf::ConfigurableParamHelper<HitMergerParams> {
+  int nFlushThreads = 4;        // number of threads merging/writing the detector branches of an event in parallel
+  int maxBufferedMB = 4096;     // data buffered for events not yet flushed, above which no new data is received from the workers (<= 0: unbounded)
+  int backpressureTimeout = 10; // seconds after which a waiting merger reports that it is stalled
+  bool flatTransport = false;   // primaries, tracks and POD hits are sent as flat arrays instead of TMessages (the receivers accept both)
+  bool flatKinematics = false;  // also write the MCTracks to a memory-mappable flat file next to the kinematics file (<prefix>_Kine.dat)
+
+  O2ParamDef(HitMergerParams, "HitMergerParams");
+};
+} // namespace conf
+} // namespace o2
+
+#endif /* O2_SIMCONFIG_HITMERGERPARAMS_H_ */
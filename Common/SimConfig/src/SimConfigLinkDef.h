@@ -19,6 +19,8 @@
 
 #pragma link C++ class o2::conf::SimCutParams + ;
 #pragma link C++ class o2::conf::ConfigurableParamHelper < o2::conf::SimCutParams> + ;
+#pragma link C++ struct o2::conf::HitMergerParams + ;
+#pragma link C++ class o2::conf::ConfigurableParamHelper < o2::conf::HitMergerParams> + ;
 
 #pragma link C++ class o2::conf::SimUserDecay + ;
 #pragma link C++ class o2::conf::ConfigurableParamHelper < o2::conf::SimUserDecay> + ;
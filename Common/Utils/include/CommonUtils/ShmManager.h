@@ -22,6 +22,7 @@
 #include <list>
 #include <cstddef>
 #include <atomic>
+#include <string>
 
 #include <boost/interprocess/managed_external_buffer.hpp>
 #include <boost/interprocess/allocators/allocator.hpp>
@@ -100,6 +101,18 @@ class ShmManager
 
   void printSegInfo() const;
 
+  // named (POSIX) shared memory segments, independent of the simulation pool above:
+  // one process creates and fills a segment, which other processes then map by name
+
+  // creates the segment (replacing a previous one of the same name) and maps it writable; nullptr on failure
+  static void* createNamedSegment(std::string const& name, size_t size);
+  // maps an existing segment, returns nullptr if absent; the segment itself is opened read-only
+  // and the mapping is private, so that local modifications (e.g. pointer relocation) only
+  // copy the touched pages into the process
+  static void* attachNamedSegment(std::string const& name, size_t& size);
+  static void detachNamedSegment(void* ptr, size_t size);
+  static bool removeNamedSegment(std::string const& name);
+
  private:
   ShmManager();
   ~ShmManager();
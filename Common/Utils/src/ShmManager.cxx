@@ -21,6 +21,10 @@
 #include <fairlogger/Logger.h>
 #include <sys/shm.h>
 #include <sys/ipc.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <algorithm>
 
 #include <boost/interprocess/managed_external_buffer.hpp>
@@ -28,6 +32,8 @@
 #include <sstream>
 #include <cstdlib>
 #include <cassert>
+#include <cerrno>
+#include <cstring>
 
 using namespace boost::interprocess;
 
@@ -247,5 +253,72 @@ void ShmManager::release()
 #endif
 }
 
+namespace
+{
+// POSIX shm names are of the form /somename
+std::string shmName(std::string const& name)
+{
+  return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+} // namespace
+
+void* ShmManager::createNamedSegment(std::string const& name, size_t size)
+{
+  const auto shmname = shmName(name);
+  // processes having mapped a previous segment of this name keep it until they unmap it
+  shm_unlink(shmname.c_str());
+  auto fd = shm_open(shmname.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd == -1) {
+    LOG(ERROR) << "COULD NOT CREATE NAMED SEGMENT " << shmname << " : " << strerror(errno);
+    return nullptr;
+  }
+  void* addr = MAP_FAILED;
+  if (ftruncate(fd, size) == 0) {
+    addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (addr == MAP_FAILED) {
+    LOG(ERROR) << "COULD NOT MAP NAMED SEGMENT " << shmname << " OF SIZE " << size << " : " << strerror(errno);
+    shm_unlink(shmname.c_str());
+    return nullptr;
+  }
+  LOG(DEBUG) << "CREATED NAMED SEGMENT " << shmname << " OF SIZE " << size;
+  return addr;
+}
+
+void* ShmManager::attachNamedSegment(std::string const& name, size_t& size)
+{
+  const auto shmname = shmName(name);
+  size = 0;
+  auto fd = shm_open(shmname.c_str(), O_RDONLY, 0);
+  if (fd == -1) {
+    return nullptr;
+  }
+  struct stat st;
+  void* addr = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    addr = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  if (addr == MAP_FAILED) {
+    LOG(ERROR) << "COULD NOT MAP NAMED SEGMENT " << shmname;
+    return nullptr;
+  }
+  size = st.st_size;
+  return addr;
+}
+
+void ShmManager::detachNamedSegment(void* ptr, size_t size)
+{
+  if (ptr) {
+    munmap(ptr, size);
+  }
+}
+
+bool ShmManager::removeNamedSegment(std::string const& name)
+{
+  return shm_unlink(shmName(name).c_str()) == 0;
+}
+
 } // end namespace utils
 } // end namespace o2
@@ -55,6 +55,12 @@ class NameConf : public o2::conf::ConfigurableParamHelper<NameConf>
     return o2::utils::Str::concat_string(prefix, "_", KINE_STRING, ".root");
   }
 
+  // Filename of the flat, memory-mappable copy of the MCTracks of the kinematics file
+  static std::string getMCKinematicsFlatFileName(const std::string_view prefix = STANDARDSIMPREFIX)
+  {
+    return o2::utils::Str::concat_string(prefix, "_", KINE_STRING, ".", DAT_EXT_STRING);
+  }
+
   // Filename to store kinematics + TrackRefs
   static std::string getMCHeadersFileName(const std::string_view prefix = STANDARDSIMPREFIX)
   {
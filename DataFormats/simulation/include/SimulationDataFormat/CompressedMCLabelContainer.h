@@ -0,0 +1,416 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CompressedMCLabelContainer.h
+/// \brief A read-only, delta and variable-length coded flat container of MCCompLabels with indexed access
+
+#ifndef O2_COMPRESSEDMCLABELCONTAINER_H
+#define O2_COMPRESSEDMCLABELCONTAINER_H
+
+#include "SimulationDataFormat/MCCompLabel.h"
+#include <gsl/span>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#ifndef GPUCA_STANDALONE
+#include <Framework/Traits.h>
+#endif
+
+namespace o2
+{
+namespace dataformats
+{
+
+/// Encoding of the labels in the compressed containers.
+///
+/// Layout of the flat buffer: FlatHeader, the (nofBlocks + 1) byte offsets of the blocks in the payload and the payload.
+/// The data indices are grouped in blocks of BlockSize consecutive indices. Each data index is coded as the number of
+/// its labels followed by the labels. The first label is coded relative to the first label of the previous data index
+/// of the block with labels (a zero label at the start of the block), the other ones relative to the preceding label:
+///  - if the event and source are the same: (zigzag(trackID - reference trackID) << 2 | fake flag changed << 1)
+///  - otherwise: 1 followed by the bare label value
+/// all numbers being stored as little-endian base-128 varints. A label repeated by neighbouring digits thus takes
+/// one byte, a digit with a single label two bytes instead of the 12 bytes of ConstMCTruthContainer.
+/// The decoding of a data index starts at its block, so that random access skips at most BlockSize - 1 indices.
+namespace mclabelcoding
+{
+struct FlatHeader {
+  uint32_t version = 1;
+  uint32_t blockSize = 0;         // number of data indices per block
+  uint32_t nofHeaderElements = 0; // number of data indices
+  uint32_t nofBlocks = 0;         // number of blocks
+  uint64_t nofTruthElements = 0;  // number of labels
+  uint64_t payloadSize = 0;       // size of the coded labels in bytes
+};
+static_assert(sizeof(FlatHeader) % sizeof(uint64_t) == 0, "the block offsets follow the header");
+
+constexpr uint32_t BlockSize = 32;
+constexpr ULong64_t maskFake = ULong64_t(1) << 63;                      // fake flag of MCCompLabel
+constexpr ULong64_t maskUpper = ~(MCCompLabel::maskTrackID | maskFake); // event, source and reserved bits
+
+inline uint64_t readVarint(const uint8_t*& ptr)
+{
+  uint64_t value = 0;
+  int shift = 0;
+  uint8_t byte;
+  do {
+    byte = *ptr++;
+    value |= uint64_t(byte & 0x7f) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return value;
+}
+
+inline void writeVarint(std::vector<char>& out, uint64_t value)
+{
+  while (value >= 0x80) {
+    out.push_back(char((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(char(value));
+}
+
+/// decode a label coded relative to the label with bare value reference
+inline ULong64_t decodeLabel(const uint8_t*& ptr, ULong64_t reference)
+{
+  const auto code = readVarint(ptr);
+  if (code & 1) {
+    return readVarint(ptr);
+  }
+  const auto zigzag = code >> 2;
+  const auto delta = (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+  return ((reference & ~MCCompLabel::maskTrackID) ^ ((code & 2) ? maskFake : 0)) | ((reference + delta) & MCCompLabel::maskTrackID);
+}
+
+inline void encodeLabel(std::vector<char>& out, ULong64_t label, ULong64_t reference)
+{
+  if (((label ^ reference) & maskUpper) == 0) {
+    const int64_t delta = int64_t(label & MCCompLabel::maskTrackID) - int64_t(reference & MCCompLabel::maskTrackID);
+    const uint64_t zigzag = (uint64_t(delta) << 1) ^ uint64_t(delta >> 63);
+    writeVarint(out, (zigzag << 2) | (((label ^ reference) & maskFake) ? 2 : 0));
+  } else {
+    writeVarint(out, 1);
+    writeVarint(out, label);
+  }
+}
+} // namespace mclabelcoding
+
+/// @class CompressedMCLabelRange
+/// @brief The labels of one data index, decoded while iterating
+///
+/// Span-like read access to the labels of a data index of a compressed container, with forward iterators
+/// returning the labels by value. The labels are only valid as long as the underlying buffer.
+class CompressedMCLabelRange
+{
+ public:
+  class iterator
+  {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = MCCompLabel;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const MCCompLabel*;
+    using reference = MCCompLabel;
+
+    iterator() = default;
+    iterator(const uint8_t* ptr, ULong64_t reference, uint32_t left) : mPtr(ptr), mLeft(left)
+    {
+      if (mLeft) {
+        mValue = mclabelcoding::decodeLabel(mPtr, reference);
+      }
+    }
+
+    MCCompLabel operator*() const
+    {
+      MCCompLabel label;
+      label.setRawValue(mValue);
+      return label;
+    }
+    iterator& operator++()
+    {
+      if (--mLeft) {
+        mValue = mclabelcoding::decodeLabel(mPtr, mValue);
+      }
+      return *this;
+    }
+    iterator operator++(int)
+    {
+      auto tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    bool operator==(const iterator& other) const { return mLeft == other.mLeft; }
+    bool operator!=(const iterator& other) const { return mLeft != other.mLeft; }
+
+   private:
+    const uint8_t* mPtr = nullptr; // next coded label
+    ULong64_t mValue = 0;          // bare value of the current label, the reference of the next one
+    uint32_t mLeft = 0;            // number of labels left including the current one
+  };
+
+  CompressedMCLabelRange() = default;
+  CompressedMCLabelRange(const uint8_t* ptr, ULong64_t reference, uint32_t size) : mPtr(ptr), mReference(reference), mSize(size) {}
+
+  size_t size() const { return mSize; }
+  bool empty() const { return mSize == 0; }
+  iterator begin() const { return iterator(mPtr, mReference, mSize); }
+  iterator end() const { return iterator(); }
+  MCCompLabel front() const { return *begin(); }
+  // decodes the labels up to i
+  MCCompLabel operator[](size_t i) const
+  {
+    auto it = begin();
+    std::advance(it, i);
+    return *it;
+  }
+
+ private:
+  const uint8_t* mPtr = nullptr; // first coded label
+  ULong64_t mReference = 0;      // bare value of the reference of the first label
+  uint32_t mSize = 0;            // number of labels
+};
+
+/// @class CompressedMCLabelContainerView
+/// @brief Read access to a compressed label buffer without owning the storage (similar to ConstMCTruthContainerView)
+class CompressedMCLabelContainerView
+{
+ public:
+  using FlatHeader = mclabelcoding::FlatHeader;
+
+  CompressedMCLabelContainerView() = default;
+  CompressedMCLabelContainerView(gsl::span<const char> const bufferview) : mStorage(bufferview) {}
+
+  // the labels of a data index, empty for an index which is not in the container
+  CompressedMCLabelRange getLabels(uint32_t dataindex) const
+  {
+    if (dataindex >= getIndexedSize()) {
+      return CompressedMCLabelRange();
+    }
+    const auto& header = getHeader();
+    const auto block = dataindex / header.blockSize;
+    const uint8_t* ptr = getPayloadStart() + getBlockOffsets()[block];
+    ULong64_t previous = 0; // first label of the previous data index with labels
+    for (auto skip = dataindex % header.blockSize; skip > 0; --skip) {
+      const auto n = mclabelcoding::readVarint(ptr);
+      if (n > 0) {
+        previous = mclabelcoding::decodeLabel(ptr, previous);
+        auto label = previous;
+        for (auto i = n - 1; i > 0; --i) {
+          label = mclabelcoding::decodeLabel(ptr, label);
+        }
+      }
+    }
+    const auto size = uint32_t(mclabelcoding::readVarint(ptr));
+    return CompressedMCLabelRange(ptr, previous, size);
+  }
+
+  // return the number of original data indexed here
+  size_t getIndexedSize() const { return size_t(mStorage.size()) >= sizeof(FlatHeader) ? getHeader().nofHeaderElements : 0; }
+
+  // return the number of labels managed in this container
+  size_t getNElements() const { return size_t(mStorage.size()) >= sizeof(FlatHeader) ? getHeader().nofTruthElements : 0; }
+
+  // return underlying buffer
+  const gsl::span<const char>& getBuffer() const { return mStorage; }
+
+ private:
+  gsl::span<const char> mStorage;
+
+  FlatHeader const& getHeader() const { return *reinterpret_cast<FlatHeader const*>(mStorage.data()); }
+  uint64_t const* getBlockOffsets() const { return reinterpret_cast<uint64_t const*>(mStorage.data() + sizeof(FlatHeader)); }
+  uint8_t const* getPayloadStart() const
+  {
+    return reinterpret_cast<uint8_t const*>(mStorage.data() + sizeof(FlatHeader) + (getHeader().nofBlocks + 1) * sizeof(uint64_t));
+  }
+};
+
+/// @class CompressedMCLabelContainer
+/// @brief A read-only, compressed alternative to ConstMCTruthContainer<MCCompLabel>
+///
+/// The labels are kept in a single flat buffer which can be shared in memory, sent over network or stored
+/// with IOMCTruthContainerView. This container needs to be filled by calling "flatten_to" of a CompressedMCLabelWriter.
+class CompressedMCLabelContainer : public std::vector<char>
+{
+ public:
+  // (unfortunately we need these constructors for DPL)
+  using std::vector<char>::vector;
+  CompressedMCLabelContainer() = default;
+
+  CompressedMCLabelContainerView getView() const { return CompressedMCLabelContainerView(gsl::span<const char>(*this)); }
+
+  CompressedMCLabelRange getLabels(uint32_t dataindex) const { return getView().getLabels(dataindex); }
+
+  // return the number of original data indexed here
+  size_t getIndexedSize() const { return getView().getIndexedSize(); }
+
+  // return the number of labels managed in this container
+  size_t getNElements() const { return getView().getNElements(); }
+};
+
+/// @class CompressedMCLabelWriter
+/// @brief Streaming writer of the compressed label containers
+///
+/// The labels are added in increasing order of the data index, as for MCTruthContainer::addElement, and are coded
+/// as soon as the next data index is started, so that the labels never need to be kept uncompressed.
+class CompressedMCLabelWriter
+{
+ public:
+  using FlatHeader = mclabelcoding::FlatHeader;
+
+  // add a label for a data index, the data index must be the current or a new one
+  void addElement(uint32_t dataindex, MCCompLabel const& element)
+  {
+    startIndex(dataindex);
+    mCurrentLabels.push_back(element);
+  }
+
+  // convenience interface to add multiple labels at once
+  void addElements(uint32_t dataindex, gsl::span<const MCCompLabel> elements)
+  {
+    startIndex(dataindex);
+    mCurrentLabels.insert(mCurrentLabels.end(), elements.begin(), elements.end());
+  }
+
+  // compress all labels of a label container (MCTruthContainer, ConstMCTruthContainer or view)
+  template <typename LabelContainer>
+  void addContainer(LabelContainer const& labels)
+  {
+    const auto offset = getIndexedSize();
+    for (size_t i = 0; i < labels.getIndexedSize(); ++i) {
+      const auto elements = labels.getLabels(i);
+      addElements(uint32_t(offset + i), gsl::span<const MCCompLabel>(elements.data(), elements.size()));
+    }
+  }
+
+  // return the number of data indices added
+  size_t getIndexedSize() const { return mNofIndices; }
+
+  // return the number of labels added
+  size_t getNElements() const { return mNofElements + mCurrentLabels.size(); }
+
+  void clear()
+  {
+    mPayload.clear();
+    mBlockOffsets.clear();
+    mCurrentLabels.clear();
+    mNofIndices = 0;
+    mNofCoded = 0;
+    mNofElements = 0;
+    mPrevious = 0;
+  }
+
+  // write the flat buffer of a CompressedMCLabelContainer (or any vector-like container of bytes)
+  // the writer can be further filled afterwards
+  template <typename ContainerType>
+  size_t flatten_to(ContainerType& container) const
+  {
+    // code the current data index separately, the coded ones are copied as they are
+    std::vector<char> tail;
+    std::vector<uint64_t> tailOffsets;
+    auto nofCoded = mNofCoded;
+    auto previous = mPrevious;
+    if (mNofCoded < mNofIndices) {
+      codeIndex(tail, tailOffsets, nofCoded, previous, mCurrentLabels);
+    }
+    for (auto& offset : tailOffsets) {
+      offset += mPayload.size();
+    }
+    tailOffsets.push_back(mPayload.size() + tail.size());
+
+    FlatHeader header;
+    header.blockSize = mclabelcoding::BlockSize;
+    header.nofHeaderElements = mNofIndices;
+    header.nofBlocks = mBlockOffsets.size() + tailOffsets.size() - 1;
+    header.nofTruthElements = getNElements();
+    header.payloadSize = mPayload.size() + tail.size();
+
+    const size_t bufferSize = sizeof(FlatHeader) + (header.nofBlocks + 1) * sizeof(uint64_t) + header.payloadSize;
+    container.resize((bufferSize / sizeof(typename ContainerType::value_type)) + ((bufferSize % sizeof(typename ContainerType::value_type)) > 0 ? 1 : 0));
+    char* target = reinterpret_cast<char*>(container.data());
+    auto append = [&target](const void* source, size_t size) {
+      if (size) {
+        std::memcpy(target, source, size);
+        target += size;
+      }
+    };
+    append(&header, sizeof(FlatHeader));
+    append(mBlockOffsets.data(), mBlockOffsets.size() * sizeof(uint64_t));
+    append(tailOffsets.data(), tailOffsets.size() * sizeof(uint64_t));
+    append(mPayload.data(), mPayload.size());
+    append(tail.data(), tail.size());
+    return bufferSize;
+  }
+
+ private:
+  std::vector<char> mPayload;              // coded labels of the completed data indices
+  std::vector<uint64_t> mBlockOffsets;     // start of the blocks in the payload
+  std::vector<MCCompLabel> mCurrentLabels; // labels of the last data index, not yet coded
+  uint32_t mNofIndices = 0;                // number of data indices including the current one
+  uint32_t mNofCoded = 0;                  // number of coded data indices
+  uint64_t mNofElements = 0;               // number of coded labels
+  ULong64_t mPrevious = 0;                 // first label of the last coded data index of the block with labels
+
+  void startIndex(uint32_t dataindex)
+  {
+    if (dataindex + 1 == mNofIndices) {
+      return; // more labels for the current data index
+    }
+    if (dataindex < mNofIndices) {
+      throw std::runtime_error("CompressedMCLabelWriter: data indices must be added in increasing order");
+    }
+    if (mNofCoded < mNofIndices) {
+      mNofElements += mCurrentLabels.size();
+      codeIndex(mPayload, mBlockOffsets, mNofCoded, mPrevious, mCurrentLabels);
+      mCurrentLabels.clear();
+    }
+    // add empty holes
+    while (mNofCoded < dataindex) {
+      codeIndex(mPayload, mBlockOffsets, mNofCoded, mPrevious, mCurrentLabels);
+    }
+    mNofIndices = dataindex + 1;
+  }
+
+  static void codeIndex(std::vector<char>& payload, std::vector<uint64_t>& blockOffsets, uint32_t& nofCoded, ULong64_t& previous,
+                        std::vector<MCCompLabel> const& labels)
+  {
+    if (nofCoded % mclabelcoding::BlockSize == 0) {
+      blockOffsets.push_back(payload.size());
+      previous = 0;
+    }
+    mclabelcoding::writeVarint(payload, labels.size());
+    auto reference = previous;
+    for (auto& label : labels) {
+      mclabelcoding::encodeLabel(payload, label.getRawValue(), reference);
+      reference = label.getRawValue();
+    }
+    if (!labels.empty()) {
+      previous = labels.front().getRawValue();
+    }
+    ++nofCoded;
+  }
+};
+
+} // namespace dataformats
+} // namespace o2
+
+// This is done so that DPL treats this container as a vector (see ConstMCTruthContainer)
+#ifndef GPUCA_STANDALONE
+namespace o2::framework
+{
+template <>
+struct is_specialization<o2::dataformats::CompressedMCLabelContainer, std::vector> : std::true_type {
+};
+} // namespace o2::framework
+#endif
+
+#endif
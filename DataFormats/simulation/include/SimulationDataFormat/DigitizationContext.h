@@ -82,6 +82,10 @@ class DigitizationContext
   /// irecord is vector of QED interaction times (sampled externally)
   void fillQED(std::string_view QEDprefix, std::vector<o2::InteractionTimeRecord> const& irecord);
 
+  /// same as above with the number of events of the QED production given, the QED events being assigned
+  /// round robin starting from entry firstQEDEntry (allows to fill consecutive contexts without reading the QED production)
+  void fillQED(std::string_view QEDprefix, std::vector<o2::InteractionTimeRecord> const& irecord, int numberQEDevents, int firstQEDEntry = 0);
+
   /// Common functions the setup input TChains for reading, given the state (prefixes) encapsulated
   /// by this context. The input vector needs to be empty otherwise nothing will be done.
   /// return boolean saying if input simchains was modified or not
@@ -89,6 +89,8 @@ class MCCompLabel
 
   // allow to retrieve bare label
   ULong64_t getRawValue() const { return mLabel; }
+  // restore a label from its bare value
+  void setRawValue(ULong64_t raw) { mLabel = raw; }
 
   // comparison operator, compares only label, not eventual weight or correctness info
   bool operator==(const MCCompLabel& other) const { return (mLabel & maskFull) == (other.mLabel & maskFull); }
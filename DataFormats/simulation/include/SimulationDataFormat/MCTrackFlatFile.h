@@ -0,0 +1,132 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  MCTrackFlatFile.h
+/// \brief Flat binary sidecar of the kinematics file with the packed MCTracks of all events, which is memory-mapped read only
+
+#ifndef ALICEO2_DATA_MCTRACKFLATFILE_H_
+#define ALICEO2_DATA_MCTRACKFLATFILE_H_
+
+#include "SimulationDataFormat/MCTrack.h"
+#include <gsl/span>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace o2
+{
+namespace dataformats
+{
+
+/// \class MCTrackFlatFile
+/// The MCTracks of the events of a simulation, as written to the MCTrack branch of the kinematics file, stored in a flat binary
+/// file which is memory-mapped read only. The tracks of an event or a single track are then accessed in place, without ROOT I/O
+/// and without loading whole events: only the pages which are touched are read from disk.
+///
+/// Layout of the file: Header, the MCTrack records of all events in the order of the entries of the kinematics tree,
+/// and the table of the (nEvents + 1) indices of the first record of each event (the last one being the total number of records).
+/// The records are the in-memory representation of o2::MCTrack, the record size in the header guards against a different layout.
+class MCTrackFlatFile
+{
+ public:
+  struct Header {
+    char magic[8];            ///< file identifier "O2MCKINE"
+    uint32_t version;         ///< version of the file layout
+    uint32_t trackSize;       ///< size of an MCTrack record
+    uint64_t nEvents;         ///< number of events
+    uint64_t offsetsPosition; ///< position of the table of the first record of each event in the file
+    char reserved[32];
+  };
+  static_assert(sizeof(Header) == 64, "the records are expected to start at a 64 byte boundary");
+  static_assert(std::is_trivially_copyable<o2::MCTrack>::value, "MCTracks are stored as plain records");
+
+  static constexpr char MAGIC[8]{'O', '2', 'M', 'C', 'K', 'I', 'N', 'E'};
+  static constexpr uint32_t VERSION{1};
+
+  /// \class Writer
+  /// Appends the tracks event by event; the file is only valid after close().
+  /// A file which is not closed explicitly is removed by the destructor.
+  class Writer
+  {
+   public:
+    Writer() = default;
+    ~Writer();
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    /// create the file, an already opened but not closed file is removed
+    bool open(const std::string& file);
+
+    /// append the tracks of the next event
+    bool addEvent(gsl::span<const o2::MCTrack> tracks);
+
+    /// write the table of offsets and the header
+    bool close();
+
+    /// close and remove an unfinished file, e.g. when the writing is aborted
+    void discard();
+
+    bool isOpen() const { return mOut.is_open(); }
+
+   private:
+    std::ofstream mOut;
+    std::string mFileName;
+    std::vector<uint64_t> mOffsets; ///< index of the first record of each event
+  };
+
+  MCTrackFlatFile() = default;
+  ~MCTrackFlatFile();
+  MCTrackFlatFile(const MCTrackFlatFile&) = delete;
+  MCTrackFlatFile& operator=(const MCTrackFlatFile&) = delete;
+
+  /// memory-map a file. A previously mapped file is unmapped
+  /// \param file file written by the Writer
+  /// \return returns true if the file is a valid flat kinematics file
+  bool open(const std::string& file);
+
+  /// unmap the file
+  void close();
+
+  /// \return returns if a file is mapped
+  bool isOpen() const { return mHeader != nullptr; }
+
+  size_t getNEvents() const { return mHeader ? mHeader->nEvents : 0; }
+
+  /// the tracks of an event, an empty span if the event does not exist
+  gsl::span<const o2::MCTrack> getTracks(int event) const
+  {
+    if (event < 0 || size_t(event) >= getNEvents()) {
+      return {};
+    }
+    return {mTracks + mOffsets[event], mTracks + mOffsets[event + 1]};
+  }
+
+  /// a single track, nullptr if it does not exist
+  o2::MCTrack const* getTrack(int event, int track) const
+  {
+    auto tracks = getTracks(event);
+    return (track >= 0 && size_t(track) < tracks.size()) ? &tracks[track] : nullptr;
+  }
+
+ private:
+  const Header* mHeader{nullptr};      ///< header of the mapped file
+  const o2::MCTrack* mTracks{nullptr}; ///< the records of all events
+  const uint64_t* mOffsets{nullptr};   ///< index of the first record of each event
+  void* mMappedAddress{nullptr};       ///< start of the mapped file
+  size_t mMappedSize{0};               ///< size of the mapped file
+};
+
+} // namespace dataformats
+} // namespace o2
+
+#endif
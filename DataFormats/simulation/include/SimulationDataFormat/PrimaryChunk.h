@@ -14,6 +14,7 @@
 
 #include <cstring>
 #include <SimulationDataFormat/MCEventHeader.h>
+#include <TParticle.h>
 
 namespace o2
 {
@@ -45,11 +46,48 @@ inline bool operator<(SubEventInfo const& a, SubEventInfo const& b)
   return a.eventID <= b.eventID && (a.part < b.part);
 }
 
+// plain (trivially copyable) image of a TParticle, used to send the primaries
+// as a flat array instead of streaming the TParticle objects
+struct FlatParticle {
+  static constexpr uint32_t USERBITS = 0x00ffc000; // bits 14-23 (e.g. ParticleStatus) set by generators and stack
+
+  int32_t pdg = 0;
+  int32_t status = 0;
+  int32_t mother[2] = {-1, -1};
+  int32_t daughter[2] = {-1, -1};
+  uint32_t uniqueID = 0;
+  uint32_t bits = 0;
+  double p[4] = {0., 0., 0., 0.}; // px, py, pz, E
+  double v[4] = {0., 0., 0., 0.}; // vx, vy, vz, t
+  double polarTheta = 0.; // the polarisation angles as stored by TParticle, so that it is restored exactly
+  double polarPhi = 0.;
+  double calcMass = 0.;
+  double weight = 1.;
+
+  FlatParticle() = default;
+  explicit FlatParticle(TParticle const& part)
+    : pdg(part.GetPdgCode()), status(part.GetStatusCode()), mother{part.GetFirstMother(), part.GetSecondMother()}, daughter{part.GetFirstDaughter(), part.GetLastDaughter()}, uniqueID(part.GetUniqueID()), bits(part.TestBits(USERBITS)), p{part.Px(), part.Py(), part.Pz(), part.Energy()}, v{part.Vx(), part.Vy(), part.Vz(), part.T()}, polarTheta(part.GetPolarTheta()), polarPhi(part.GetPolarPhi()), calcMass(part.GetCalcMass()), weight(part.GetWeight())
+  {
+  }
+
+  TParticle toTParticle() const
+  {
+    TParticle part(pdg, status, mother[0], mother[1], daughter[0], daughter[1], p[0], p[1], p[2], p[3], v[0], v[1], v[2], v[3]);
+    part.SetPolarTheta(polarTheta);
+    part.SetPolarPhi(polarPhi);
+    part.SetCalcMass(calcMass);
+    part.SetWeight(weight);
+    part.SetUniqueID(uniqueID);
+    part.SetBit(bits);
+    return part;
+  }
+};
+
 // Encapsulating primaries/tracks as well as the event info
 // to be processed by the simulation processors.
 struct PrimaryChunk {
   SubEventInfo mSubEventInfo;
-  std::vector<TParticle> mParticles; // the particles for this chunk
+  std::vector<TParticle> mParticles; // the particles for this chunk (empty when they are sent as FlatParticles)
   ClassDefNV(PrimaryChunk, 1);
 };
 } // namespace data
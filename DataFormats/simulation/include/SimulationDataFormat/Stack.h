@@ -27,9 +27,9 @@
 
 #include <map>
 #include <memory>
-#include <stack>
 #include <utility>
 #include <functional>
+#include <vector>
 
 class TClonesArray;
 class TRefArray;
@@ -44,8 +44,11 @@ class Detector;
 namespace data
 {
 /// This class handles the particle stack for the transport simulation.
-/// For the stack FILO functunality, it uses the STL stack. To store
-/// the tracks during transport, a TParticle array is used.
+/// For the stack FILO functunality, it keeps a vector of indices to the
+/// pending tracks. The secondaries are stored in flat arrays (one per
+/// particle property) which are reused between primaries and events,
+/// so that pushing a track does not allocate. The TParticle handed to
+/// the transport engine is only built when the track is popped.
 /// At the end of the event, tracks satisfying the filter criteria
 /// are copied to a MCTrack array, which is stored in the output.
 ///
@@ -190,7 +193,7 @@ class Stack : public FairGenericStack
   void initFromPrimaries(std::vector<TParticle>& primaries)
   {
     Reset();
-    for (auto p : primaries) {
+    for (auto& p : primaries) {
       Int_t doTrack = 0;
       if (p.TestBit(ParticleStatus::kToBeDone)) {
         doTrack = 1;
@@ -230,9 +233,31 @@ class Stack : public FairGenericStack
   typedef std::function<bool(const TParticle& p, const std::vector<TParticle>& particles)> TransportFcn;
 
  private:
-  /// STL stack (FILO) used to handle the TParticles for tracking
-  /// stack entries refer to
-  std::stack<TParticle> mStack; //!
+  /// Flat (structure of arrays) storage of the secondaries pushed by the transport.
+  /// Rows are appended in the order of PushTrack; truncating keeps the capacity of the arrays.
+  struct SecondaryPool {
+    std::vector<int> pdg, status, mother0, mother1, daughter0, daughter1;
+    std::vector<double> px, py, pz, e, vx, vy, vz, t, polx, poly, polz, weight;
+    std::vector<unsigned int> process;
+    std::vector<bool> toBeDone;
+
+    int size() const { return pdg.size(); }
+    /// append a row and return its index
+    int push(int toBeDone, int pdgCode, int statusCode, int parentID, int secondParentID, int daughter1ID, int daughter2ID,
+             double px, double py, double pz, double e, double vx, double vy, double vz, double time,
+             double polx, double poly, double polz, double weight, unsigned int proc);
+    /// keep the first n rows
+    void truncate(int n);
+    /// build the TParticle of a row, identical to the one constructed from the PushTrack arguments
+    void fillParticle(int row, TParticle& p) const;
+  };
+
+  /// Stack (FILO) of the tracks to be handed to the transport: an entry >= 0 is the row of a
+  /// secondary in mSecondaries, an entry < 0 refers to the primary (-1 - entry) in mPrimaryParticles
+  std::vector<int> mStack;             //!
+  SecondaryPool mSecondaries;          //!
+  int mNumberOfPendingSecondaries = 0; //! number of secondaries in mStack
+  int mLastSecondaryRow = -1;          //! row of the last pushed secondary if mCurrentParticle0 is not yet built from it
 
   /// Array of TParticles (contains all TParticles put into or created
   /// by the transport)
@@ -240,6 +265,9 @@ class Stack : public FairGenericStack
   std::vector<int> mTransportedIDs;          //! prim + sec trackIDs transported for "current" primary
   std::vector<int> mIndexOfPrimaries;        //! index of primaries in mParticles
   std::vector<int> mTrackIDtoParticlesEntry; //! an O(1) mapping of trackID to the entry of mParticles
+  std::vector<int> mIndicesKept;             //! index in mParticles -> index of the kept track, reused by FinishPrimary
+  std::vector<int> mReorderedIndices;        //! ordering of the kept tracks, reused by FinishPrimary
+  std::vector<int> mInvReorderedIndices;     //! inverse ordering of the kept tracks, reused by FinishPrimary
   // the current TParticle object
   TParticle mCurrentParticle;
   TParticle mCurrentParticle0;
@@ -315,6 +343,9 @@ class Stack : public FairGenericStack
 
   void handleTransportPrimary(TParticle& p);
 
+  /// build mCurrentParticle0 from the last pushed secondary, if not yet done
+  void updateCurrentParticle0();
+
   ClassDefOverride(Stack, 1);
 };
 
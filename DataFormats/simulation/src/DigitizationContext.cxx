@@ -15,6 +15,7 @@
 #include <TChain.h>
 #include <TFile.h>
 #include <iostream>
+#include <algorithm>
 #include <numeric> // for iota
 #include <MathUtils/Cartesian.h>
 
@@ -202,12 +203,7 @@ DigitizationContext const* DigitizationContext::loadFromFile(std::string_view fi
 
 void DigitizationContext::fillQED(std::string_view QEDprefix, std::vector<o2::InteractionTimeRecord> const& irecord)
 {
-  mQEDSimPrefix = QEDprefix;
-
-  std::vector<std::vector<o2::steer::EventPart>> qedEventParts;
-
-  // we need to fill the QED parts (using a simple round robin scheme)
-  auto qedKinematicsName = o2::base::NameConf::getMCKinematicsFileName(mQEDSimPrefix);
+  auto qedKinematicsName = o2::base::NameConf::getMCKinematicsFileName(QEDprefix);
   // find out how many events are stored
   TFile f(qedKinematicsName.c_str(), "OPEN");
   auto t = (TTree*)f.Get("o2sim");
@@ -215,36 +211,61 @@ void DigitizationContext::fillQED(std::string_view QEDprefix, std::vector<o2::In
     LOG(ERROR) << "No QED kinematics found";
     throw std::runtime_error("No QED kinematics found");
   }
-  auto numberQEDevents = t->GetEntries();
-  int eventID = 0;
-  for (auto& tmp : irecord) {
-    std::vector<EventPart> qedpart;
-    qedpart.emplace_back(QEDSOURCEID, eventID++);
-    qedEventParts.push_back(qedpart);
-    if (eventID == numberQEDevents) {
-      eventID = 0;
-    }
-  }
+  fillQED(QEDprefix, irecord, t->GetEntries());
+}
 
-  // we need to do the interleaved event records for detectors consuming both
-  // normal and QED events
-  // --> merge both; sort first according to times and sort second one according to same order
-  auto combinedrecords = mEventRecords;
-  combinedrecords.insert(combinedrecords.end(), irecord.begin(), irecord.end());
-  auto combinedparts = mEventParts;
-  combinedparts.insert(combinedparts.end(), qedEventParts.begin(), qedEventParts.end());
-
-  // get sorted index vector based on event records
-  std::vector<size_t> idx(combinedrecords.size());
-  std::iota(idx.begin(), idx.end(), 0);
+void DigitizationContext::fillQED(std::string_view QEDprefix, std::vector<o2::InteractionTimeRecord> const& irecord, int numberQEDevents, int firstQEDEntry)
+{
+  mQEDSimPrefix = QEDprefix;
+  if (numberQEDevents <= 0) {
+    throw std::runtime_error("No QED events to fill");
+  }
 
-  std::stable_sort(idx.begin(), idx.end(),
-                   [&combinedrecords](size_t i1, size_t i2) { return combinedrecords[i1] < combinedrecords[i2]; });
+  // we need to fill the QED parts (using a simple round robin scheme)
+  auto getQEDPart = [numberQEDevents, firstQEDEntry](size_t i) {
+    return std::vector<EventPart>{EventPart(QEDSOURCEID, int((firstQEDEntry + i) % numberQEDevents))};
+  };
 
+  // we need to do the interleaved event records for detectors consuming both
+  // normal and QED events, a normal collision preceding a QED one at the same time
   mEventRecordsWithQED.clear();
   mEventPartsWithQED.clear();
-  for (int i = 0; i < idx.size(); ++i) {
-    mEventRecordsWithQED.push_back(combinedrecords[idx[i]]);
-    mEventPartsWithQED.push_back(combinedparts[idx[i]]);
+  mEventRecordsWithQED.reserve(mEventRecords.size() + irecord.size());
+  mEventPartsWithQED.reserve(mEventRecords.size() + irecord.size());
+  auto addCollision = [this](size_t i) {
+    mEventRecordsWithQED.push_back(mEventRecords[i]);
+    mEventPartsWithQED.push_back(mEventParts[i]);
+  };
+  auto addQED = [this, &irecord, &getQEDPart](size_t i) {
+    mEventRecordsWithQED.push_back(irecord[i]);
+    mEventPartsWithQED.push_back(getQEDPart(i));
+  };
+
+  if (std::is_sorted(mEventRecords.begin(), mEventRecords.end()) && std::is_sorted(irecord.begin(), irecord.end())) {
+    // both sequences come from interaction samplers: merge them in a single pass
+    size_t icoll = 0, iqed = 0;
+    while (icoll < mEventRecords.size() || iqed < irecord.size()) {
+      if (iqed < irecord.size() && (icoll == mEventRecords.size() || irecord[iqed] < mEventRecords[icoll])) {
+        addQED(iqed++);
+      } else {
+        addCollision(icoll++);
+      }
+    }
+    return;
+  }
+
+  // --> otherwise sort the combined records according to times
+  const auto ncoll = mEventRecords.size();
+  std::vector<size_t> idx(ncoll + irecord.size());
+  std::iota(idx.begin(), idx.end(), 0);
+  auto getRecord = [this, &irecord, ncoll](size_t i) -> o2::InteractionTimeRecord const& { return i < ncoll ? mEventRecords[i] : irecord[i - ncoll]; };
+  std::stable_sort(idx.begin(), idx.end(),
+                   [&getRecord](size_t i1, size_t i2) { return getRecord(i1) < getRecord(i2); });
+  for (auto i : idx) {
+    if (i < ncoll) {
+      addCollision(i);
+    } else {
+      addQED(i - ncoll);
+    }
   }
 }
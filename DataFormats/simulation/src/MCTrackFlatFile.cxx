@@ -0,0 +1,178 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  MCTrackFlatFile.cxx
+/// \brief Implementation of the flat binary sidecar of the kinematics file
+
+#include "SimulationDataFormat/MCTrackFlatFile.h"
+#include "FairLogger.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace o2::dataformats;
+
+namespace
+{
+// the table of offsets starts at an 8 byte boundary after the records
+inline uint64_t getOffsetsPosition(uint64_t nTracks)
+{
+  return (sizeof(MCTrackFlatFile::Header) + nTracks * sizeof(o2::MCTrack) + 7) & ~uint64_t(7);
+}
+} // namespace
+
+MCTrackFlatFile::Writer::~Writer()
+{
+  discard();
+}
+
+void MCTrackFlatFile::Writer::discard()
+{
+  if (!mOut.is_open()) {
+    return;
+  }
+  // without header the file would already be rejected, but a stale file must not shadow the ROOT kinematics
+  mOut.close();
+  mOffsets.clear();
+  if (::unlink(mFileName.data()) != 0) {
+    LOG(ERROR) << "Failed to remove unfinished flat kinematics file " << mFileName << ": " << std::strerror(errno);
+    return;
+  }
+  LOG(WARNING) << "Removed unfinished flat kinematics file " << mFileName;
+}
+
+bool MCTrackFlatFile::Writer::open(const std::string& file)
+{
+  discard();
+  mOut.open(file, std::ios::binary | std::ios::trunc);
+  if (!mOut) {
+    LOG(ERROR) << "Failed to create flat kinematics file " << file;
+    return false;
+  }
+  mFileName = file;
+  mOffsets.assign(1, 0);
+  // the header is only written on close, an unfinished file is not recognized as valid
+  const Header header{};
+  mOut.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  return bool(mOut);
+}
+
+bool MCTrackFlatFile::Writer::addEvent(gsl::span<const o2::MCTrack> tracks)
+{
+  if (!mOut.is_open()) {
+    return false;
+  }
+  mOut.write(reinterpret_cast<const char*>(tracks.data()), tracks.size() * sizeof(o2::MCTrack));
+  mOffsets.push_back(mOffsets.back() + tracks.size());
+  if (!mOut) {
+    LOG(ERROR) << "Failed to write to flat kinematics file " << mFileName;
+    return false;
+  }
+  return true;
+}
+
+bool MCTrackFlatFile::Writer::close()
+{
+  if (!mOut.is_open()) {
+    return false;
+  }
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.trackSize = sizeof(o2::MCTrack);
+  header.nEvents = mOffsets.size() - 1;
+  header.offsetsPosition = getOffsetsPosition(mOffsets.back());
+  const char padding[8]{};
+  mOut.write(padding, header.offsetsPosition - sizeof(Header) - mOffsets.back() * sizeof(o2::MCTrack));
+  mOut.write(reinterpret_cast<const char*>(mOffsets.data()), mOffsets.size() * sizeof(uint64_t));
+  mOut.seekp(0);
+  mOut.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  mOut.close();
+  mOffsets.clear();
+  if (!mOut) {
+    LOG(ERROR) << "Failed to write flat kinematics file " << mFileName;
+    return false;
+  }
+  LOG(INFO) << "Wrote " << header.nEvents << " events to flat kinematics file " << mFileName;
+  return true;
+}
+
+MCTrackFlatFile::~MCTrackFlatFile()
+{
+  close();
+}
+
+bool MCTrackFlatFile::open(const std::string& file)
+{
+  close();
+  const int fd = ::open(file.data(), O_RDONLY);
+  if (fd < 0) {
+    LOG(ERROR) << "Failed to open flat kinematics file " << file << ": " << std::strerror(errno);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(Header)) {
+    LOG(ERROR) << file << " is not a flat kinematics file";
+    ::close(fd);
+    return false;
+  }
+  void* address = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd); // the mapping stays valid
+  if (address == MAP_FAILED) {
+    LOG(ERROR) << "Failed to map flat kinematics file " << file << ": " << std::strerror(errno);
+    return false;
+  }
+  mMappedAddress = address;
+  mMappedSize = st.st_size;
+
+  const auto header = static_cast<const Header*>(address);
+  if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION || header->trackSize != sizeof(o2::MCTrack)) {
+    LOG(ERROR) << file << " is not a flat kinematics file of version " << VERSION << " with MCTracks of " << sizeof(o2::MCTrack) << " bytes";
+    close();
+    return false;
+  }
+  if (header->offsetsPosition < sizeof(Header) || header->offsetsPosition % sizeof(uint64_t) != 0 ||
+      mMappedSize != header->offsetsPosition + (header->nEvents + 1) * sizeof(uint64_t)) {
+    LOG(ERROR) << "Size of flat kinematics file " << file << " (" << mMappedSize << " bytes) does not match its " << header->nEvents << " events";
+    close();
+    return false;
+  }
+  const auto offsets = reinterpret_cast<const uint64_t*>(static_cast<const char*>(address) + header->offsetsPosition);
+  if (offsets[0] != 0 || getOffsetsPosition(offsets[header->nEvents]) != header->offsetsPosition) {
+    LOG(ERROR) << "Inconsistent table of events in flat kinematics file " << file;
+    close();
+    return false;
+  }
+
+  mHeader = header;
+  mTracks = reinterpret_cast<const o2::MCTrack*>(static_cast<const char*>(address) + sizeof(Header));
+  mOffsets = offsets;
+  // single tracks are looked up by label in random order
+  madvise(address, mMappedSize, MADV_RANDOM);
+  return true;
+}
+
+void MCTrackFlatFile::close()
+{
+  if (mMappedAddress) {
+    munmap(mMappedAddress, mMappedSize);
+  }
+  mMappedAddress = nullptr;
+  mMappedSize = 0;
+  mHeader = nullptr;
+  mTracks = nullptr;
+  mOffsets = nullptr;
+}
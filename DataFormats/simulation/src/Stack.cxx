@@ -205,54 +205,61 @@ void Stack::PushTrack(Int_t toBeDone, Int_t parentId, Int_t pdgCode, Double_t px
   // - in all cases to push a secondary particle
   //
   //
-  // Create new TParticle and add it to the TParticle array
+  // Secondaries are added to the flat pool, primaries are kept as TParticle
 
   Int_t trackId = mNumberOfEntriesInParticles;
   // Set track variable
   ntr = trackId;
   //  Int_t daughter1Id = -1;
   //  Int_t daughter2Id = -1;
-  Int_t iStatus = (proc == kPPrimary) ? is : trackId;
-  TParticle p(pdgCode, iStatus, parentId, secondparentId, daughter1Id, daughter2Id, px, py, pz, e, vx, vy, vz, time);
-  p.SetPolarisation(polx, poly, polz);
-  p.SetWeight(weight);
-  p.SetUniqueID(proc); // using the unique ID to transfer process ID
-  p.SetBit(ParticleStatus::kPrimary, proc == kPPrimary ? 1 : 0); // set primary bit
-  p.SetBit(ParticleStatus::kToBeDone, toBeDone == 1 ? 1 : 0);    // set to be done bit
   mNumberOfEntriesInParticles++;
 
   insertInVector(mTrackIDtoParticlesEntry, trackId, (int)(mParticles.size()));
 
+  if (proc != kPPrimary) {
+    // A secondary produced by the transport: its properties go to the flat pool and the MCTrack is
+    // built directly, the TParticle is only created when the track is popped
+    MCTrack track(pdgCode, parentId, secondparentId, daughter1Id, daughter2Id, px, py, pz, vx, vy, vz, time * 1e09, 0);
+    track.setProcess(proc);
+    track.setToBeDone(toBeDone == 1);
+    mParticles.emplace_back(track);
+    mLastSecondaryRow = mSecondaries.push(toBeDone, pdgCode, trackId, parentId, secondparentId, daughter1Id, daughter2Id,
+                                          px, py, pz, e, vx, vy, vz, time, polx, poly, polz, weight, proc);
+    mStack.push_back(mLastSecondaryRow);
+    mNumberOfPendingSecondaries++;
+    return;
+  }
+
+  // This is a particle from the primary particle generator
+  //
+  // SetBit is used to pass information about the primary particle to the stack during transport.
+  // Sime particles have already decayed or are partons from a shower. They are needed for the
+  // event history in the stack, but not for transport.
+  //
+  TParticle p(pdgCode, is, parentId, secondparentId, daughter1Id, daughter2Id, px, py, pz, e, vx, vy, vz, time);
+  p.SetPolarisation(polx, poly, polz);
+  p.SetWeight(weight);
+  p.SetUniqueID(proc);                                        // using the unique ID to transfer process ID
+  p.SetBit(ParticleStatus::kPrimary, 1);                      // set primary bit
+  p.SetBit(ParticleStatus::kToBeDone, toBeDone == 1 ? 1 : 0); // set to be done bit
+
   handleTransportPrimary(p); // handle selective transport of primary particles
 
-  // Push particle on the stack if toBeDone is set
-  if (p.TestBit(ParticleStatus::kPrimary)) {
-    // This is a particle from the primary particle generator
-    //
-    // SetBit is used to pass information about the primary particle to the stack during transport.
-    // Sime particles have already decayed or are partons from a shower. They are needed for the
-    // event history in the stack, but not for transport.
-    //
-
-    // primary particles might have been pushed with a second creation process
-    // in case we pushed a secondary track of a previous simulation to be continued.
-    // We save therefore in the UniqueID the correct process
-    // while the particle will still be treated as a primary given its bit settings
-    p.SetUniqueID(proc2);
-
-    mIndexMap[trackId] = trackId;
-    p.SetBit(ParticleStatus::kKeep, 1);
-    if (p.TestBit(ParticleStatus::kToBeDone)) {
-      mNumberOfPrimariesforTracking++;
-    }
-    mNumberOfPrimaryParticles++;
-    mPrimaryParticles.push_back(p);
-    mTracks->emplace_back(p);
-  } else {
-    mParticles.emplace_back(p);
-    mCurrentParticle0 = p;
+  // primary particles might have been pushed with a second creation process
+  // in case we pushed a secondary track of a previous simulation to be continued.
+  // We save therefore in the UniqueID the correct process
+  // while the particle will still be treated as a primary given its bit settings
+  p.SetUniqueID(proc2);
+
+  mIndexMap[trackId] = trackId;
+  p.SetBit(ParticleStatus::kKeep, 1);
+  if (p.TestBit(ParticleStatus::kToBeDone)) {
+    mNumberOfPrimariesforTracking++;
   }
-  mStack.push(p);
+  mNumberOfPrimaryParticles++;
+  mPrimaryParticles.push_back(p);
+  mTracks->emplace_back(p);
+  mStack.push_back(-(int)mPrimaryParticles.size());
 }
 
 void Stack::handleTransportPrimary(TParticle& p)
@@ -286,11 +293,85 @@ void Stack::PushTrack(int toBeDone, TParticle& p)
     if (p.TestBit(ParticleStatus::kToBeDone)) {
       mNumberOfPrimariesforTracking++;
     }
-    mStack.push(p);
+    mStack.push_back(-(int)mPrimaryParticles.size());
     mTracks->emplace_back(p);
   }
 }
 
+int Stack::SecondaryPool::push(int toBeDone_, int pdgCode, int statusCode, int parentID, int secondParentID, int daughter1ID, int daughter2ID,
+                               double px_, double py_, double pz_, double e_, double vx_, double vy_, double vz_, double time,
+                               double polx_, double poly_, double polz_, double weight_, unsigned int proc)
+{
+  pdg.push_back(pdgCode);
+  status.push_back(statusCode);
+  mother0.push_back(parentID);
+  mother1.push_back(secondParentID);
+  daughter0.push_back(daughter1ID);
+  daughter1.push_back(daughter2ID);
+  px.push_back(px_);
+  py.push_back(py_);
+  pz.push_back(pz_);
+  e.push_back(e_);
+  vx.push_back(vx_);
+  vy.push_back(vy_);
+  vz.push_back(vz_);
+  t.push_back(time);
+  polx.push_back(polx_);
+  poly.push_back(poly_);
+  polz.push_back(polz_);
+  weight.push_back(weight_);
+  process.push_back(proc);
+  toBeDone.push_back(toBeDone_ == 1);
+  return (int)pdg.size() - 1;
+}
+
+void Stack::SecondaryPool::truncate(int n)
+{
+  if (n >= size()) {
+    return;
+  }
+  // shrinking a vector never releases its memory
+  pdg.resize(n);
+  status.resize(n);
+  mother0.resize(n);
+  mother1.resize(n);
+  daughter0.resize(n);
+  daughter1.resize(n);
+  px.resize(n);
+  py.resize(n);
+  pz.resize(n);
+  e.resize(n);
+  vx.resize(n);
+  vy.resize(n);
+  vz.resize(n);
+  t.resize(n);
+  polx.resize(n);
+  poly.resize(n);
+  polz.resize(n);
+  weight.resize(n);
+  process.resize(n);
+  toBeDone.resize(n);
+}
+
+void Stack::SecondaryPool::fillParticle(int row, TParticle& p) const
+{
+  p = TParticle(pdg[row], status[row], mother0[row], mother1[row], daughter0[row], daughter1[row],
+                px[row], py[row], pz[row], e[row], vx[row], vy[row], vz[row], t[row]);
+  p.SetPolarisation(polx[row], poly[row], polz[row]);
+  p.SetWeight(weight[row]);
+  p.SetUniqueID(process[row]);
+  p.SetBit(ParticleStatus::kPrimary, 0);
+  p.SetBit(ParticleStatus::kToBeDone, toBeDone[row] ? 1 : 0);
+}
+
+void Stack::updateCurrentParticle0()
+{
+  if (mLastSecondaryRow >= 0) {
+    mSecondaries.fillParticle(mLastSecondaryRow, mCurrentParticle0);
+    mLastSecondaryRow = -1;
+  }
+}
+
 /// Set the current track number
 /// Declared in TVirtualMCStack
 /// \param iTrack track number
@@ -302,6 +383,7 @@ void Stack::SetCurrentTrack(Int_t iTrack)
     mCurrentParticle = p;
     mIndexOfCurrentPrimary = iTrack;
   } else {
+    updateCurrentParticle0();
     mCurrentParticle = mCurrentParticle0;
   }
 }
@@ -343,10 +425,15 @@ TParticle* Stack::PopNextTrack(Int_t& iTrack)
 
   TParticle* nextParticle = nullptr;
   while (!found && !mStack.empty()) {
-    // get next particle from stack
-    mCurrentParticle = mStack.top();
-    // remove particle from the top
-    mStack.pop();
+    // get next particle from the top of the stack and remove it
+    const int entry = mStack.back();
+    mStack.pop_back();
+    if (entry < 0) {
+      mCurrentParticle = mPrimaryParticles[-1 - entry];
+    } else {
+      mSecondaries.fillParticle(entry, mCurrentParticle);
+      mNumberOfPendingSecondaries--;
+    }
     // test if primary to be transported
     if (mCurrentParticle.TestBit(ParticleStatus::kToBeDone)) {
       if (mCurrentParticle.TestBit(ParticleStatus::kPrimary)) {
@@ -431,9 +518,8 @@ void Stack::FinishPrimary()
   int indexNew = 0;
   int indexoffset = mTracks->size();
   int neglected = 0;
-  std::vector<int> indicesKept((int)(mParticles.size()));
-  std::vector<MCTrack> tmpTracks;
-  Int_t ic = 0;
+  auto& indicesKept = mIndicesKept;
+  indicesKept.resize(mParticles.size());
 
   // mTrackIDtoParticlesEntry
   // trackID to mTrack -> index in mParticles
@@ -445,6 +531,7 @@ void Stack::FinishPrimary()
   // old (mTrack-highWaterMark) -> new (mTrack-highWaterMark)
   //
 
+  // the kept tracks are compacted in place to the front of mParticles
   for (auto& particle : mParticles) {
     if (particle.getStore() || !mPruneKinematics) {
       // map the global track index to the new persistent index
@@ -457,7 +544,9 @@ void Stack::FinishPrimary()
       }
       // at this point we have the correct mother index in mParticles or
       // a negative one which is a pointer to a primary
-      tmpTracks.emplace_back(particle);
+      if (indexNew != indexOld) {
+        mParticles[indexNew] = particle;
+      }
       indicesKept[indexOld] = indexNew;
       indexNew++;
     } else {
@@ -467,16 +556,19 @@ void Stack::FinishPrimary()
     indexOld++;
     mTracksDone++;
   }
-  Int_t ntr = (int)(tmpTracks.size());
-  std::vector<int> reOrderedIndices(ntr);
-  std::vector<int> invreOrderedIndices(ntr);
+  Int_t ntr = indexNew;
+  mParticles.resize(ntr);
+  auto& reOrderedIndices = mReorderedIndices;
+  auto& invreOrderedIndices = mInvReorderedIndices;
+  reOrderedIndices.resize(ntr);
+  invreOrderedIndices.resize(ntr);
   for (Int_t i = 0; i < ntr; i++) {
     invreOrderedIndices[i] = i;
     reOrderedIndices[i] = i;
   }
 
   if (mIsG4Like) {
-    ReorderKine(tmpTracks, reOrderedIndices);
+    ReorderKine(mParticles, reOrderedIndices);
     for (Int_t i = 0; i < ntr; i++) {
       Int_t index = reOrderedIndices[i];
       invreOrderedIndices[index] = i;
@@ -484,7 +576,7 @@ void Stack::FinishPrimary()
   }
   for (Int_t i = 0; i < ntr; i++) {
     Int_t index = reOrderedIndices[i];
-    auto& particle = tmpTracks[index];
+    auto& particle = mParticles[index];
     Int_t imo = particle.getMotherTrackId();
     Int_t imo0 = imo;
     if (imo >= 0) {
@@ -501,12 +593,13 @@ void Stack::FinishPrimary()
   }
 
   //
-  // Update index map
+  // Update index map, the tracks of the finished primary no longer have an entry in mParticles
   //
   Int_t imax = mNumberOfEntriesInParticles;
-  Int_t imin = imax - mParticles.size();
+  Int_t imin = imax - indicesKept.size();
   for (Int_t idTrack = imin; idTrack < imax; idTrack++) {
     Int_t index1 = mTrackIDtoParticlesEntry[idTrack];
+    mTrackIDtoParticlesEntry[idTrack] = -1;
     Int_t index2 = indicesKept[index1];
     if (index2 == -1) {
       continue;
@@ -518,11 +611,20 @@ void Stack::FinishPrimary()
   // we can now clear the particles buffer!
   reOrderedIndices.clear();
   invreOrderedIndices.clear();
+  indicesKept.clear();
   mParticles.clear();
-  tmpTracks.clear();
   mTransportedIDs.clear();
-  mTrackIDtoParticlesEntry.clear();
+  // mTrackIDtoParticlesEntry is only queried for the tracks of the current primary: keep its size until
+  // the end of the event, clearing it here would refill it up to the current trackID for each primary
   mIndexOfPrimaries.clear();
+
+  // release the rows of the secondaries which are no longer on the stack
+  updateCurrentParticle0();
+  if (mNumberOfPendingSecondaries == 0) {
+    mSecondaries.truncate(0);
+  } else if (mStack.back() >= 0) {
+    mSecondaries.truncate(mStack.back() + 1);
+  }
 }
 
 void Stack::UpdateTrackIndex(TRefArray* detList)
@@ -590,9 +692,10 @@ void Stack::Reset()
 
   mIndexOfCurrentTrack = -1;
   mNumberOfPrimaryParticles = mNumberOfEntriesInParticles = mNumberOfEntriesInTracks = 0;
-  while (!mStack.empty()) {
-    mStack.pop();
-  }
+  updateCurrentParticle0();
+  mStack.clear();
+  mSecondaries.truncate(0);
+  mNumberOfPendingSecondaries = 0;
   mParticles.clear();
   mTracks->clear();
   if (!mIsExternalMode && (mPrimariesDone != mNumberOfPrimariesforTracking)) {
@@ -93,3 +93,63 @@ BOOST_AUTO_TEST_CASE(Stack_test)
     BOOST_CHECK(inst->getPrimaries().size() == 2);
   }
 }
+
+// secondaries pushed during the transport are handed back as TParticle when popped
+BOOST_AUTO_TEST_CASE(Stack_test_secondaries)
+{
+  o2::data::Stack st;
+  int ntr;
+  st.PushTrack(1, -1, 211, 0.1, 0.2, 10., 10.1, 0., 0., 0., 0., 0., 0., 0., kPPrimary, ntr, 1., 1);
+  st.PushTrack(1, -1, -211, 0.3, 0.4, -10., 10.1, 0., 0., 0., 0., 0., 0., 0., kPPrimary, ntr, 1., 1);
+
+  int itrack;
+  auto p = st.PopNextTrack(itrack);
+  BOOST_REQUIRE(p != nullptr);
+  BOOST_CHECK(itrack == 1);
+  BOOST_CHECK(p->TestBit(ParticleStatus::kPrimary));
+  st.SetCurrentTrack(itrack);
+
+  // two secondaries of the primary 1
+  st.PushTrack(1, itrack, 11, 0.01, 0.02, 0.03, 0.04, 1., 2., 3., 1e-9, 0., 0., 1., kPDecay, ntr, 0.5, 0);
+  BOOST_CHECK(ntr == 2);
+  st.PushTrack(1, itrack, -11, 0.05, 0.06, 0.07, 0.09, 4., 5., 6., 2e-9, 0., 0., 0., kPPair, ntr, 0.25, 0);
+  BOOST_CHECK(ntr == 3);
+  BOOST_CHECK(st.GetNtrack() == 4);
+
+  // FILO: the last pushed secondary comes first
+  p = st.PopNextTrack(itrack);
+  BOOST_REQUIRE(p != nullptr);
+  BOOST_CHECK(itrack == 3);
+  BOOST_CHECK(p->GetPdgCode() == -11);
+  BOOST_CHECK(p->GetStatusCode() == 3);
+  BOOST_CHECK(p->GetFirstMother() == 1);
+  BOOST_CHECK(p->GetUniqueID() == kPPair);
+  BOOST_CHECK(!p->TestBit(ParticleStatus::kPrimary));
+  BOOST_CHECK(p->TestBit(ParticleStatus::kToBeDone));
+  BOOST_CHECK(p->Px() == 0.05 && p->Energy() == 0.09 && p->Vz() == 6. && p->T() == 2e-9 && p->GetWeight() == 0.25);
+
+  p = st.PopNextTrack(itrack);
+  BOOST_REQUIRE(p != nullptr);
+  BOOST_CHECK(itrack == 2);
+  BOOST_CHECK(p->GetPdgCode() == 11);
+  BOOST_CHECK(p->GetUniqueID() == kPDecay);
+  BOOST_CHECK(p->Py() == 0.02 && p->Vx() == 1. && p->T() == 1e-9 && p->GetWeight() == 0.5);
+  st.FinishPrimary();
+
+  p = st.PopNextTrack(itrack);
+  BOOST_REQUIRE(p != nullptr);
+  BOOST_CHECK(itrack == 0);
+  BOOST_CHECK(p->GetPdgCode() == 211);
+  st.FinishPrimary();
+  BOOST_CHECK(st.PopNextTrack(itrack) == nullptr);
+
+  // both secondaries are stored after the primaries, with the primary 1 as mother
+  auto tracks = st.getMCTracks();
+  BOOST_REQUIRE(tracks->size() == 4);
+  for (int i = 2; i < 4; ++i) {
+    BOOST_CHECK((*tracks)[i].getMotherTrackId() == 1);
+    BOOST_CHECK((*tracks)[i].isSecondary());
+  }
+  BOOST_CHECK((*tracks)[1].getFirstDaughterTrackId() == 2);
+  BOOST_CHECK((*tracks)[1].getLastDaughterTrackId() == 3);
+}
@@ -0,0 +1,75 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchStack.cxx
+/// \brief Throughput of the simulation Stack for a transport-like sequence of tracks: the primaries of an
+///        event are pushed, every popped track produces a few secondaries and the kinematics is pruned
+///        after each primary, as done with Geant3.
+
+#include "SimulationDataFormat/Stack.h"
+#include "TMCProcess.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// number of secondaries produced by each popped track, precomputed to keep the generation out of the timing
+std::vector<int> makeSecondaryCounts(size_t n)
+{
+  std::mt19937 rng(1);
+  std::poisson_distribution<int> dist(0.9);
+  std::vector<int> counts(n);
+  for (auto& c : counts) {
+    c = dist(rng);
+  }
+  return counts;
+}
+
+static void BM_StackEvent(benchmark::State& state)
+{
+  const int nPrimaries = state.range(0);
+  const int maxTracks = 20 * nPrimaries; // stops the cascade of secondaries
+  const auto secondaries = makeSecondaryCounts(1 << 16);
+  o2::data::Stack stack;
+  stack.pruneKinematics(true);
+
+  size_t nTracks = 0;
+  for (auto _ : state) {
+    int ntr, itrack, counter = 0;
+    for (int i = 0; i < nPrimaries; i++) {
+      stack.PushTrack(1, -1, 211, 0.1, 0.2, 0.1 * (i - nPrimaries / 2), 1., 0., 0., 0., 0., 0., 0., 0., kPPrimary, ntr, 1., 1);
+    }
+    bool first = true;
+    while (auto p = stack.PopNextTrack(itrack)) {
+      if (p->TestBit(ParticleStatus::kPrimary) && !first) {
+        stack.FinishPrimary();
+      }
+      first = false;
+      stack.SetCurrentTrack(itrack);
+      const int nsec = stack.GetNtrack() < maxTracks ? secondaries[counter++ & 0xffff] : 0;
+      if ((counter & 3) == 0) {
+        stack.addHit(0);
+      }
+      for (int k = 0; k < nsec; k++) {
+        stack.PushTrack(1, itrack, 11, 0.5 * p->Px(), 0.5 * p->Py(), 0.5 * p->Pz(), 0.5 * p->Energy(), p->Vx() + 1., p->Vy(), p->Vz(), p->T() + 1e-9,
+                        0., 0., 0., kPDecay, ntr, 1., 0);
+      }
+    }
+    stack.FinishPrimary();
+    nTracks += stack.GetNtrack();
+    benchmark::DoNotOptimize(stack.getMCTracks()->data());
+    stack.Reset();
+  }
+  state.SetItemsProcessed(nTracks);
+}
+
+BENCHMARK(BM_StackEvent)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,113 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test CompressedMCLabelContainer class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "SimulationDataFormat/CompressedMCLabelContainer.h"
+#include "SimulationDataFormat/MCTruthContainer.h"
+#include <stdexcept>
+#include <vector>
+
+using namespace o2;
+using namespace o2::dataformats;
+
+namespace
+{
+void checkSame(MCTruthContainer<MCCompLabel> const& reference, CompressedMCLabelContainerView const& compressed)
+{
+  BOOST_CHECK_EQUAL(compressed.getIndexedSize(), reference.getIndexedSize());
+  BOOST_CHECK_EQUAL(compressed.getNElements(), reference.getNElements());
+  for (uint32_t i = 0; i < reference.getIndexedSize(); ++i) {
+    const auto expected = reference.getLabels(i);
+    const auto labels = compressed.getLabels(i);
+    BOOST_CHECK_EQUAL(labels.size(), expected.size());
+    size_t j = 0;
+    for (auto label : labels) {
+      BOOST_CHECK_EQUAL(label.getRawValue(), expected[j].getRawValue());
+      ++j;
+    }
+    BOOST_CHECK_EQUAL(j, expected.size());
+    if (!expected.empty()) {
+      BOOST_CHECK_EQUAL(labels[expected.size() - 1].getRawValue(), expected.back().getRawValue());
+    }
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(CompressedMCLabelContainer_test)
+{
+  // digits of neighbouring tracks, some with several labels, some without and some special labels
+  MCTruthContainer<MCCompLabel> reference;
+  CompressedMCLabelWriter writer;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    if (i % 7 == 3) {
+      continue;
+    }
+    const int track = 200 + i / 5;
+    std::vector<MCCompLabel> labels{MCCompLabel(track, i / 100, 0)};
+    if (i % 11 == 0) {
+      labels.emplace_back(track + 1, i / 100, 0, true);
+      labels.emplace_back(5, 2, 1);
+    }
+    if (i % 97 == 0) {
+      labels.emplace_back(true); // noise
+      labels.emplace_back();     // not set
+    }
+    if (i == 500) {
+      labels.emplace_back(MCCompLabel::maxTrackID(), 0, 0);
+      labels.emplace_back(0, 0, 0);
+    }
+    for (auto& label : labels) {
+      reference.addElement(i, label);
+      writer.addElement(i, label);
+    }
+  }
+  BOOST_CHECK_EQUAL(writer.getIndexedSize(), reference.getIndexedSize());
+  BOOST_CHECK_EQUAL(writer.getNElements(), reference.getNElements());
+
+  CompressedMCLabelContainer compressed;
+  writer.flatten_to(compressed);
+  checkSame(reference, compressed.getView());
+  BOOST_CHECK(compressed.getLabels(1000).empty());
+
+  std::vector<char> flat;
+  reference.flatten_to(flat);
+  BOOST_TEST_MESSAGE("Compressed size " << compressed.size() << " bytes, flat size " << flat.size() << " bytes");
+  BOOST_CHECK(compressed.size() * 3 < flat.size());
+
+  // the writer can be filled further after flattening
+  writer.addElement(999, MCCompLabel(1, 2, 3));
+  reference.addElement(999, MCCompLabel(1, 2, 3));
+  writer.addElements(1010, std::vector<MCCompLabel>{MCCompLabel(4, 5, 6), MCCompLabel(7, 5, 6)});
+  reference.addElements(1010, std::vector<MCCompLabel>{MCCompLabel(4, 5, 6), MCCompLabel(7, 5, 6)});
+  writer.flatten_to(compressed);
+  checkSame(reference, compressed.getView());
+
+  // labels are only added in increasing order of data index
+  BOOST_CHECK_THROW(writer.addElement(5, MCCompLabel(1, 2, 3)), std::runtime_error);
+
+  // compressing a whole container
+  CompressedMCLabelWriter converter;
+  converter.addContainer(reference);
+  std::vector<char> buffer;
+  converter.flatten_to(buffer);
+  checkSame(reference, CompressedMCLabelContainerView(buffer));
+
+  // empty container
+  writer.clear();
+  writer.flatten_to(compressed);
+  BOOST_CHECK_EQUAL(compressed.getIndexedSize(), 0);
+  BOOST_CHECK_EQUAL(compressed.getNElements(), 0);
+  BOOST_CHECK(compressed.getLabels(0).empty());
+  BOOST_CHECK_EQUAL(CompressedMCLabelContainerView().getIndexedSize(), 0);
+}
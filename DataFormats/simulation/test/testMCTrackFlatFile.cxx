@@ -0,0 +1,88 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test MCTrackFlatFile class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "SimulationDataFormat/MCTrackFlatFile.h"
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+using namespace o2;
+using o2::dataformats::MCTrackFlatFile;
+
+BOOST_AUTO_TEST_CASE(MCTrackFlatFile_test)
+{
+  const std::string filename = "testMCTrackFlatFile.dat";
+
+  // events with 3, 0 and 5 tracks
+  std::vector<std::vector<MCTrack>> events(3);
+  const int ntracks[3] = {3, 0, 5};
+  for (int event = 0; event < 3; ++event) {
+    for (int i = 0; i < ntracks[event]; ++i) {
+      events[event].emplace_back(211 + event, i - 1, -1, -1, -1, 0.1 * i, 0.2, 1. * event, 0., 0., 0.1 * i, 1e-9 * event, 0);
+    }
+  }
+
+  MCTrackFlatFile::Writer writer;
+  BOOST_CHECK(writer.open(filename));
+  for (auto& tracks : events) {
+    BOOST_CHECK(writer.addEvent(tracks));
+  }
+
+  // the file is only valid once closed
+  MCTrackFlatFile reader;
+  BOOST_CHECK(!reader.open(filename));
+  BOOST_CHECK(!reader.isOpen());
+
+  BOOST_CHECK(writer.close());
+  BOOST_CHECK(reader.open(filename));
+  BOOST_CHECK_EQUAL(reader.getNEvents(), 3);
+  for (int event = 0; event < 3; ++event) {
+    auto tracks = reader.getTracks(event);
+    BOOST_CHECK_EQUAL(tracks.size(), ntracks[event]);
+    for (int i = 0; i < ntracks[event]; ++i) {
+      const auto& original = events[event][i];
+      auto track = reader.getTrack(event, i);
+      BOOST_CHECK(track == &tracks[i]);
+      BOOST_CHECK_EQUAL(track->GetPdgCode(), original.GetPdgCode());
+      BOOST_CHECK_EQUAL(track->getMotherTrackId(), original.getMotherTrackId());
+      BOOST_CHECK_EQUAL(track->Px(), original.Px());
+      BOOST_CHECK_EQUAL(track->Pz(), original.Pz());
+      BOOST_CHECK_EQUAL(track->Vz(), original.Vz());
+      BOOST_CHECK_EQUAL(track->T(), original.T());
+    }
+    BOOST_CHECK(reader.getTrack(event, ntracks[event]) == nullptr);
+  }
+  BOOST_CHECK(reader.getTracks(3).empty());
+  BOOST_CHECK(reader.getTrack(-1, 0) == nullptr);
+  reader.close();
+
+  // a truncated file is rejected
+  {
+    std::ifstream in(filename, std::ios::binary);
+    std::vector<char> content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), content.size() - sizeof(uint64_t));
+  }
+  BOOST_CHECK(!reader.open(filename));
+  std::remove(filename.c_str());
+
+  // a file which is not closed, e.g. by an aborted merger, is removed
+  {
+    MCTrackFlatFile::Writer aborted;
+    BOOST_CHECK(aborted.open(filename));
+    BOOST_CHECK(aborted.addEvent(events[0]));
+  }
+  BOOST_CHECK(!std::ifstream(filename).good());
+}
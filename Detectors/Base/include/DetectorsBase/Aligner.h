@@ -31,6 +31,7 @@ class Aligner : public o2::conf::ConfigurableParamHelper<Aligner>
   const std::string& getCCDB() const { return mCCDB; }
   const std::string& getDetectors() const { return mDetectors; }
   long getTimeStamp() const;
+  bool isTimeStampSet() const { return mTimeStamp > 0; }
   o2::detectors::DetID::mask_t getDetectorsMask() const;
 
   bool isAlignmentRequested() const { return getDetectorsMask().any(); }
@@ -35,6 +35,8 @@
 #include <type_traits>
 #include <unistd.h>
 #include <cassert>
+#include <gsl/span>
+#include <algorithm>
 
 class FairMQParts;
 class FairMQChannel;
@@ -44,6 +46,44 @@ namespace o2
 namespace base
 {
 
+// header in front of a flat message: the payload is a plain array of nElements objects of elementSize bytes
+struct FlatMessageHeader {
+  static constexpr uint32_t MAGIC = 0x4c46324f; // "O2FL"
+  uint32_t magic = MAGIC;
+  uint32_t elementSize = 0;
+  uint64_t nElements = 0;
+};
+
+// a flat message adopted from the transport; the payload is used in place and stays
+// valid as long as a copy of this object exists (the message buffer is released afterwards)
+class FlatMessage
+{
+ public:
+  FlatMessage() = default;
+  FlatMessage(std::shared_ptr<void> owner, void* data, FlatMessageHeader const& header)
+    : mOwner(std::move(owner)), mData(data), mHeader(header) {}
+
+  template <typename T>
+  gsl::span<T> asSpan() const
+  {
+    if (!mData || mHeader.elementSize != sizeof(T)) {
+      return gsl::span<T>();
+    }
+    return gsl::span<T>(static_cast<T*>(mData), mHeader.nElements);
+  }
+  size_t size() const { return mData ? mHeader.nElements : 0; }
+  bool empty() const { return size() == 0; }
+  bool isValid() const { return mData != nullptr; } // false if no message was adopted into this object
+
+ private:
+  std::shared_ptr<void> mOwner; // the FairMQ message holding the data
+  void* mData = nullptr;        // start of the payload (behind the header)
+  FlatMessageHeader mHeader;
+};
+
+// the adopted flat hit messages of one detector for one event, indexed [branch][entry]
+using FlatHitStore = std::vector<std::vector<FlatMessage>>;
+
 /// This is the basic class for any AliceO2 detector module, whether it is
 /// sensitive or not. Detector classes depend on this.
 class Detector : public FairDetector
@@ -170,6 +210,13 @@ class Detector : public FairDetector
   // merging
   virtual void mergeHitEntries(TTree& origin, TTree& target, std::vector<int> const& trackoffsets, std::vector<int> const& nprimaries, std::vector<int> const& subevtsOrdered) = 0;
 
+  // interfaces for hits sent in the flat format: the hit messages are adopted without decoding
+  // into store[branch][entry] (returns false if the hits at index are not flat, nothing is consumed then)
+  // and merged from there, with the same track ID adjustment as mergeHitEntries
+  // (returns false if nothing was merged); by default the hits take the TMessage path
+  virtual bool adoptFlatHits(FairMQParts& /*parts*/, int& /*index*/, FlatHitStore& /*store*/, int /*entry*/) { return false; }
+  virtual bool mergeFlatHitEntries(FlatHitStore& /*store*/, TTree& /*target*/, std::vector<int> const& /*trackoffsets*/, std::vector<int> const& /*nprimaries*/, std::vector<int> const& /*subevtsOrdered*/) { return false; }
+
   // hook which is called automatically to custom initialize the O2 detectors
   // all initialization not able to do in constructors should be done here
   // (typically the case for geometry related stuff, etc)
@@ -266,6 +313,52 @@ T decodeTMessage(FairMQParts& dataparts, int index)
   return static_cast<T>(decodeTMessageCore(dataparts, index));
 }
 
+// a container can be sent as flat message if its elements can be copied bytewise
+template <typename Container>
+struct IsFlatTransportable {
+  static constexpr bool value = std::is_trivially_copyable<typename Container::value_type>::value;
+};
+
+void attachFlatMessageCore(FairMQChannel& channel, FairMQParts& parts, void const* data, uint32_t elementSize, uint64_t nElements);
+bool isFlatMessage(FairMQParts& dataparts, int index);
+FlatMessage adoptFlatMessage(FairMQParts& dataparts, int index);
+bool useFlatTransport();
+
+// sends the elements of a vector as a flat array, costing a single memcpy instead of a ROOT streaming
+template <typename T>
+void attachFlatMessage(std::vector<T> const& data, FairMQChannel& channel, FairMQParts& parts)
+{
+  static_assert(std::is_trivially_copyable<T>::value, "flat messages require trivially copyable types");
+  attachFlatMessageCore(channel, parts, data.data(), sizeof(T), data.size());
+}
+
+// sends a container in the flat format if possible and configured (HitMergerParams.flatTransport), as TMessage otherwise
+template <typename Container>
+void attachData(Container const& data, FairMQChannel& channel, FairMQParts& parts)
+{
+  if constexpr (IsFlatTransportable<Container>::value) {
+    if (useFlatTransport()) {
+      attachFlatMessage(data, channel, parts);
+      return;
+    }
+  }
+  attachTMessage(data, channel, parts);
+}
+
+// the counterpart of attachData: returns a newly allocated vector decoded from either format
+template <typename T>
+std::vector<T>* decodeData(FairMQParts& dataparts, int index)
+{
+  if constexpr (std::is_trivially_copyable<T>::value) {
+    if (isFlatMessage(dataparts, index)) {
+      auto message = adoptFlatMessage(dataparts, index);
+      auto span = message.asSpan<T>();
+      return new std::vector<T>(span.begin(), span.end());
+    }
+  }
+  return decodeTMessage<std::vector<T>*>(dataparts, index);
+}
+
 void attachDetIDHeaderMessage(int id, FairMQChannel& channel, FairMQParts& parts);
 
 template <typename T>
@@ -333,7 +426,7 @@ class DetImpl : public o2::base::Detector
 
     while (auto hits = static_cast<Det*>(this)->Det::getHits(probe++)) {
       if (!UseShm<Det>::value || !o2::utils::ShmManager::Instance().isOperational()) {
-        attachTMessage(*hits, channel, parts);
+        attachData(*hits, channel, parts);
       } else {
         // this is the shared mem variant
         // we will just send the sharedmem ID and the offset inside
@@ -426,6 +519,91 @@ class DetImpl : public o2::base::Detector
     }
   }
 
+  // the flat counterpart of mergeAndAdjustHits: the hits of the subevents are read in place from the adopted messages
+  template <typename Hit>
+  void mergeAndAdjustFlatHits(std::string const& brname, std::vector<FlatMessage> const& entrymessages, TTree& target,
+                              std::vector<int> const& trackoffsets, std::vector<int> const& nprimaries, std::vector<int> const& subevtsOrdered)
+  {
+    // like for the event tree without the branch, no branch is made if the detector sent no hits
+    if (std::none_of(entrymessages.begin(), entrymessages.end(), [](FlatMessage const& message) { return message.isValid(); })) {
+      return;
+    }
+    Int_t entries = subevtsOrdered.size();
+    Int_t nprimTot = 0;
+    size_t nhits = 0;
+    for (auto entry = 0; entry < entries; entry++) {
+      nprimTot += nprimaries[entry];
+      nhits += entry < (int)entrymessages.size() ? entrymessages[entry].size() : 0;
+    }
+    auto targetdata = new std::vector<Hit>;
+    targetdata->reserve(nhits);
+    // offset for pimary track index
+    Int_t idelta0 = 0;
+    // offset for secondary track index
+    Int_t idelta1 = nprimTot;
+    for (int entry = entries - 1; entry >= 0; --entry) {
+      // proceed in the order of subevent Ids
+      Int_t index = subevtsOrdered[entry];
+      Int_t nprim = nprimaries[index];
+      idelta1 -= nprim;
+      if (index < (int)entrymessages.size()) {
+        for (auto const& hit : entrymessages[index].template asSpan<Hit>()) {
+          targetdata->push_back(hit);
+          const auto oldID = hit.GetTrackID();
+          // offset depends on whether the trackis a primary or secondary
+          targetdata->back().SetTrackID(oldID + ((oldID < nprim) ? idelta0 : idelta1));
+        }
+      }
+      // adjust offsets for next subevent
+      idelta0 += nprim;
+      idelta1 += trackoffsets[index];
+    }
+    // fill target for this event
+    auto targetbr = o2::base::getOrMakeBranch(target, brname.c_str(), &targetdata);
+    targetbr->SetAddress(&targetdata);
+    targetbr->Fill();
+    targetbr->ResetAddress();
+    delete targetdata;
+  }
+
+  bool mergeFlatHitEntries(FlatHitStore& store, TTree& target, std::vector<int> const& trackoffsets, std::vector<int> const& nprimaries, std::vector<int> const& subevtsOrdered) final
+  {
+    using Hit_t = typename std::remove_pointer<decltype(static_cast<Det*>(this)->Det::getHits(0))>::type::value_type;
+    if constexpr (std::is_trivially_copyable<Hit_t>::value) {
+      int probe = 0;
+      std::string name = static_cast<Det*>(this)->getHitBranchNames(probe);
+      while (name.size() > 0 && probe < (int)store.size()) {
+        mergeAndAdjustFlatHits<Hit_t>(name, store[probe], target, trackoffsets, nprimaries, subevtsOrdered);
+        name = static_cast<Det*>(this)->getHitBranchNames(++probe);
+      }
+      return true;
+    }
+    return false;
+  }
+
+  bool adoptFlatHits(FairMQParts& parts, int& index, FlatHitStore& store, int entry) final
+  {
+    using Hit_t = typename std::remove_pointer<decltype(static_cast<Det*>(this)->Det::getHits(0))>::type::value_type;
+    if constexpr (std::is_trivially_copyable<Hit_t>::value) {
+      if ((UseShm<Det>::value && o2::utils::ShmManager::Instance().isOperational()) || !isFlatMessage(parts, index)) {
+        return false;
+      }
+      int probe = 0;
+      while (static_cast<Det*>(this)->getHitBranchNames(probe).size() > 0) {
+        if ((int)store.size() <= probe) {
+          store.resize(probe + 1);
+        }
+        if ((int)store[probe].size() <= entry) {
+          store[probe].resize(entry + 1);
+        }
+        store[probe][entry] = adoptFlatMessage(parts, index++);
+        probe++;
+      }
+      return true;
+    }
+    return false;
+  }
+
  public:
   void fillHitBranch(TTree& tr, FairMQParts& parts, int& index) override
   {
@@ -437,7 +615,7 @@ class DetImpl : public o2::base::Detector
       if (!UseShm<Det>::value || !o2::utils::ShmManager::Instance().isOperational()) {
 
         // for each branch name we extract/decode hits from the message parts ...
-        auto hitsptr = decodeTMessage<Hit_t>(parts, index++);
+        Hit_t hitsptr = decodeData<typename std::remove_pointer<Hit_t>::type::value_type>(parts, index++);
         if (hitsptr) {
           // ... and fill the tree branch
           auto br = getOrMakeBranch(tr, name.c_str(), hitsptr);
@@ -0,0 +1,140 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file GeometryImage.h
+/// \brief Flat image of the geometry derived objects, shared by the processes of a workflow
+
+#ifndef ALICEO2_BASE_GEOMETRYIMAGE_H_
+#define ALICEO2_BASE_GEOMETRYIMAGE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace detectors
+{
+class DetMatrixCache;
+}
+
+namespace base
+{
+class MatLayerCylSet;
+
+/// Flat, position independent image of the objects which the devices derive from the geometry: the material
+/// LUT and the cached sensor matrices of the detectors (with the alignment of the loaded geometry applied).
+/// It is built once, published to a named shared memory segment and attached read-only by the devices, which
+/// then skip loading the LUT file and extracting the matrices from TGeo.
+/// The image is a header, a table of entries and their 64 byte aligned payloads, with offsets instead of
+/// pointers, so that it can be mapped at any address.
+/// The header identifies the geometry and the LUT file the objects were built from, the devices take only
+/// the objects of the geometry and LUT they load themselves.
+class GeometryImage
+{
+ public:
+  /// environment variable with the name of the image to attach
+  static constexpr const char* EnvName = "ALICEO2_GEOMETRY_IMAGE";
+  static constexpr uint32_t Version = 2;
+  static constexpr int MatLUTType = -1; ///< entry type of the material LUT, others are the transformation types
+
+  struct Header {
+    char magic[8];        ///< set once the image is complete
+    uint32_t version;     ///< layout version
+    uint32_t nEntries;    ///< number of entries following the header
+    uint64_t size;        ///< total size of the image
+    char geometry[256];   ///< GeometryManager::getGeometryID() of the geometry of the matrices
+    char matLUTFile[256]; ///< file of the material LUT
+  };
+
+  struct Entry {
+    char name[24];     ///< detector name or MatLUT
+    int32_t type;      ///< transformation type or MatLUTType
+    int32_t nElements; ///< number of matrices
+    uint64_t offset;   ///< payload offset from the image start
+    uint64_t size;     ///< payload size
+  };
+
+  GeometryImage() = default;
+  ~GeometryImage() { detach(); }
+  GeometryImage(const GeometryImage&) = delete;
+  GeometryImage& operator=(const GeometryImage&) = delete;
+
+  /// image of the process: the one named by the EnvName variable, attached at the first call if published
+  static GeometryImage& Instance();
+
+  // ----- building the image
+
+  /// set the identifier of the geometry of the matrices, GeometryManager::getGeometryID() of the loaded geometry
+  void setGeometryID(const std::string& geometryID) { mGeometryID = geometryID; }
+  /// add a flat copy of the material LUT loaded from this file
+  void addMatLUT(const MatLayerCylSet& lut, const std::string& fileName);
+  /// add the filled transformation caches of a detector
+  void addMatrixCache(const o2::detectors::DetMatrixCache& cache);
+  /// size of the image of the added objects
+  size_t getImageSize() const;
+  /// write the image of the added objects to dest, of at least getImageSize() bytes
+  void writeImage(char* dest) const;
+  /// publish the image of the added objects to the shared memory segment of this name, returns its size or 0
+  size_t publish(const std::string& name) const;
+  /// remove the published image, the processes which have attached it keep their mapping
+  static bool remove(const std::string& name);
+
+  // ----- using the image
+
+  /// attach the image published under this name
+  bool attach(const std::string& name);
+  void detach();
+  bool isAttached() const { return mImage != nullptr; }
+  size_t getSize() const { return mImageSize; }
+  const Header* getHeader() const { return reinterpret_cast<const Header*>(mImage); }
+  const Entry* getEntries() const { return reinterpret_cast<const Entry*>(mImage + sizeof(Header)); }
+  const Entry* findEntry(const std::string& name, int type) const;
+
+  std::string getGeometryID() const;
+  std::string getMatLUTFile() const;
+
+  /// material LUT of the image, nullptr if not attached, absent or built from another file
+  const MatLayerCylSet* getMatLUT(const std::string& fileName);
+
+  /// fill the not yet filled caches of the transformations of the mask, for which the image has matrices
+  /// of the detector, provided that the image was built from the geometry loaded by the GeometryManager;
+  /// returns the mask of the transformations taken from the image
+  int fillMatrixCache(o2::detectors::DetMatrixCache& cache, int mask) const;
+
+  /// material LUT of the image of the process if available, otherwise loaded from the file
+  static const MatLayerCylSet* loadMatLUT(const std::string& fileName, const std::string& name = "MatBud");
+
+  void print() const;
+
+ private:
+  static constexpr size_t Alignment = 64;
+  static size_t alignSize(size_t size) { return (size + Alignment - 1) / Alignment * Alignment; }
+  size_t getPayloadStart() const { return alignSize(sizeof(Header) + mEntries.size() * sizeof(Entry)); }
+  char* addEntry(const std::string& name, int type, int nElements, size_t size);
+  bool setImage(char* image, size_t size);
+
+  // objects added to be published, entry offsets are relative to the payload start
+  std::string mGeometryID;
+  std::string mMatLUTFile;
+  std::vector<Entry> mEntries;
+  std::vector<char> mPayload;
+
+  // attached image
+  char* mImage = nullptr;
+  size_t mImageSize = 0;
+  MatLayerCylSet* mMatLUT = nullptr; ///< relocated LUT within the image
+};
+
+} // namespace base
+} // namespace o2
+
+#endif
@@ -21,6 +21,7 @@
 #include <TGeoShape.h>
 #include <TMath.h>
 #include <TObject.h> // for TObject
+#include <string>
 #include <string_view>
 #include "DetectorsCommonDataFormats/DetID.h"
 #include "GPUCommonLogger.h" // for LOG
@@ -51,6 +52,8 @@ class GeometryManager : public TObject
   ///< load geometry from file
   static void loadGeometry(std::string_view geomFilePath = "", bool applyMisalignment = true);
   static bool isGeometryLoaded() { return gGeoManager != nullptr; }
+  ///< identifier of the geometry loaded by loadGeometry: its file and the applied alignment, empty if not loaded
+  static const std::string& getGeometryID() { return sGeometryID; }
 
   ///< Get the global transformation matrix (ideal geometry) for a given alignable volume
   ///< The alignable volume is identified by 'symname' which has to be either a valid symbolic
@@ -135,6 +138,7 @@ class GeometryManager : public TObject
   static constexpr UInt_t sSensorMask =
     (0x1 << sDetOffset) - 1; /// mask=max sensitive volumes allowed per detector (0xffff)
   static std::mutex sTGMutex;
+  static std::string sGeometryID; ///< file and alignment of the loaded geometry
 
   ClassDefOverride(GeometryManager, 0); // Manager of geometry information for alignment
 };
@@ -19,6 +19,8 @@
 #include "Field/MagneticField.h"
 #include "TString.h" // for TString
 #include "TGeoManager.h"
+#include "SimConfig/HitMergerParams.h"
+#include <cstring>
 
 using std::cout;
 using std::endl;
@@ -256,6 +258,50 @@ void* decodeTMessageCore(FairMQParts& dataparts, int index)
   return message.get()->ReadObjectAny(message.get()->GetClass());
 }
 
+void attachFlatMessageCore(FairMQChannel& channel, FairMQParts& parts, void const* data, uint32_t elementSize, uint64_t nElements)
+{
+  FlatMessageHeader header;
+  header.elementSize = elementSize;
+  header.nElements = nElements;
+  const size_t payloadsize = elementSize * nElements;
+  std::unique_ptr<FairMQMessage> message(channel.NewMessage(sizeof(FlatMessageHeader) + payloadsize));
+  auto buffer = static_cast<char*>(message->GetData());
+  std::memcpy(buffer, &header, sizeof(FlatMessageHeader));
+  if (payloadsize > 0) {
+    std::memcpy(buffer + sizeof(FlatMessageHeader), data, payloadsize);
+  }
+  parts.AddPart(std::move(message));
+}
+
+bool isFlatMessage(FairMQParts& dataparts, int index)
+{
+  if (index >= dataparts.Size()) {
+    return false;
+  }
+  auto& message = dataparts.At(index);
+  if (!message || message->GetSize() < sizeof(FlatMessageHeader)) {
+    return false;
+  }
+  FlatMessageHeader header;
+  std::memcpy(&header, message->GetData(), sizeof(FlatMessageHeader));
+  return header.magic == FlatMessageHeader::MAGIC && message->GetSize() == sizeof(FlatMessageHeader) + header.elementSize * header.nElements;
+}
+
+FlatMessage adoptFlatMessage(FairMQParts& dataparts, int index)
+{
+  // the message is taken out of the parts and kept alive by the returned object, no copy is made
+  std::shared_ptr<FairMQMessage> message(std::move(dataparts.At(index)));
+  FlatMessageHeader header;
+  std::memcpy(&header, message->GetData(), sizeof(FlatMessageHeader));
+  auto payload = static_cast<char*>(message->GetData()) + sizeof(FlatMessageHeader);
+  return FlatMessage(std::move(message), payload, header);
+}
+
+bool useFlatTransport()
+{
+  return o2::conf::HitMergerParams::Instance().flatTransport;
+}
+
 } // namespace base
 } // namespace o2
 ClassImp(o2::base::Detector);
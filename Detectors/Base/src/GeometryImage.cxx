@@ -0,0 +1,367 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file GeometryImage.cxx
+/// \brief Implementation of the GeometryImage class
+
+#include "DetectorsBase/GeometryImage.h"
+#include "DetectorsBase/MatLayerCylSet.h"
+#include "DetectorsBase/GeometryManager.h"
+#include "DetectorsCommonDataFormats/DetMatrixCache.h"
+#include "CommonUtils/ShmManager.h"
+#include "CommonUtils/StringUtils.h"
+#include "MathUtils/Utils.h"
+#include "GPUCommonLogger.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+using namespace o2::base;
+using o2::detectors::DetMatrixCache;
+using o2::detectors::MatrixCache;
+
+namespace
+{
+constexpr char Magic[8] = {'O', '2', 'G', 'E', 'O', 'I', 'M', 'G'};
+constexpr const char* MatLUTName = "MatLUT";
+constexpr int NMatrixComponents = 12;
+
+// the matrices are stored as their 12 components, the 2D rotations as cosine and sine
+void storeMatrices(const MatrixCache<DetMatrixCache::Mat3D>& cache, char* dest)
+{
+  auto* components = reinterpret_cast<double*>(dest);
+  for (int i = 0; i < cache.getSize(); i++, components += NMatrixComponents) {
+    cache.getMatrix(i).GetComponents(components, components + NMatrixComponents);
+  }
+}
+
+void storeMatrices(const MatrixCache<DetMatrixCache::Rot2D>& cache, char* dest)
+{
+  auto* components = reinterpret_cast<float*>(dest);
+  for (int i = 0; i < cache.getSize(); i++, components += 2) {
+    cache.getMatrix(i).getComponents(components[0], components[1]);
+  }
+}
+
+void loadMatrices(MatrixCache<DetMatrixCache::Mat3D>& cache, const char* src, int n)
+{
+  const auto* components = reinterpret_cast<const double*>(src);
+  cache.setSize(n);
+  for (int i = 0; i < n; i++, components += NMatrixComponents) {
+    cache.setMatrix(DetMatrixCache::Mat3D(components, components + NMatrixComponents), i);
+  }
+}
+
+void loadMatrices(MatrixCache<DetMatrixCache::Rot2D>& cache, const char* src, int n)
+{
+  const auto* components = reinterpret_cast<const float*>(src);
+  cache.setSize(n);
+  for (int i = 0; i < n; i++, components += 2) {
+    cache.setMatrix(DetMatrixCache::Rot2D(components[0], components[1]), i);
+  }
+}
+
+// the LUT files are compared by their full path
+std::string getFullPath(const std::string& fileName)
+{
+  return o2::utils::Str::pathExists(fileName) ? o2::utils::Str::getFullPath(fileName) : fileName;
+}
+
+template <size_t N>
+std::string getString(const char (&str)[N])
+{
+  return std::string(str, strnlen(str, N));
+}
+
+template <size_t N>
+void setString(char (&dest)[N], const std::string& str)
+{
+  std::strncpy(dest, str.c_str(), N - 1);
+  if (str.size() >= N) {
+    LOG(WARNING) << "Geometry image keeps only the first " << N - 1 << " characters of " << str;
+  }
+}
+
+template <typename T>
+constexpr size_t matrixSize()
+{
+  return std::is_same_v<T, DetMatrixCache::Rot2D> ? 2 * sizeof(float) : NMatrixComponents * sizeof(double);
+}
+} // namespace
+
+//________________________________________________________________________________
+GeometryImage& GeometryImage::Instance()
+{
+  // never destroyed: the objects of the image may be used until the process exits
+  static GeometryImage* instance = [] {
+    auto* image = new GeometryImage();
+    if (const char* name = std::getenv(EnvName)) {
+      const auto start = std::chrono::steady_clock::now();
+      if (image->attach(name)) {
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        LOG(INFO) << "Attached geometry image " << name << " of " << image->getSize() / 1024 << " kB in " << elapsed.count() << " ms";
+      } else {
+        LOG(WARNING) << "Geometry image " << name << " is not available, the geometry derived objects will be built locally";
+      }
+    }
+    return image;
+  }();
+  return *instance;
+}
+
+//________________________________________________________________________________
+char* GeometryImage::addEntry(const std::string& name, int type, int nElements, size_t size)
+{
+  Entry entry{};
+  std::strncpy(entry.name, name.c_str(), sizeof(entry.name) - 1);
+  entry.type = type;
+  entry.nElements = nElements;
+  entry.offset = mPayload.size();
+  entry.size = size;
+  mEntries.push_back(entry);
+  mPayload.resize(alignSize(mPayload.size() + size));
+  return mPayload.data() + entry.offset;
+}
+
+//________________________________________________________________________________
+void GeometryImage::addMatLUT(const MatLayerCylSet& lut, const std::string& fileName)
+{
+  mMatLUTFile = getFullPath(fileName);
+  // the object followed by its flat buffer, with the pointers to the buffer turned into offsets
+  const auto objSize = alignSize(sizeof(MatLayerCylSet));
+  auto* dest = addEntry(MatLUTName, MatLUTType, 1, objSize + lut.getFlatBufferSize());
+  MatLayerCylSet flat;
+  flat.cloneFromObject(lut, dest + objSize);
+  flat.setFutureBufferAddress(nullptr);
+  std::memcpy(dest, (const void*)&flat, sizeof(flat));
+}
+
+//________________________________________________________________________________
+void GeometryImage::addMatrixCache(const DetMatrixCache& cache)
+{
+  auto add = [this, &cache](const auto& matrices, int type) {
+    if (matrices.isFilled()) {
+      using Matrix = std::decay_t<decltype(matrices.getMatrix(0))>;
+      storeMatrices(matrices, addEntry(cache.getName(), type, matrices.getSize(), matrices.getSize() * matrixSize<Matrix>()));
+    }
+  };
+  add(cache.getCacheL2G(), o2::math_utils::TransformType::L2G);
+  add(cache.getCacheT2L(), o2::math_utils::TransformType::T2L);
+  add(cache.getCacheT2G(), o2::math_utils::TransformType::T2G);
+  add(cache.getCacheT2GRot(), o2::math_utils::TransformType::T2GRot);
+}
+
+//________________________________________________________________________________
+size_t GeometryImage::getImageSize() const
+{
+  return getPayloadStart() + mPayload.size();
+}
+
+//________________________________________________________________________________
+void GeometryImage::writeImage(char* dest) const
+{
+  const auto payloadStart = getPayloadStart();
+  std::memset(dest, 0, payloadStart);
+  auto* header = reinterpret_cast<Header*>(dest);
+  header->version = Version;
+  header->nEntries = mEntries.size();
+  header->size = getImageSize();
+  setString(header->geometry, mGeometryID);
+  setString(header->matLUTFile, mMatLUTFile);
+  auto* entries = reinterpret_cast<Entry*>(dest + sizeof(Header));
+  for (size_t i = 0; i < mEntries.size(); i++) {
+    entries[i] = mEntries[i];
+    entries[i].offset += payloadStart;
+  }
+  std::memcpy(dest + payloadStart, mPayload.data(), mPayload.size());
+  // the image becomes valid once complete
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(header->magic, Magic, sizeof(Magic));
+}
+
+//________________________________________________________________________________
+size_t GeometryImage::publish(const std::string& name) const
+{
+  const auto size = getImageSize();
+  auto* dest = static_cast<char*>(o2::utils::ShmManager::createNamedSegment(name, size));
+  if (!dest) {
+    LOG(ERROR) << "Failed to publish geometry image " << name;
+    return 0;
+  }
+  writeImage(dest);
+  o2::utils::ShmManager::detachNamedSegment(dest, size);
+  return size;
+}
+
+//________________________________________________________________________________
+bool GeometryImage::remove(const std::string& name)
+{
+  return o2::utils::ShmManager::removeNamedSegment(name);
+}
+
+//________________________________________________________________________________
+bool GeometryImage::attach(const std::string& name)
+{
+  detach();
+  size_t size = 0;
+  auto* image = static_cast<char*>(o2::utils::ShmManager::attachNamedSegment(name, size));
+  if (!image) {
+    return false;
+  }
+  if (!setImage(image, size)) {
+    LOG(ERROR) << "Shared memory segment " << name << " does not hold a complete geometry image";
+    o2::utils::ShmManager::detachNamedSegment(image, size);
+    return false;
+  }
+  return true;
+}
+
+//________________________________________________________________________________
+bool GeometryImage::setImage(char* image, size_t size)
+{
+  const auto* header = reinterpret_cast<const Header*>(image);
+  if (size < sizeof(Header) || std::memcmp(header->magic, Magic, sizeof(Magic)) || header->version != Version ||
+      header->size > size || sizeof(Header) + header->nEntries * sizeof(Entry) > header->size) {
+    return false;
+  }
+  const auto* entries = reinterpret_cast<const Entry*>(image + sizeof(Header));
+  for (uint32_t i = 0; i < header->nEntries; i++) {
+    if (entries[i].offset % Alignment || entries[i].offset + entries[i].size > header->size) {
+      return false;
+    }
+  }
+  mImage = image;
+  mImageSize = size;
+  mMatLUT = nullptr;
+  return true;
+}
+
+//________________________________________________________________________________
+void GeometryImage::detach()
+{
+  if (mImage) {
+    o2::utils::ShmManager::detachNamedSegment(mImage, mImageSize);
+    mImage = nullptr;
+    mImageSize = 0;
+    mMatLUT = nullptr;
+  }
+}
+
+//________________________________________________________________________________
+const GeometryImage::Entry* GeometryImage::findEntry(const std::string& name, int type) const
+{
+  if (!isAttached()) {
+    return nullptr;
+  }
+  const auto* entries = getEntries();
+  for (uint32_t i = 0; i < getHeader()->nEntries; i++) {
+    if (entries[i].type == type && !std::strncmp(entries[i].name, name.c_str(), sizeof(entries[i].name))) {
+      return &entries[i];
+    }
+  }
+  return nullptr;
+}
+
+//________________________________________________________________________________
+std::string GeometryImage::getGeometryID() const
+{
+  return isAttached() ? getString(getHeader()->geometry) : std::string();
+}
+
+//________________________________________________________________________________
+std::string GeometryImage::getMatLUTFile() const
+{
+  return isAttached() ? getString(getHeader()->matLUTFile) : std::string();
+}
+
+//________________________________________________________________________________
+const MatLayerCylSet* GeometryImage::getMatLUT(const std::string& fileName)
+{
+  if (!mMatLUT) {
+    if (const auto* entry = findEntry(MatLUTName, MatLUTType)) {
+      const auto requested = getFullPath(fileName);
+      if (requested.compare(0, sizeof(Header::matLUTFile) - 1, getMatLUTFile())) {
+        LOG(WARNING) << "Material LUT of the geometry image is built from " << getMatLUTFile() << ", not from " << requested << ", it is not used";
+        return nullptr;
+      }
+      auto* obj = mImage + entry->offset;
+      mMatLUT = reinterpret_cast<MatLayerCylSet*>(obj);
+      // the relocation writes to the layout and layer descriptors only, the pages of the cells stay shared
+      mMatLUT->setActualBufferAddress(obj + alignSize(sizeof(MatLayerCylSet)));
+    }
+  }
+  return mMatLUT;
+}
+
+//________________________________________________________________________________
+int GeometryImage::fillMatrixCache(DetMatrixCache& cache, int mask) const
+{
+  if (!isAttached()) {
+    return 0;
+  }
+  const auto& geometryID = GeometryManager::getGeometryID();
+  if (geometryID.compare(0, sizeof(Header::geometry) - 1, getGeometryID())) {
+    LOG(WARNING) << "Geometry image is built from the geometry " << getGeometryID() << ", not from the loaded " << geometryID
+                 << ", the " << cache.getName() << " matrices are not taken from it";
+    return 0;
+  }
+  int filled = 0;
+  auto fill = [this, &cache, mask, &filled](auto& matrices, int type) {
+    if (!(mask & o2::math_utils::bit2Mask(type)) || matrices.isFilled()) {
+      return;
+    }
+    const auto* entry = findEntry(cache.getName(), type);
+    if (entry && entry->nElements == cache.getSize()) {
+      loadMatrices(matrices, mImage + entry->offset, entry->nElements);
+      filled |= o2::math_utils::bit2Mask(type);
+    }
+  };
+  fill(cache.getCacheL2G(), o2::math_utils::TransformType::L2G);
+  fill(cache.getCacheT2L(), o2::math_utils::TransformType::T2L);
+  fill(cache.getCacheT2G(), o2::math_utils::TransformType::T2G);
+  fill(cache.getCacheT2GRot(), o2::math_utils::TransformType::T2GRot);
+  if (filled) {
+    LOG(INFO) << "Loaded " << cache.getName() << " matrices of mask " << filled << " from the geometry image";
+  }
+  return filled;
+}
+
+//________________________________________________________________________________
+const MatLayerCylSet* GeometryImage::loadMatLUT(const std::string& fileName, const std::string& name)
+{
+  const auto start = std::chrono::steady_clock::now();
+  const MatLayerCylSet* lut = Instance().getMatLUT(fileName);
+  const bool fromImage = lut != nullptr;
+  if (!fromImage) {
+    lut = MatLayerCylSet::loadFromFile(fileName, name);
+  }
+  const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  LOG(INFO) << "Material LUT taken from " << (fromImage ? "the geometry image" : fileName) << " in " << elapsed.count() << " ms";
+  return lut;
+}
+
+//________________________________________________________________________________
+void GeometryImage::print() const
+{
+  if (!isAttached()) {
+    LOG(INFO) << "No geometry image attached";
+    return;
+  }
+  LOG(INFO) << "Geometry image v" << getHeader()->version << " of " << getHeader()->size << " bytes with " << getHeader()->nEntries << " entries";
+  LOG(INFO) << "Geometry: " << getGeometryID() << ", material LUT file: " << getMatLUTFile();
+  const auto* entries = getEntries();
+  for (uint32_t i = 0; i < getHeader()->nEntries; i++) {
+    LOG(INFO) << std::string(entries[i].name, strnlen(entries[i].name, sizeof(entries[i].name))) << " type " << entries[i].type
+              << ": " << entries[i].nElements << " elements, " << entries[i].size << " bytes at " << entries[i].offset;
+  }
+}
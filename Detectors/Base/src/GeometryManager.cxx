@@ -27,6 +27,7 @@
 #include "DetectorsCommonDataFormats/AlignParam.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include "DetectorsBase/Aligner.h"
+#include "CommonUtils/StringUtils.h"
 
 using namespace o2::detectors;
 using namespace o2::base;
@@ -35,6 +36,7 @@ using namespace o2::base;
 /// the look-up table mapping unique volume indices to symbolic volume names. For that, it
 /// collects several static methods
 std::mutex GeometryManager::sTGMutex;
+std::string GeometryManager::sGeometryID;
 
 //______________________________________________________________________
 Bool_t GeometryManager::getOriginalMatrix(const char* symname, TGeoHMatrix& m)
@@ -254,6 +256,10 @@ bool GeometryManager::applyAlignment(const std::vector<o2::detectors::AlignParam
   std::iota(std::begin(ord), std::end(ord), 0); // sort to apply alignment in correct hierarchy
   std::sort(std::begin(ord), std::end(ord), [&algPars](int a, int b) { return algPars[a].getLevel() > algPars[b].getLevel(); });
 
+  if (!sGeometryID.empty()) {
+    // the geometry is no longer the one which was loaded
+    sGeometryID += o2::utils::Str::concat_string(" +", std::to_string(nvols), " alignment objects");
+  }
   bool res = true;
   for (int i = 0; i < nvols; i++) {
     if (!algPars[ord[i]].applyToGeometry()) {
@@ -496,8 +502,15 @@ void GeometryManager::loadGeometry(std::string_view geomFileName, bool applyMisa
   if (!flGeom.Get(std::string(o2::base::NameConf::GEOMOBJECTNAME).c_str())) {
     LOG(FATAL) << "Did not find geometry named " << o2::base::NameConf::GEOMOBJECTNAME;
   }
+  std::string geometryID = o2::utils::Str::getFullPath(fname);
   if (applyMisalignment) {
     auto& aligner = Aligner::Instance();
     aligner.applyAlignment();
+    if (aligner.isAlignmentRequested()) {
+      // the processes using the latest alignment are assumed to see the same one
+      geometryID += o2::utils::Str::concat_string(" aligned ", aligner.getDetectors(), " from ", aligner.getCCDB(), " at ",
+                                                  aligner.isTimeStampSet() ? std::to_string(aligner.getTimeStamp()) : "latest");
+    }
   }
+  sGeometryID = geometryID;
 }
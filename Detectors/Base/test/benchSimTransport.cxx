@@ -0,0 +1,107 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchSimTransport.cxx
+/// \brief Throughput of the o2-sim worker -> merger transport of tracks and hits:
+///        TMessage streaming versus flat messages adopted by the receiver
+
+#include "DetectorsBase/Detector.h"
+#include "SimulationDataFormat/MCTrack.h"
+#include "SimulationDataFormat/TrackReference.h"
+#include "SimulationDataFormat/BaseHits.h"
+#include <FairMQTransportFactory.h>
+#include <FairMQChannel.h>
+#include <FairMQParts.h>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using Hit = o2::BasicXYZEHit<float>;
+
+template <typename T>
+std::vector<T> makeData(size_t n);
+
+template <>
+std::vector<o2::MCTrack> makeData(size_t n)
+{
+  std::vector<o2::MCTrack> tracks;
+  for (size_t i = 0; i < n; ++i) {
+    tracks.emplace_back(211, (int)i / 2 - 1, -1, -1, -1, 0.1 * i, 0.2, 1.5, 0.1, 0.1, 0.5 * i, 1.e-9, 0);
+  }
+  return tracks;
+}
+
+template <>
+std::vector<o2::TrackReference> makeData(size_t n)
+{
+  std::vector<o2::TrackReference> refs;
+  for (size_t i = 0; i < n; ++i) {
+    refs.emplace_back(0.1 * i, 0.2, 0.3, 1., 2., 3., 10., 1.e-9, i, 0);
+  }
+  return refs;
+}
+
+template <>
+std::vector<Hit> makeData(size_t n)
+{
+  std::vector<Hit> hits;
+  for (size_t i = 0; i < n; ++i) {
+    hits.emplace_back(0.1 * i, 0.2, 0.3, 1.e-9, 1.e-6, i, 0);
+  }
+  return hits;
+}
+
+FairMQChannel& getChannel()
+{
+  static auto factory = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  static FairMQChannel channel{"bench", "push", factory};
+  return channel;
+}
+
+// send and receive as TMessage: streaming on the sender, object creation on the receiver
+template <typename T>
+static void BM_TMessage(benchmark::State& state)
+{
+  auto data = makeData<T>(state.range(0));
+  auto& channel = getChannel();
+  for (auto _ : state) {
+    FairMQParts parts;
+    o2::base::attachTMessage(data, channel, parts);
+    auto decoded = o2::base::decodeTMessage<std::vector<T>*>(parts, 0);
+    benchmark::DoNotOptimize(decoded->data());
+    delete decoded;
+  }
+  state.SetBytesProcessed(state.iterations() * data.size() * sizeof(T));
+}
+
+// send as flat message, the receiver adopts the buffer and reads it in place
+template <typename T>
+static void BM_Flat(benchmark::State& state)
+{
+  auto data = makeData<T>(state.range(0));
+  auto& channel = getChannel();
+  for (auto _ : state) {
+    FairMQParts parts;
+    o2::base::attachFlatMessage(data, channel, parts);
+    auto message = o2::base::adoptFlatMessage(parts, 0);
+    auto span = message.asSpan<T>();
+    benchmark::DoNotOptimize(span.data());
+  }
+  state.SetBytesProcessed(state.iterations() * data.size() * sizeof(T));
+}
+
+BENCHMARK_TEMPLATE(BM_TMessage, o2::MCTrack)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK_TEMPLATE(BM_Flat, o2::MCTrack)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK_TEMPLATE(BM_TMessage, o2::TrackReference)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK_TEMPLATE(BM_Flat, o2::TrackReference)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK_TEMPLATE(BM_TMessage, Hit)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK_TEMPLATE(BM_Flat, Hit)->RangeMultiplier(10)->Range(100, 1000000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,209 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test DetectorsBase FlatTransport
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "DetectorsBase/Detector.h"
+#include "SimulationDataFormat/BaseHits.h"
+#include "SimulationDataFormat/PrimaryChunk.h"
+#include "CommonUtils/ConfigurableParam.h"
+#include <FairMQTransportFactory.h>
+#include <FairMQChannel.h>
+#include <FairMQParts.h>
+#include <TTree.h>
+#include <TParticle.h>
+#include <TVector3.h>
+#include <vector>
+
+namespace
+{
+using Hit = o2::BasicXYZEHit<float>;
+
+// a detector with a single hit vector, just enough to send and merge hits as the workers and the hit merger do
+class FlatTestDetector : public o2::base::DetImpl<FlatTestDetector>
+{
+ public:
+  FlatTestDetector() : o2::base::DetImpl<FlatTestDetector>("ITS", true) {}
+  std::vector<Hit>* getHits(int i) const { return i == 0 ? mHits : nullptr; }
+  void InitializeO2Detector() override {}
+  Bool_t ProcessHits(FairVolume*) override { return false; }
+  void Register() override {}
+  void Reset() override {}
+
+  std::vector<Hit>* mHits = nullptr;
+};
+
+FairMQChannel& getChannel()
+{
+  static auto factory = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  static FairMQChannel channel{"test", "push", factory};
+  return channel;
+}
+
+// the subevents of an event, as the hit merger sees them
+struct Event {
+  std::vector<std::vector<Hit>> hits;
+  std::vector<int> trackoffsets;
+  std::vector<int> nprimaries;
+  std::vector<int> subevtsOrdered;
+};
+
+Event makeEvent()
+{
+  Event event;
+  event.subevtsOrdered = {2, 0, 3, 1};
+  for (int sub = 0; sub < 4; ++sub) {
+    const int nprim = 2 + sub;
+    const int ntracks = nprim + 3 * sub;
+    event.nprimaries.push_back(nprim);
+    event.trackoffsets.push_back(ntracks);
+    event.hits.emplace_back();
+    // the second subevent has no hits
+    for (int i = 0; sub != 1 && i < 10 + sub; ++i) {
+      event.hits.back().emplace_back(0.1f * i, 0.2f * sub, 0.3f, 1.e-9f * i, 1.e-6f, i % ntracks, 0);
+    }
+  }
+  return event;
+}
+
+std::vector<Hit> readMerged(TTree& target, std::string const& brname)
+{
+  std::vector<Hit>* hits = nullptr;
+  auto br = target.GetBranch(brname.c_str());
+  BOOST_REQUIRE(br != nullptr);
+  br->SetAddress(&hits);
+  br->GetEntry(0);
+  std::vector<Hit> result(*hits);
+  br->ResetAddress();
+  delete hits;
+  return result;
+}
+
+std::vector<Hit> mergeTMessages(FlatTestDetector& detector, Event& event)
+{
+  o2::conf::ConfigurableParam::updateFromString("HitMergerParams.flatTransport=false");
+  TTree origin("origin", "origin");
+  for (auto& hits : event.hits) {
+    detector.mHits = &hits;
+    FairMQParts parts;
+    detector.attachHits(getChannel(), parts);
+    int index = 1; // behind the detector ID
+    BOOST_CHECK(!o2::base::isFlatMessage(parts, index));
+    detector.fillHitBranch(origin, parts, index);
+    origin.SetEntries(origin.GetEntries() + 1);
+  }
+  TTree target("target", "target");
+  detector.mergeHitEntries(origin, target, event.trackoffsets, event.nprimaries, event.subevtsOrdered);
+  return readMerged(target, detector.getHitBranchNames(0));
+}
+
+std::vector<Hit> mergeFlat(FlatTestDetector& detector, Event& event)
+{
+  o2::conf::ConfigurableParam::updateFromString("HitMergerParams.flatTransport=true");
+  o2::base::FlatHitStore store;
+  int entry = 0;
+  for (auto& hits : event.hits) {
+    detector.mHits = &hits;
+    FairMQParts parts;
+    detector.attachHits(getChannel(), parts);
+    int index = 1;
+    BOOST_CHECK(detector.adoptFlatHits(parts, index, store, entry++));
+    BOOST_CHECK_EQUAL(index, parts.Size());
+  }
+  TTree target("target", "target");
+  BOOST_CHECK(detector.mergeFlatHitEntries(store, target, event.trackoffsets, event.nprimaries, event.subevtsOrdered));
+  return readMerged(target, detector.getHitBranchNames(0));
+}
+
+void checkEqual(std::vector<Hit> const& flat, std::vector<Hit> const& reference)
+{
+  BOOST_REQUIRE_EQUAL(flat.size(), reference.size());
+  for (size_t i = 0; i < flat.size(); ++i) {
+    BOOST_CHECK_EQUAL(flat[i].GetTrackID(), reference[i].GetTrackID());
+    BOOST_CHECK_EQUAL(flat[i].GetX(), reference[i].GetX());
+    BOOST_CHECK_EQUAL(flat[i].GetY(), reference[i].GetY());
+    BOOST_CHECK_EQUAL(flat[i].GetZ(), reference[i].GetZ());
+    BOOST_CHECK_EQUAL(flat[i].GetTime(), reference[i].GetTime());
+    BOOST_CHECK_EQUAL(flat[i].GetEnergyLoss(), reference[i].GetEnergyLoss());
+    BOOST_CHECK_EQUAL(flat[i].GetDetectorID(), reference[i].GetDetectorID());
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(FlatHitsMergeLikeTMessages)
+{
+  FlatTestDetector detector;
+  auto event = makeEvent();
+  auto reference = mergeTMessages(detector, event);
+  auto flat = mergeFlat(detector, event);
+  checkEqual(flat, reference);
+
+  // a single subevent is taken over without track ID adjustment on both paths
+  Event single;
+  single.hits = {event.hits[0]};
+  single.trackoffsets = {event.trackoffsets[0]};
+  single.nprimaries = {event.nprimaries[0]};
+  single.subevtsOrdered = {0};
+  checkEqual(mergeFlat(detector, single), mergeTMessages(detector, single));
+  o2::conf::ConfigurableParam::updateFromString("HitMergerParams.flatTransport=false");
+}
+
+BOOST_AUTO_TEST_CASE(FlatHitsNoBranchWithoutData)
+{
+  // a detector which sent nothing for the event gets no branch, as with the event trees
+  FlatTestDetector detector;
+  auto event = makeEvent();
+  TTree origin("origin", "origin");
+  TTree target("target", "target");
+  detector.mergeHitEntries(origin, target, event.trackoffsets, event.nprimaries, event.subevtsOrdered);
+  BOOST_CHECK(target.GetBranch(detector.getHitBranchNames(0).c_str()) == nullptr);
+
+  o2::base::FlatHitStore store(1);
+  TTree flattarget("target", "target");
+  detector.mergeFlatHitEntries(store, flattarget, event.trackoffsets, event.nprimaries, event.subevtsOrdered);
+  BOOST_CHECK(flattarget.GetBranch(detector.getHitBranchNames(0).c_str()) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(FlatParticleRoundTrip)
+{
+  TParticle particle(211, 1, 3, -1, 5, 7, 0.1, -0.2, 1.5, 1.6, 0.01, 0.02, -3., 1.e-9);
+  particle.SetPolarisation(0.3, -0.4, 0.5);
+  particle.SetCalcMass(0.13957);
+  particle.SetWeight(0.25);
+  particle.SetUniqueID(42);
+  particle.SetBit(1 << 14);
+
+  auto restored = o2::data::FlatParticle(particle).toTParticle();
+  BOOST_CHECK_EQUAL(restored.GetPdgCode(), particle.GetPdgCode());
+  BOOST_CHECK_EQUAL(restored.GetStatusCode(), particle.GetStatusCode());
+  BOOST_CHECK_EQUAL(restored.GetFirstMother(), particle.GetFirstMother());
+  BOOST_CHECK_EQUAL(restored.GetSecondMother(), particle.GetSecondMother());
+  BOOST_CHECK_EQUAL(restored.GetFirstDaughter(), particle.GetFirstDaughter());
+  BOOST_CHECK_EQUAL(restored.GetLastDaughter(), particle.GetLastDaughter());
+  BOOST_CHECK_EQUAL(restored.Px(), particle.Px());
+  BOOST_CHECK_EQUAL(restored.Energy(), particle.Energy());
+  BOOST_CHECK_EQUAL(restored.Vz(), particle.Vz());
+  BOOST_CHECK_EQUAL(restored.T(), particle.T());
+  BOOST_CHECK_EQUAL(restored.GetCalcMass(), particle.GetCalcMass());
+  BOOST_CHECK_EQUAL(restored.GetWeight(), particle.GetWeight());
+  BOOST_CHECK_EQUAL(restored.GetUniqueID(), particle.GetUniqueID());
+  BOOST_CHECK(restored.TestBit(1 << 14));
+  // the polarisation is restored bit by bit, not recomputed from its vector
+  BOOST_CHECK_EQUAL(restored.GetPolarTheta(), particle.GetPolarTheta());
+  BOOST_CHECK_EQUAL(restored.GetPolarPhi(), particle.GetPolarPhi());
+  TVector3 pol, refpol;
+  restored.GetPolarisation(pol);
+  particle.GetPolarisation(refpol);
+  BOOST_CHECK(pol == refpol);
+}
@@ -15,6 +15,12 @@
 #include <boost/test/unit_test.hpp>
 
 #include "buildMatBudLUT.C"
+#include "DetectorsBase/GeometryImage.h"
+#include "DetectorsBase/GeometryManager.h"
+#include "DetectorsCommonDataFormats/DetMatrixCache.h"
+#include "MathUtils/Utils.h"
+#include <cmath>
+#include <unistd.h>
 
 namespace o2
 {
@@ -27,4 +33,94 @@ BOOST_AUTO_TEST_CASE(MatBudLUT)
 
 #endif //!GPUCA_ALIGPUCODE
 }
+
+#ifndef GPUCA_ALIGPUCODE
+class TestMatrixCache : public o2::detectors::DetMatrixCache
+{
+ public:
+  TestMatrixCache() : DetMatrixCache(o2::detectors::DetID::ITS) {}
+  void fillMatrixCache(int) override {}
+};
+#endif //!GPUCA_ALIGPUCODE
+
+BOOST_AUTO_TEST_CASE(MatBudLUTImage)
+{
+#ifndef GPUCA_ALIGPUCODE
+  using TransformType = o2::math_utils::TransformType;
+  // the LUT written by the previous test and some matrices
+  const auto* lut = o2::base::MatLayerCylSet::loadFromFile();
+  BOOST_REQUIRE(lut);
+  TestMatrixCache matrices;
+  const int nSensors = 5;
+  matrices.setSize(nSensors);
+  matrices.getCacheL2G().setSize(nSensors);
+  matrices.getCacheT2GRot().setSize(nSensors);
+  for (int i = 0; i < nSensors; i++) {
+    const double components[12] = {0., -1., 0., 1. + i, 1., 0., 0., 2., 0., 0., 1., -3. * i};
+    matrices.getCacheL2G().setMatrix(TestMatrixCache::Mat3D(components, components + 12), i);
+    matrices.getCacheT2GRot().setMatrix(TestMatrixCache::Rot2D(0.3f * i), i);
+  }
+
+  o2::base::GeometryImage image;
+  image.setGeometryID(o2::base::GeometryManager::getGeometryID());
+  image.addMatLUT(*lut, "matbud.root");
+  image.addMatrixCache(matrices);
+  const std::string name = "o2testgeometryimage" + std::to_string(getpid());
+  BOOST_CHECK_EQUAL(image.publish(name), image.getImageSize());
+  // an image of another geometry, e.g. of a different alignment
+  image.setGeometryID("other geometry");
+  BOOST_CHECK_EQUAL(image.publish(name + "other"), image.getImageSize());
+
+  o2::base::GeometryImage attached;
+  BOOST_REQUIRE(attached.attach(name));
+  // the processes having attached the image keep it after its removal
+  BOOST_CHECK(o2::base::GeometryImage::remove(name));
+  BOOST_CHECK(!o2::base::GeometryImage().attach(name));
+
+  // the LUT of another file is not provided
+  BOOST_CHECK(!attached.getMatLUT("othermatbud.root"));
+  const auto* sharedLUT = attached.getMatLUT("matbud.root");
+  BOOST_REQUIRE(sharedLUT);
+  BOOST_CHECK_EQUAL(sharedLUT->getNLayers(), lut->getNLayers());
+  for (int i = 0; i < 100; i++) {
+    const float phi = 0.0628f * i, r = 2.f + 0.5f * i, z = 0.3f * i - 15.f;
+    const auto expected = lut->getMatBudget(0.f, 0.f, 0.f, r * std::cos(phi), r * std::sin(phi), z);
+    const auto budget = sharedLUT->getMatBudget(0.f, 0.f, 0.f, r * std::cos(phi), r * std::sin(phi), z);
+    BOOST_CHECK_EQUAL(budget.meanRho, expected.meanRho);
+    BOOST_CHECK_EQUAL(budget.meanX2X0, expected.meanX2X0);
+    BOOST_CHECK_EQUAL(budget.length, expected.length);
+  }
+
+  // only the transformations of the image are provided
+  TestMatrixCache cache;
+  cache.setSize(nSensors);
+  const int mask = o2::math_utils::bit2Mask(TransformType::L2G, TransformType::T2L, TransformType::T2GRot);
+  BOOST_CHECK_EQUAL(attached.fillMatrixCache(cache, mask), o2::math_utils::bit2Mask(TransformType::L2G, TransformType::T2GRot));
+  BOOST_CHECK(!cache.getCacheT2L().isFilled());
+  for (int i = 0; i < nSensors; i++) {
+    double expected[12], components[12];
+    matrices.getMatrixL2G(i).GetComponents(expected, expected + 12);
+    cache.getMatrixL2G(i).GetComponents(components, components + 12);
+    for (int j = 0; j < 12; j++) {
+      BOOST_CHECK_EQUAL(components[j], expected[j]);
+    }
+    float cs, sn, expectedCs, expectedSn;
+    matrices.getMatrixT2GRot(i).getComponents(expectedCs, expectedSn);
+    cache.getMatrixT2GRot(i).getComponents(cs, sn);
+    BOOST_CHECK_EQUAL(cs, expectedCs);
+    BOOST_CHECK_EQUAL(sn, expectedSn);
+  }
+  // already filled caches are kept
+  BOOST_CHECK_EQUAL(attached.fillMatrixCache(cache, mask), 0);
+
+  // no matrices from the image of another geometry
+  o2::base::GeometryImage other;
+  BOOST_REQUIRE(other.attach(name + "other"));
+  BOOST_CHECK(o2::base::GeometryImage::remove(name + "other"));
+  TestMatrixCache otherCache;
+  otherCache.setSize(nSensors);
+  BOOST_CHECK_EQUAL(other.fillMatrixCache(otherCache, mask), 0);
+  BOOST_CHECK(!otherCache.getCacheL2G().isFilled());
+#endif //!GPUCA_ALIGPUCODE
+}
 } // namespace o2
@@ -41,6 +41,8 @@ class TimeSlot
     }
     return *this;
   }
+  TimeSlot(TimeSlot&& src) = default;
+  TimeSlot& operator=(TimeSlot&& src) = default;
 
   ~TimeSlot() = default;
 
@@ -15,9 +15,13 @@
 /// @brief Processor for the multiple time slots calibration
 
 #include "DetectorsCalibration/TimeSlot.h"
+#include <TROOT.h>
+#include <chrono>
 #include <deque>
+#include <future>
 #include <gsl/gsl>
 #include <limits>
+#include <memory>
 
 namespace o2
 {
@@ -31,7 +35,9 @@ class TimeSlotCalibration
 
  public:
   TimeSlotCalibration() = default;
-  virtual ~TimeSlotCalibration() = default;
+  // the owner should stop() the calibration while the derived object is still alive: here the workers may already
+  // see it partially destroyed
+  virtual ~TimeSlotCalibration() { stop(); }
   uint64_t getMaxSlotsDelay() const { return mMaxSlotsDelay; }
   void setMaxSlotsDelay(uint64_t v) { mMaxSlotsDelay = v; }
 
@@ -49,6 +55,27 @@ class TimeSlotCalibration
 
   void setUpdateAtTheEndOfRunOnly() { mUpdateAtTheEndOfRunOnly = kTRUE; }
 
+  // prepare closed slots (see prepareSlot) in up to n worker threads while new TFs are being processed, keeping at most
+  // maxPending closed slots in memory; finalizeSlot is still called in the processing thread, in the order of the slots.
+  // With n = 0 (default) the closed slots are prepared and finalized immediately, in the processing thread
+  void setFinalizationThreads(int n, size_t maxPending = 4)
+  {
+    waitForFinalization();
+    mFinalizationThreads = n < 0 ? 0 : n;
+    mMaxPendingSlots = maxPending < 1 ? 1 : maxPending;
+    if (mFinalizationThreads > 0) {
+      ROOT::EnableThreadSafety(); // the fits of the workers create ROOT objects
+    }
+  }
+  int getFinalizationThreads() const { return mFinalizationThreads; }
+  size_t getMaxPendingSlots() const { return mMaxPendingSlots; }
+  // number of closed slots which were not finalized yet
+  size_t getNPendingSlots() const { return mPendingSlots.size(); }
+  // finalize all the closed slots, waiting for their preparation
+  void waitForFinalization() { publishFinalizedSlots(0); }
+  // wait for the preparation of the closed slots and drop them without finalization, e.g. when the processing is stopped
+  void stop();
+
   int getNSlots() const { return mSlots.size(); }
   Slot& getSlotForTF(TFType tf);
   Slot& getSlot(int i) { return (Slot&)mSlots.at(i); }
@@ -66,6 +93,10 @@ class TimeSlotCalibration
   virtual void initOutput() = 0;
   // process the time slot container and add results to the output
   virtual void finalizeSlot(Slot& slot) = 0;
+  // optional heavy part of the processing of a closed slot (e.g. fits), called before finalizeSlot. With finalization
+  // threads it runs in a worker, concurrently with the processing of new TFs and with the preparation of other slots:
+  // it may only modify the slot and read the configuration of the calibrator, the results go to the output in finalizeSlot
+  virtual void prepareSlot(Slot& slot) {}
   // create new time slot in the beginning or the end of the slots pool
   virtual Slot& emplaceNewSlot(bool front, TFType tstart, TFType tend) = 0;
   // check if the slot has enough data to be finalized
@@ -78,8 +109,19 @@ class TimeSlotCalibration
 
  private:
   TFType tf2SlotMin(TFType tf) const;
+  void closeSlot(Slot& slot);
+  void startSlotsPreparation();
+  void publishFinalizedSlots(size_t maxPending);
+
+  struct PendingSlot {
+    std::unique_ptr<Slot> slot;
+    std::future<void> prepared;
+  };
 
   std::deque<Slot> mSlots;
+  std::deque<PendingSlot> mPendingSlots; //! closed slots being prepared in the worker threads
+  int mFinalizationThreads = 0;          // number of threads to prepare the closed slots, 0 to do it in the processing thread
+  size_t mMaxPendingSlots = 4;           // max number of closed slots not finalized yet
 
   TFType mLastClosedTF = 0;
   TFType mFirstTF = 0;
@@ -98,7 +140,7 @@ class TimeSlotCalibration
                                                 // after how many TF to check again.
   bool mWasCheckedInfiniteSlot = false;         // flag to know whether the statistics of the infinite slot was already checked
 
-  ClassDef(TimeSlotCalibration, 1);
+  ClassDef(TimeSlotCalibration, 2);
 };
 
 //_________________________________________________
@@ -108,6 +150,8 @@ bool TimeSlotCalibration<Input, Container>::process(TFType tf, const gsl::span<c
 
   // process current TF
 
+  publishFinalizedSlots(mMaxPendingSlots);
+
   int maxDelay = mMaxSlotsDelay * mSlotLength;
   if (!mUpdateAtTheEndOfRunOnly) {                                                               // if you update at the end of run only, then you accept everything
     if (tf < mLastClosedTF || (!mSlots.empty() && getLastSlot().getTFStart() > tf + maxDelay)) { // ignore TF; note that if you have only 1 timeslot
@@ -128,6 +172,7 @@ bool TimeSlotCalibration<Input, Container>::process(TFType tf, const gsl::span<c
     // check if some slots are done
     checkSlotsToFinalize(tf, maxDelay);
   }
+  publishFinalizedSlots(mMaxPendingSlots);
 
   return true;
 }
@@ -164,8 +209,8 @@ void TimeSlotCalibration<Input, Container>::checkSlotsToFinalize(TFType tf, int
         mSlots[0].setTFStart(mLastClosedTF);
         mSlots[0].setTFEnd(mMaxSeenTF);
         LOG(INFO) << "Finalizing slot for " << mSlots[0].getTFStart() << " <= TF <= " << mSlots[0].getTFEnd();
-        finalizeSlot(mSlots[0]);                  // will be removed after finalization
         mLastClosedTF = mSlots[0].getTFEnd() + 1; // will not accept any TF below this
+        closeSlot(mSlots[0]);                     // will be removed after finalization
         mSlots.erase(mSlots.begin());
         // creating a new slot if we are not at the end of run
         if (tf != INFINITE_TF) {
@@ -186,7 +231,7 @@ void TimeSlotCalibration<Input, Container>::checkSlotsToFinalize(TFType tf, int
       if ((slot->getTFEnd() + maxDelay) < tf) {
         if (hasEnoughData(*slot)) {
           LOG(DEBUG) << "Finalizing slot for " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd();
-          finalizeSlot(*slot); // will be removed after finalization
+          closeSlot(*slot); // will be removed after finalization
         } else if ((slot + 1) != mSlots.end()) {
           LOG(INFO) << "Merging underpopulated slot " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd()
                     << " to slot " << (slot + 1)->getTFStart() << " <= TF <= " << (slot + 1)->getTFEnd();
@@ -206,6 +251,9 @@ void TimeSlotCalibration<Input, Container>::checkSlotsToFinalize(TFType tf, int
       }
     }
   }
+  if (tf == INFINITE_TF) { // end of run: all the closed slots have to be in the output
+    waitForFinalization();
+  }
 }
 
 //_________________________________________________
@@ -217,9 +265,84 @@ void TimeSlotCalibration<Input, Container>::finalizeOldestSlot()
     LOG(WARNING) << "There are no slots defined";
     return;
   }
-  finalizeSlot(mSlots.front());
   mLastClosedTF = mSlots.front().getTFEnd() + 1; // do not accept any TF below this
+  closeSlot(mSlots.front());
   mSlots.erase(mSlots.begin());
+  waitForFinalization();
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::closeSlot(Slot& slot)
+{
+  // prepare and finalize the slot, possibly moving it to the workers; it can be erased from mSlots afterwards
+  if (mFinalizationThreads < 1) {
+    prepareSlot(slot);
+    finalizeSlot(slot);
+    return;
+  }
+  mPendingSlots.emplace_back(PendingSlot{std::make_unique<Slot>(std::move(slot)), {}});
+  startSlotsPreparation();
+  publishFinalizedSlots(mMaxPendingSlots); // blocks if too many closed slots are kept in memory
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::startSlotsPreparation()
+{
+  // the preparation of the pending slots is started in their order, in up to mFinalizationThreads threads
+  int running = 0;
+  for (auto& pending : mPendingSlots) {
+    if (pending.prepared.valid()) {
+      if (pending.prepared.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        running++;
+      }
+      continue;
+    }
+    if (running >= mFinalizationThreads) {
+      break;
+    }
+    auto slot = pending.slot.get();
+    pending.prepared = std::async(std::launch::async, [this, slot]() { prepareSlot(*slot); });
+    running++;
+  }
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::publishFinalizedSlots(size_t maxPending)
+{
+  // finalize the prepared slots in their order, waiting for the oldest ones if more than maxPending are left
+  while (!mPendingSlots.empty()) {
+    auto& front = mPendingSlots.front();
+    if (!front.prepared.valid()) {
+      startSlotsPreparation();
+    }
+    if (mPendingSlots.size() <= maxPending && front.prepared.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      break;
+    }
+    auto pending = std::move(front);
+    mPendingSlots.pop_front();
+    pending.prepared.get(); // rethrows the exceptions of prepareSlot
+    LOG(DEBUG) << "Publishing slot for " << pending.slot->getTFStart() << " <= TF <= " << pending.slot->getTFEnd();
+    finalizeSlot(*pending.slot);
+    startSlotsPreparation();
+  }
+}
+
+//_________________________________________________
+template <typename Input, typename Container>
+void TimeSlotCalibration<Input, Container>::stop()
+{
+  if (!mPendingSlots.empty()) {
+    LOG(INFO) << "Dropping " << mPendingSlots.size() << " closed slots not finalized yet";
+  }
+  for (auto& pending : mPendingSlots) {
+    if (pending.prepared.valid()) {
+      pending.prepared.wait();
+    }
+  }
+  mPendingSlots.clear();
 }
 
 //________________________________________
@@ -0,0 +1,150 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test DetectorsCalibration TimeSlotCalibration
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "DetectorsCalibration/TimeSlotCalibration.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using o2::calibration::TFType;
+
+constexpr TFType INFINITE_TF = 0xffffffffffffffff;
+constexpr TFType SlotLength = 5;
+constexpr TFType NTFs = 100;
+
+struct Counter {
+  int entries = 0;
+  double result = 0.;
+  void fill(const gsl::span<const int> data) { entries += data.size(); }
+  void merge(const Counter* prev) { entries += prev->entries; }
+  void print() const {}
+};
+
+// prepares the slots in a time decreasing with their start, so that the workers complete them out of order
+class TestCalibrator final : public o2::calibration::TimeSlotCalibration<int, Counter>
+{
+  using Slot = o2::calibration::TimeSlot<Counter>;
+
+ public:
+  bool hasEnoughData(const Slot& slot) const final { return slot.getContainer()->entries > 0; }
+  void initOutput() final { mOutput.clear(); }
+  void prepareSlot(Slot& slot) final
+  {
+    const int running = ++mRunning;
+    for (int maxRunning = mMaxRunning; running > maxRunning && !mMaxRunning.compare_exchange_weak(maxRunning, running);) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10 - slot.getTFStart() % 10));
+    if (slot.getTFStart() == mThrowAt) {
+      mRunning--;
+      throw std::runtime_error("fit failed");
+    }
+    slot.getContainer()->result = 2. * slot.getTFStart();
+    mRunning--;
+  }
+  void finalizeSlot(Slot& slot) final { mOutput.emplace_back(slot.getTFStart(), slot.getContainer()->result); }
+  Slot& emplaceNewSlot(bool front, TFType tstart, TFType tend) final
+  {
+    auto& slots = getSlots();
+    auto& slot = front ? slots.emplace_front(tstart, tend) : slots.emplace_back(tstart, tend);
+    slot.setContainer(std::make_unique<Counter>());
+    return slot;
+  }
+
+  std::vector<std::pair<TFType, double>> mOutput;
+  std::atomic<int> mRunning{0};    // preparations in progress
+  std::atomic<int> mMaxRunning{0}; // max number of concurrent preparations
+  TFType mThrowAt = INFINITE_TF;   // start of the slot failing its preparation
+};
+
+void processRun(TestCalibrator& calibrator, int nThreads, size_t maxPending)
+{
+  calibrator.setSlotLength(SlotLength);
+  calibrator.setMaxSlotsDelay(1);
+  calibrator.setFinalizationThreads(nThreads, maxPending);
+  const std::vector<int> data{1, 2, 3};
+  for (TFType tf = 0; tf < NTFs; tf++) {
+    calibrator.process(tf, data);
+    BOOST_CHECK_LE(calibrator.getNPendingSlots(), maxPending);
+  }
+  calibrator.checkSlotsToFinalize(INFINITE_TF);
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TimeSlotCalibrationSlotOrder)
+{
+  TestCalibrator serial;
+  processRun(serial, 0, 4);
+  BOOST_REQUIRE(!serial.mOutput.empty());
+  for (size_t i = 0; i < serial.mOutput.size(); i++) {
+    BOOST_CHECK_EQUAL(serial.mOutput[i].first, i * SlotLength);
+    BOOST_CHECK_EQUAL(serial.mOutput[i].second, 2. * i * SlotLength);
+  }
+
+  // the slots are finalized in their order, whatever the order in which the workers complete them
+  for (int nThreads : {1, 3}) {
+    TestCalibrator parallel;
+    processRun(parallel, nThreads, 4);
+    BOOST_CHECK_EQUAL(parallel.getNPendingSlots(), 0);
+    BOOST_CHECK(parallel.mOutput == serial.mOutput);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TimeSlotCalibrationBackpressure)
+{
+  // no more closed slots than maxPending are kept (checked in processRun), no more than nThreads are prepared at once
+  for (size_t maxPending : {1, 2, 8}) {
+    TestCalibrator calibrator;
+    processRun(calibrator, 2, maxPending);
+    BOOST_CHECK_EQUAL(calibrator.getNPendingSlots(), 0);
+    BOOST_CHECK_EQUAL(calibrator.mOutput.size(), NTFs / SlotLength);
+    BOOST_CHECK_LE(calibrator.mMaxRunning, 2);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TimeSlotCalibrationRethrow)
+{
+  TestCalibrator calibrator;
+  calibrator.mThrowAt = 3 * SlotLength;
+  BOOST_CHECK_THROW(processRun(calibrator, 2, 2), std::runtime_error);
+  // the slots before the failing one are in the output
+  BOOST_CHECK_EQUAL(calibrator.mOutput.size(), 3);
+  calibrator.stop();
+  BOOST_CHECK_EQUAL(calibrator.getNPendingSlots(), 0);
+  BOOST_CHECK_EQUAL(calibrator.mRunning, 0);
+}
+
+BOOST_AUTO_TEST_CASE(TimeSlotCalibrationStop)
+{
+  TestCalibrator calibrator;
+  calibrator.setSlotLength(SlotLength);
+  calibrator.setMaxSlotsDelay(0);
+  calibrator.setFinalizationThreads(2, 8);
+  const std::vector<int> data{1};
+  for (TFType tf = 0; tf < 6 * SlotLength; tf++) {
+    calibrator.process(tf, data);
+  }
+  const auto nFinalized = calibrator.mOutput.size();
+  BOOST_CHECK_EQUAL(nFinalized + calibrator.getNPendingSlots(), 5);
+  // the closed slots being prepared are dropped without finalization
+  calibrator.stop();
+  BOOST_CHECK_EQUAL(calibrator.getNPendingSlots(), 0);
+  BOOST_CHECK_EQUAL(calibrator.mRunning, 0);
+  BOOST_CHECK_EQUAL(calibrator.mOutput.size(), nFinalized);
+}
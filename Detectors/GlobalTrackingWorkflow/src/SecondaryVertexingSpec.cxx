@@ -19,6 +19,7 @@
 #include "DataFormatsITS/TrackITS.h"
 #include "DetectorsBase/Propagator.h"
 #include "DetectorsBase/GeometryManager.h"
+#include "DetectorsBase/GeometryImage.h"
 #include "GlobalTrackingWorkflow/SecondaryVertexingSpec.h"
 #include "SimulationDataFormat/MCEventLabel.h"
 #include "CommonDataFormat/BunchFilling.h"
@@ -72,7 +73,7 @@ void SecondaryVertexingSpec::init(InitContext& ic)
   std::string matLUTPath = ic.options().get<std::string>("material-lut-path");
   std::string matLUTFile = o2::base::NameConf::getMatLUTFileName(matLUTPath);
   if (o2::utils::Str::pathExists(matLUTFile)) {
-    auto* lut = o2::base::MatLayerCylSet::loadFromFile(matLUTFile);
+    auto* lut = o2::base::GeometryImage::loadMatLUT(matLUTFile);
     o2::base::Propagator::Instance()->setMatLUT(lut);
     LOG(INFO) << "Loaded material LUT from " << matLUTFile;
   } else {
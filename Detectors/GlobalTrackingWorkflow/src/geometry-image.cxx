@@ -0,0 +1,136 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// A tool building the image of the geometry derived objects (material LUT, ITS and MFT sensor matrices)
+// and publishing it to shared memory, where the devices of a workflow started with
+// ALICEO2_GEOMETRY_IMAGE=<name> attach to it instead of building these objects themselves.
+
+#include "DetectorsBase/GeometryImage.h"
+#include "DetectorsBase/GeometryManager.h"
+#include "DetectorsBase/MatLayerCylSet.h"
+#include "DetectorsCommonDataFormats/NameConf.h"
+#include "ITSBase/GeometryTGeo.h"
+#include "MFTBase/GeometryTGeo.h"
+#include "MathUtils/Utils.h"
+#include "CommonUtils/StringUtils.h"
+#include <FairLogger.h>
+#include <boost/program_options.hpp>
+#include <sys/resource.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace bpo = boost::program_options;
+
+namespace
+{
+long getMaxRSSMB()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss / 1024;
+}
+
+double getElapsedMS(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int publish(const std::string& name, const bpo::variables_map& vm)
+{
+  // the objects are built from the geometry, not taken from a previously published image
+  unsetenv(o2::base::GeometryImage::EnvName);
+
+  const auto start = std::chrono::steady_clock::now();
+  o2::base::GeometryImage image;
+  o2::base::GeometryManager::loadGeometry(vm["geometry-prefix"].as<std::string>());
+  // the devices take the matrices only if they load the same geometry with the same alignment
+  image.setGeometryID(o2::base::GeometryManager::getGeometryID());
+  const int mask = o2::math_utils::bit2Mask(o2::math_utils::TransformType::L2G, o2::math_utils::TransformType::T2L,
+                                            o2::math_utils::TransformType::T2G, o2::math_utils::TransformType::T2GRot);
+  auto* its = o2::its::GeometryTGeo::Instance();
+  its->fillMatrixCache(mask);
+  image.addMatrixCache(*its);
+  auto* mft = o2::mft::GeometryTGeo::Instance();
+  mft->fillMatrixCache(mask);
+  image.addMatrixCache(*mft);
+  const auto matLUTFile = o2::base::NameConf::getMatLUTFileName(vm["material-lut-path"].as<std::string>());
+  if (o2::utils::Str::pathExists(matLUTFile)) {
+    if (const auto* lut = o2::base::MatLayerCylSet::loadFromFile(matLUTFile)) {
+      image.addMatLUT(*lut, matLUTFile);
+    }
+  } else {
+    LOG(WARNING) << "Material LUT " << matLUTFile << " file is absent, it will not be in the image";
+  }
+  const auto size = image.publish(name);
+  if (!size) {
+    return 1;
+  }
+  LOG(INFO) << "Published geometry image " << name << " of " << size / 1024 << " kB, built in " << getElapsedMS(start)
+            << " ms with max RSS " << getMaxRSSMB() << " MB";
+  return 0;
+}
+
+int print(const std::string& name)
+{
+  const auto start = std::chrono::steady_clock::now();
+  o2::base::GeometryImage image;
+  if (!image.attach(name)) {
+    LOG(ERROR) << "No geometry image " << name << " published";
+    return 1;
+  }
+  const bool hasLUT = image.getMatLUT(image.getMatLUTFile()) != nullptr;
+  LOG(INFO) << "Attached geometry image " << name << (hasLUT ? " with" : " without") << " material LUT in "
+            << getElapsedMS(start) << " ms, max RSS " << getMaxRSSMB() << " MB";
+  image.print();
+  return 0;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  bpo::options_description options("Build the image of the geometry derived objects and publish it to shared memory\n\nAllowed options");
+  const char* envName = std::getenv(o2::base::GeometryImage::EnvName);
+  options.add_options()(
+    "publish", "Build the image and publish it.")(
+    "remove", "Remove the published image.")(
+    "print", "Attach the published image and print its content.")(
+    "name", bpo::value<std::string>()->default_value(envName ? envName : "o2geometryimage"), "Name of the shared memory segment of the image.")(
+    "geometry-prefix", bpo::value<std::string>()->default_value(""), "Prefix of the geometry file.")(
+    "material-lut-path", bpo::value<std::string>()->default_value(""), "Path of the material LUT file.")(
+    "help,h", "Produce help message.");
+
+  bpo::variables_map vm;
+  try {
+    bpo::store(bpo::command_line_parser(argc, argv).options(options).run(), vm);
+    bpo::notify(vm);
+  } catch (const bpo::error& e) {
+    std::cerr << e.what() << "\n\n"
+              << options << "\n";
+    return 1;
+  }
+  if (vm.count("help") || !(vm.count("publish") || vm.count("remove") || vm.count("print"))) {
+    std::cout << options << std::endl;
+    return 0;
+  }
+
+  const auto name = vm["name"].as<std::string>();
+  if (vm.count("remove")) {
+    if (!o2::base::GeometryImage::remove(name)) {
+      LOG(WARNING) << "No geometry image " << name << " to remove";
+    }
+    return 0;
+  }
+  if (vm.count("publish") && publish(name, vm)) {
+    return 1;
+  }
+  return vm.count("print") ? print(name) : 0;
+}
@@ -22,6 +22,7 @@
 #include "GlobalTracking/MatchTOF.h"
 #include "ReconstructionDataFormats/TrackTPCITS.h"
 #include "DetectorsBase/GeometryManager.h"
+#include "DetectorsBase/GeometryImage.h"
 #include "DetectorsBase/Propagator.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include <gsl/span>
@@ -61,7 +62,7 @@ class TOFDPLRecoWorkflowTask
     std::string matLUTPath = ic.options().get<std::string>("material-lut-path");
     std::string matLUTFile = o2::base::NameConf::getMatLUTFileName(matLUTPath);
     if (o2::utils::Str::pathExists(matLUTFile)) {
-      auto* lut = o2::base::MatLayerCylSet::loadFromFile(matLUTFile);
+      auto* lut = o2::base::GeometryImage::loadMatLUT(matLUTFile);
       o2::base::Propagator::Instance()->setMatLUT(lut);
       LOG(INFO) << "Loaded material LUT from " << matLUTFile;
     } else {
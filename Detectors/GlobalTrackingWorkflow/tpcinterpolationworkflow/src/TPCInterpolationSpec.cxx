@@ -36,6 +36,7 @@ void TPCInterpolationDPL::init(InitContext& ic)
   o2::base::Propagator::initFieldFromGRP();
   mTimer.Stop();
   mTimer.Reset();
+  mInterpolation.setNThreads(ic.options().get<int>("nthreads"));
   mInterpolation.init();
 }
 
@@ -107,7 +108,7 @@ DataProcessorSpec getTPCInterpolationSpec(bool useMC)
     inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<TPCInterpolationDPL>(useMC)},
-    Options{}};
+    Options{{"nthreads", VariantType::Int, 1, {"Number of threads used for the track interpolation"}}}};
 }
 
 } // namespace tpc
@@ -18,6 +18,7 @@
 
 #include "ITSBase/GeometryTGeo.h"
 #include "DetectorsBase/GeometryManager.h"
+#include "DetectorsBase/GeometryImage.h"
 #include "ITSMFTBase/SegmentationAlpide.h"
 #include "MathUtils/Cartesian.h"
 
@@ -388,6 +389,8 @@ void GeometryTGeo::fillMatrixCache(int mask)
     Build(mask);
     return;
   }
+  // matrices published in the shared geometry image are not rebuilt from TGeo
+  o2::base::GeometryImage::Instance().fillMatrixCache(*this, mask);
 
   // build matrices
   if ((mask & o2::math_utils::bit2Mask(o2::math_utils::TransformType::L2G)) && !getCacheL2G().isFilled()) {
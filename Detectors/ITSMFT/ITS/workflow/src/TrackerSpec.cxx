@@ -31,6 +31,7 @@
 
 #include "Field/MagneticField.h"
 #include "DetectorsBase/GeometryManager.h"
+#include "DetectorsBase/GeometryImage.h"
 #include "DetectorsBase/Propagator.h"
 #include "ITSBase/GeometryTGeo.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
@@ -70,7 +71,7 @@ void TrackerDPL::init(InitContext& ic)
     std::string matLUTPath = ic.options().get<std::string>("material-lut-path");
     std::string matLUTFile = o2::base::NameConf::getMatLUTFileName(matLUTPath);
     if (o2::utils::Str::pathExists(matLUTFile)) {
-      auto* lut = o2::base::MatLayerCylSet::loadFromFile(matLUTFile);
+      auto* lut = o2::base::GeometryImage::loadMatLUT(matLUTFile);
       o2::base::Propagator::Instance()->setMatLUT(lut);
       LOG(INFO) << "Loaded material LUT from " << matLUTFile;
     } else {
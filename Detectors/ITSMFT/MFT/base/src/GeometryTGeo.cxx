@@ -19,6 +19,7 @@
 #include "MFTBase/GeometryTGeo.h"
 
 #include "DetectorsBase/GeometryManager.h"
+#include "DetectorsBase/GeometryImage.h"
 #include "MathUtils/Cartesian.h"
 
 #include "FairLogger.h" // for LOG
@@ -415,6 +416,8 @@ void GeometryTGeo::fillMatrixCache(Int_t mask)
     Build(mask);
     return;
   }
+  // matrices published in the shared geometry image are not rebuilt from TGeo
+  o2::base::GeometryImage::Instance().fillMatrixCache(*this, mask);
   // LOG(INFO) << "mask " << mask << " o2::math_utils::bit2Mask " << o2::math_utils::bit2Mask(o2::math_utils::TransformType::L2G) <<
   // FairLogger::endl;
   // build matrices
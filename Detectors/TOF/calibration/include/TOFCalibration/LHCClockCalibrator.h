@@ -32,6 +32,10 @@ struct LHCClockDataHisto {
   float v2Bin = nbins / (2 * range);
   int entries = 0;
   std::vector<float> histo{0};
+  // result of the fit of the closed slot, done in LHCClockCalibrator::prepareSlot
+  bool fitDone = false;         //!
+  double fitResult = -4;        //!
+  std::vector<float> fitValues; //!
 
   LHCClockDataHisto();
 
@@ -64,9 +68,9 @@ class LHCClockCalibrator final : public o2::calibration::TimeSlotCalibration<o2:
 
  public:
   LHCClockCalibrator(int minEnt = 500, int nb = 1000, float r = 24400, const std::string path = "http://ccdb-test.cern.ch:8080") : mMinEntries(minEnt), mNBins(nb), mRange(r) { mCalibTOFapi.setURL(path); }
-  ~LHCClockCalibrator() final = default;
   bool hasEnoughData(const Slot& slot) const final { return slot.getContainer()->entries >= mMinEntries; }
   void initOutput() final;
+  void prepareSlot(Slot& slot) final;
   void finalizeSlot(Slot& slot) final;
   Slot& emplaceNewSlot(bool front, TFType tstart, TFType tend) final;
 
@@ -51,6 +51,13 @@ class TOFChannelData
  public:
   static constexpr int NCOMBINSTRIP = o2::tof::Geo::NPADX + o2::tof::Geo::NPADS;
 
+  struct ChannelFit {
+    float offset = 0;
+    float sigma = 0;
+    float fractionUnderPeak = 0;
+    bool valid = false;
+  };
+
   TOFChannelData()
   {
     LOG(INFO) << "Default c-tor, not to be used";
@@ -98,6 +105,10 @@ class TOFChannelData
 
   std::vector<int> getEntriesPerChannel() const { return mEntries; }
 
+  // results of the fits of the channels of the closed slot
+  std::vector<ChannelFit>& getChannelFits() { return mChannelFits; }
+  bool hasChannelFits() const { return !mChannelFits.empty(); }
+
  private:
   float mRange = o2::tof::Geo::BC_TIME_INPS * 0.5;
   int mNBins = 1000;
@@ -107,6 +118,7 @@ class TOFChannelData
 
   CalibTOFapi* mCalibTOFapi = nullptr; // calibTOFapi to correct the t-text
   int mNElsPerSector = o2::tof::Geo::NPADSXSECTOR;
+  std::vector<ChannelFit> mChannelFits; //! filled by TOFChannelCalibrator::prepareSlot
 
   ClassDefNV(TOFChannelData, 1);
 };
@@ -145,8 +157,6 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<T
 
   TOFChannelCalibrator(int minEnt = 500, int nb = 1000, float r = 24400) : mMinEntries(minEnt), mNBins(nb), mRange(r){};
 
-  ~TOFChannelCalibrator() final = default;
-
   bool hasEnoughData(const Slot& slot) const final
   {
     // Checking if all channels have enough data to do calibration.
@@ -164,6 +174,15 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<T
     return;
   }
 
+  void prepareSlot(Slot& slot) final
+  {
+    // the fits of the channels can be done outside of the processing thread when calibrating with tracks,
+    // while the cosmics calibration relies on the common mFuncDeltaOffset and stays in finalizeSlot
+    if (!mCalibWithCosmics) {
+      fitChannels(slot);
+    }
+  }
+
   void finalizeSlot(Slot& slot) final
   {
     // here we simply decide which finalize to call: for the use case with Tracks or cosmics
@@ -306,15 +325,14 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<T
     mTimeSlewingVector.emplace_back(ts);
   }
 
-  void finalizeSlotWithTracks(Slot& slot)
+  void fitChannels(Slot& slot) const
   {
-    // Extract results for the single slot
+    // Fit the t-texp distributions of the channels of the slot, keeping the results in its container
     o2::tof::TOFChannelData* c = slot.getContainer();
-    LOG(INFO) << "Finalize slot " << slot.getTFStart() << " <= TF <= " << slot.getTFEnd();
-
-    // for the CCDB entry
-    std::map<std::string, std::string> md;
-    TimeSlewing& ts = mCalibTOFapi->getSlewParamObj(); // we take the current CCDB object, since we want to simply update the offset
+    auto& fits = c->getChannelFits();
+    fits.clear();
+    fits.resize(Geo::NCHANNELS);
+    const std::vector<int> entriesPerChannel = c->getEntriesPerChannel();
 
     for (int ich = 0; ich < Geo::NCHANNELS; ich++) {
       // make the slice of the 2D histogram so that we have the 1D of the current channel
@@ -327,7 +345,6 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<T
       }
       std::vector<float> fitValues;
       std::vector<float> histoValues;
-      std::vector<int> entriesPerChannel = c->getEntriesPerChannel();
       if (entriesPerChannel.at(ich) == 0) {
         continue; // skip always since a channel with 0 entries is normal, it will be flagged as problematic
         if (mTest) {
@@ -339,7 +356,7 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<T
       }
 
       // more efficient way
-      auto histo = c->getHisto(sector);
+      const auto& histo = c->getHisto(sector);
       for (unsigned j = chinsector; j <= chinsector; ++j) {
         for (unsigned i = 0; i < c->getNbins(); ++i) {
           const auto& v = histo.at(i, j);
@@ -379,10 +396,32 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<T
       }
 
       fractionUnderPeak = entriesInChannel > 0 ? c->integral(ich, intmin, intmax) / entriesInChannel : 0;
+      fits[ich] = {fitValues[1], std::abs(fitValues[2]), fractionUnderPeak, true};
+    }
+  }
+
+  void finalizeSlotWithTracks(Slot& slot)
+  {
+    // Extract results for the single slot
+    o2::tof::TOFChannelData* c = slot.getContainer();
+    LOG(INFO) << "Finalize slot " << slot.getTFStart() << " <= TF <= " << slot.getTFEnd();
+    if (!c->hasChannelFits()) {
+      fitChannels(slot);
+    }
+
+    // for the CCDB entry
+    std::map<std::string, std::string> md;
+    TimeSlewing& ts = mCalibTOFapi->getSlewParamObj(); // we take the current CCDB object, since we want to simply update the offset
+
+    const auto& fits = c->getChannelFits();
+    for (int ich = 0; ich < Geo::NCHANNELS; ich++) {
+      if (!fits[ich].valid) {
+        continue;
+      }
       // now we need to store the results in the TimeSlewingObject
-      ts.setFractionUnderPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, fractionUnderPeak);
-      ts.setSigmaPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, abs(fitValues[2]));
-      ts.updateOffsetInfo(ich, fitValues[1]);
+      ts.setFractionUnderPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, fits[ich].fractionUnderPeak);
+      ts.setSigmaPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, fits[ich].sigma);
+      ts.updateOffsetInfo(ich, fits[ich].offset);
     }
     auto clName = o2::utils::MemFileHelper::getClassName(ts);
     auto flName = o2::ccdb::CcdbApi::generateFileName(clName);
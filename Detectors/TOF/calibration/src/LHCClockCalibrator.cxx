@@ -73,6 +73,16 @@ void LHCClockCalibrator::initOutput()
   return;
 }
 
+//_____________________________________________
+void LHCClockCalibrator::prepareSlot(Slot& slot)
+{
+  // Fit the histogram of the slot, possibly in a worker thread
+  o2::tof::LHCClockDataHisto* c = slot.getContainer();
+  float* array = &c->histo[0];
+  c->fitResult = fitGaus(c->nbins, array, -(c->range), c->range, c->fitValues);
+  c->fitDone = true;
+}
+
 //_____________________________________________
 void LHCClockCalibrator::finalizeSlot(Slot& slot)
 {
@@ -80,9 +90,11 @@ void LHCClockCalibrator::finalizeSlot(Slot& slot)
   o2::tof::LHCClockDataHisto* c = slot.getContainer();
   LOG(INFO) << "Finalize slot " << slot.getTFStart() << " <= TF <= " << slot.getTFEnd() << " with "
             << c->getEntries() << " entries";
-  std::vector<float> fitValues;
-  float* array = &c->histo[0];
-  double fitres = fitGaus(c->nbins, array, -(c->range), c->range, fitValues);
+  if (!c->fitDone) {
+    prepareSlot(slot);
+  }
+  const auto& fitValues = c->fitValues;
+  double fitres = c->fitResult;
   if (fitres >= 0) {
     LOG(INFO) << "Fit result " << fitres << " Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
   } else {
@@ -22,6 +22,7 @@
 #include "Framework/Task.h"
 #include "Framework/ConfigParamRegistry.h"
 #include "Framework/ControlService.h"
+#include "Framework/CallbackService.h"
 #include "Framework/WorkflowSpec.h"
 #include "CCDB/CcdbApi.h"
 #include "CCDB/CcdbObjectInfo.h"
@@ -45,6 +46,9 @@ class LHCClockCalibDevice : public o2::framework::Task
     mCalibrator = std::make_unique<o2::tof::LHCClockCalibrator>(minEnt, nb);
     mCalibrator->setSlotLength(slotL);
     mCalibrator->setMaxSlotsDelay(delay);
+    mCalibrator->setFinalizationThreads(ic.options().get<int>("finalization-threads"));
+    // the slots being fitted in the workers are dropped before the calibrator is destroyed
+    ic.services().get<CallbackService>().set(CallbackService::Id::Stop, [this]() { mCalibrator->stop(); });
   }
 
   void run(o2::framework::ProcessingContext& pc) final
@@ -115,7 +119,8 @@ DataProcessorSpec getLHCClockCalibDeviceSpec()
       {"tf-per-slot", VariantType::Int, 5, {"number of TFs per calibration time slot"}},
       {"max-delay", VariantType::Int, 3, {"number of slots in past to consider"}},
       {"min-entries", VariantType::Int, 500, {"minimum number of entries to fit single time slot"}},
-      {"nbins", VariantType::Int, 1000, {"number of bins for "}}}};
+      {"nbins", VariantType::Int, 1000, {"number of bins for "}},
+      {"finalization-threads", VariantType::Int, 0, {"number of threads fitting the closed slots, 0 to fit them in the processing thread"}}}};
 }
 
 } // namespace framework
@@ -23,6 +23,7 @@
 #include "Framework/Task.h"
 #include "Framework/ConfigParamRegistry.h"
 #include "Framework/ControlService.h"
+#include "Framework/CallbackService.h"
 #include "Framework/WorkflowSpec.h"
 #include "CCDB/CcdbApi.h"
 #include "CCDB/CcdbObjectInfo.h"
@@ -68,6 +69,9 @@ class TOFChannelCalibDevice : public o2::framework::Task
     mCalibrator->setCheckIntervalInfiniteSlot(updateInterval);
     mCalibrator->setCheckDeltaIntervalInfiniteSlot(deltaUpdateInterval);
     mCalibrator->setMaxSlotsDelay(delay);
+    mCalibrator->setFinalizationThreads(ic.options().get<int>("finalization-threads"));
+    // the slots being fitted in the workers are dropped before the calibrator is destroyed
+    ic.services().get<CallbackService>().set(CallbackService::Id::Stop, [this]() { mCalibrator->stop(); });
 
     if (updateAtEORonly) { // has priority over other settings
       mCalibrator->setUpdateAtTheEndOfRunOnly();
@@ -251,7 +255,8 @@ DataProcessorSpec getTOFChannelCalibDeviceSpec(bool useCCDB, bool attachChannelO
       {"tf-per-slot", VariantType::Int64, INFINITE_TF_int64, {"number of TFs per calibration time slot"}},
       {"max-delay", VariantType::Int64, 0ll, {"number of slots in past to consider"}},
       {"update-interval", VariantType::Int64, 10ll, {"number of TF after which to try to finalize calibration"}},
-      {"delta-update-interval", VariantType::Int64, 10ll, {"number of TF after which to try to finalize calibration, if previous attempt failed"}}}};
+      {"delta-update-interval", VariantType::Int64, 10ll, {"number of TF after which to try to finalize calibration, if previous attempt failed"}},
+      {"finalization-threads", VariantType::Int, 0, {"number of threads fitting the channels of the closed slots (calibration with tracks), 0 to fit them in the processing thread"}}}};
 }
 
 } // namespace framework
@@ -62,12 +62,14 @@ class Compressor
 
   inline void rewind()
   {
+    mDecoderSaveBufferDataSize = 0;
     decoderRewind();
     encoderRewind();
   };
 
   void checkSummary();
   void resetCounters();
+  void addCounters(const Compressor& other);
 
   void setDecoderCONET(bool val)
   {
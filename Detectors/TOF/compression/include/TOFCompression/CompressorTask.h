@@ -20,6 +20,7 @@
 #include "Framework/Task.h"
 #include "Framework/DataProcessorSpec.h"
 #include "TOFCompression/Compressor.h"
+#include "TOFCompression/ParallelCompressor.h"
 #include <fstream>
 
 using namespace o2::framework;
@@ -40,7 +41,9 @@ class CompressorTask : public Task
 
  private:
   Compressor<RDH, verbose, paranoid> mCompressor;
+  ParallelCompressor<RDH, verbose, paranoid> mParallelCompressor; // used with more than one thread
   int mOutputBufferSize;
+  int mNThreads = 1;
 };
 
 } // namespace tof
@@ -0,0 +1,115 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   ParallelCompressor.h
+/// @since  2021-06-14
+/// @brief  TOF raw data compressor, links compressed in parallel
+///
+/// The HBFs of the input buffer are indexed up front and grouped by link (FEE id).
+/// Each link is compressed by the Compressor owned by the thread processing it into
+/// its own region of a scratch buffer, then the compressed HBFs are concatenated
+/// in the order of the input. The output is byte-identical to Compressor::run().
+
+#ifndef O2_TOF_PARALLELCOMPRESSOR
+#define O2_TOF_PARALLELCOMPRESSOR
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "TOFCompression/Compressor.h"
+
+namespace o2
+{
+namespace tof
+{
+
+template <typename RDH, bool verbose, bool paranoid>
+class ParallelCompressor
+{
+
+ public:
+  ParallelCompressor() = default;
+  ~ParallelCompressor() = default;
+
+  /// index the HBFs of the decoder buffer, compress the links in parallel and concatenate the output;
+  /// if the compressed data do not fit, the buffer is compressed again by the sequential compressor
+  bool run();
+
+  void checkSummary();
+  void resetCounters();
+
+  void setNThreads(int val) { mNThreads = val > 0 ? val : 1; };
+  int getNThreads() const { return mNThreads; };
+
+  void setDecoderVerbose(bool val) { mDecoderVerbose = val; };
+  void setEncoderVerbose(bool val) { mEncoderVerbose = val; };
+  void setCheckerVerbose(bool val) { mCheckerVerbose = val; };
+
+  void setDecoderBuffer(const char* val) { mDecoderBuffer = val; };
+  void setEncoderBuffer(char* val) { mEncoderBuffer = val; };
+  void setDecoderBufferSize(long val) { mDecoderBufferSize = val; };
+  void setEncoderBufferSize(long val) { mEncoderBufferSize = val; };
+
+  inline uint32_t getDecoderByteCounter() const { return mDecoderByteCounter; };
+  inline uint32_t getEncoderByteCounter() const { return mEncoderByteCounter; };
+  int getNumberOfHBFs() const { return mHBFs.size(); };
+  int getNumberOfLinks() const { return mLinks.size(); };
+
+  // benchmarks
+  double mIntegratedBytes = 0.;
+  double mIntegratedTime = 0.;
+
+ protected:
+  /** a complete HBF of the input and its position in the scratch output **/
+  struct HBF_t {
+    long decoderOffset = 0;
+    long decoderSize = 0;
+    long encoderOffset = 0;
+    long encoderSize = 0;
+  };
+
+  /** the HBFs of a link, in input order, and the scratch region they are compressed into **/
+  struct Link_t {
+    uint16_t feeId = 0;
+    std::vector<int> hbfs;
+    long scratchOffset = 0;
+    long scratchSize = 0;
+    bool overflow = false;
+  };
+
+  long indexHBFs();
+  void compressLink(Compressor<RDH, verbose, paranoid>& compressor, Link_t& link);
+  Compressor<RDH, verbose, paranoid>& getCompressor(int ithread);
+  void runSequential();
+
+  int mNThreads = 1;
+  bool mDecoderVerbose = false;
+  bool mEncoderVerbose = false;
+  bool mCheckerVerbose = false;
+
+  const char* mDecoderBuffer = nullptr;
+  long mDecoderBufferSize = 0;
+  char* mEncoderBuffer = nullptr;
+  long mEncoderBufferSize = 0;
+  uint32_t mDecoderByteCounter = 0;
+  uint32_t mEncoderByteCounter = 0;
+
+  std::vector<HBF_t> mHBFs;
+  std::vector<Link_t> mLinks;
+  std::vector<char> mScratchBuffer;
+  std::vector<std::unique_ptr<Compressor<RDH, verbose, paranoid>>> mCompressors; // one per thread, each owns its HBF save buffer
+  std::unique_ptr<Compressor<RDH, verbose, paranoid>> mSummary;                  // checker counters of the compressed buffers
+};
+
+} // namespace tof
+} // namespace o2
+
+#endif /** O2_TOF_PARALLELCOMPRESSOR **/
@@ -41,14 +41,31 @@ void CompressorTask<RDH, verbose, paranoid>::init(InitContext& ic)
   auto encoderVerbose = ic.options().get<bool>("tof-compressor-encoder-verbose");
   auto checkerVerbose = ic.options().get<bool>("tof-compressor-checker-verbose");
   mOutputBufferSize = ic.options().get<int>("tof-compressor-output-buffer-size");
+  mNThreads = ic.options().get<int>("tof-compressor-nthreads");
+
+  /** the CONET mode has no HBFs to be indexed by link **/
+  if (decoderCONET && mNThreads > 1) {
+    LOG(WARNING) << "link-parallel compression not available in CONET mode, running with one thread";
+    mNThreads = 1;
+  }
 
   mCompressor.setDecoderCONET(decoderCONET);
   mCompressor.setDecoderVerbose(decoderVerbose);
   mCompressor.setEncoderVerbose(encoderVerbose);
   mCompressor.setCheckerVerbose(checkerVerbose);
+  mCompressor.resetCounters();
+
+  mParallelCompressor.setNThreads(mNThreads);
+  mParallelCompressor.setDecoderVerbose(decoderVerbose);
+  mParallelCompressor.setEncoderVerbose(encoderVerbose);
+  mParallelCompressor.setCheckerVerbose(checkerVerbose);
 
   auto finishFunction = [this]() {
-    mCompressor.checkSummary();
+    if (mNThreads > 1) {
+      mParallelCompressor.checkSummary();
+    } else {
+      mCompressor.checkSummary();
+    }
   };
 
   ic.services().get<CallbackService>().set(CallbackService::Id::Stop, finishFunction);
@@ -120,15 +137,23 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
       auto payloadIn = ref.payload;
       auto payloadInSize = headerIn->payloadSize;
 
-      /** prepare compressor **/
-      mCompressor.setDecoderBuffer(payloadIn);
-      mCompressor.setDecoderBufferSize(payloadInSize);
-      mCompressor.setEncoderBuffer(bufferPointer);
-      mCompressor.setEncoderBufferSize(bufferSize);
-
-      /** run **/
-      mCompressor.run();
-      auto payloadOutSize = mCompressor.getEncoderByteCounter();
+      /** run compressor, the parallel one yields the same output **/
+      uint32_t payloadOutSize = 0;
+      if (mNThreads > 1) {
+        mParallelCompressor.setDecoderBuffer(payloadIn);
+        mParallelCompressor.setDecoderBufferSize(payloadInSize);
+        mParallelCompressor.setEncoderBuffer(bufferPointer);
+        mParallelCompressor.setEncoderBufferSize(bufferSize);
+        mParallelCompressor.run();
+        payloadOutSize = mParallelCompressor.getEncoderByteCounter();
+      } else {
+        mCompressor.setDecoderBuffer(payloadIn);
+        mCompressor.setDecoderBufferSize(payloadInSize);
+        mCompressor.setEncoderBuffer(bufferPointer);
+        mCompressor.setEncoderBufferSize(bufferSize);
+        mCompressor.run();
+        payloadOutSize = mCompressor.getEncoderByteCounter();
+      }
       bufferPointer += payloadOutSize;
       bufferSize -= payloadOutSize;
       headerOut.payloadSize += payloadOutSize;
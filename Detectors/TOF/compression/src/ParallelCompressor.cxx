@@ -0,0 +1,284 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   ParallelCompressor.cxx
+/// @since  2021-06-14
+/// @brief  TOF raw data compressor, links compressed in parallel
+
+#include "TOFCompression/ParallelCompressor.h"
+#include "Framework/Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace o2
+{
+namespace tof
+{
+
+template <typename RDH, bool verbose, bool paranoid>
+Compressor<RDH, verbose, paranoid>& ParallelCompressor<RDH, verbose, paranoid>::getCompressor(int ithread)
+{
+  auto& compressor = mCompressors[ithread];
+  compressor->setDecoderVerbose(mDecoderVerbose);
+  compressor->setEncoderVerbose(mEncoderVerbose);
+  compressor->setCheckerVerbose(mCheckerVerbose);
+  return *compressor;
+}
+
+template <typename RDH, bool verbose, bool paranoid>
+long ParallelCompressor<RDH, verbose, paranoid>::indexHBFs()
+{
+  /** walk the RDHs with the same checks as Compressor::processHBF, the first HBF that the
+      compressor would reject is returned and left to the sequential compressor, so that
+      the error handling and the output are the same as without the index **/
+
+  mHBFs.clear();
+  mLinks.clear();
+  std::map<uint16_t, int> linkIndex;
+
+  long position = 0;
+  while (position < mDecoderBufferSize) {
+    if (mDecoderBufferSize - position < (long)sizeof(RDH)) {
+      LOG(ERROR) << "incomplete RDH at the end of the buffer, " << mDecoderBufferSize - position << " bytes ignored";
+      return -1;
+    }
+    auto first = reinterpret_cast<const RDH*>(mDecoderBuffer + position);
+    if (first->stop || first->pageCnt != 0) {
+      return position;
+    }
+
+    /** loop until RDH close **/
+    auto rdh = first;
+    long offset = position;
+    while (!rdh->stop) {
+      if (rdh->feeId != first->feeId || rdh->orbit != first->orbit) {
+        return position;
+      }
+      if (rdh->offsetToNext == 0) {
+        LOG(ERROR) << "invalid RDH offset to next at position " << offset << " of " << mDecoderBufferSize << ", stop compressing this buffer";
+        return -1;
+      }
+      offset += rdh->offsetToNext;
+      if (offset >= mDecoderBufferSize) {
+        return position;
+      }
+      if (mDecoderBufferSize - offset < (long)sizeof(RDH)) {
+        LOG(ERROR) << "incomplete RDH at the end of the buffer, " << mDecoderBufferSize - offset << " bytes ignored";
+        return -1;
+      }
+      rdh = reinterpret_cast<const RDH*>(mDecoderBuffer + offset);
+    }
+    if (rdh->feeId != first->feeId || rdh->orbit != first->orbit) {
+      return position;
+    }
+
+    /** the HBF ends after the RDH close, if this does not point further the
+        compressor stops on it as on the first RDH of the next HBF **/
+    bool last = rdh->offsetToNext == 0;
+    long end = std::min(offset + (long)(last ? rdh->headerSize : rdh->offsetToNext), mDecoderBufferSize);
+
+    auto ilink = linkIndex.emplace(first->feeId, mLinks.size());
+    if (ilink.second) {
+      mLinks.emplace_back();
+      mLinks.back().feeId = first->feeId;
+    }
+    mLinks[ilink.first->second].hbfs.push_back(mHBFs.size());
+    mHBFs.push_back({position, end - position, 0, 0});
+
+    if (last) {
+      return -1;
+    }
+    position = end;
+  }
+  return -1;
+}
+
+template <typename RDH, bool verbose, bool paranoid>
+void ParallelCompressor<RDH, verbose, paranoid>::compressLink(Compressor<RDH, verbose, paranoid>& compressor, Link_t& link)
+{
+  long used = 0;
+  link.overflow = false;
+  for (auto ihbf : link.hbfs) {
+    auto& hbf = mHBFs[ihbf];
+    hbf.encoderOffset = link.scratchOffset + used;
+    hbf.encoderSize = 0;
+    /** the compressed HBF is never larger than the raw one, the region of the link is sized accordingly **/
+    if (used + hbf.decoderSize > link.scratchSize) {
+      link.overflow = true;
+      continue;
+    }
+    compressor.setDecoderBuffer(mDecoderBuffer + hbf.decoderOffset);
+    compressor.setDecoderBufferSize(hbf.decoderSize);
+    compressor.setEncoderBuffer(mScratchBuffer.data() + hbf.encoderOffset);
+    compressor.setEncoderBufferSize(link.scratchSize - used);
+    compressor.run();
+    hbf.encoderSize = compressor.getEncoderByteCounter();
+    used += hbf.encoderSize;
+  }
+}
+
+template <typename RDH, bool verbose, bool paranoid>
+void ParallelCompressor<RDH, verbose, paranoid>::runSequential()
+{
+  /** the links were compressed in parallel, drop their counters so that the HBFs are not counted twice **/
+  for (auto& compressor : mCompressors) {
+    compressor->resetCounters();
+  }
+  auto& compressor = getCompressor(0);
+  compressor.setDecoderBuffer(mDecoderBuffer);
+  compressor.setDecoderBufferSize(mDecoderBufferSize);
+  compressor.setEncoderBuffer(mEncoderBuffer);
+  compressor.setEncoderBufferSize(mEncoderBufferSize);
+  compressor.run();
+  mEncoderByteCounter = compressor.getEncoderByteCounter();
+  mDecoderByteCounter = compressor.getDecoderByteCounter();
+}
+
+template <typename RDH, bool verbose, bool paranoid>
+bool ParallelCompressor<RDH, verbose, paranoid>::run()
+{
+  auto start = std::chrono::high_resolution_clock::now();
+
+  if (!mSummary) {
+    mSummary = std::make_unique<Compressor<RDH, verbose, paranoid>>();
+    mSummary->resetCounters();
+  }
+  while ((int)mCompressors.size() < mNThreads) {
+    mCompressors.emplace_back(std::make_unique<Compressor<RDH, verbose, paranoid>>());
+    mCompressors.back()->resetCounters();
+  }
+
+  /** index the HBFs and assign every link a scratch region as large as its input **/
+  auto tail = indexHBFs();
+  long scratchSize = 0;
+  for (auto& link : mLinks) {
+    link.scratchOffset = scratchSize;
+    link.scratchSize = 0;
+    for (auto ihbf : link.hbfs) {
+      link.scratchSize += mHBFs[ihbf].decoderSize;
+    }
+    scratchSize += link.scratchSize;
+  }
+  if ((long)mScratchBuffer.size() < scratchSize) {
+    mScratchBuffer.resize(scratchSize);
+  }
+
+  /** compress the links in parallel **/
+  int nLinks = mLinks.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int ilink = 0; ilink < nLinks; ++ilink) {
+    int ithread = 0;
+#ifdef WITH_OPENMP
+    ithread = omp_get_thread_num();
+#endif
+    compressLink(getCompressor(ithread), mLinks[ilink]);
+  }
+
+  /** concatenate the compressed HBFs in input order **/
+  int nHBFs = mHBFs.size();
+  std::vector<long> outputOffset(nHBFs + 1, 0);
+  for (int ihbf = 0; ihbf < nHBFs; ++ihbf) {
+    outputOffset[ihbf + 1] = outputOffset[ihbf] + mHBFs[ihbf].encoderSize;
+  }
+  bool overflow = outputOffset[nHBFs] > mEncoderBufferSize;
+  for (const auto& link : mLinks) {
+    if (link.overflow) {
+      LOG(WARNING) << "compressed data of link " << link.feeId << " exceed the raw data size, buffer compressed sequentially";
+      overflow = true;
+    }
+  }
+  if (overflow) {
+    if (outputOffset[nHBFs] > mEncoderBufferSize) {
+      LOG(WARNING) << "compressed data (" << outputOffset[nHBFs] << " bytes) exceed the encoder buffer size (" << mEncoderBufferSize << " bytes), buffer compressed sequentially";
+    }
+    runSequential();
+  } else {
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static) num_threads(mNThreads)
+#endif
+    for (int ihbf = 0; ihbf < nHBFs; ++ihbf) {
+      std::memcpy(mEncoderBuffer + outputOffset[ihbf], mScratchBuffer.data() + mHBFs[ihbf].encoderOffset, mHBFs[ihbf].encoderSize);
+    }
+    mEncoderByteCounter = outputOffset[nHBFs];
+    mDecoderByteCounter = nHBFs > 0 ? mHBFs.back().decoderOffset + mHBFs.back().decoderSize : 0;
+
+    /** the rest of the buffer is not made of valid HBFs, let the sequential compressor handle it **/
+    if (tail >= 0) {
+      auto& compressor = getCompressor(0);
+      compressor.setDecoderBuffer(mDecoderBuffer + tail);
+      compressor.setDecoderBufferSize(mDecoderBufferSize - tail);
+      compressor.setEncoderBuffer(mEncoderBuffer + mEncoderByteCounter);
+      compressor.setEncoderBufferSize(mEncoderBufferSize - mEncoderByteCounter);
+      compressor.run();
+      mEncoderByteCounter += compressor.getEncoderByteCounter();
+      mDecoderByteCounter = tail + compressor.getDecoderByteCounter();
+    }
+  }
+
+  /** the counters of the threads hold this buffer only, move them to the summary **/
+  for (auto& compressor : mCompressors) {
+    mSummary->addCounters(*compressor);
+    compressor->resetCounters();
+  }
+
+  auto finish = std::chrono::high_resolution_clock::now();
+  mIntegratedBytes += mDecoderBufferSize;
+  mIntegratedTime += std::chrono::duration<double>(finish - start).count();
+
+  if (verbose && mDecoderVerbose) {
+    LOG(INFO) << "compressed " << nHBFs << " HBFs of " << nLinks << " links with " << mNThreads << " threads: "
+              << mDecoderBufferSize << " -> " << mEncoderByteCounter << " bytes";
+  }
+
+  return false;
+}
+
+template <typename RDH, bool verbose, bool paranoid>
+void ParallelCompressor<RDH, verbose, paranoid>::resetCounters()
+{
+  for (auto& compressor : mCompressors) {
+    compressor->resetCounters();
+  }
+  if (mSummary) {
+    mSummary->resetCounters();
+  }
+}
+
+template <typename RDH, bool verbose, bool paranoid>
+void ParallelCompressor<RDH, verbose, paranoid>::checkSummary()
+{
+  if (!mSummary) {
+    mSummary = std::make_unique<Compressor<RDH, verbose, paranoid>>();
+    mSummary->resetCounters();
+  }
+  mSummary->checkSummary();
+  if (mIntegratedTime > 0.) {
+    LOG(INFO) << "--- COMPRESSOR THROUGHPUT: " << mIntegratedBytes / 1.e6 << " MB in " << mIntegratedTime << " s | "
+              << mIntegratedBytes / 1.e6 / mIntegratedTime << " MB/s with " << mNThreads << " threads";
+  }
+}
+
+template class ParallelCompressor<o2::header::RAWDataHeaderV6, false, false>;
+template class ParallelCompressor<o2::header::RAWDataHeaderV6, false, true>;
+template class ParallelCompressor<o2::header::RAWDataHeaderV6, true, false>;
+template class ParallelCompressor<o2::header::RAWDataHeaderV6, true, true>;
+
+} // namespace tof
+} // namespace o2
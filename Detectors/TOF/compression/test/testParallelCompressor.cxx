@@ -0,0 +1,133 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TOF ParallelCompressor
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "TOFCompression/Compressor.h"
+#include "TOFCompression/ParallelCompressor.h"
+#include "Headers/RAWDataHeader.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace o2::tof;
+using RDH = o2::header::RAWDataHeaderV6;
+
+namespace
+{
+
+void addPage(std::vector<char>& buffer, uint16_t feeId, uint32_t orbit, uint16_t pageCnt, bool stop, const std::vector<uint32_t>& payload)
+{
+  RDH rdh;
+  rdh.feeId = feeId;
+  rdh.orbit = orbit;
+  rdh.pageCnt = pageCnt;
+  rdh.stop = stop;
+  rdh.memorySize = rdh.headerSize + payload.size() * sizeof(uint32_t);
+  rdh.offsetToNext = rdh.memorySize;
+  auto pos = buffer.size();
+  buffer.resize(pos + rdh.offsetToNext);
+  std::memcpy(buffer.data() + pos, &rdh, sizeof(RDH));
+  std::memcpy(buffer.data() + pos + rdh.headerSize, payload.data(), payload.size() * sizeof(uint32_t));
+}
+
+/// HBFs of several links interleaved as on a CRU endpoint: empty HBFs, multi-page HBFs
+/// and HBFs whose payload is not TOF data, which the compressor flags as fatal
+std::vector<char> makeBuffer(int nLinks, int nOrbits)
+{
+  std::vector<char> buffer;
+  std::vector<uint32_t> garbage = {0x0, 0x0, 0x0, 0x0};
+  for (int orbit = 0; orbit < nOrbits; ++orbit) {
+    for (int link = 0; link < nLinks; ++link) {
+      int npages = 1 + (orbit + link) % 3;
+      for (int page = 0; page < npages; ++page) {
+        addPage(buffer, link, orbit, page, false, (orbit * link) % 4 == 1 ? garbage : std::vector<uint32_t>{});
+      }
+      addPage(buffer, link, orbit, npages, true, {});
+    }
+  }
+  return buffer;
+}
+
+std::vector<char> compressSequential(const std::vector<char>& input)
+{
+  std::vector<char> output(input.size());
+  auto compressor = std::make_unique<Compressor<RDH, false, false>>();
+  compressor->setDecoderBuffer(input.data());
+  compressor->setDecoderBufferSize(input.size());
+  compressor->setEncoderBuffer(output.data());
+  compressor->setEncoderBufferSize(output.size());
+  compressor->run();
+  output.resize(compressor->getEncoderByteCounter());
+  return output;
+}
+
+/// encoderBufferSize is the size declared to the compressor, the output buffer is always as large as the input
+std::vector<char> compressParallel(const std::vector<char>& input, int nThreads, long encoderBufferSize = -1)
+{
+  std::vector<char> output(input.size());
+  ParallelCompressor<RDH, false, false> compressor;
+  compressor.setNThreads(nThreads);
+  compressor.setDecoderBuffer(input.data());
+  compressor.setDecoderBufferSize(input.size());
+  compressor.setEncoderBuffer(output.data());
+  compressor.setEncoderBufferSize(encoderBufferSize < 0 ? output.size() : encoderBufferSize);
+  compressor.run();
+  output.resize(compressor.getEncoderByteCounter());
+  return output;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(ParallelCompressorByteIdentical)
+{
+  auto input = makeBuffer(12, 16);
+  auto reference = compressSequential(input);
+  BOOST_CHECK(!reference.empty());
+  for (int nThreads : {1, 2, 4, 12}) {
+    auto output = compressParallel(input, nThreads);
+    BOOST_CHECK_EQUAL(output.size(), reference.size());
+    BOOST_CHECK(output == reference);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ParallelCompressorStopsLikeSequential)
+{
+  // a continuation page of a different link in the middle of an HBF stops the compression
+  auto input = makeBuffer(4, 4);
+  addPage(input, 1, 4, 0, false, {});
+  addPage(input, 2, 4, 1, false, {});
+  addPage(input, 1, 4, 1, true, {});
+  auto valid = makeBuffer(4, 2);
+  input.insert(input.end(), valid.begin(), valid.end());
+
+  auto reference = compressSequential(input);
+  auto output = compressParallel(input, 4);
+  BOOST_CHECK_EQUAL(output.size(), reference.size());
+  BOOST_CHECK(output == reference);
+}
+
+BOOST_AUTO_TEST_CASE(ParallelCompressorOverflowFallsBack)
+{
+  // the concatenated output does not fit the declared encoder buffer: the buffer is compressed
+  // again by the sequential compressor instead of being dropped
+  auto input = makeBuffer(8, 8);
+  auto reference = compressSequential(input);
+  BOOST_REQUIRE(reference.size() > 1);
+  for (int nThreads : {1, 4}) {
+    auto output = compressParallel(input, nThreads, reference.size() - 1);
+    BOOST_CHECK_EQUAL(output.size(), reference.size());
+    BOOST_CHECK(output == reference);
+  }
+}
@@ -22,6 +22,7 @@
 #include "Framework/DataProcessorSpec.h"
 #include "TOFReconstruction/DecoderBase.h"
 #include <fstream>
+#include <chrono>
 
 class TFile;
 class TH1;
@@ -58,8 +59,17 @@ class CompressedInspectorTask : public DecoderBaseT<RDH>, public Task
                       const CrateTrailer_t* crateTrailer, const Diagnostic_t* diagnostics,
                       const Error_t* errors) override;
 
+  void throughputReport() const;
+
   bool mStatus = false;
   TFile* mFile = nullptr;
+
+  /** throughput counters **/
+  uint64_t mTimeFrames = 0;
+  uint64_t mInputBytes = 0;
+  double mDecodeTime = 0.;
+  std::chrono::time_point<std::chrono::steady_clock> mFirstTimeFrame;
+  std::chrono::time_point<std::chrono::steady_clock> mLastTimeFrame;
   std::map<std::string, TH1*> mHistos1D;
   std::map<std::string, TH1*> mHistos2D;
 };
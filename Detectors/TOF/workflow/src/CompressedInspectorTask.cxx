@@ -68,9 +68,12 @@ void CompressedInspectorTask<RDH>::init(InitContext& ic)
   mHistos2D["test"] = new TH2F("hTest", ";slot;TDC", 24, 1., 13., 15, 0., 15.);
   mHistos2D["crateBC"] = new TH2F("hCrateBC", ";crate;BC", 72, 0., 72., 4096, 0., 4096.);
   mHistos2D["crateOrbit"] = new TH2F("hCrateOrbit", ";crate;orbit", 72, 0., 72., 4096, 0., 4096.);
+  mHistos1D["tfSize"] = new TH1F("hTFSize", ";TF payload (MB)", 1000, 0., 100.);
+  mHistos1D["throughput"] = new TH1F("hThroughput", ";decoding throughput (MB/s)", 1000, 0., 10000.);
 
   auto finishFunction = [this]() {
     LOG(INFO) << "CompressedInspector finish";
+    throughputReport();
     for (auto& histo : mHistos1D) {
       histo.second->Write();
     }
@@ -93,6 +96,12 @@ void CompressedInspectorTask<RDH>::run(ProcessingContext& pc)
     return;
   }
 
+  auto start = std::chrono::steady_clock::now();
+  if (mTimeFrames == 0) {
+    mFirstTimeFrame = start;
+  }
+  uint64_t tfBytes = 0;
+
   /** loop over inputs routes **/
   for (auto iit = pc.inputs().begin(), iend = pc.inputs().end(); iit != iend; ++iit) {
     if (!iit.isValid()) {
@@ -109,8 +118,42 @@ void CompressedInspectorTask<RDH>::run(ProcessingContext& pc)
       DecoderBaseT<RDH>::setDecoderBuffer(payloadIn);
       DecoderBaseT<RDH>::setDecoderBufferSize(payloadInSize);
       DecoderBaseT<RDH>::run();
+      tfBytes += payloadInSize;
     }
   }
+
+  auto finish = std::chrono::steady_clock::now();
+  double elapsed = std::chrono::duration<double>(finish - start).count();
+  mTimeFrames++;
+  mInputBytes += tfBytes;
+  mDecodeTime += elapsed;
+  mLastTimeFrame = finish;
+  mHistos1D["tfSize"]->Fill(tfBytes / 1.e6);
+  if (elapsed > 0.) {
+    mHistos1D["throughput"]->Fill(tfBytes / 1.e6 / elapsed);
+  }
+}
+
+template <typename RDH>
+void CompressedInspectorTask<RDH>::throughputReport() const
+{
+  /** the decoding throughput measures the inspector itself, the input rate the
+      upstream chain (e.g. the compressor) as seen from here **/
+  if (mTimeFrames == 0) {
+    LOG(INFO) << "CompressedInspector throughput: no data received";
+    return;
+  }
+  double megaBytes = mInputBytes / 1.e6;
+  double wallTime = std::chrono::duration<double>(mLastTimeFrame - mFirstTimeFrame).count();
+  LOG(INFO) << "CompressedInspector throughput: " << mTimeFrames << " TFs, " << megaBytes << " MB, "
+            << megaBytes / mTimeFrames << " MB/TF";
+  if (mDecodeTime > 0.) {
+    LOG(INFO) << "CompressedInspector throughput: decoding " << mDecodeTime << " s, " << megaBytes / mDecodeTime << " MB/s";
+  }
+  if (mTimeFrames > 1 && wallTime > 0.) {
+    LOG(INFO) << "CompressedInspector throughput: input rate " << megaBytes / wallTime << " MB/s, "
+              << (mTimeFrames - 1) / wallTime << " TF/s over " << wallTime << " s";
+  }
 }
 
 template <typename RDH>
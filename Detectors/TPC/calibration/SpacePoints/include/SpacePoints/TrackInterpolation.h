@@ -111,26 +111,48 @@ class TrackInterpolation
     unsigned short clAvailable{0};
   };
 
+  /// Output for a chunk of consecutive input tracks. The cluster residual references of the tracks are relative
+  /// to the chunk, the chunks are merged in the order of the input tracks into the final output
+  struct ChunkOutput {
+    std::vector<TrackData> trackData{};           ///< reference tracks of this chunk
+    std::vector<TPCClusterResiduals> clRes{};     ///< cluster residuals of this chunk
+    std::vector<unsigned int> tracksDone{};       ///< indices of the ITS-TPC matched tracks processed successfully
+  };
+
+  /// Working area owned by each processing thread
+  struct ThreadData {
+    const o2::base::Propagator* propagator{nullptr};                 ///< propagator used by this thread
+    std::array<CacheStruct, constants::MAXGLOBALPADROW> cache{{}}; ///< caching positions, covariances and angles for track extrapolations and interpolation
+  };
+
   // -------------------------------------- processing functions --------------------------------------------------
 
   /// Initialize everything
   void init();
 
   /// Main processing function
+  /// The tracks are processed in chunks of mChunkSize tracks distributed over mNThreads threads. The output does
+  /// not depend on the number of threads.
   void process();
 
   /// Extrapolate ITS-only track through TPC and store residuals to TPC clusters along the way
+  /// The track data entry to be filled has to be added to output.trackData beforehand
   /// \param trkITS ITS only track to be extrapolated
   /// \param trkTPC TPC track matched to trkITS used for TPC cluster access
   /// \param trkTime time assigned to TPC track (needed for cluster coordinate transformation)
   /// \param trkIdTPC TPC track ID
+  /// \param thread working area of the calling thread
+  /// \param output output of the chunk the track belongs to
   /// \return flag if track could successfully be extrapolated to all TPC clusters
-  bool extrapolateTrackITS(const o2::its::TrackITS& trkITS, const TrackTPC& trkTPC, float trkTime, int trkIdTPC);
+  bool extrapolateTrackITS(const o2::its::TrackITS& trkITS, const TrackTPC& trkTPC, float trkTime, int trkIdTPC, ThreadData& thread, ChunkOutput& output) const;
 
   /// Interpolate ITS-TPC-TOF tracks in the TPC and store residuals to TPC clusters
+  /// The track data entry to be filled has to be added to output.trackData beforehand
   /// \param matchTOF
+  /// \param thread working area of the calling thread
+  /// \param output output of the chunk the track belongs to
   /// \return flag if track could be processed successfully
-  bool interpolateTrackITSTOF(const o2::dataformats::MatchInfoTOF& matchTOF);
+  bool interpolateTrackITSTOF(const o2::dataformats::MatchInfoTOF& matchTOF, ThreadData& thread, ChunkOutput& output) const;
 
   /// Check if given ITS-TPC track fullfills quality criteria
   /// \param matchITSTPC ITS-TPC track to be checked
@@ -152,6 +174,12 @@ class TrackInterpolation
   void setMatCorr(MatCorrType matCorr) { mMatCorr = matCorr; }
   /// Sets whether ITS tracks without match in TRD or TOF should be processed as well
   void setDoITSOnlyTracks(bool flag) { mDoITSOnlyTracks = flag; }
+  /// Sets the number of threads used for the processing
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+  /// Sets the number of tracks per chunk processed by a thread at once
+  void setChunkSize(size_t n) { mChunkSize = n > 0 ? n : 1; }
+  size_t getChunkSize() const { return mChunkSize; }
 
   // --------------------------------- input ---------------------------------------------
 
@@ -175,6 +203,13 @@ class TrackInterpolation
   std::vector<TrackData>& getReferenceTracks() { return mTrackData; }
 
  private:
+  /// Processes nTracks input tracks in chunks, calling processTrack(iTrack, thread, output) for each of them
+  template <typename F>
+  void processChunks(size_t nTracks, std::vector<ChunkOutput>& chunks, F&& processTrack) const;
+
+  /// Appends the output of the chunks to mTrackData and mClRes, shifting the cluster residual references
+  void mergeChunks(std::vector<ChunkOutput>& chunks);
+
   // parameters + settings
   float mTPCTimeBinMUS{.2f}; ///< TPC time bin duration in us
   float mSigYZ2TOF{.75f};    ///< for now assume cluster error for TOF equal for all clusters in both Y and Z
@@ -182,6 +217,8 @@ class TrackInterpolation
   float mMaxStep{2.f};          ///< maximum step for propagation
   MatCorrType mMatCorr{MatCorrType::USEMatCorrNONE}; ///< if material correction should be done
   bool mDoITSOnlyTracks{false}; ///< if ITS only tracks should be processed or not
+  int mNThreads{1};             ///< number of processing threads
+  size_t mChunkSize{50};        ///< number of tracks processed by a thread at once
 
   // input
   gsl::span<const o2::dataformats::TrackTPCITS> mITSTPCTracksArray; ///< input ITS-TPC matched tracks from span
@@ -197,9 +234,6 @@ class TrackInterpolation
   std::vector<TrackData> mTrackData{};                  ///< this vector is used to store the track quality information on a per track basis
   std::vector<TPCClusterResiduals> mClRes{};            ///< residuals for each available TPC cluster of all tracks
 
-  // cache
-  std::array<CacheStruct, constants::MAXGLOBALPADROW> mCache{{}}; ///< caching positions, covariances and angles for track extrapolations and interpolation
-
   // helpers
   std::unique_ptr<TPCFastTransform> mFastTransform{}; ///< TPC cluster transformation
   bool mInitDone{false};                              ///< initialization done flag
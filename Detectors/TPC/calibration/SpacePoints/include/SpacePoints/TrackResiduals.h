@@ -25,6 +25,7 @@
 #include <array>
 #include <bitset>
 #include <string>
+#include <fstream>
 #include <Rtypes.h>
 
 #include "DataFormatsTPC/Defs.h"
@@ -76,6 +77,10 @@ class TrackResiduals
   enum class KernelType { Epanechnikov,
                           Gaussian };
 
+  /// Storage of the local residuals per sector
+  enum class LocalResFormat { Tree,    ///< one ROOT tree per sector (also the format of the AliRoot compact trees)
+                              Binary }; ///< flat file per sector with consecutive LocalResid structures, streamed without ROOT
+
   /// Structure which gets filled with the results for each voxel
   struct VoxRes {
     std::array<float, ResDim> D{};            ///< values of extracted distortions
@@ -141,7 +146,16 @@ class TrackResiduals
 
   // -------------------------------------- settings --------------------------------------------------
   /// Sets a flag to print the memory usage at certain points in the program for performance studies.
+  /// The memory used by the buffers of each sector is reported as well.
   void setPrintMemoryUsage() { mPrintMem = true; }
+  /// Sets the number of threads used to process the sectors, or the voxels of a single sector
+  /// (only with OpenMP support).
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+  /// Sets the storage of the local residuals which are written by the conversion methods and read by the processing.
+  /// Sectors stored in ROOT trees can only be read in parallel with ROOT thread safety enabled.
+  void setLocalResFormat(LocalResFormat format) { mLocalResFormat = format; }
+  LocalResFormat getLocalResFormat() const { return mLocalResFormat; }
   /// Sets the kernel type used for smoothing.
   /// \param kernel Kernel type (Epanechnikov / Gaussian)
   /// \param bwX Bin width in X
@@ -166,7 +180,7 @@ class TrackResiduals
   /// Create output files for each sector with trees for local residuals
   void prepareLocalResidualTrees();
 
-  /// Write trees with local residuals to file
+  /// Write trees with local residuals to file (or close the binary files)
   void writeLocalResidualTreesToFile();
 
   /// Loads residual data from track interpolation and fills voxel data structures local residuals
@@ -179,6 +193,16 @@ class TrackResiduals
   /// \param iSec Sector to process
   void processSectorResiduals(Int_t iSec);
 
+  /// Reads the local residuals of given sector, in the format defined by mLocalResFormat.
+  /// Only points with accepted track inclination are kept, at most mMaxPointsPerSector points are read.
+  /// \param iSec Sector to read
+  /// \param dy Vector filled with the residuals in y
+  /// \param dz Vector filled with the residuals in z
+  /// \param tg Vector filled with tan(phi) of the tracks
+  /// \param bins Vector filled with the global voxel bin numbers
+  /// \return false if the input is not available
+  bool readLocalResiduals(int iSec, std::vector<float>& dy, std::vector<float>& dz, std::vector<float>& tg, std::vector<unsigned short>& bins) const;
+
   /// Performs the robust linear fit for one voxel to estimate the distortions in X, Y and Z and their errors.
   /// \param dy Vector with residuals in y
   /// \param dz Vector with residuals in z
@@ -360,6 +384,11 @@ class TrackResiduals
   /// \return Ignore flag
   bool getXBinIgnored(int iSec, int bin) const { return mXBinsIgnore[iSec].test(bin); }
 
+  /// Results of the processing of the residuals of a sector
+  /// \param iSec Sector number
+  /// \return Results for each voxel of the sector
+  const std::vector<VoxRes>& getVoxelResults(int iSec) const { return mVoxelResults[iSec]; }
+
   /// Calculates the bin indices of the closest voxel.
   /// \param x Coordinate in X
   /// \param y2x Coordinate in Y/X
@@ -485,6 +514,9 @@ class TrackResiduals
   /// Prints the current memory usage
   void printMem() const;
 
+  /// Prints the memory used by the buffers for the residuals of one sector
+  void printSectorMem(int iSec, size_t nPoints) const;
+
   /// Dumps the content of a vector to the specified file
   /// \param vec Data vector
   /// \param fName Filename
@@ -510,6 +542,12 @@ class TrackResiduals
   void closeOutputFile();
 
  private:
+  /// Processes residuals for given sector without dumping the results, returns false if the sector was not processed
+  bool extractSectorResiduals(int iSec);
+
+  /// Stores mLocalResid for given sector in the local residuals tree or binary file
+  void fillLocalResidual(int iSec);
+
   // names of input files / trees
   std::string mInputFileNameResiduals{"residuals_tpc.root"}; ///< name of file with track residuals
   // some constants
@@ -533,6 +571,7 @@ class TrackResiduals
   // status flags
   bool mIsInitialized{}; ///< initialize only once
   bool mPrintMem{};      ///< turn on to print memory usage at certain points
+  int mNThreads{1};      ///< number of threads for the processing of the residuals
   // binning
   int mNXBins{param::NPadRows};            ///< number of bins in radial direction
   int mNY2XBins{param::NY2XBins};          ///< number of y/x bins per sector
@@ -554,10 +593,12 @@ class TrackResiduals
   float mMaxZ2X{1.f};                      ///< max z/x value
   std::array<bool, VoxDim> mUniformBins{true, true, true}; ///< if binning is uniform for each dimension
   // local residual data, extracted from track interpolation
-  std::array<std::unique_ptr<TFile>, SECTORSPERSIDE * SIDES> mTmpFile{}; ///< I/O file
-  std::array<std::unique_ptr<TTree>, SECTORSPERSIDE * SIDES> mTmpTree{}; ///< I/O tree per sector
-  LocalResid mLocalResid{};                                              ///< data exchange structure for filling mTmpTree
-  LocalResid* mLocalResidPtr{&mLocalResid};                              ///< pointer to mLocalResid
+  std::array<std::unique_ptr<TFile>, SECTORSPERSIDE * SIDES> mTmpFile{};            ///< I/O file
+  std::array<std::unique_ptr<TTree>, SECTORSPERSIDE * SIDES> mTmpTree{};            ///< I/O tree per sector
+  std::array<std::unique_ptr<std::ofstream>, SECTORSPERSIDE * SIDES> mTmpBinFile{}; //!< output binary file per sector
+  LocalResFormat mLocalResFormat{LocalResFormat::Tree};                             ///< storage of the local residuals
+  LocalResid mLocalResid{};                                                         ///< data exchange structure for filling mTmpTree
+  LocalResid* mLocalResidPtr{&mLocalResid};                                         ///< pointer to mLocalResid
   // settings
   std::string mLocalResFileName{"deltasSect"};   ///< filename for local residuals input
   std::string mLocalResTreeName{"treeSec"};      ///< name for tree with local residuals
@@ -584,7 +625,6 @@ class TrackResiduals
   std::array<int, VoxDim> mStepKern{};                             ///< N bins to consider with given kernel settings
   std::array<float, VoxDim> mKernelScaleEdge{};                    ///< optional scaling factors for kernel width on the edge
   std::array<float, VoxDim> mKernelWInv{};                         ///< inverse kernel width in bins
-  std::array<double, ResDim * sMaxSmtDim> mLastSmoothingRes{};     ///< results of last smoothing operation
   // (intermediate) results
   std::array<std::bitset<param::NPadRows>, SECTORSPERSIDE * SIDES> mXBinsIgnore{};          ///< flags which X bins to ignore
   std::array<std::array<float, param::NPadRows>, SECTORSPERSIDE * SIDES> mValidFracXBins{}; ///< for each sector for each X-bin the fraction of validated voxels
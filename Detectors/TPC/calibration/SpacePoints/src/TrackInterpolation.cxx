@@ -22,7 +22,7 @@
 #include "ReconstructionDataFormats/GlobalTrackID.h"
 
 #include <fairlogger/Logger.h>
-#include <set>
+#include <algorithm>
 
 using namespace o2::tpc;
 
@@ -60,62 +60,124 @@ void TrackInterpolation::process()
   return;
 #endif
 
-  std::set<unsigned int> tracksDone; // to store indices of ITS-TPC matched tracks that have been processed
-
   LOG(INFO) << "Processing " << mTOFMatchesArray.size() << " ITS-TPC-TOF matched tracks out of "
-            << mITSTPCTracksArray.size() << " ITS-TPC matched tracks";
-
-  // TODO reserve only a fraction of the needed space for all tracks? How many tracks pass on average the quality cuts with how many TPC clusters?
-  mTrackData.reserve(mTOFMatchesArray.size());
-  mClRes.reserve(mTOFMatchesArray.size() * param::NPadRows);
+            << mITSTPCTracksArray.size() << " ITS-TPC matched tracks with " << mNThreads << " threads";
 
   int nTracksTPC = mTPCTracksArray.size();
+  std::vector<ChunkOutput> chunks;
 
-  for (const auto& trkTOF : mTOFMatchesArray) {
+  processChunks(mTOFMatchesArray.size(), chunks, [this, nTracksTPC](size_t iTrk, ThreadData& thread, ChunkOutput& output) {
     // process ITS-TPC-TOF matched tracks
+    const auto& trkTOF = mTOFMatchesArray[iTrk];
     if (!trackPassesQualityCuts(mITSTPCTracksArray[trkTOF.getTrackIndex()])) {
       LOG(DEBUG) << "Abandoning track due to bad quality";
-      continue;
+      return;
     }
-    mTrackData.emplace_back();
-    if (!interpolateTrackITSTOF(trkTOF)) {
+    output.trackData.emplace_back();
+    if (!interpolateTrackITSTOF(trkTOF, thread, output)) {
       LOG(DEBUG) << "Failed to interpolate ITS-TOF track";
-      mTrackData.pop_back();
-      continue;
+      output.trackData.pop_back();
+      return;
+    }
+    output.trackData.back().nTracksInEvent = nTracksTPC;
+    output.tracksDone.push_back(trkTOF.getTrackIndex());
+  });
+
+  std::vector<bool> tracksDone(mITSTPCTracksArray.size(), false); // flags of ITS-TPC matched tracks that have been processed
+  size_t nTracksDoneTOF = 0;
+  for (const auto& chunk : chunks) {
+    for (auto iTrk : chunk.tracksDone) {
+      if (!tracksDone[iTrk]) {
+        tracksDone[iTrk] = true;
+        ++nTracksDoneTOF;
+      }
     }
-    mTrackData.back().nTracksInEvent = nTracksTPC;
-    tracksDone.insert(trkTOF.getTrackIndex());
   }
+  mergeChunks(chunks);
 
-  LOG(INFO) << "Could process " << tracksDone.size() << " ITS-TPC-TOF matched tracks successfully";
+  LOG(INFO) << "Could process " << nTracksDoneTOF << " ITS-TPC-TOF matched tracks successfully";
 
   if (mDoITSOnlyTracks) {
-    size_t nTracksDoneITS = 0;
-    size_t nTracksSkipped = 0;
-    for (std::size_t iTrk = 0; iTrk < mITSTPCTracksArray.size(); ++iTrk) {
+    processChunks(mITSTPCTracksArray.size(), chunks, [this, nTracksTPC, &tracksDone](size_t iTrk, ThreadData& thread, ChunkOutput& output) {
       // process ITS-TPC matched tracks that were not matched to TOF
-      if (tracksDone.find(iTrk) != tracksDone.end()) {
+      if (tracksDone[iTrk]) {
         // track also has a matching cluster in TOF and has already been processed
-        ++nTracksSkipped;
-        continue;
+        return;
       }
       const auto& trk = mITSTPCTracksArray[iTrk];
       if (!trackPassesQualityCuts(trk, false)) {
-        continue;
+        return;
       }
-      mTrackData.emplace_back();
+      output.trackData.emplace_back();
       const auto& trkTPC = mTPCTracksArray[trk.getRefTPC()];
       const auto& trkITS = mITSTracksArray[trk.getRefITS()];
-      if (!extrapolateTrackITS(trkITS, trkTPC, trk.getTimeMUS().getTimeStamp(), trk.getRefTPC())) {
-        mTrackData.pop_back();
-        continue;
+      if (!extrapolateTrackITS(trkITS, trkTPC, trk.getTimeMUS().getTimeStamp(), trk.getRefTPC(), thread, output)) {
+        output.trackData.pop_back();
+        return;
       }
-      mTrackData.back().nTracksInEvent = nTracksTPC;
-      ++nTracksDoneITS;
+      output.trackData.back().nTracksInEvent = nTracksTPC;
+    });
+    size_t nTracksDoneITS = 0;
+    for (const auto& chunk : chunks) {
+      nTracksDoneITS += chunk.trackData.size();
     }
+    mergeChunks(chunks);
     LOG(INFO) << "Could process " << nTracksDoneITS << " ITS-TPC matched tracks successfully";
-    LOG(INFO) << "Skipped " << nTracksSkipped << " tracks, as they were successfully propagated to TOF";
+    LOG(INFO) << "Skipped " << nTracksDoneTOF << " tracks, as they were successfully propagated to TOF";
+  }
+}
+
+template <typename F>
+void TrackInterpolation::processChunks(size_t nTracks, std::vector<ChunkOutput>& chunks, F&& processTrack) const
+{
+  // each thread works with its own propagator reference and extrapolation cache on the chunks it picks up,
+  // the chunks themselves do not depend on the number of threads
+  const size_t nChunks = (nTracks + mChunkSize - 1) / mChunkSize;
+  chunks.clear();
+  chunks.resize(nChunks);
+  const auto propagator = o2::base::Propagator::Instance();
+#ifdef WITH_OPENMP
+  const int nThreads = std::max(1, static_cast<int>(std::min(static_cast<size_t>(mNThreads), nChunks)));
+#pragma omp parallel num_threads(nThreads)
+#endif
+  {
+    ThreadData thread;
+    thread.propagator = propagator;
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (size_t iChunk = 0; iChunk < nChunks; ++iChunk) {
+      auto& output = chunks[iChunk];
+      const size_t first = iChunk * mChunkSize;
+      const size_t last = std::min(nTracks, first + mChunkSize);
+      // TODO reserve only a fraction of the needed space for all tracks? How many tracks pass on average the quality cuts with how many TPC clusters?
+      output.trackData.reserve(last - first);
+      output.clRes.reserve((last - first) * param::NPadRows);
+      for (size_t iTrk = first; iTrk < last; ++iTrk) {
+        processTrack(iTrk, thread, output);
+      }
+    }
+  }
+}
+
+void TrackInterpolation::mergeChunks(std::vector<ChunkOutput>& chunks)
+{
+  size_t nTracks = mTrackData.size(), nClRes = mClRes.size();
+  for (const auto& chunk : chunks) {
+    nTracks += chunk.trackData.size();
+    nClRes += chunk.clRes.size();
+  }
+  mTrackData.reserve(nTracks);
+  mClRes.reserve(nClRes);
+  for (auto& chunk : chunks) {
+    const int offset = mClRes.size();
+    for (auto& trk : chunk.trackData) {
+      trk.clIdx.setFirstEntry(trk.clIdx.getFirstEntry() + offset);
+      mTrackData.push_back(trk);
+    }
+    mClRes.insert(mClRes.end(), chunk.clRes.begin(), chunk.clRes.end());
   }
+  chunks.clear();
 }
 
 bool TrackInterpolation::trackPassesQualityCuts(const o2::dataformats::TrackTPCITS& matchITSTPC, bool hasOuterPoint) const
@@ -149,11 +211,11 @@ bool TrackInterpolation::trackPassesQualityCuts(const o2::dataformats::TrackTPCI
   return true;
 }
 
-bool TrackInterpolation::interpolateTrackITSTOF(const o2::dataformats::MatchInfoTOF& matchTOF)
+bool TrackInterpolation::interpolateTrackITSTOF(const o2::dataformats::MatchInfoTOF& matchTOF, ThreadData& thread, ChunkOutput& output) const
 {
   // get TPC cluster residuals to ITS-TOF only tracks
-  size_t trkIdx = mTrackData.size() - 1;
-  auto propagator = o2::base::Propagator::Instance();
+  size_t trkIdx = output.trackData.size() - 1;
+  const auto propagator = thread.propagator;
   const auto& matchITSTPC = mITSTPCTracksArray[matchTOF.getTrackIndex()];
   const auto& clTOF = mTOFClustersArray[matchTOF.getTOFClIndex()];
   //const int clTOFSec = (TMath::ATan2(-clTOF.getY(), -clTOF.getX()) + o2::constants::math::PI) * o2::constants::math::Rad2Deg * 0.05; // taken from TOF cluster class as there is no const getter for the sector
@@ -163,10 +225,10 @@ bool TrackInterpolation::interpolateTrackITSTOF(const o2::dataformats::MatchInfo
   const auto& trkITS = mITSTracksArray[matchITSTPC.getRefITS()];
   auto trkWork = trkITS.getParamOut();
   // reset the cache array (sufficient to set )
-  for (auto& elem : mCache) {
+  for (auto& elem : thread.cache) {
     elem.clAvailable = 0;
   }
-  mTrackData[trkIdx].clIdx.setFirstEntry(mClRes.size()); // reference the first cluster residual belonging to this track
+  output.trackData[trkIdx].clIdx.setFirstEntry(output.clRes.size()); // reference the first cluster residual belonging to this track
   //printf("=== New Track with pt = %.3f, nClsTPC = %i ===\n", trkWork.getQ2Pt(), trkTPC.getNClusterReferences());
 
   // store the TPC cluster positions in the cache
@@ -179,18 +241,18 @@ bool TrackInterpolation::interpolateTrackITSTOF(const o2::dataformats::MatchInfo
     std::array<float, 2> clTPCYZ;
     mFastTransform->TransformIdeal(sector, row, clTPC.getPad(), clTPC.getTime(), clTPCX, clTPCYZ[0], clTPCYZ[1], clusterTimeBinOffset);
     sector %= SECTORSPERSIDE;
-    mCache[row].clAvailable = 1;
-    mCache[row].clY = clTPCYZ[0];
-    mCache[row].clZ = clTPCYZ[1];
-    mCache[row].clAngle = o2::math_utils::sector2Angle(sector);
+    thread.cache[row].clAvailable = 1;
+    thread.cache[row].clY = clTPCYZ[0];
+    thread.cache[row].clZ = clTPCYZ[1];
+    thread.cache[row].clAngle = o2::math_utils::sector2Angle(sector);
   }
 
   // first extrapolate through TPC and store track position at each pad row
   for (int iRow = 0; iRow < param::NPadRows; ++iRow) {
-    if (!mCache[iRow].clAvailable) {
+    if (!thread.cache[iRow].clAvailable) {
       continue;
     }
-    if (!trkWork.rotate(mCache[iRow].clAngle)) {
+    if (!trkWork.rotate(thread.cache[iRow].clAngle)) {
       LOG(DEBUG) << "Failed to rotate track during first extrapolation";
       return false;
     }
@@ -198,13 +260,13 @@ bool TrackInterpolation::interpolateTrackITSTOF(const o2::dataformats::MatchInfo
       LOG(DEBUG) << "Failed on first extrapolation";
       return false;
     }
-    mCache[iRow].y[ExtOut] = trkWork.getY();
-    mCache[iRow].z[ExtOut] = trkWork.getZ();
-    mCache[iRow].sy2[ExtOut] = trkWork.getSigmaY2();
-    mCache[iRow].szy[ExtOut] = trkWork.getSigmaZY();
-    mCache[iRow].sz2[ExtOut] = trkWork.getSigmaZ2();
-    mCache[iRow].phi[ExtOut] = trkWork.getSnp();
-    mCache[iRow].tgl[ExtOut] = trkWork.getTgl();
+    thread.cache[iRow].y[ExtOut] = trkWork.getY();
+    thread.cache[iRow].z[ExtOut] = trkWork.getZ();
+    thread.cache[iRow].sy2[ExtOut] = trkWork.getSigmaY2();
+    thread.cache[iRow].szy[ExtOut] = trkWork.getSigmaZY();
+    thread.cache[iRow].sz2[ExtOut] = trkWork.getSigmaZ2();
+    thread.cache[iRow].phi[ExtOut] = trkWork.getSnp();
+    thread.cache[iRow].tgl[ExtOut] = trkWork.getTgl();
     //printf("Track alpha at row %i: %.2f, Y(%.2f), Z(%.2f)\n", iRow, trkWork.getAlpha(), trkWork.getY(), trkWork.getZ());
   }
 
@@ -231,10 +293,10 @@ bool TrackInterpolation::interpolateTrackITSTOF(const o2::dataformats::MatchInfo
 
   // go back through the TPC and store updated track positions
   for (int iRow = param::NPadRows; iRow--;) {
-    if (!mCache[iRow].clAvailable) {
+    if (!thread.cache[iRow].clAvailable) {
       continue;
     }
-    if (!trkWork.rotate(mCache[iRow].clAngle)) {
+    if (!trkWork.rotate(thread.cache[iRow].clAngle)) {
       LOG(DEBUG) << "Failed to rotate track during back propagation";
       return false;
     }
@@ -243,69 +305,69 @@ bool TrackInterpolation::interpolateTrackITSTOF(const o2::dataformats::MatchInfo
       //printf("trkX(%.2f), clX(%.2f), clY(%.2f), clZ(%.2f), alphaTOF(%.2f)\n", trkWork.getX(), param::RowX[iRow], clTOFYZ[0], clTOFYZ[1], clTOFAlpha);
       return false;
     }
-    mCache[iRow].y[ExtIn] = trkWork.getY();
-    mCache[iRow].z[ExtIn] = trkWork.getZ();
-    mCache[iRow].sy2[ExtIn] = trkWork.getSigmaY2();
-    mCache[iRow].szy[ExtIn] = trkWork.getSigmaZY();
-    mCache[iRow].sz2[ExtIn] = trkWork.getSigmaZ2();
-    mCache[iRow].phi[ExtIn] = trkWork.getSnp();
-    mCache[iRow].tgl[ExtIn] = trkWork.getTgl();
+    thread.cache[iRow].y[ExtIn] = trkWork.getY();
+    thread.cache[iRow].z[ExtIn] = trkWork.getZ();
+    thread.cache[iRow].sy2[ExtIn] = trkWork.getSigmaY2();
+    thread.cache[iRow].szy[ExtIn] = trkWork.getSigmaZY();
+    thread.cache[iRow].sz2[ExtIn] = trkWork.getSigmaZ2();
+    thread.cache[iRow].phi[ExtIn] = trkWork.getSnp();
+    thread.cache[iRow].tgl[ExtIn] = trkWork.getTgl();
   }
 
   // calculate weighted mean at each pad row (assume for now y and z are uncorrelated) and store residuals to TPC clusters
   unsigned short deltaRow = 0;
   unsigned short nMeasurements = 0;
   for (int iRow = 0; iRow < param::NPadRows; ++iRow) {
-    if (!mCache[iRow].clAvailable) {
+    if (!thread.cache[iRow].clAvailable) {
       ++deltaRow;
       continue;
     }
-    float wTotY = 1.f / mCache[iRow].sy2[ExtOut] + 1.f / mCache[iRow].sy2[ExtIn];
-    float wTotZ = 1.f / mCache[iRow].sz2[ExtOut] + 1.f / mCache[iRow].sz2[ExtIn];
-    mCache[iRow].y[Int] = (mCache[iRow].y[ExtOut] / mCache[iRow].sy2[ExtOut] + mCache[iRow].y[ExtIn] / mCache[iRow].sy2[ExtIn]) / wTotY;
-    mCache[iRow].z[Int] = (mCache[iRow].z[ExtOut] / mCache[iRow].sz2[ExtOut] + mCache[iRow].z[ExtIn] / mCache[iRow].sz2[ExtIn]) / wTotZ;
+    float wTotY = 1.f / thread.cache[iRow].sy2[ExtOut] + 1.f / thread.cache[iRow].sy2[ExtIn];
+    float wTotZ = 1.f / thread.cache[iRow].sz2[ExtOut] + 1.f / thread.cache[iRow].sz2[ExtIn];
+    thread.cache[iRow].y[Int] = (thread.cache[iRow].y[ExtOut] / thread.cache[iRow].sy2[ExtOut] + thread.cache[iRow].y[ExtIn] / thread.cache[iRow].sy2[ExtIn]) / wTotY;
+    thread.cache[iRow].z[Int] = (thread.cache[iRow].z[ExtOut] / thread.cache[iRow].sz2[ExtOut] + thread.cache[iRow].z[ExtIn] / thread.cache[iRow].sz2[ExtIn]) / wTotZ;
 
     // simple average w/o weighting for angles
-    mCache[iRow].phi[Int] = (mCache[iRow].phi[ExtOut] + mCache[iRow].phi[ExtIn]) / 2.f;
-    mCache[iRow].tgl[Int] = (mCache[iRow].tgl[ExtOut] + mCache[iRow].tgl[ExtIn]) / 2.f;
+    thread.cache[iRow].phi[Int] = (thread.cache[iRow].phi[ExtOut] + thread.cache[iRow].phi[ExtIn]) / 2.f;
+    thread.cache[iRow].tgl[Int] = (thread.cache[iRow].tgl[ExtOut] + thread.cache[iRow].tgl[ExtIn]) / 2.f;
 
     TPCClusterResiduals res;
-    res.setDY(mCache[iRow].clY - mCache[iRow].y[Int]);
-    res.setDZ(mCache[iRow].clZ - mCache[iRow].z[Int]);
-    res.setY(mCache[iRow].y[Int]);
-    res.setZ(mCache[iRow].z[Int]);
-    res.setPhi(mCache[iRow].phi[Int]);
-    res.setTgl(mCache[iRow].tgl[Int]);
-    res.sec = o2::math_utils::angle2Sector(mCache[iRow].clAngle);
+    res.setDY(thread.cache[iRow].clY - thread.cache[iRow].y[Int]);
+    res.setDZ(thread.cache[iRow].clZ - thread.cache[iRow].z[Int]);
+    res.setY(thread.cache[iRow].y[Int]);
+    res.setZ(thread.cache[iRow].z[Int]);
+    res.setPhi(thread.cache[iRow].phi[Int]);
+    res.setTgl(thread.cache[iRow].tgl[Int]);
+    res.sec = o2::math_utils::angle2Sector(thread.cache[iRow].clAngle);
     res.dRow = deltaRow;
     res.row = iRow;
-    mClRes.push_back(std::move(res));
+    output.clRes.push_back(std::move(res));
     ++nMeasurements;
     deltaRow = 1;
   }
 
-  mTrackData[trkIdx].trkId = matchITSTPC.getRefTPC();
-  mTrackData[trkIdx].eta = trkTPC.getEta();
-  mTrackData[trkIdx].phi = trkTPC.getSnp();
-  mTrackData[trkIdx].qPt = trkTPC.getQ2Pt();
-  mTrackData[trkIdx].chi2TPC = trkTPC.getChi2();
-  mTrackData[trkIdx].chi2ITS = trkITS.getChi2();
-  mTrackData[trkIdx].nClsTPC = trkTPC.getNClusterReferences();
-  mTrackData[trkIdx].nClsITS = trkITS.getNumberOfClusters();
-  mTrackData[trkIdx].clIdx.setEntries(nMeasurements);
+  output.trackData[trkIdx].trkId = matchITSTPC.getRefTPC();
+  output.trackData[trkIdx].eta = trkTPC.getEta();
+  output.trackData[trkIdx].phi = trkTPC.getSnp();
+  output.trackData[trkIdx].qPt = trkTPC.getQ2Pt();
+  output.trackData[trkIdx].chi2TPC = trkTPC.getChi2();
+  output.trackData[trkIdx].chi2ITS = trkITS.getChi2();
+  output.trackData[trkIdx].nClsTPC = trkTPC.getNClusterReferences();
+  output.trackData[trkIdx].nClsITS = trkITS.getNumberOfClusters();
+  output.trackData[trkIdx].clIdx.setEntries(nMeasurements);
 
   LOG(DEBUG) << "Track interpolation successfull";
   return true;
 }
 
-bool TrackInterpolation::extrapolateTrackITS(const o2::its::TrackITS& trkITS, const TrackTPC& trkTPC, float trkTime, int trkIdTPC)
+bool TrackInterpolation::extrapolateTrackITS(const o2::its::TrackITS& trkITS, const TrackTPC& trkTPC, float trkTime, int trkIdTPC, ThreadData& thread, ChunkOutput& output) const
 {
   // extrapolate ITS-only track through TPC and store residuals to TPC clusters in the output vectors
-  size_t trkIdx = mTrackData.size() - 1;
-  mTrackData[trkIdx].clIdx.setFirstEntry(mClRes.size());
+  size_t trkIdx = output.trackData.size() - 1;
+  output.trackData[trkIdx].clIdx.setFirstEntry(output.clRes.size());
   auto trk = trkITS.getParamOut();
   float clusterTimeBinOffset = trkTime / mTPCTimeBinMUS;
-  auto propagator = o2::base::Propagator::Instance();
+  const auto propagator = thread.propagator;
   unsigned short rowPrev = 0;
   unsigned short nMeasurements = 0;
   for (int iCl = trkTPC.getNClusterReferences(); iCl--;) {
@@ -331,18 +393,18 @@ bool TrackInterpolation::extrapolateTrackITS(const o2::its::TrackITS& trkITS, co
     res.dRow = row - rowPrev;
     res.row = row;
     rowPrev = row;
-    mClRes.push_back(std::move(res));
+    output.clRes.push_back(std::move(res));
     ++nMeasurements;
   }
-  mTrackData[trkIdx].trkId = trkIdTPC;
-  mTrackData[trkIdx].eta = trkTPC.getEta();
-  mTrackData[trkIdx].phi = trkTPC.getSnp();
-  mTrackData[trkIdx].qPt = trkTPC.getQ2Pt();
-  mTrackData[trkIdx].chi2TPC = trkTPC.getChi2();
-  mTrackData[trkIdx].chi2ITS = trkITS.getChi2();
-  mTrackData[trkIdx].nClsTPC = trkTPC.getNClusterReferences();
-  mTrackData[trkIdx].nClsITS = trkITS.getNumberOfClusters();
-  mTrackData[trkIdx].clIdx.setEntries(nMeasurements);
+  output.trackData[trkIdx].trkId = trkIdTPC;
+  output.trackData[trkIdx].eta = trkTPC.getEta();
+  output.trackData[trkIdx].phi = trkTPC.getSnp();
+  output.trackData[trkIdx].qPt = trkTPC.getQ2Pt();
+  output.trackData[trkIdx].chi2TPC = trkTPC.getChi2();
+  output.trackData[trkIdx].chi2ITS = trkITS.getChi2();
+  output.trackData[trkIdx].nClsTPC = trkTPC.getNClusterReferences();
+  output.trackData[trkIdx].nClsITS = trkITS.getNumberOfClusters();
+  output.trackData[trkIdx].clIdx.setEntries(nMeasurements);
 
   return true;
 }
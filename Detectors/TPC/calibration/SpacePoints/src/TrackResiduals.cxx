@@ -24,10 +24,16 @@
 #include "TMatrixDSym.h"
 #include "TDecompChol.h"
 #include "TVectorD.h"
+#include "TROOT.h"
 
 #include <cmath>
 #include <cstring>
 #include <algorithm>
+#include <mutex>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 // for debugging
 #include "TStopwatch.h"
@@ -533,7 +539,7 @@ void TrackResiduals::fillLocalResidualsTrees()
     mLocalResid.dz = static_cast<short>(mArrDZ[iCl] * 0x7fff / param::MaxResid);
     mLocalResid.tgSlp = static_cast<short>(mArrTgSlp[iCl] * 0x7fff / param::MaxTgSlp);
     // fill tree
-    mTmpTree[secId]->Fill();
+    fillLocalResidual(secId);
     // TODO: fill statistics distribution within the voxel
   }
 }
@@ -693,6 +699,10 @@ void TrackResiduals::prepareLocalResidualTrees()
 {
   // prepare tree structure
   for (int iSec = 0; iSec < SECTORSPERSIDE * SIDES; ++iSec) {
+    if (mLocalResFormat == LocalResFormat::Binary) {
+      mTmpBinFile[iSec] = std::make_unique<std::ofstream>(mLocalResFileName + std::to_string(iSec) + ".bin", std::ios::binary | std::ios::trunc);
+      continue;
+    }
     mTmpFile[iSec] = std::make_unique<TFile>(Form("%s%d.root", mLocalResFileName.c_str(), iSec), "recreate");
     mTmpTree[iSec] = std::make_unique<TTree>(Form("%s%d", mLocalResTreeName.c_str(), iSec), "TPC local residuals");
     mTmpTree[iSec]->Branch(mLocalResBranchName.c_str(), &mLocalResidPtr);
@@ -703,6 +713,10 @@ void TrackResiduals::writeLocalResidualTreesToFile()
 {
   // write trees with local residuals to file
   for (int iSec = 0; iSec < SECTORSPERSIDE * SIDES; ++iSec) {
+    if (mTmpBinFile[iSec]) {
+      mTmpBinFile[iSec]->close();
+      mTmpBinFile[iSec].reset();
+    }
     if (!mTmpFile[iSec]) {
       continue;
     }
@@ -714,6 +728,15 @@ void TrackResiduals::writeLocalResidualTreesToFile()
   }
 }
 
+void TrackResiduals::fillLocalResidual(int iSec)
+{
+  if (mTmpBinFile[iSec]) {
+    mTmpBinFile[iSec]->write(reinterpret_cast<const char*>(&mLocalResid), sizeof(LocalResid));
+  } else {
+    mTmpTree[iSec]->Fill();
+  }
+}
+
 void TrackResiduals::convertToLocalResiduals()
 {
   // When using data generated with o2 without distortions the residuals can easily be converted
@@ -763,7 +786,7 @@ void TrackResiduals::convertToLocalResiduals()
       mLocalResid.dz = mClRes[clIdx].dz;
       mLocalResid.tgSlp = mClRes[clIdx].phi;
       mLocalResid.bvox = bvox;
-      mTmpTree[sec]->Fill();
+      fillLocalResidual(sec);
       // TODO calculate mean position of clusters in each voxel (can be updated each time a new measurement is found inside voxel)
     }
   }
@@ -778,65 +801,113 @@ void TrackResiduals::processResiduals()
   if (!mIsInitialized) {
     init();
   }
+  if (mPrintMem) {
+    printMem();
+  }
+#ifdef WITH_OPENMP
+  if (mNThreads > 1 && mLocalResFormat == LocalResFormat::Tree) {
+    ROOT::EnableThreadSafety(); // the sectors are read concurrently
+  }
+#endif
+  // the sectors are independent, their voxels are processed in parallel only if there are spare threads
+  std::array<bool, SECTORSPERSIDE * SIDES> processed{};
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int iSec = 0; iSec < SECTORSPERSIDE * SIDES; ++iSec) {
+    processed[iSec] = extractSectorResiduals(iSec);
+  }
+  // the debug output is shared
   for (int iSec = 0; iSec < SECTORSPERSIDE * SIDES; ++iSec) {
-    processSectorResiduals(iSec);
+    if (processed[iSec]) {
+      dumpResults(iSec);
+    }
+  }
+  if (mPrintMem) {
+    printMem();
   }
 }
 
 //______________________________________________________________________________
 void TrackResiduals::processSectorResiduals(int iSec)
 {
-  if (iSec < 0 || iSec > 35) {
-    LOG(error) << "wrong sector: " << iSec;
-    return;
+  if (extractSectorResiduals(iSec)) {
+    dumpResults(iSec);
   }
-  LOG(info) << "processing sector residuals for sector " << iSec;
-  if (!mIsInitialized) {
-    init();
+}
+
+//______________________________________________________________________________
+bool TrackResiduals::readLocalResiduals(int iSec, std::vector<float>& dyData, std::vector<float>& dzData, std::vector<float>& tgSlpData, std::vector<unsigned short>& binData) const
+{
+  dyData.clear();
+  dzData.clear();
+  tgSlpData.clear();
+  binData.clear();
+  if (mLocalResFormat == LocalResFormat::Binary) {
+    // stream the flat file in chunks, nothing but the accepted points is kept in memory
+    std::string filename = mLocalResFileName + std::to_string(iSec) + ".bin";
+    std::ifstream fin(filename, std::ios::binary | std::ios::ate);
+    if (!fin.good()) {
+      LOG(error) << "failed to open " << filename.c_str();
+      return false;
+    }
+    size_t nPoints = std::min<size_t>(static_cast<size_t>(fin.tellg()) / sizeof(LocalResid), std::max(mMaxPointsPerSector, 0));
+    fin.seekg(0);
+    dyData.reserve(nPoints);
+    dzData.reserve(nPoints);
+    tgSlpData.reserve(nPoints);
+    binData.reserve(nPoints);
+    std::vector<LocalResid> chunk(1 << 16);
+    size_t nRead = 0;
+    while (nRead < nPoints) {
+      size_t nChunk = std::min(chunk.size(), nPoints - nRead);
+      fin.read(reinterpret_cast<char*>(chunk.data()), nChunk * sizeof(LocalResid));
+      nChunk = fin.gcount() / sizeof(LocalResid);
+      if (!nChunk) {
+        break;
+      }
+      for (size_t i = 0; i < nChunk; ++i) {
+        const auto& trkRes = chunk[i];
+        if (fabs(trkRes.tgSlp * param::MaxTgSlp / 0x7fff) >= param::MaxTgSlp) {
+          continue;
+        }
+        dyData.push_back(trkRes.dy * param::MaxResid / 0x7fff);
+        dzData.push_back(trkRes.dz * param::MaxResid / 0x7fff);
+        tgSlpData.push_back(trkRes.tgSlp * param::MaxTgSlp / 0x7fff);
+        binData.push_back(getGlbVoxBin(trkRes.bvox[VoxX], trkRes.bvox[VoxF], trkRes.bvox[VoxZ]));
+      }
+      nRead += nChunk;
+    }
+    return true;
   }
+
   // open file and retrieve data tree (only local files are supported at the moment)
   std::string filename = mLocalResFileName + std::to_string(iSec) + ".root";
   std::unique_ptr<TFile> flin = std::make_unique<TFile>(filename.c_str());
   if (!flin || flin->IsZombie()) {
     LOG(error) << "failed to open " << filename.c_str();
-    return;
+    return false;
   }
   std::string treename = mLocalResTreeName + std::to_string(iSec);
   std::unique_ptr<TTree> tree((TTree*)flin->Get(treename.c_str()));
   if (!tree) {
     LOG(error) << "did not find the data tree " << treename.c_str();
-    return;
+    return false;
   }
   // read compact delte trees created with AliRoot or o2
   LocResStruct trkRes;
   auto* pTrkRes = &trkRes;
   tree->SetBranchAddress(mLocalResBranchName.c_str(), &pTrkRes);
   auto nPoints = tree->GetEntries();
-  if (!nPoints) {
-    LOG(warning) << "no entries found for sector " << iSec;
-    flin->Close();
-    return;
-  }
   if (nPoints > mMaxPointsPerSector) {
     nPoints = mMaxPointsPerSector;
   }
-  // initialize container holding results
-  initResultsContainer(iSec);
-
   LOG(info) << "extracted " << nPoints << " of unbinned data";
 
-  std::vector<VoxRes>& secData = mVoxelResults[iSec];
-
-  unsigned int nAccepted = 0;
-
-  std::vector<float> dyData(nPoints);
-  std::vector<float> dzData(nPoints);
-  std::vector<float> tgSlpData(nPoints);
-  std::vector<unsigned short> binData(nPoints);
-
-  if (mPrintMem) {
-    printMem();
-  }
+  dyData.reserve(nPoints);
+  dzData.reserve(nPoints);
+  tgSlpData.reserve(nPoints);
+  binData.reserve(nPoints);
 
   // read input data into internal vectors
   for (int i = 0; i < nPoints; ++i) {
@@ -845,94 +916,101 @@ void TrackResiduals::processSectorResiduals(int iSec)
     if (fabs(trkRes.tgSlp) >= param::MaxTgSlp) {
       continue;
     }
-    dyData[nAccepted] = trkRes.dy;
-    dzData[nAccepted] = trkRes.dz;
-    tgSlpData[nAccepted] = trkRes.tgSlp;
+    // convert to short and back to float to be compatible with AliRoot version
+    dyData.push_back(short(float(trkRes.dy) * 0x7fff / param::MaxResid) * param::MaxResid / 0x7fff);
+    dzData.push_back(short(float(trkRes.dz) * 0x7fff / param::MaxResid) * param::MaxResid / 0x7fff);
+    tgSlpData.push_back(short(float(trkRes.tgSlp) * 0x7fff / param::MaxTgSlp) * param::MaxTgSlp / 0x7fff);
 #else
     if (fabs(trkRes.tgSlp * param::MaxTgSlp / 0x7fff) >= param::MaxTgSlp) {
       continue;
     }
-    dyData[nAccepted] = trkRes.dy * param::MaxResid / 0x7fff;
-    dzData[nAccepted] = trkRes.dz * param::MaxResid / 0x7fff;
-    tgSlpData[nAccepted] = trkRes.tgSlp * param::MaxTgSlp / 0x7fff;
+    dyData.push_back(trkRes.dy * param::MaxResid / 0x7fff);
+    dzData.push_back(trkRes.dz * param::MaxResid / 0x7fff);
+    tgSlpData.push_back(trkRes.tgSlp * param::MaxTgSlp / 0x7fff);
 #endif
-    binData[nAccepted] = getGlbVoxBin(trkRes.bvox[VoxX], trkRes.bvox[VoxF], trkRes.bvox[VoxZ]);
-    nAccepted++;
+    binData.push_back(getGlbVoxBin(trkRes.bvox[VoxX], trkRes.bvox[VoxF], trkRes.bvox[VoxZ]));
   }
 
   tree.release();
   flin->Close();
+  return true;
+}
 
-  if (mPrintMem) {
-    printMem();
+//______________________________________________________________________________
+bool TrackResiduals::extractSectorResiduals(int iSec)
+{
+  if (iSec < 0 || iSec > 35) {
+    LOG(error) << "wrong sector: " << iSec;
+    return false;
+  }
+  LOG(info) << "processing sector residuals for sector " << iSec;
+  if (!mIsInitialized) {
+    init();
   }
 
-  LOG(info) << "Done reading input data (accepted " << nAccepted << " points)";
-
-  std::vector<size_t> binIndices(nAccepted);
+  std::vector<float> dyData;
+  std::vector<float> dzData;
+  std::vector<float> tgSlpData;
+  std::vector<unsigned short> binData;
+  if (!readLocalResiduals(iSec, dyData, dzData, tgSlpData, binData)) {
+    return false;
+  }
+  size_t nAccepted = binData.size();
+  if (!nAccepted) {
+    LOG(warning) << "no entries found for sector " << iSec;
+    return false;
+  }
+  // initialize container holding results
+  initResultsContainer(iSec);
 
-  dyData.resize(nAccepted);
-  dzData.resize(nAccepted);
-  tgSlpData.resize(nAccepted);
-  binData.resize(nAccepted);
+  std::vector<VoxRes>& secData = mVoxelResults[iSec];
 
-#ifdef LOCAL_RESIDUAL_FORMAT_OLD
-  // convert to short and back to float to be compatible with AliRoot version
-  std::vector<short> dyDataShort(nAccepted);
-  std::vector<short> dzDataShort(nAccepted);
-  std::vector<short> tgSlpDataShort(nAccepted);
-  for (unsigned int i = 0; i < nAccepted; ++i) {
-    dyDataShort[i] = short(dyData[i] * 0x7fff / param::MaxResid);
-    dzDataShort[i] = short(dzData[i] * 0x7fff / param::MaxResid);
-    tgSlpDataShort[i] = short(tgSlpData[i] * 0x7fff / param::MaxTgSlp);
-
-    dyData[i] = dyDataShort[i] * param::MaxResid / 0x7fff;
-    dzData[i] = dzDataShort[i] * param::MaxResid / 0x7fff;
-    tgSlpData[i] = tgSlpDataShort[i] * param::MaxTgSlp / 0x7fff;
-  }
-#endif
+  LOG(info) << "Done reading input data (accepted " << nAccepted << " points)";
 
   // sort in voxel increasing order
+  std::vector<size_t> binIndices(nAccepted);
   o2::math_utils::SortData(binData, binIndices);
   if (mPrintMem) {
-    printMem();
+    printSectorMem(iSec, nAccepted);
   }
 
-  // vectors holding the data for one voxel at a time
-  std::vector<float> dyVec;
-  std::vector<float> dzVec;
-  std::vector<float> tgVec;
-  // assuming we will always have around 1000 entries per voxel
-  dyVec.reserve(1e3);
-  dzVec.reserve(1e3);
-  tgVec.reserve(1e3);
-  int currVoxBin = -1;
-  unsigned int nPointsInVox = 0;
-  unsigned int nProcessed = 0;
-  while (nProcessed < nAccepted) {
-    // read all points, voxel by voxel
-    int idx = binIndices[nProcessed];
-    if (currVoxBin != binData[idx]) {
-      if (nPointsInVox) {
-        VoxRes& resVox = secData[currVoxBin];
-        processVoxelResiduals(dyVec, dzVec, tgVec, resVox);
-      }
-      currVoxBin = binData[idx];
-      nPointsInVox = 0;
+  // first sorted point of each voxel with data, the voxels are then processed independently
+  std::vector<size_t> voxelStart;
+  for (size_t i = 0; i < nAccepted; ++i) {
+    if (!i || binData[binIndices[i]] != binData[binIndices[i - 1]]) {
+      voxelStart.push_back(i);
+    }
+  }
+  voxelStart.push_back(nAccepted);
+  int nVoxWithData = voxelStart.size() - 1;
+
+#ifdef WITH_OPENMP
+#pragma omp parallel num_threads(mNThreads)
+#endif
+  {
+    // vectors holding the data for one voxel at a time
+    std::vector<float> dyVec;
+    std::vector<float> dzVec;
+    std::vector<float> tgVec;
+    // assuming we will always have around 1000 entries per voxel
+    dyVec.reserve(1e3);
+    dzVec.reserve(1e3);
+    tgVec.reserve(1e3);
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for (int iVox = 0; iVox < nVoxWithData; ++iVox) {
       dyVec.clear();
       dzVec.clear();
       tgVec.clear();
+      for (size_t i = voxelStart[iVox]; i < voxelStart[iVox + 1]; ++i) {
+        int idx = binIndices[i];
+        dyVec.push_back(dyData[idx]);
+        dzVec.push_back(dzData[idx]);
+        tgVec.push_back(tgSlpData[idx]);
+      }
+      processVoxelResiduals(dyVec, dzVec, tgVec, secData[binData[binIndices[voxelStart[iVox]]]]);
     }
-    dyVec.push_back(dyData[idx]);
-    dzVec.push_back(dzData[idx]);
-    tgVec.push_back(tgSlpData[idx]);
-    ++nPointsInVox;
-    ++nProcessed;
-  }
-  if (nPointsInVox) {
-    // process last voxel
-    VoxRes& resVox = secData[currVoxBin];
-    processVoxelResiduals(dyVec, dzVec, tgVec, resVox);
   }
   LOG(info) << "extracted residuals for sector " << iSec;
 
@@ -940,60 +1018,51 @@ void TrackResiduals::processSectorResiduals(int iSec)
   LOG(info) << "number of validated X rows: " << nRowsOK;
   if (!nRowsOK) {
     LOG(warning) << "sector " << iSec << ": all X-bins disabled, abandon smoothing";
-    return;
+    return false;
   } else {
     smooth(iSec);
   }
-  //dumpResults(iSec);
-  //return;
 
   // process dispersions
-  dyVec.clear();
-  tgVec.clear();
-  currVoxBin = -1;
-  nProcessed = 0;
-  nPointsInVox = 0;
-  while (nProcessed < nAccepted) {
-    int idx = binIndices[nProcessed];
-    if (currVoxBin != binData[idx]) {
-      if (nPointsInVox) {
-        VoxRes& resVox = secData[currVoxBin];
-        if (!getXBinIgnored(iSec, resVox.bvox[VoxX])) {
-          processVoxelDispersions(tgVec, dyVec, resVox);
-        }
+#ifdef WITH_OPENMP
+#pragma omp parallel num_threads(mNThreads)
+#endif
+  {
+    std::vector<float> dyVec;
+    std::vector<float> tgVec;
+    dyVec.reserve(1e3);
+    tgVec.reserve(1e3);
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for (int iVox = 0; iVox < nVoxWithData; ++iVox) {
+      VoxRes& resVox = secData[binData[binIndices[voxelStart[iVox]]]];
+      if (getXBinIgnored(iSec, resVox.bvox[VoxX])) {
+        continue;
       }
-      currVoxBin = binData[idx];
-      nPointsInVox = 0;
       dyVec.clear();
       tgVec.clear();
-    }
-    dyVec.push_back(dyData[idx]);
-    tgVec.push_back(tgSlpData[idx]);
-    ++nPointsInVox;
-    ++nProcessed;
-  }
-  if (nPointsInVox) {
-    // process last voxel
-    VoxRes& resVox = secData[currVoxBin];
-    if (!getXBinIgnored(iSec, resVox.bvox[VoxX])) {
+      for (size_t i = voxelStart[iVox]; i < voxelStart[iVox + 1]; ++i) {
+        int idx = binIndices[i];
+        dyVec.push_back(dyData[idx]);
+        tgVec.push_back(tgSlpData[idx]);
+      }
       processVoxelDispersions(tgVec, dyVec, resVox);
     }
   }
-  // smooth dispersions
-  for (int ix = 0; ix < mNXBins; ++ix) {
-    if (getXBinIgnored(iSec, ix)) {
+  // smooth dispersions, only the dispersions of the neighbours are used
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 64) num_threads(mNThreads)
+#endif
+  for (int voxBin = 0; voxBin < mNVoxPerSector; ++voxBin) {
+    VoxRes& resVox = secData[voxBin];
+    if (getXBinIgnored(iSec, resVox.bvox[VoxX])) {
       continue;
     }
-    for (int iz = 0; iz < mNZ2XBins; ++iz) {
-      for (int ip = 0; ip < mNY2XBins; ++ip) {
-        int voxBin = getGlbVoxBin(ix, ip, iz);
-        VoxRes& resVox = secData[voxBin];
-        getSmoothEstimate(iSec, resVox.stat[VoxX], resVox.stat[VoxF], resVox.stat[VoxZ], resVox.DS, 0x1 << VoxV);
-      }
-    }
+    getSmoothEstimate(iSec, resVox.stat[VoxX], resVox.stat[VoxF], resVox.stat[VoxZ], resVox.DS, 0x1 << VoxV);
   }
   LOG(info) << "Done processing residuals for sector " << iSec;
-  dumpResults(iSec);
+  return true;
 }
 
 //______________________________________________________________________________
@@ -1185,40 +1254,38 @@ int TrackResiduals::validateVoxels(int iSec)
 void TrackResiduals::smooth(int iSec)
 {
   std::vector<VoxRes>& secData = mVoxelResults[iSec];
-  for (int ix = 0; ix < mNXBins; ++ix) {
-    if (getXBinIgnored(iSec, ix)) {
+  // the flags are only updated once all the estimates are done, since they are used for the neighbouring voxels
+  std::vector<char> smoothDone(mNVoxPerSector, false);
+  int nFailed = 0;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 64) num_threads(mNThreads) reduction(+ : nFailed)
+#endif
+  for (int voxBin = 0; voxBin < mNVoxPerSector; ++voxBin) {
+    VoxRes& resVox = secData[voxBin];
+    if (getXBinIgnored(iSec, resVox.bvox[VoxX])) {
       continue;
     }
-    for (int ip = 0; ip < mNY2XBins; ++ip) {
-      for (int iz = 0; iz < mNZ2XBins; ++iz) {
-        int voxBin = getGlbVoxBin(ix, ip, iz);
-        VoxRes& resVox = secData[voxBin];
-        resVox.flags &= ~SmoothDone;
-        bool res = getSmoothEstimate(resVox.bsec, resVox.stat[VoxX], resVox.stat[VoxF], resVox.stat[VoxZ], resVox.DS, (0x1 << VoxX | 0x1 << VoxF | 0x1 << VoxZ));
-        if (!res) {
-          mNSmoothingFailedBins[iSec]++;
-        } else {
-          resVox.flags |= SmoothDone;
-        }
-      }
+    bool res = getSmoothEstimate(resVox.bsec, resVox.stat[VoxX], resVox.stat[VoxF], resVox.stat[VoxZ], resVox.DS, (0x1 << VoxX | 0x1 << VoxF | 0x1 << VoxZ));
+    if (!res) {
+      nFailed++;
+    } else {
+      smoothDone[voxBin] = true;
     }
   }
-  // substract dX contribution to dZ
-  for (int ix = 0; ix < mNXBins; ++ix) {
-    if (getXBinIgnored(iSec, ix)) {
+  mNSmoothingFailedBins[iSec] += nFailed;
+  for (int voxBin = 0; voxBin < mNVoxPerSector; ++voxBin) {
+    VoxRes& resVox = secData[voxBin];
+    if (getXBinIgnored(iSec, resVox.bvox[VoxX])) {
       continue;
     }
-    for (int ip = 0; ip < mNY2XBins; ++ip) {
-      for (int iz = 0; iz < mNZ2XBins; ++iz) {
-        int voxBin = getGlbVoxBin(ix, ip, iz);
-        VoxRes& resVox = secData[voxBin];
-        if (!(resVox.flags & SmoothDone)) {
-          continue;
-        }
-        resVox.DS[ResZ] += resVox.stat[VoxZ] * resVox.DS[ResX]; // remove slope*dX contribution from dZ
-        resVox.D[ResZ] += resVox.stat[VoxZ] * resVox.DS[ResX];  // remove slope*dX contribution from dZ
-      }
+    resVox.flags &= ~SmoothDone;
+    if (!smoothDone[voxBin]) {
+      continue;
     }
+    resVox.flags |= SmoothDone;
+    // substract dX contribution to dZ
+    resVox.DS[ResZ] += resVox.stat[VoxZ] * resVox.DS[ResX]; // remove slope*dX contribution from dZ
+    resVox.D[ResZ] += resVox.stat[VoxZ] * resVox.DS[ResX];  // remove slope*dX contribution from dZ
   }
 }
 
@@ -1268,9 +1335,10 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
   maxTrials[VoxX] = mMaxBadXBinsToCover * 2;
 
   std::array<int, VoxDim> trial{0};
+  std::array<double, ResDim * sMaxSmtDim> smoothingRes; // right-hand sides, then solutions of the fits
 
   while (true) {
-    std::fill(mLastSmoothingRes.begin(), mLastSmoothingRes.end(), 0);
+    std::fill(smoothingRes.begin(), smoothingRes.end(), 0);
     memset(&cmat[0][0], 0, sizeof(cmat));
 
     int nbOK = 0; // accounted neighbours
@@ -1456,7 +1524,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
           wi /= (voxNb->E[iDim] * voxNb->E[iDim]);
         }
         std::array<double, sMaxSmtDim*(sMaxSmtDim + 1) / 2>& cmatD = cmat[iDim];
-        double* rhsD = &mLastSmoothingRes[iDim * sMaxSmtDim];
+        double* rhsD = &smoothingRes[iDim * sMaxSmtDim];
         unsigned short iMat = 0;
         unsigned short iRhs = 0;
         // linear part
@@ -1522,7 +1590,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
       }
       matrix.Zero(); // reset matrix
       std::array<double, sMaxSmtDim*(sMaxSmtDim + 1) / 2>& cmatD = cmat[iDim];
-      double* rhsD = &mLastSmoothingRes[iDim * sMaxSmtDim];
+      double* rhsD = &smoothingRes[iDim * sMaxSmtDim];
       short iMat = -1;
       short iRhs = -1;
       short row = -1;
@@ -2232,6 +2300,8 @@ void TrackResiduals::dumpResults(int iSec)
 
 void TrackResiduals::printMem() const
 {
+  static std::mutex printMutex; // the sectors can be processed in parallel
+  std::lock_guard<std::mutex> guard(printMutex);
   static float mres = 0, mvir = 0, mres0 = 0, mvir0 = 0;
   static ProcInfo_t procInfo;
   static TStopwatch sw;
@@ -2246,3 +2316,13 @@ void TrackResiduals::printMem() const
   mvir0 = mvir;
   sw.Start();
 }
+
+void TrackResiduals::printSectorMem(int iSec, size_t nPoints) const
+{
+  // dy, dz, tg, voxel bin and sorting index per point
+  const float kMB = 1024 * 1024;
+  float buffers = nPoints * (3 * sizeof(float) + sizeof(unsigned short) + sizeof(size_t)) / kMB;
+  float results = mVoxelResults[iSec].size() * sizeof(VoxRes) / kMB;
+  LOG(info) << "sector " << iSec << ": " << nPoints << " points in buffers of " << buffers << " MB, voxel results " << results << " MB";
+  printMem();
+}
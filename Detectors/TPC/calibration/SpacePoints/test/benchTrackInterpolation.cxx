@@ -0,0 +1,168 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// Throughput of the TPC track interpolation for a synthetic time frame of ITS-TPC-TOF tracks
+// as a function of the number of threads. The output of each configuration is compared with
+// the single threaded one.
+
+#include "benchmark/benchmark.h"
+#include "SpacePoints/TrackInterpolation.h"
+#include "DataFormatsTPC/ClusterNative.h"
+#include "ReconstructionDataFormats/GlobalTrackID.h"
+#include "TPCBase/Mapper.h"
+#include "Field/MagneticField.h"
+#include "MathUtils/Utils.h"
+
+#include <TGeoGlobalMagField.h>
+#include <TGeoManager.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace o2::tpc;
+using GTrackID = o2::dataformats::GlobalTrackID;
+
+// ITS-TPC-TOF tracks with one TPC cluster per pad row, all in the A-side sector of the track
+struct SyntheticTF {
+  std::vector<o2::its::TrackITS> tracksITS;
+  std::vector<TrackTPC> tracksTPC;
+  std::vector<TPCClRefElem> clusRefs;
+  std::vector<o2::dataformats::TrackTPCITS> tracksITSTPC;
+  std::vector<o2::dataformats::MatchInfoTOF> matchesTOF;
+  std::vector<o2::tof::Cluster> clustersTOF;
+  std::vector<ClusterNative> clustersTPC;
+  ClusterNativeAccess clusterIndex;
+
+  explicit SyntheticTF(int nTracks)
+  {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> tglDist(0.05f, 0.8f);
+    std::uniform_real_distribution<float> timeDist(50.f, 400.f);
+    const auto& mapper = Mapper::instance();
+    std::vector<std::vector<ClusterNative>> clusters(constants::MAXSECTOR * constants::MAXGLOBALPADROW);
+    const std::array<float, 15> cov{1e-4f, 0.f, 1e-4f, 0.f, 0.f, 1e-5f, 0.f, 0.f, 0.f, 1e-5f, 0.f, 0.f, 0.f, 0.f, 1e-4f};
+    for (int iTrk = 0; iTrk < nTracks; ++iTrk) {
+      const int sector = iTrk % (constants::MAXSECTOR / 2);
+      const float tgl = tglDist(rng);
+      const std::array<float, 5> par{0.f, 0.f, 0.f, tgl, (iTrk % 2 ? 1.f : -1.f) * 0.3f};
+      const float alpha = o2::math_utils::sector2Angle(sector);
+      o2::track::TrackParCov trk(40.f, alpha, par, cov);
+
+      tracksITS.emplace_back(trk, 1.f, trk);
+      tracksITS.back().setNumberOfClusters(7);
+
+      auto& trkTPC = tracksTPC.emplace_back(40.f, alpha, par, cov);
+      const int nCl = param::NPadRows;
+      trkTPC.setClusterRef(clusRefs.size(), nCl);
+      const size_t refOffset = clusRefs.size();
+      clusRefs.resize(refOffset + nCl + (2 * nCl + sizeof(TPCClRefElem) - 1) / sizeof(TPCClRefElem));
+      auto clIdx = &clusRefs[refOffset];
+      auto secRow = reinterpret_cast<uint8_t*>(clIdx + nCl);
+      const float time = timeDist(rng);
+      for (int iRow = 0; iRow < nCl; ++iRow) {
+        auto& clRow = clusters[sector * constants::MAXGLOBALPADROW + iRow];
+        clIdx[iRow] = clRow.size();
+        secRow[iRow] = sector;
+        secRow[iRow + nCl] = iRow;
+        auto& cl = clRow.emplace_back();
+        cl.setPad(mapper.getNumberOfPadsInRowSector(iRow) / 2.f);
+        cl.setTime(time);
+      }
+
+      auto& trkITSTPC = tracksITSTPC.emplace_back(trk);
+      trkITSTPC.setRefITS(GTrackID(iTrk, GTrackID::ITS));
+      trkITSTPC.setRefTPC(GTrackID(iTrk, GTrackID::TPC));
+      trkITSTPC.setTimeMUS(0.f, 1.f);
+
+      auto& clTOF = clustersTOF.emplace_back(0, 372.f, 0.f, tgl * 332.f, 0.75f, 0.75f, 0.f, 0., 0., 0.f, 0, 0);
+      clTOF.setSector(sector);
+      matchesTOF.emplace_back(o2::dataformats::EvIndex<int, int>{0, iTrk}, 1.f, o2::track::TrackLTIntegral{},
+                              o2::dataformats::EvIndex<int, GTrackID>{0, GTrackID(iTrk, GTrackID::ITSTPC)});
+    }
+    std::memset(&clusterIndex, 0, sizeof(clusterIndex));
+    for (int sector = 0; sector < constants::MAXSECTOR; ++sector) {
+      for (int row = 0; row < constants::MAXGLOBALPADROW; ++row) {
+        const auto& clRow = clusters[sector * constants::MAXGLOBALPADROW + row];
+        clusterIndex.nClusters[sector][row] = clRow.size();
+        clustersTPC.insert(clustersTPC.end(), clRow.begin(), clRow.end());
+      }
+    }
+    clusterIndex.clustersLinear = clustersTPC.data();
+    clusterIndex.setOffsetPtrs();
+  }
+
+  void setInputs(TrackInterpolation& interpolation) const
+  {
+    interpolation.setITSTracksInp(tracksITS);
+    interpolation.setTPCTracksInp(tracksTPC);
+    interpolation.setTPCTrackClusIdxInp(clusRefs);
+    interpolation.setTPCClustersInp(&clusterIndex);
+    interpolation.setITSTPCTrackMatchesInp(tracksITSTPC);
+    interpolation.setTOFMatchesInp(matchesTOF);
+    interpolation.setTOFClustersInp(clustersTOF);
+  }
+};
+
+const SyntheticTF& getTF()
+{
+  static const SyntheticTF tf = []() {
+    // the propagator requires a geometry, which is not accessed without material corrections
+    new TGeoManager("benchTrackInterpolation", "benchTrackInterpolation");
+    auto fld = o2::field::MagneticField::createFieldMap();
+    TGeoGlobalMagField::Instance()->SetField(fld);
+    TGeoGlobalMagField::Instance()->Lock();
+    o2::base::Propagator::Instance();
+    return SyntheticTF(10000);
+  }();
+  return tf;
+}
+
+bool sameOutput(TrackInterpolation& a, TrackInterpolation& b)
+{
+  const auto &trkA = a.getReferenceTracks(), &trkB = b.getReferenceTracks();
+  const auto &resA = a.getClusterResiduals(), &resB = b.getClusterResiduals();
+  if (trkA.size() != trkB.size() || resA.size() != resB.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < trkA.size(); ++i) {
+    if (trkA[i].trkId != trkB[i].trkId || !(trkA[i].clIdx == trkB[i].clIdx)) {
+      return false;
+    }
+  }
+  return std::memcmp(resA.data(), resB.data(), resA.size() * sizeof(TPCClusterResiduals)) == 0;
+}
+
+static void BM_TrackInterpolation(benchmark::State& state)
+{
+  const auto& tf = getTF();
+  TrackInterpolation reference;
+  reference.init();
+  tf.setInputs(reference);
+  reference.process();
+
+  TrackInterpolation interpolation;
+  interpolation.setNThreads(state.range(0));
+  interpolation.init();
+  tf.setInputs(interpolation);
+  for (auto _ : state) {
+    interpolation.process();
+  }
+  if (!sameOutput(reference, interpolation)) {
+    state.SkipWithError("output differs from the single threaded processing");
+  }
+  state.counters["residuals"] = interpolation.getClusterResiduals().size();
+  state.SetItemsProcessed(state.iterations() * tf.matchesTOF.size());
+}
+
+BENCHMARK(BM_TrackInterpolation)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,115 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTrackResiduals.cxx
+/// \brief checks that the residuals processed with several threads are identical to the serial ones
+
+#define BOOST_TEST_MODULE Test TPC TrackResiduals
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "SpacePoints/TrackResiduals.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace o2::tpc
+{
+
+static constexpr int NSectorsWithData = 6; // the other sectors have no input and are skipped
+static constexpr int NPointsPerVoxel = 40;
+static const std::string FileName = "testTrackResidualsSect";
+
+// a small binning, read from the flat files written below
+void setBinning(TrackResiduals& residuals)
+{
+  residuals.setNY2XBins(3);
+  residuals.setNZ2XBins(2);
+  residuals.setLocalResFormat(TrackResiduals::LocalResFormat::Binary);
+  residuals.setLocalResFileName(FileName);
+}
+
+short toShort(float val, float max)
+{
+  return static_cast<short>(std::max(-max, std::min(val, max)) * 0x7fff / max);
+}
+
+// the points of each voxel follow dy = a + b * tgSlp with a gaussian noise
+void writeLocalResiduals()
+{
+  for (int iSec = 0; iSec < NSectorsWithData; ++iSec) {
+    std::mt19937 gen(iSec);
+    std::uniform_real_distribution<float> tgSlp(-0.5f, 0.5f);
+    std::normal_distribution<float> noise(0.f, 0.1f);
+    std::ofstream fout(FileName + std::to_string(iSec) + ".bin", std::ios::binary | std::ios::trunc);
+    TrackResiduals::LocalResid res;
+    for (int ix = 0; ix < param::NPadRows; ++ix) {
+      for (int ip = 0; ip < 3; ++ip) {
+        for (int iz = 0; iz < 2; ++iz) {
+          res.bvox[TrackResiduals::VoxX] = ix;
+          res.bvox[TrackResiduals::VoxF] = ip;
+          res.bvox[TrackResiduals::VoxZ] = iz;
+          for (int i = 0; i < NPointsPerVoxel; ++i) {
+            const float tg = tgSlp(gen);
+            res.tgSlp = toShort(tg, param::MaxTgSlp);
+            res.dy = toShort(0.01f * ix + 0.2f * ip + 0.3f * tg + noise(gen), param::MaxResid);
+            res.dz = toShort(-0.1f * iz + 0.05f * iSec + noise(gen), param::MaxResid);
+            fout.write(reinterpret_cast<const char*>(&res), sizeof(res));
+          }
+        }
+      }
+    }
+  }
+}
+
+int compareResults(const TrackResiduals::VoxRes& a, const TrackResiduals::VoxRes& b)
+{
+  return a.D != b.D || a.E != b.E || a.DS != b.DS || a.EXYCorr != b.EXYCorr || a.dYSigMAD != b.dYSigMAD ||
+         a.dZSigLTM != b.dZSigLTM || a.stat != b.stat || a.bvox != b.bvox || a.bsec != b.bsec || a.flags != b.flags;
+}
+
+BOOST_AUTO_TEST_CASE(TrackResidualsParallelEqualsSerial)
+{
+  writeLocalResiduals();
+
+  TrackResiduals serial;
+  setBinning(serial);
+  serial.processResiduals();
+
+  TrackResiduals parallel;
+  setBinning(parallel);
+  parallel.setNThreads(4);
+  parallel.processResiduals();
+
+  int nDone = 0;
+  int nDiff = 0;
+  for (int iSec = 0; iSec < SECTORSPERSIDE * SIDES; ++iSec) {
+    const auto& resSerial = serial.getVoxelResults(iSec);
+    const auto& resParallel = parallel.getVoxelResults(iSec);
+    BOOST_REQUIRE_EQUAL(resSerial.size(), resParallel.size());
+    for (size_t i = 0; i < resSerial.size(); ++i) {
+      nDone += (resSerial[i].flags & TrackResiduals::SmoothDone) != 0;
+      nDiff += compareResults(resSerial[i], resParallel[i]);
+    }
+  }
+  // the comparison is not trivial: the voxels of the sectors with data are fitted and smoothed
+  BOOST_CHECK_GT(nDone, 0);
+  BOOST_CHECK_EQUAL(nDiff, 0);
+
+  for (int iSec = 0; iSec < NSectorsWithData; ++iSec) {
+    std::remove((FileName + std::to_string(iSec) + ".bin").c_str());
+  }
+}
+
+} // namespace o2::tpc
@@ -61,6 +61,13 @@ class TPCFastTransformHelperO2
     mSpaceChargeCorrection = spaceChargeCorrection;
   };
 
+  /// set the number of threads for the approximation of the space charge correction.
+  /// The correction function is then called concurrently, so it must be thread safe
+  void setNthreads(int n) { mNthreads = n; }
+
+  /// get the number of threads for the approximation of the space charge correction
+  int getNthreads() const { return mNthreads; }
+
   /// creates TPCFastTransform object
   std::unique_ptr<TPCFastTransform> create(Long_t TimeStamp);
 
@@ -81,8 +88,9 @@ class TPCFastTransformHelperO2
   bool mIsInitialized = 0;                                                                     ///< initialization flag
   std::function<void(int roc, const double XYZ[3], double dXdYdZ[3])> mSpaceChargeCorrection = nullptr; ///< pointer to an external correction method
   TPCFastTransformGeo mGeo;                                                                    ///< geometry parameters
+  int mNthreads = 1;                                                                           ///< number of threads for the approximation of the correction
 
-  ClassDefNV(TPCFastTransformHelperO2, 2);
+  ClassDefNV(TPCFastTransformHelperO2, 3);
 };
 } // namespace tpc
 } // namespace o2
@@ -25,6 +25,11 @@
 #include "Spline2DHelper.h"
 #include "Riostream.h"
 #include "FairLogger.h"
+#include "TStopwatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 using namespace o2::gpu;
 
@@ -263,19 +268,75 @@ int TPCFastTransformHelperO2::updateCalibration(TPCFastTransform& fastTransform,
   // for the future: switch TOF correction off for a while
 
   if (mSpaceChargeCorrection) {
-    for (int slice = 0; slice < correction.getGeometry().getNumberOfSlices(); slice++) {
-      for (int row = 0; row < correction.getGeometry().getNumberOfRows(); row++) {
-        const TPCFastSpaceChargeCorrection::SplineType& spline = correction.getSpline(slice, row);
-        float* data = correction.getSplineData(slice, row);
-        Spline2DHelper<float> helper;
-        helper.setSpline(spline, 3, 3);
-        auto F = [&](double su, double sv, double dxuv[3]) {
-          getSpaceChargeCorrection(slice, row, su, sv, dxuv[0], dxuv[1], dxuv[2]);
-        };
-        helper.approximateFunction(data, 0., 1., 0., 1., F);
-      } // row
-    }   // slice
-    correction.initInverse();
+    const int nSlices = correction.getGeometry().getNumberOfSlices();
+    const int nRows = correction.getGeometry().getNumberOfRows();
+
+    TStopwatch timer;
+
+    // the least-squares matrices only depend on the spline scenario, they are computed once and shared by all the rows of the scenario
+    std::vector<Spline2DHelper<float>> helpers(correction.getNumberOfScenarios());
+    std::vector<bool> isHelperSet(correction.getNumberOfScenarios(), false);
+    for (int row = 0; row < nRows; row++) {
+      const int scenario = correction.getRowInfo(row).splineScenarioID;
+      if (!isHelperSet[scenario]) {
+        helpers[scenario].setSpline(correction.getSpline(0, row), 3, 3);
+        isHelperSet[scenario] = true;
+      }
+    }
+
+    // the (slice, row) pairs are approximated independently
+    std::vector<double> maxDeviation(3 * nSlices * nRows, 0.);
+#pragma omp parallel for num_threads(mNthreads) schedule(dynamic)
+    for (int sliceRow = 0; sliceRow < nSlices * nRows; sliceRow++) {
+      const int slice = sliceRow / nRows;
+      const int row = sliceRow % nRows;
+      const TPCFastSpaceChargeCorrection::SplineType& spline = correction.getSpline(slice, row);
+      const Spline2DHelper<float>& helper = helpers[correction.getRowInfo(row).splineScenarioID];
+      float* data = correction.getSplineData(slice, row);
+
+      // correction at the data points of the least-squares fit
+      const int nPointsU = helper.getNumberOfDataPointsU1();
+      const int nPointsV = helper.getNumberOfDataPointsU2();
+      const double scaleU = 1. / spline.getGridX1().getUmax();
+      const double scaleV = 1. / spline.getGridX2().getUmax();
+      std::vector<double> dataPointF(3 * nPointsU * nPointsV);
+      for (int iv = 0; iv < nPointsV; iv++) {
+        const double sv = helper.getHelperU2().getDataPoint(iv).u * scaleV;
+        for (int iu = 0; iu < nPointsU; iu++) {
+          const double su = helper.getHelperU1().getDataPoint(iu).u * scaleU;
+          double* f = &dataPointF[3 * (iv * nPointsU + iu)];
+          getSpaceChargeCorrection(slice, row, su, sv, f[0], f[1], f[2]);
+        }
+      }
+      helper.approximateFunction(data, dataPointF.data());
+
+      // accuracy of the approximation at the data points
+      for (int iv = 0; iv < nPointsV; iv++) {
+        for (int iu = 0; iu < nPointsU; iu++) {
+          const double* f = &dataPointF[3 * (iv * nPointsU + iu)];
+          float s[3];
+          spline.interpolateU(data, helper.getHelperU1().getDataPoint(iu).u, helper.getHelperU2().getDataPoint(iv).u, s);
+          for (int dim = 0; dim < 3; dim++) {
+            maxDeviation[3 * sliceRow + dim] = std::max(maxDeviation[3 * sliceRow + dim], std::abs(s[dim] - f[dim]));
+          }
+        }
+      }
+    } // slice, row
+
+    double maxDx = 0., maxDu = 0., maxDv = 0.;
+    for (int sliceRow = 0; sliceRow < nSlices * nRows; sliceRow++) {
+      maxDx = std::max(maxDx, maxDeviation[3 * sliceRow + 0]);
+      maxDu = std::max(maxDu, maxDeviation[3 * sliceRow + 1]);
+      maxDv = std::max(maxDv, maxDeviation[3 * sliceRow + 2]);
+    }
+    timer.Stop();
+    LOG(INFO) << "TPC space charge correction approximated for " << nSlices * nRows << " rows with " << mNthreads << " threads in " << timer.RealTime()
+              << " s, max deviation at the data points: dx " << maxDx << " du " << maxDu << " dv " << maxDv << " cm";
+
+    timer.Start();
+    correction.initInverse(false, mNthreads);
+    timer.Stop();
+    LOG(INFO) << "TPC inverse space charge correction initialized with " << mNthreads << " threads in " << timer.RealTime() << " s";
   } else {
     correction.setNoCorrection();
   }
@@ -29,6 +29,7 @@
 #include "Riostream.h"
 #include "FairLogger.h"
 
+#include <algorithm>
 #include <vector>
 #include <iostream>
 #include <iomanip>
@@ -197,5 +198,47 @@ BOOST_AUTO_TEST_CASE(FastTransform_test_setSpaceChargeCorrection)
   BOOST_CHECK_MESSAGE(fabs(maxDeviation) < 1.e-2, "test of inverse correction map failed, max difference " << maxDeviation << " cm is too large");
 }
 
+BOOST_AUTO_TEST_CASE(FastTransform_test_setSpaceChargeCorrection_nThreads)
+{
+  auto correctionGlobal = [](int roc, const double XYZ[3], double dXdYdZ[3]) {
+    dXdYdZ[0] = 0.1 + 0.001 * XYZ[1];
+    dXdYdZ[1] = -0.2 + 0.001 * XYZ[0];
+    dXdYdZ[2] = 0.3 + 0.001 * XYZ[2];
+  };
+
+  TPCFastTransformHelperO2* helper = TPCFastTransformHelperO2::instance();
+  helper->setSpaceChargeCorrection(correctionGlobal);
+  helper->setNthreads(1);
+  std::unique_ptr<TPCFastTransform> fastTransform1(helper->create(0));
+  helper->setNthreads(4);
+  std::unique_ptr<TPCFastTransform> fastTransform4(helper->create(0));
+  helper->setNthreads(1);
+  helper->setSpaceChargeCorrection(nullptr);
+
+  // the rows are approximated independently, so the result must not depend on the number of threads
+  const TPCFastTransformGeo& geo = fastTransform1->getGeometry();
+  double maxDiff = 0.;
+  for (int slice = 0; slice < geo.getNumberOfSlices(); slice += 5) {
+    float lastTimeBin = fastTransform1->getMaxDriftTime(slice, 0.f);
+    for (int row = 0; row < geo.getNumberOfRows(); row += 7) {
+      int nPads = geo.getRowInfo(row).maxPad + 1;
+      for (int pad = 0; pad < nPads; pad += 10) {
+        for (float time = 0; time < lastTimeBin; time += 50) {
+          float x1, y1, z1, x4, y4, z4;
+          fastTransform1->Transform(slice, row, pad, time, x1, y1, z1);
+          fastTransform4->Transform(slice, row, pad, time, x4, y4, z4);
+          float nx1, nx4;
+          fastTransform1->InverseTransformYZtoX(slice, row, y1, z1, nx1);
+          fastTransform4->InverseTransformYZtoX(slice, row, y1, z1, nx4);
+          for (float d : {x1 - x4, y1 - y4, z1 - z4, nx1 - nx4}) {
+            maxDiff = std::max(maxDiff, (double)fabs(d));
+          }
+        }
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(maxDiff, 0.);
+}
+
 } // namespace tpc
 } // namespace o2
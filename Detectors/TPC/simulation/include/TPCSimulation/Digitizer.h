@@ -20,6 +20,7 @@
 #include "TPCSimulation/PadResponse.h"
 #include "TPCSimulation/Point.h"
 #include "TPCSpaceCharge/SpaceCharge.h"
+#include "TPCSpaceCharge/DistortionLookupTable.h"
 
 #include "TPCBase/Mapper.h"
 
@@ -125,12 +126,19 @@ class Digitizer
   /// \param TFile file containing distortions and corrections
   void setUseSCDistortions(TFile& finp);
 
+  /// Enable the use of space-charge distortions by providing a lookup table of the global distortions, which is memory-mapped
+  /// The lookup table should be written with SpaceCharge::writeDistortionLookupTable
+  /// \param lookupTableFile file containing the lookup table
+  void setUseSCDistortions(const std::string& lookupTableFile);
+
  private:
-  DigitContainer mDigitContainer;    ///< Container for the Digits
-  std::unique_ptr<SC> mSpaceCharge;  ///< Handler of space-charge distortions
-  Sector mSector = -1;               ///< ID of the currently processed sector
-  double mEventTime = 0.f;           ///< Time of the currently processed event
-  double mOutputDigitTimeOffset = 0; ///< Time of the first IR sampled in the digitizer
+  DigitContainer mDigitContainer;                                ///< Container for the Digits
+  std::unique_ptr<SC> mSpaceCharge;                              ///< Handler of space-charge distortions
+  std::unique_ptr<DistortionLookupTable> mDistortionLookupTable; //!< Lookup table of the space-charge distortions, used instead of mSpaceCharge if set
+  std::vector<GlobalPosition3D> mHitPositions;                   //!< Distorted positions of the hits of one hit group
+  Sector mSector = -1;                                           ///< ID of the currently processed sector
+  double mEventTime = 0.f;                                       ///< Time of the currently processed event
+  double mOutputDigitTimeOffset = 0;                             ///< Time of the first IR sampled in the digitizer
   // FIXME: whats the reason for hving this static?
   static bool mIsContinuous;      ///< Switch for continuous readout
   bool mUseSCDistortions = false; ///< Flag to switch on the use of space-charge distortions
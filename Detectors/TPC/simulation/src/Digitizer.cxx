@@ -40,7 +40,7 @@ bool o2::tpc::Digitizer::mIsContinuous = true;
 void Digitizer::init()
 {
   // Calculate distortion lookup tables if initial space-charge density is provided
-  if (mUseSCDistortions) {
+  if (mUseSCDistortions && mSpaceCharge) {
     mSpaceCharge->init();
   }
 }
@@ -73,13 +73,26 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
 
   for (auto& hitGroup : hits) {
     const int MCTrackID = hitGroup.GetTrackID();
+
+    // The distortions of all hits of the group are interpolated together from the lookup table
+    if (mDistortionLookupTable) {
+      mHitPositions.clear();
+      for (size_t hitindex = 0; hitindex < hitGroup.getSize(); ++hitindex) {
+        const auto& eh = hitGroup.getHit(hitindex);
+        mHitPositions.emplace_back(eh.GetX(), eh.GetY(), eh.GetZ());
+      }
+      mDistortionLookupTable->apply(mHitPositions);
+    }
+
     for (size_t hitindex = 0; hitindex < hitGroup.getSize(); ++hitindex) {
       const auto& eh = hitGroup.getHit(hitindex);
 
       GlobalPosition3D posEle(eh.GetX(), eh.GetY(), eh.GetZ());
 
       // Distort the electron position in case space-charge distortions are used
-      if (mUseSCDistortions) {
+      if (mDistortionLookupTable) {
+        posEle = mHitPositions[hitindex];
+      } else if (mUseSCDistortions) {
         mSpaceCharge->distortElectron(posEle);
       }
 
@@ -196,6 +209,21 @@ void Digitizer::setUseSCDistortions(TFile& finp)
   mSpaceCharge->setGlobalCorrectionsFromFile(finp, Side::C);
 }
 
+void Digitizer::setUseSCDistortions(const std::string& lookupTableFile)
+{
+  auto lookupTable = std::make_unique<DistortionLookupTable>();
+  if (!lookupTable->open(lookupTableFile)) {
+    LOG(ERROR) << "Space-charge distortion lookup table " << lookupTableFile << " could not be opened";
+    return;
+  }
+  if (lookupTable->getType() != DistortionLookupTable::Type::Distortions) {
+    LOG(ERROR) << "Lookup table " << lookupTableFile << " contains corrections instead of distortions";
+    return;
+  }
+  mUseSCDistortions = true;
+  mDistortionLookupTable = std::move(lookupTable);
+}
+
 void Digitizer::setStartTime(double time)
 {
   static SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
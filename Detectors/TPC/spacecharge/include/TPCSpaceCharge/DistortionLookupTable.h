@@ -0,0 +1,130 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  DistortionLookupTable.h
+/// \brief Precomputed global distortions or corrections of both TPC sides in a flat binary file, which is memory-mapped read only
+
+#ifndef ALICEO2_TPC_DISTORTIONLOOKUPTABLE_H_
+#define ALICEO2_TPC_DISTORTIONLOOKUPTABLE_H_
+
+#include "DataFormatsTPC/Defs.h"
+#include <gsl/span>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace tpc
+{
+
+/// \class DistortionLookupTable
+/// The global distortions (or corrections) dZ, dR, dRPhi are sampled once, e.g. by SpaceCharge::writeDistortionLookupTable(), on a regular
+/// grid in |z|, r and phi for each side of the TPC and written to a binary file as single precision floats. The three components of each
+/// vertex are stored next to each other and z is the fastest running index, so that the 8 vertices needed for the trilinear interpolation
+/// of a point are read from 4 contiguous blocks of 24 bytes.
+/// The file is memory-mapped read only: the pages are shared through the page cache by all processes using the same file (e.g. the
+/// digitizer lanes) and are only read from disk when accessed. The spacing of the table should be chosen finer than the one of the
+/// SpaceCharge grid, since trilinear interpolation replaces the tricubic one.
+///
+/// Layout of the file: Header, values of the A side, values of the C side. The values of one side are indexed by
+/// 3 * (iz + nZ * (ir + nR * iphi)) + {0: dZ, 1: dR, 2: dRPhi}.
+class DistortionLookupTable
+{
+ public:
+  enum class Type : uint32_t {
+    Distortions = 0, ///< global distortions
+    Corrections = 1  ///< global corrections
+  };
+
+  struct Header {
+    char magic[8];    ///< file identifier "O2TPCLUT"
+    uint32_t version; ///< version of the file layout
+    Type type;        ///< distortions or corrections
+    uint32_t nZ;      ///< number of vertices in |z|
+    uint32_t nR;      ///< number of vertices in r
+    uint32_t nPhi;    ///< number of vertices in phi (periodic, phi_i = i * 2 pi / nPhi)
+    float zMax;       ///< |z| of the last vertex in z, the first one is at z = 0
+    float rMin;       ///< radius of the first vertex in r
+    float rMax;       ///< radius of the last vertex in r
+    char reserved[24];
+  };
+  static_assert(sizeof(Header) == 64, "the values are expected to start at a 64 byte boundary");
+
+  static constexpr char MAGIC[8]{'O', '2', 'T', 'P', 'C', 'L', 'U', 'T'};
+  static constexpr uint32_t VERSION{1};
+  static constexpr int NVALUES{3}; ///< dZ, dR, dRPhi per vertex
+
+  DistortionLookupTable() = default;
+  ~DistortionLookupTable();
+  DistortionLookupTable(const DistortionLookupTable&) = delete;
+  DistortionLookupTable& operator=(const DistortionLookupTable&) = delete;
+
+  /// write a lookup table
+  /// \param file output file
+  /// \param header header of the table. magic and version are set by this function
+  /// \param values values of the A side followed by the values of the C side in the layout described above
+  /// \return returns true if the table was written successfully
+  static bool write(const std::string& file, Header header, const std::vector<float>& values);
+
+  /// memory-map a lookup table. A previously mapped table is unmapped
+  /// \param file file written by write()
+  /// \return returns true if the file is a valid lookup table
+  bool open(const std::string& file);
+
+  /// unmap the lookup table
+  void close();
+
+  /// \return returns if a lookup table is mapped
+  bool isOpen() const { return mValues[Side::A] != nullptr; }
+
+  const Header& getHeader() const { return *mHeader; }
+  Type getType() const { return mHeader->type; }
+
+  /// interpolate the values for a point in cylindrical coordinates
+  /// \param z global z coordinate, which also defines the side
+  /// \param r radius
+  /// \param phi phi in any range, it is wrapped to [0, 2 pi)
+  /// \param dZ returns the distortion/correction in z direction
+  /// \param dR returns the distortion/correction in r direction
+  /// \param dRPhi returns the distortion/correction in rphi direction
+  void getValuesCyl(const float z, const float r, const float phi, float& dZ, float& dR, float& dRPhi) const;
+
+  /// interpolate the values for a batch of points in cylindrical coordinates.
+  /// The points are processed in blocks and the stages of the interpolation are written as simple loops over the block, which the compiler vectorizes
+  void getValuesCyl(const size_t nPoints, const float* z, const float* r, const float* phi, float* dZ, float* dR, float* dRPhi) const;
+
+  /// move a point by the interpolated distortion (or correction)
+  /// \param point global cartesian coordinates of the point
+  void apply(GlobalPosition3D& point) const;
+
+  /// move a batch of points by the interpolated distortions (or corrections)
+  /// \param points global cartesian coordinates of the points
+  void apply(gsl::span<GlobalPosition3D> points) const;
+
+ private:
+  static constexpr int BLOCKSIZE{64}; ///< number of points which are processed together in the batched interpolation
+
+  const Header* mHeader{nullptr};                ///< header of the mapped file
+  const float* mValues[SIDES]{nullptr, nullptr}; ///< values of the A and C side
+  void* mMappedAddress{nullptr};                 ///< start of the mapped file
+  size_t mMappedSize{0};                         ///< size of the mapped file
+  float mInvSpacingZ{0};                         ///< inverse spacing in |z|
+  float mInvSpacingR{0};                         ///< inverse spacing in r
+  float mInvSpacingPhi{0};                       ///< inverse spacing in phi
+  float mMaxIndexZ{0};                           ///< largest relative position in |z| which is interpolated (the grid is clamped above)
+  float mMaxIndexR{0};                           ///< largest relative position in r which is interpolated (the grid is clamped above)
+};
+
+} // namespace tpc
+} // namespace o2
+
+#endif
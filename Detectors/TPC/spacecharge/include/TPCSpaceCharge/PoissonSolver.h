@@ -86,17 +86,23 @@ class PoissonSolver
 
   static DataT getConvergenceError() { return sConvergenceError; }
 
-  /// get the number of threads used for some of the calculations
+  /// get the number of threads used for the calculations
   static int getNThreads() { return sNThreads; }
 
-  /// set the number of threads used for some of the calculations
+  /// set the number of threads used for the calculations. The phi slices are distributed over the threads, the result does not depend on the number of threads
   static void setNThreads(int nThreads) { sNThreads = nThreads; }
 
  private:
   const RegularGrid& mGrid3D{};                                      ///< grid properties
   inline static DataT sConvergenceError{1e-6};                       ///< Error tolerated
   static constexpr DataT INVTWOPI = 1. / o2::constants::math::TwoPI; ///< inverse of 2*pi
-  inline static int sNThreads{4};                                    ///< number of threads which are used during some of the calculations (increasing this number has no big impact)
+  inline static int sNThreads{1};                                    ///< number of threads which are used during the relaxation, restriction, interpolation and residue calculations
+  static constexpr size_t MinPointsParallel = 1 << 15;               ///< multigrid levels with less points are processed by one thread, the parallel overhead would dominate
+  static constexpr size_t RelaxTileBytes = 1 << 16;                  ///< size of the rows of the potential, of its neighbouring phi slices and of the charge relaxed as one tile
+
+  /// \param nPoints number of points of the multigrid level
+  /// \return number of threads used for the calculations of the level
+  static int getNThreadsLevel(const size_t nPoints) { return nPoints < MinPointsParallel ? 1 : sNThreads; }
 
   /// Relative error calculation: comparison with exact solution
   ///
@@ -23,6 +23,7 @@
 #include "TPCSpaceCharge/SpaceChargeHelpers.h"
 #include "TPCSpaceCharge/RegularGrid3D.h"
 #include "TPCSpaceCharge/DataContainer3D.h"
+#include "TPCSpaceCharge/DistortionLookupTable.h"
 
 #include "TPCBase/ParameterGas.h"
 #include "Field/MagneticField.h"
@@ -289,6 +290,16 @@ class SpaceCharge
   /// \param side side of the TPC
   void setDistortionLookupTables(const DataContainer& distdZ, const DataContainer& distdR, const DataContainer& distdRPhi, const Side side);
 
+  /// write the global distortions or corrections of both sides to a lookup table, which is memory-mapped by DistortionLookupTable.
+  /// The values are sampled with the tricubic interpolators on a regular grid, which should be finer than the grid of this object since the lookup table is interpolated trilinearly.
+  /// \param file output file
+  /// \param type write the global distortions or the global corrections
+  /// \param nZ number of vertices of the lookup table in z
+  /// \param nR number of vertices of the lookup table in r
+  /// \param nPhi number of vertices of the lookup table in phi
+  /// \return returns true if the lookup table was written
+  bool writeDistortionLookupTable(const std::string& file, const Type type = Type::Distortions, const size_t nZ = 2 * Nz - 1, const size_t nR = 2 * Nr - 1, const size_t nPhi = Nphi) const;
+
   /// set the density, potential, electric fields, local distortions/corrections, global distortions/corrections from a file. Missing objects in the file are ignored.
   /// \file file containing the stored values for the density, potential, electric fields, local distortions/corrections, global distortions/corrections
   /// \param side side of the TPC
@@ -559,6 +570,7 @@ class SpaceCharge
   {
     sNThreads = nThreads;
     o2::tpc::TriCubicInterpolator<DataT, Nz, Nr, Nphi>::setNThreads(nThreads);
+    ASolv::setNThreads(nThreads);
   }
 
   /// set which kind of numerical integration is used for calcution of the integrals int Er/Ez dz, int Ephi/Ez dz, int Ez dz
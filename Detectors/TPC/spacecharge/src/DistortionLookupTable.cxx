@@ -0,0 +1,216 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  DistortionLookupTable.cxx
+/// \brief Implementation of the memory-mapped lookup table for the global distortions and corrections
+
+#include "TPCSpaceCharge/DistortionLookupTable.h"
+#include "CommonConstants/MathConstants.h"
+#include "Framework/Logger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace o2::tpc;
+
+namespace
+{
+inline float lerp(const float a, const float b, const float t) { return a + t * (b - a); }
+} // namespace
+
+DistortionLookupTable::~DistortionLookupTable()
+{
+  close();
+}
+
+bool DistortionLookupTable::write(const std::string& file, Header header, const std::vector<float>& values)
+{
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  std::memset(header.reserved, 0, sizeof(header.reserved));
+  const size_t nValues = size_t(SIDES) * NVALUES * header.nZ * header.nR * header.nPhi;
+  if (header.nZ < 2 || header.nR < 2 || header.nPhi < 1 || values.size() != nValues) {
+    LOGP(ERROR, "Lookup table with {}x{}x{} vertices requires {} values, but {} are given", header.nZ, header.nR, header.nPhi, nValues, values.size());
+    return false;
+  }
+  std::ofstream out(file, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+  if (!out) {
+    LOGP(ERROR, "Failed to write lookup table to {}", file);
+    return false;
+  }
+  return true;
+}
+
+bool DistortionLookupTable::open(const std::string& file)
+{
+  close();
+  const int fd = ::open(file.data(), O_RDONLY);
+  if (fd < 0) {
+    LOGP(ERROR, "Failed to open lookup table {}: {}", file, std::strerror(errno));
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(Header)) {
+    LOGP(ERROR, "{} is not a lookup table", file);
+    ::close(fd);
+    return false;
+  }
+  void* address = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd); // the mapping stays valid
+  if (address == MAP_FAILED) {
+    LOGP(ERROR, "Failed to map lookup table {}: {}", file, std::strerror(errno));
+    return false;
+  }
+  mMappedAddress = address;
+  mMappedSize = st.st_size;
+
+  const auto header = static_cast<const Header*>(address);
+  const size_t nValuesSide = size_t(NVALUES) * header->nZ * header->nR * header->nPhi;
+  if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION) {
+    LOGP(ERROR, "{} is not a lookup table of version {}", file, VERSION);
+    close();
+    return false;
+  }
+  if (header->nZ < 2 || header->nR < 2 || header->nPhi < 1 || mMappedSize != sizeof(Header) + SIDES * nValuesSide * sizeof(float)) {
+    LOGP(ERROR, "Size of lookup table {} ({} bytes) does not match its {}x{}x{} vertices", file, mMappedSize, header->nZ, header->nR, header->nPhi);
+    close();
+    return false;
+  }
+
+  mHeader = header;
+  mValues[Side::A] = reinterpret_cast<const float*>(static_cast<const char*>(address) + sizeof(Header));
+  mValues[Side::C] = mValues[Side::A] + nValuesSide;
+  mInvSpacingZ = (header->nZ - 1) / header->zMax;
+  mInvSpacingR = (header->nR - 1) / (header->rMax - header->rMin);
+  mInvSpacingPhi = header->nPhi / static_cast<float>(o2::constants::math::TwoPI);
+  mMaxIndexZ = header->nZ - 1;
+  mMaxIndexR = header->nR - 1;
+  // the values are only read when accessed, random access is expected during the interpolation
+  madvise(address, mMappedSize, MADV_RANDOM);
+  return true;
+}
+
+void DistortionLookupTable::close()
+{
+  if (mMappedAddress) {
+    munmap(mMappedAddress, mMappedSize);
+  }
+  mMappedAddress = nullptr;
+  mMappedSize = 0;
+  mHeader = nullptr;
+  mValues[Side::A] = mValues[Side::C] = nullptr;
+}
+
+void DistortionLookupTable::getValuesCyl(const float z, const float r, const float phi, float& dZ, float& dR, float& dRPhi) const
+{
+  float values[NVALUES];
+  getValuesCyl(1, &z, &r, &phi, &values[0], &values[1], &values[2]);
+  dZ = values[0];
+  dR = values[1];
+  dRPhi = values[2];
+}
+
+void DistortionLookupTable::getValuesCyl(const size_t nPoints, const float* z, const float* r, const float* phi, float* dZ, float* dR, float* dRPhi) const
+{
+  const size_t nZ = mHeader->nZ;
+  const size_t nR = mHeader->nR;
+  const int nPhi = mHeader->nPhi;
+  const float fNPhi = nPhi;
+  const size_t offsetC = mValues[Side::C] - mValues[Side::A];
+  const float rMin = mHeader->rMin;
+  const float* values = mValues[Side::A];
+
+  // position of the points relative to the grid: index of the first value of the vertices (iz, ir, iphi) and (iz, ir, iphi + 1) and the weights of the upper vertices
+  size_t index0[BLOCKSIZE];
+  size_t index1[BLOCKSIZE];
+  float tZ[BLOCKSIZE];
+  float tR[BLOCKSIZE];
+  float tPhi[BLOCKSIZE];
+  for (size_t first = 0; first < nPoints; first += BLOCKSIZE) {
+    const size_t nBlock = std::min(size_t(BLOCKSIZE), nPoints - first);
+
+    // cell and weights of each point
+    for (size_t i = 0; i < nBlock; ++i) {
+      const size_t ip = first + i;
+      const float posZ = std::clamp(std::abs(z[ip]) * mInvSpacingZ, 0.f, mMaxIndexZ);
+      const float posR = std::clamp((r[ip] - rMin) * mInvSpacingR, 0.f, mMaxIndexR);
+      float posPhi = phi[ip] * mInvSpacingPhi;
+      posPhi -= fNPhi * std::floor(posPhi / fNPhi);
+      const int iZ = std::min(static_cast<int>(posZ), static_cast<int>(nZ) - 2);
+      const int iR = std::min(static_cast<int>(posR), static_cast<int>(nR) - 2);
+      const int iPhi = std::min(static_cast<int>(posPhi), nPhi - 1); // posPhi can be rounded to nPhi
+      const int iPhi1 = (iPhi + 1 == nPhi) ? 0 : iPhi + 1;
+      const size_t offsetSide = (z[ip] < 0) ? offsetC : 0;
+      index0[i] = offsetSide + NVALUES * (iZ + nZ * (iR + nR * iPhi));
+      index1[i] = offsetSide + NVALUES * (iZ + nZ * (iR + nR * iPhi1));
+      tZ[i] = posZ - iZ;
+      tR[i] = posR - iR;
+      tPhi[i] = posPhi - iPhi;
+    }
+
+    // trilinear interpolation of each component
+    const size_t deltaR = NVALUES * nZ;
+    float* out[NVALUES]{dZ + first, dR + first, dRPhi + first};
+    for (int val = 0; val < NVALUES; ++val) {
+      const float* data = values + val;
+      float* res = out[val];
+      for (size_t i = 0; i < nBlock; ++i) {
+        const float* v0 = data + index0[i];
+        const float* v1 = data + index1[i];
+        const float c00 = lerp(v0[0], v0[NVALUES], tZ[i]);
+        const float c01 = lerp(v0[deltaR], v0[deltaR + NVALUES], tZ[i]);
+        const float c10 = lerp(v1[0], v1[NVALUES], tZ[i]);
+        const float c11 = lerp(v1[deltaR], v1[deltaR + NVALUES], tZ[i]);
+        res[i] = lerp(lerp(c00, c01, tR[i]), lerp(c10, c11, tR[i]), tPhi[i]);
+      }
+    }
+  }
+}
+
+void DistortionLookupTable::apply(GlobalPosition3D& point) const
+{
+  apply(gsl::span<GlobalPosition3D>(&point, 1));
+}
+
+void DistortionLookupTable::apply(gsl::span<GlobalPosition3D> points) const
+{
+  float z[BLOCKSIZE];
+  float radius[BLOCKSIZE];
+  float phi[BLOCKSIZE];
+  float dZ[BLOCKSIZE];
+  float dR[BLOCKSIZE];
+  float dRPhi[BLOCKSIZE];
+  for (size_t first = 0; first < points.size(); first += BLOCKSIZE) {
+    const size_t nBlock = std::min(size_t(BLOCKSIZE), points.size() - first);
+    for (size_t i = 0; i < nBlock; ++i) {
+      const auto& point = points[first + i];
+      z[i] = point.Z();
+      radius[i] = std::sqrt(point.X() * point.X() + point.Y() * point.Y());
+      phi[i] = std::atan2(point.Y(), point.X());
+    }
+    getValuesCyl(nBlock, z, radius, phi, dZ, dR, dRPhi);
+    for (size_t i = 0; i < nBlock; ++i) {
+      const float radiusNew = radius[i] + dR[i];
+      const float phiNew = phi[i] + dRPhi[i] / radius[i];
+      points[first + i].SetXYZ(radiusNew * std::cos(phiNew), radiusNew * std::sin(phiNew), z[i] + dZ[i]);
+    }
+  }
+}
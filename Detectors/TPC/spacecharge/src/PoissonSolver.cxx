@@ -255,6 +255,7 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::poissonMultiGrid3D2D(DataContainer& mat
     tvCharge[count - 1].resize(tnRRow, tnZColumn, Nphi);
 
     if (count == 1) {
+#pragma omp parallel for num_threads(sNThreads)
       for (int iphi = 0; iphi < Nphi; ++iphi) {
         for (int ir = 0; ir < Nr; ++ir) {
           for (int iz = 0; iz < Nz; ++iz) {
@@ -329,6 +330,7 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::poissonMultiGrid3D2D(DataContainer& mat
   }
 
   // fill output
+#pragma omp parallel for num_threads(sNThreads)
   for (int iphi = 0; iphi < Nphi; ++iphi) {
     for (int ir = 0; ir < Nr; ++ir) {
       for (int iz = 0; iz < Nz; ++iz) {
@@ -427,6 +429,7 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::poissonMultiGrid3D(DataContainer& matri
 
     // memory for the finest grid is from parameters
     if (count == 1) {
+#pragma omp parallel for num_threads(sNThreads)
       for (int iphi = 0; iphi < Nphi; ++iphi) {
         for (int ir = 0; ir < Nr; ++ir) {
           for (int iz = 0; iz < Nz; ++iz) {
@@ -557,6 +560,7 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::poissonMultiGrid3D(DataContainer& matri
   }
 
   // fill output
+#pragma omp parallel for num_threads(sNThreads)
   for (int iphi = 0; iphi < Nphi; ++iphi) {
     for (int ir = 0; ir < Nr; ++ir) {
       for (int iz = 0; iz < Nz; ++iz) {
@@ -910,7 +914,7 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::residue2D(Vector& residue, const Vector
                                                    const DataT tempRatio, std::vector<DataT>& coefficient1, std::vector<DataT>& coefficient2)
 {
   const int iPhi = 0;
-#pragma omp parallel for num_threads(sNThreads)
+#pragma omp parallel for num_threads(getNThreadsLevel(tnRRow * tnZColumn))
   for (int i = 1; i < tnRRow - 1; ++i) {
     for (int j = 1; j < tnZColumn - 1; ++j) {
       residue(i, j, iPhi) = ih2 * (coefficient1[i] * matricesCurrentV(i + 1, j, iPhi) + coefficient2[i] * matricesCurrentV(i - 1, j, iPhi) + tempRatio * (matricesCurrentV(i, j + 1, iPhi) + matricesCurrentV(i, j - 1, iPhi)) - inverseTempFourth * matricesCurrentV(i, j, iPhi)) + matricesCurrentCharge(i, j, iPhi);
@@ -931,7 +935,7 @@ template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
 void PoissonSolver<DataT, Nz, Nr, Nphi>::residue3D(Vector& residue, const Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const int tnPhi, const int symmetry,
                                                    const DataT ih2, const DataT tempRatioZ, const std::array<DataT, Nr>& coefficient1, const std::array<DataT, Nr>& coefficient2, const std::array<DataT, Nr>& coefficient3, const std::array<DataT, Nr>& inverseCoefficient4) const
 {
-#pragma omp parallel for num_threads(sNThreads) // parallising this loop is possible - but using more than 2 cores makes it slower -
+#pragma omp parallel for num_threads(getNThreadsLevel(tnRRow * tnZColumn * tnPhi))
   for (int m = 0; m < tnPhi; ++m) {
     int mp1 = m + 1;
     int signPlus = 1;
@@ -981,6 +985,8 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::interp3D(Vector& matricesCurrentV, cons
 {
   // Do restrict 2 D for each slice
   if (newPhiSlice == 2 * oldPhiSlice) {
+    // each coarse slice is interpolated to the fine slices m and m + 1
+#pragma omp parallel for num_threads(getNThreadsLevel(tnRRow * tnZColumn * newPhiSlice))
     for (int m = 0; m < newPhiSlice; m += 2) {
       // assuming no symmetry
       int mm = m * 0.5;
@@ -1038,7 +1044,7 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::interp3D(Vector& matricesCurrentV, cons
     }
 
   } else {
-#pragma omp parallel for num_threads(sNThreads) // no change
+#pragma omp parallel for num_threads(getNThreadsLevel(tnRRow * tnZColumn * newPhiSlice)) // no change
     for (int m = 0; m < newPhiSlice; ++m) {
       interp2D(matricesCurrentV, matricesCurrentVC, tnRRow, tnZColumn, m);
     }
@@ -1087,6 +1093,8 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::addInterp3D(Vector& matricesCurrentV, c
 {
   // Do restrict 2 D for each slice
   if (newPhiSlice == 2 * oldPhiSlice) {
+    // each coarse slice is interpolated to the fine slices m and m + 1
+#pragma omp parallel for num_threads(getNThreadsLevel(tnRRow * tnZColumn * newPhiSlice))
     for (int m = 0; m < newPhiSlice; m += 2) {
       // assuming no symmetry
       int mm = m * 0.5;
@@ -1144,7 +1152,7 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::addInterp3D(Vector& matricesCurrentV, c
     }
 
   } else {
-#pragma omp parallel for num_threads(sNThreads) // no change
+#pragma omp parallel for num_threads(getNThreadsLevel(tnRRow * tnZColumn * newPhiSlice)) // no change
     for (int m = 0; m < newPhiSlice; m++) {
       addInterp2D(matricesCurrentV, matricesCurrentVC, tnRRow, tnZColumn, m);
     }
@@ -1192,52 +1200,74 @@ template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
 void PoissonSolver<DataT, Nz, Nr, Nphi>::relax3D(Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const int iPhi, const int symmetry, const DataT h2,
                                                  const DataT tempRatioZ, const std::array<DataT, Nr>& coefficient1, const std::array<DataT, Nr>& coefficient2, const std::array<DataT, Nr>& coefficient3, const std::array<DataT, Nr>& coefficient4) const
 {
-  // Gauss-Seidel (Read Black}
+  // Gauss-Seidel (Red Black)
   if (MGParameters::relaxType == RelaxType::GaussSeidel) {
-    // for each slice
+    // relax the points of one colour in the z columns [jFirst, jLast) of phi slice m
+    const auto relaxSlice = [&](const int m, const int msw, const int jFirst, const int jLast) {
+      const int jsw = ((msw + m) % 2) ? 1 : 2;
+      int mp1 = m + 1;
+      int signPlus = 1;
+      int mm1 = m - 1;
+      int signMinus = 1;
+      // Reflection symmetry in phi (e.g. symmetry at sector boundaries, or half sectors, etc.)
+      if (symmetry == 1) {
+        if (mp1 > iPhi - 1) {
+          mp1 = iPhi - 2;
+        }
+        if (mm1 < 0) {
+          mm1 = 1;
+        }
+      }
+      // Anti-symmetry in phi
+      else if (symmetry == -1) {
+        if (mp1 > iPhi - 1) {
+          mp1 = iPhi - 2;
+          signPlus = -1;
+        }
+        if (mm1 < 0) {
+          mm1 = 1;
+          signMinus = -1;
+        }
+      } else { // No Symmetries in phi, no boundaries, the calculation is continuous across all phi
+        if (mp1 > iPhi - 1) {
+          mp1 = m + 1 - iPhi;
+        }
+        if (mm1 < 0) {
+          mm1 = m - 1 + iPhi;
+        }
+      }
+      int isw = ((jFirst - 1) % 2) ? 3 - jsw : jsw;
+      for (int j = jFirst; j < jLast; ++j, isw = 3 - isw) {
+        for (int i = isw; i < tnRRow - 1; i += 2) {
+          (matricesCurrentV)(i, j, m) = (coefficient2[i] * (matricesCurrentV)(i - 1, j, m) + tempRatioZ * ((matricesCurrentV)(i, j - 1, m) + (matricesCurrentV)(i, j + 1, m)) + coefficient1[i] * (matricesCurrentV)(i + 1, j, m) + coefficient3[i] * (signPlus * (matricesCurrentV)(i, j, mp1) + signMinus * (matricesCurrentV)(i, j, mm1)) + (h2 * (matricesCurrentCharge)(i, j, m))) * coefficient4[i];
+        } // end cols
+      }   // end Nr
+    };
+
+    // The points of one colour depend only on points of the other colour, so within a sweep they can be relaxed in any order.
+    // Each thread keeps the same contiguous block of slices in both sweeps and relaxes it tile by tile, a tile being a block of z
+    // columns (of full r rows) of all its slices: the rows of the neighbouring slices and of the charge are then reused from the cache.
+    // Without symmetry and with an odd number of slices the first and the last slice have the same colour across the phi boundary:
+    // the last slice is then relaxed after all others, which gives the same result as relaxing the slices one after the other.
+    const int nPhiParallel = (symmetry == 0 && (iPhi % 2)) ? iPhi - 1 : iPhi;
+    const int tileColumns = std::max(2, static_cast<int>(RelaxTileBytes / (4 * tnRRow * sizeof(DataT))));
+#pragma omp parallel num_threads(getNThreadsLevel(tnRRow * tnZColumn * iPhi))
     for (int iPass = 1; iPass <= 2; ++iPass) {
       const int msw = (iPass % 2) ? 1 : 2;
-      for (int m = 0; m < iPhi; ++m) {
-        const int jsw = ((msw + m) % 2) ? 1 : 2;
-        int mp1 = m + 1;
-        int signPlus = 1;
-        int mm1 = m - 1;
-        int signMinus = 1;
-        // Reflection symmetry in phi (e.g. symmetry at sector boundaries, or half sectors, etc.)
-        if (symmetry == 1) {
-          if (mp1 > iPhi - 1) {
-            mp1 = iPhi - 2;
-          }
-          if (mm1 < 0) {
-            mm1 = 1;
-          }
-        }
-        // Anti-symmetry in phi
-        else if (symmetry == -1) {
-          if (mp1 > iPhi - 1) {
-            mp1 = iPhi - 2;
-            signPlus = -1;
-          }
-          if (mm1 < 0) {
-            mm1 = 1;
-            signMinus = -1;
-          }
-        } else { // No Symmetries in phi, no boundaries, the calculation is continuous across all phi
-          if (mp1 > iPhi - 1) {
-            mp1 = m + 1 - iPhi;
-          }
-          if (mm1 < 0) {
-            mm1 = m - 1 + iPhi;
-          }
+      for (int jFirst = 1; jFirst < tnZColumn - 1; jFirst += tileColumns) {
+        const int jLast = std::min(jFirst + tileColumns, tnZColumn - 1);
+        // the static schedule assigns the same slices to a thread for all tiles
+#pragma omp for schedule(static) nowait
+        for (int m = 0; m < nPhiParallel; ++m) {
+          relaxSlice(m, msw, jFirst, jLast);
         }
-        int isw = jsw;
-        for (int j = 1; j < tnZColumn - 1; ++j, isw = 3 - isw) {
-          for (int i = isw; i < tnRRow - 1; i += 2) {
-            (matricesCurrentV)(i, j, m) = (coefficient2[i] * (matricesCurrentV)(i - 1, j, m) + tempRatioZ * ((matricesCurrentV)(i, j - 1, m) + (matricesCurrentV)(i, j + 1, m)) + coefficient1[i] * (matricesCurrentV)(i + 1, j, m) + coefficient3[i] * (signPlus * (matricesCurrentV)(i, j, mp1) + signMinus * (matricesCurrentV)(i, j, mm1)) + (h2 * (matricesCurrentCharge)(i, j, m))) * coefficient4[i];
-          } // end cols
-        }   // end Nr
-      }     // end phi
-    }       // end sweep
+      }
+#pragma omp barrier
+#pragma omp single
+      for (int m = nPhiParallel; m < iPhi; ++m) {
+        relaxSlice(m, msw, 1, tnZColumn - 1);
+      }
+    } // end sweep
   } else if (MGParameters::relaxType == RelaxType::Jacobi) {
     // for each slice
     for (int m = 0; m < iPhi; ++m) {
@@ -1361,8 +1391,9 @@ template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
 void PoissonSolver<DataT, Nz, Nr, Nphi>::restrict3D(Vector& matricesCurrentCharge, const Vector& residue, const int tnRRow, const int tnZColumn, const int newPhiSlice, const int oldPhiSlice) const
 {
   if (2 * newPhiSlice == oldPhiSlice) {
-    int mm = 0;
-    for (int m = 0; m < newPhiSlice; m++, mm += 2) {
+#pragma omp parallel for num_threads(getNThreadsLevel(tnRRow * tnZColumn * newPhiSlice))
+    for (int m = 0; m < newPhiSlice; m++) {
+      const int mm = 2 * m;
       // assuming no symmetry
       int mp1 = mm + 1;
       int mm1 = mm - 1;
@@ -1409,6 +1440,7 @@ void PoissonSolver<DataT, Nz, Nr, Nphi>::restrict3D(Vector& matricesCurrentCharg
     } // end phis
 
   } else {
+#pragma omp parallel for num_threads(getNThreadsLevel(tnRRow * tnZColumn * newPhiSlice))
     for (int m = 0; m < newPhiSlice; ++m) {
       restrict2D(matricesCurrentCharge, residue, tnRRow, tnZColumn, m);
     }
@@ -1451,15 +1483,14 @@ DataT PoissonSolver<DataT, Nz, Nr, Nphi>::getConvergenceError(const Vector& matr
 {
   std::vector<DataT> errorArr(prevArrayV.getNphi());
 
-  // subtract the two matrices
-  std::transform(prevArrayV.begin(), prevArrayV.end(), matricesCurrentV.begin(), prevArrayV.begin(), std::minus<DataT>());
-
-#pragma omp parallel for num_threads(sNThreads) // parallising this loop is possible - but using more than 2 cores makes it slower -
+#pragma omp parallel for num_threads(getNThreadsLevel(prevArrayV.getNr() * prevArrayV.getNz() * prevArrayV.getNphi()))
   for (unsigned int m = 0; m < prevArrayV.getNphi(); ++m) {
-    // square each entry in the vector and sum them up
     const auto phiStep = prevArrayV.getNr() * prevArrayV.getNz(); // number of points in one phi slice
     const auto start = prevArrayV.begin() + m * phiStep;
     const auto end = start + phiStep;
+    // subtract the two matrices
+    std::transform(start, end, matricesCurrentV.begin() + m * phiStep, start, std::minus<DataT>());
+    // square each entry in the vector and sum them up
     errorArr[m] = std::inner_product(start, end, start, 0.); // inner product "Sum (matrix[a]*matrix[a])"
   }
   // return largest error
@@ -1362,6 +1362,51 @@ void SpaceCharge<DataT, Nz, Nr, Nphi>::setDistortionLookupTables(const DataConta
   mIsGlobalDistSet[side] = true;
 }
 
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+bool SpaceCharge<DataT, Nz, Nr, Nphi>::writeDistortionLookupTable(const std::string& file, const Type type, const size_t nZ, const size_t nR, const size_t nPhi) const
+{
+  const bool isDist = type == Type::Distortions;
+  for (const auto side : {Side::A, Side::C}) {
+    if (isDist ? !mIsGlobalDistSet[side] : !mIsGlobalCorrSet[side]) {
+      LOGP(warning, "============== global {} of side {} are not set! returning ==============\n", isDist ? "distortions" : "corrections", getSideName(side));
+      return false;
+    }
+  }
+
+  DistortionLookupTable::Header header{};
+  header.type = isDist ? DistortionLookupTable::Type::Distortions : DistortionLookupTable::Type::Corrections;
+  header.nZ = nZ;
+  header.nR = nR;
+  header.nPhi = nPhi;
+  header.zMax = GridProp::ZMAX;
+  header.rMin = GridProp::RMIN;
+  header.rMax = GridProp::RMAX;
+
+  const size_t nValuesSide = DistortionLookupTable::NVALUES * nZ * nR * nPhi;
+  std::vector<float> values(SIDES * nValuesSide);
+  const DataT spacingZ = GridProp::ZMAX / (nZ - 1);
+  const DataT spacingR = (GridProp::RMAX - GridProp::RMIN) / (nR - 1);
+  const DataT spacingPhi = GridProp::PHIMAX / nPhi;
+  for (const auto side : {Side::A, Side::C}) {
+    const auto& interpolator = isDist ? mInterpolatorGlobalDist[side] : mInterpolatorGlobalCorr[side];
+#pragma omp parallel for num_threads(sNThreads)
+    for (size_t iPhi = 0; iPhi < nPhi; ++iPhi) {
+      const DataT phi = iPhi * spacingPhi;
+      for (size_t iR = 0; iR < nR; ++iR) {
+        const DataT radius = GridProp::RMIN + iR * spacingR;
+        float* vals = values.data() + side * nValuesSide + DistortionLookupTable::NVALUES * nZ * (iR + nR * iPhi);
+        for (size_t iZ = 0; iZ < nZ; ++iZ) {
+          const DataT z = getSign(side) * (iZ * spacingZ);
+          *vals++ = interpolator.evaldZ(z, radius, phi);
+          *vals++ = interpolator.evaldR(z, radius, phi);
+          *vals++ = interpolator.evaldRPhi(z, radius, phi);
+        }
+      }
+    }
+  }
+  return DistortionLookupTable::write(file, header, values);
+}
+
 using DataTD = double;
 template class o2::tpc::SpaceCharge<DataTD, 17, 17, 90>;
 template class o2::tpc::SpaceCharge<DataTD, 33, 33, 180>;
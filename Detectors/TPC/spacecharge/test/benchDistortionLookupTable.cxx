@@ -0,0 +1,130 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  benchDistortionLookupTable.cxx
+/// \brief Distortion of electron positions with the tricubic interpolation of the SpaceCharge class (129x129x180 grid, as used in the digitizer)
+///        compared to the memory-mapped lookup table with single and batched trilinear interpolation.
+///        The maximum deviation of the lookup table from the tricubic interpolation is reported as a counter.
+
+#include "benchmark/benchmark.h"
+#include "TPCSpaceCharge/SpaceCharge.h"
+#include "TPCSpaceCharge/DistortionLookupTable.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <random>
+
+using namespace o2::tpc;
+
+using DataT = double;
+using SC = SpaceCharge<DataT, 129, 129, 180>;
+
+struct Setup {
+  std::unique_ptr<SC> spaceCharge = std::make_unique<SC>();
+  DistortionLookupTable lookupTable;
+  std::vector<GlobalPosition3D> points;
+  const std::string file = (std::filesystem::temp_directory_path() / "benchDistortionLookupTable.bin").string();
+
+  Setup()
+  {
+    // smooth global distortions of the order of 1 cm
+    for (const auto side : {Side::A, Side::C}) {
+      DataContainer3D<DataT, 129, 129, 180> distdZ;
+      DataContainer3D<DataT, 129, 129, 180> distdR;
+      DataContainer3D<DataT, 129, 129, 180> distdRPhi;
+      for (size_t iPhi = 0; iPhi < 180; ++iPhi) {
+        const DataT phi = spaceCharge->getPhiVertex(iPhi, side);
+        for (size_t iR = 0; iR < 129; ++iR) {
+          const DataT radius = spaceCharge->getRVertex(iR, side);
+          for (size_t iZ = 0; iZ < 129; ++iZ) {
+            const DataT z = spaceCharge->getZVertex(iZ, side);
+            distdZ(iZ, iR, iPhi) = 0.2 * std::cos(phi) * z / 250;
+            distdR(iZ, iR, iPhi) = std::sin(3 * phi) * std::exp(-(radius - 85) / 30) * std::abs(z) / 250;
+            distdRPhi(iZ, iR, iPhi) = 0.3 * std::sin(2 * phi) * std::exp(-(radius - 85) / 30);
+          }
+        }
+      }
+      spaceCharge->setDistortionLookupTables(distdZ, distdR, distdRPhi, side);
+    }
+    spaceCharge->writeDistortionLookupTable(file);
+    lookupTable.open(file);
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> distZ(-spaceCharge->getZMax(Side::A), spaceCharge->getZMax(Side::A));
+    std::uniform_real_distribution<float> distR(spaceCharge->getRMin(Side::A), spaceCharge->getRMax(Side::A));
+    std::uniform_real_distribution<float> distPhi(-M_PI, M_PI);
+    for (int i = 0; i < 100000; ++i) {
+      const float radius = distR(rng);
+      const float phi = distPhi(rng);
+      points.emplace_back(radius * std::cos(phi), radius * std::sin(phi), distZ(rng));
+    }
+  }
+
+  ~Setup() { std::filesystem::remove(file); }
+};
+
+Setup& getSetup()
+{
+  static Setup setup;
+  return setup;
+}
+
+static void BM_TriCubic(benchmark::State& state)
+{
+  auto& setup = getSetup();
+  for (auto _ : state) {
+    for (auto point : setup.points) {
+      setup.spaceCharge->distortElectron(point);
+      benchmark::DoNotOptimize(point);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * setup.points.size());
+}
+
+static void BM_LookupTable(benchmark::State& state)
+{
+  auto& setup = getSetup();
+  for (auto _ : state) {
+    for (auto point : setup.points) {
+      setup.lookupTable.apply(point);
+      benchmark::DoNotOptimize(point);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * setup.points.size());
+}
+
+static void BM_LookupTableBatch(benchmark::State& state)
+{
+  auto& setup = getSetup();
+  auto points = setup.points;
+  for (auto _ : state) {
+    state.PauseTiming();
+    points = setup.points;
+    state.ResumeTiming();
+    setup.lookupTable.apply(points);
+    benchmark::DoNotOptimize(points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * setup.points.size());
+
+  float maxDeviation = 0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    auto reference = setup.points[i];
+    setup.spaceCharge->distortElectron(reference);
+    maxDeviation = std::max({maxDeviation, std::abs(points[i].X() - reference.X()), std::abs(points[i].Y() - reference.Y()), std::abs(points[i].Z() - reference.Z())});
+  }
+  state.counters["max_deviation_cm"] = maxDeviation;
+}
+
+BENCHMARK(BM_TriCubic)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LookupTable)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LookupTableBatch)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
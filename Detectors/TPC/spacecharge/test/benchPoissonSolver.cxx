@@ -0,0 +1,73 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  benchPoissonSolver.cxx
+/// \brief Scaling of the 3D multi grid Poisson solver with the number of threads on the
+///        129x129x180 grid, using the charge density and the boundary potential of AnalyticalFields
+
+#include "benchmark/benchmark.h"
+#include "TPCSpaceCharge/PoissonSolver.h"
+#include "TPCSpaceCharge/SpaceChargeHelpers.h"
+
+using namespace o2::tpc;
+
+using DataT = double;
+static constexpr size_t NZ = 129;
+static constexpr size_t NR = 129;
+static constexpr size_t NPHI = 180;
+using GridProp = GridProperties<DataT, NZ, NR, NPHI>;
+using DataContainer = DataContainer3D<DataT, NZ, NR, NPHI>;
+using Grid = RegularGrid3D<DataT, NZ, NR, NPHI>;
+
+const Grid& getGrid()
+{
+  static const Grid grid{GridProp::ZMIN, GridProp::RMIN, GridProp::PHIMIN, GridProp::GRIDSPACINGZ, GridProp::GRIDSPACINGR, GridProp::GRIDSPACINGPHI};
+  return grid;
+}
+
+// charge density everywhere and the potential on the boundary of the grid
+void setInput(DataContainer& charge, DataContainer& potential)
+{
+  const AnalyticalFields<DataT> formulas;
+  const auto& grid = getGrid();
+  for (size_t iPhi = 0; iPhi < NPHI; ++iPhi) {
+    const DataT phi = grid.getZVertex(iPhi);
+    for (size_t iR = 0; iR < NR; ++iR) {
+      const DataT radius = grid.getYVertex(iR);
+      for (size_t iZ = 0; iZ < NZ; ++iZ) {
+        const DataT z = grid.getXVertex(iZ);
+        charge(iZ, iR, iPhi) = formulas.evalDensity(z, radius, phi);
+        const bool isBoundary = (iR == 0) || (iR == NR - 1) || (iZ == 0) || (iZ == NZ - 1);
+        potential(iZ, iR, iPhi) = isBoundary ? formulas.evalPotential(z, radius, phi) : 0;
+      }
+    }
+  }
+}
+
+static void BM_PoissonSolver3D(benchmark::State& state)
+{
+  MGParameters::isFull3D = state.range(0);
+  PoissonSolver<DataT, NZ, NR, NPHI>::setNThreads(state.range(1));
+  DataContainer charge{};
+  DataContainer potential{};
+  for (auto _ : state) {
+    state.PauseTiming();
+    setInput(charge, potential);
+    state.ResumeTiming();
+    PoissonSolver<DataT, NZ, NR, NPHI> solver(getGrid());
+    solver.poissonSolver3D(potential, charge, 0);
+  }
+}
+
+// full coarsening and semi coarsening (constant number of phi slices) with 1 to 32 threads
+BENCHMARK(BM_PoissonSolver3D)->ArgsProduct({{1, 0}, {1, 2, 4, 8, 16, 32}})->Unit(benchmark::kSecond)->UseRealTime();
+
+BENCHMARK_MAIN();
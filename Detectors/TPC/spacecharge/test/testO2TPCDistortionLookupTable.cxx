@@ -0,0 +1,155 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  testO2TPCDistortionLookupTable.cxx
+/// \brief this task tests the memory-mapped lookup table of the global distortions against the tricubic interpolation of the SpaceCharge class
+
+#define BOOST_TEST_MODULE Test TPC DistortionLookupTable class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "TPCSpaceCharge/SpaceCharge.h"
+#include "TPCSpaceCharge/DistortionLookupTable.h"
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace o2
+{
+namespace tpc
+{
+
+using DataT = double;
+static constexpr int NZ = 33;
+static constexpr int NR = 33;
+static constexpr int NPHI = 180;
+using SC = SpaceCharge<DataT, NZ, NR, NPHI>;
+static constexpr float ABSTOLERANCE = 1e-3; // absolute tolerance in cm for the trilinear interpolation of the lookup table compared to the tricubic interpolation
+
+// smooth global distortions with a maximum of 1 cm
+void setDistortions(SC& sc)
+{
+  for (const auto side : {Side::A, Side::C}) {
+    DataContainer3D<DataT, NZ, NR, NPHI> distdZ;
+    DataContainer3D<DataT, NZ, NR, NPHI> distdR;
+    DataContainer3D<DataT, NZ, NR, NPHI> distdRPhi;
+    for (size_t iPhi = 0; iPhi < NPHI; ++iPhi) {
+      const DataT phi = sc.getPhiVertex(iPhi, side);
+      for (size_t iR = 0; iR < NR; ++iR) {
+        const DataT radius = sc.getRVertex(iR, side);
+        for (size_t iZ = 0; iZ < NZ; ++iZ) {
+          const DataT z = sc.getZVertex(iZ, side);
+          distdZ(iZ, iR, iPhi) = 0.2 * std::cos(phi) * z / sc.getZMax(Side::A);
+          distdR(iZ, iR, iPhi) = std::sin(phi) * (radius - sc.getRMin(side)) / (sc.getRMax(side) - sc.getRMin(side));
+          distdRPhi(iZ, iR, iPhi) = 0.3 * std::sin(2 * phi) * radius / sc.getRMax(side);
+        }
+      }
+    }
+    sc.setDistortionLookupTables(distdZ, distdR, distdRPhi, side);
+  }
+}
+
+struct LookupTableFile {
+  const std::string name = (std::filesystem::temp_directory_path() / "testO2TPCDistortionLookupTable.bin").string();
+  ~LookupTableFile() { std::filesystem::remove(name); }
+};
+
+BOOST_AUTO_TEST_CASE(DistortionLookupTable_test)
+{
+  auto sc = std::make_unique<SC>();
+  setDistortions(*sc);
+  const LookupTableFile file;
+  BOOST_REQUIRE(sc->writeDistortionLookupTable(file.name));
+
+  DistortionLookupTable lut;
+  BOOST_REQUIRE(lut.open(file.name));
+  BOOST_CHECK(lut.getType() == DistortionLookupTable::Type::Distortions);
+  BOOST_CHECK_EQUAL(lut.getHeader().nZ, 2 * NZ - 1);
+  BOOST_CHECK_EQUAL(lut.getHeader().nR, 2 * NR - 1);
+  BOOST_CHECK_EQUAL(lut.getHeader().nPhi, NPHI);
+
+  // random points in the volume of both sides, phi is not restricted to [0, 2pi)
+  const size_t nPoints = 1000;
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> distZ(-sc->getZMax(Side::A), sc->getZMax(Side::A));
+  std::uniform_real_distribution<float> distR(sc->getRMin(Side::A), sc->getRMax(Side::A));
+  std::uniform_real_distribution<float> distPhi(-4, 8);
+  std::vector<float> z(nPoints), r(nPoints), phi(nPoints);
+  for (size_t i = 0; i < nPoints; ++i) {
+    z[i] = distZ(rng);
+    r[i] = distR(rng);
+    phi[i] = distPhi(rng);
+  }
+
+  std::vector<float> dZ(nPoints), dR(nPoints), dRPhi(nPoints);
+  lut.getValuesCyl(nPoints, z.data(), r.data(), phi.data(), dZ.data(), dR.data(), dRPhi.data());
+  std::vector<GlobalPosition3D> points;
+  for (size_t i = 0; i < nPoints; ++i) {
+    const Side side = SC::getSide(z[i]);
+    DataT refdZ{};
+    DataT refdR{};
+    DataT refdRPhi{};
+    sc->getDistortionsCyl(z[i], r[i], sc->regulatePhi(phi[i], side), side, refdZ, refdR, refdRPhi);
+    BOOST_CHECK_SMALL(dZ[i] - static_cast<float>(refdZ), ABSTOLERANCE);
+    BOOST_CHECK_SMALL(dR[i] - static_cast<float>(refdR), ABSTOLERANCE);
+    BOOST_CHECK_SMALL(dRPhi[i] - static_cast<float>(refdRPhi), ABSTOLERANCE);
+
+    // the single point interpolation gives the same result as the batched one
+    float valdZ{};
+    float valdR{};
+    float valdRPhi{};
+    lut.getValuesCyl(z[i], r[i], phi[i], valdZ, valdR, valdRPhi);
+    BOOST_CHECK_EQUAL(valdZ, dZ[i]);
+    BOOST_CHECK_EQUAL(valdR, dR[i]);
+    BOOST_CHECK_EQUAL(valdRPhi, dRPhi[i]);
+
+    points.emplace_back(r[i] * std::cos(phi[i]), r[i] * std::sin(phi[i]), z[i]);
+  }
+
+  // distortion of the electron positions
+  auto pointsRef = points;
+  lut.apply(points);
+  for (size_t i = 0; i < nPoints; ++i) {
+    sc->distortElectron(pointsRef[i]);
+    BOOST_CHECK_SMALL(points[i].X() - pointsRef[i].X(), 2 * ABSTOLERANCE);
+    BOOST_CHECK_SMALL(points[i].Y() - pointsRef[i].Y(), 2 * ABSTOLERANCE);
+    BOOST_CHECK_SMALL(points[i].Z() - pointsRef[i].Z(), 2 * ABSTOLERANCE);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DistortionLookupTableInvalidFile_test)
+{
+  auto sc = std::make_unique<SC>();
+  const LookupTableFile file;
+  DistortionLookupTable lut;
+
+  // global distortions are not set
+  BOOST_CHECK(!sc->writeDistortionLookupTable(file.name));
+  BOOST_CHECK(!lut.open(file.name));
+
+  setDistortions(*sc);
+  BOOST_REQUIRE(sc->writeDistortionLookupTable(file.name, SC::Type::Distortions, 5, 5, 4));
+  BOOST_REQUIRE(lut.open(file.name));
+  lut.close();
+  BOOST_CHECK(!lut.isOpen());
+
+  // truncated file
+  std::filesystem::resize_file(file.name, std::filesystem::file_size(file.name) - sizeof(float));
+  BOOST_CHECK(!lut.open(file.name));
+
+  // not a lookup table
+  std::ofstream(file.name, std::ios::trunc) << "not a lookup table of the TPC distortions, but some text which is long enough for a header";
+  BOOST_CHECK(!lut.open(file.name));
+  BOOST_CHECK(!lut.isOpen());
+}
+
+} // namespace tpc
+} // namespace o2
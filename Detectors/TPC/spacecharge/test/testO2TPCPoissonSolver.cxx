@@ -20,6 +20,7 @@
 #include <boost/test/unit_test.hpp>
 #include "TPCSpaceCharge/PoissonSolver.h"
 #include "TPCSpaceCharge/SpaceChargeHelpers.h"
+#include <array>
 
 namespace o2
 {
@@ -194,6 +195,32 @@ void poissonSolver3D()
   testAlmostEqualArray<DataT, Nz, Nr, Nphi>(potentialAnalytical, potentialNumerical);
 }
 
+template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
+void poissonSolver3DThreads(const int symmetry)
+{
+  using GridProp = GridProperties<DataT, Nr, Nz, Nphi>;
+  const o2::tpc::RegularGrid3D<DataT, Nz, Nr, Nphi> grid3D{GridProp::ZMIN, GridProp::RMIN, GridProp::PHIMIN, GridProp::GRIDSPACINGZ, GridProp::GRIDSPACINGR, GridProp::GRIDSPACINGPHI};
+
+  using DataContainer = o2::tpc::DataContainer3D<DataT, Nz, Nr, Nphi>;
+  DataContainer charge{};
+  const o2::tpc::AnalyticalFields<DataT> analyticalFields;
+  setChargeDensityFromFormula<DataT, Nz, Nr, Nphi>(analyticalFields, grid3D, charge);
+
+  // the relaxation of the phi slices in parallel has to give the same result as the sequential relaxation
+  using Solver = PoissonSolver<DataT, Nz, Nr, Nphi>;
+  const int nThreads = Solver::getNThreads();
+  std::array<DataContainer, 2> potential{};
+  const std::array<int, 2> threads{1, 7};
+  for (int i = 0; i < 2; ++i) {
+    setPotentialBoundaryFromFormula<DataT, Nz, Nr, Nphi>(analyticalFields, grid3D, potential[i]);
+    Solver::setNThreads(threads[i]);
+    Solver poissonSolver(grid3D);
+    poissonSolver.poissonSolver3D(potential[i], charge, symmetry);
+  }
+  Solver::setNThreads(nThreads);
+  BOOST_CHECK(potential[0].getData() == potential[1].getData());
+}
+
 template <typename DataT, size_t Nz, size_t Nr, size_t Nphi>
 void poissonSolver2D()
 {
@@ -233,6 +260,16 @@ BOOST_AUTO_TEST_CASE(PoissonSolver3D2D_test)
   poissonSolver3D<DataT, NZ, NR, NPHI>();
 }
 
+BOOST_AUTO_TEST_CASE(PoissonSolver3DThreads_test)
+{
+  // odd number of phi slices in the coarser grids, the finer grids are large enough to be processed in parallel and relaxed in several tiles
+  o2::tpc::MGParameters::isFull3D = true;
+  poissonSolver3DThreads<DataT, NZ, NR, NPHI>(0);
+  o2::tpc::MGParameters::isFull3D = false;
+  poissonSolver3DThreads<DataT, NZ, NR, NPHI>(0);
+  poissonSolver3DThreads<DataT, NZ, NR, NPHI>(1);
+}
+
 BOOST_AUTO_TEST_CASE(PoissonSolver2D_test)
 {
   const int Nphi = 1;
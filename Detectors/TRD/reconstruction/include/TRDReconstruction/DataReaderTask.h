@@ -20,6 +20,7 @@
 #include "Framework/DataProcessorSpec.h"
 #include "TRDReconstruction/CruRawReader.h"
 #include "TRDReconstruction/CompressedRawReader.h"
+#include "TRDReconstruction/ParallelCruRawReader.h"
 #include "DataFormatsTRD/Tracklet64.h"
 #include "DataFormatsTRD/TriggerRecord.h"
 #include "TRDBase/Digit.h"
@@ -35,14 +36,16 @@ namespace o2::trd
 class DataReaderTask : public Task
 {
  public:
-  DataReaderTask(bool compresseddata, bool byteswap, bool verbose, bool headerverbose, bool dataverbose) : mCompressedData(compresseddata), mByteSwap(byteswap), mVerbose(verbose), mHeaderVerbose(headerverbose), mDataVerbose(dataverbose) {}
+  DataReaderTask(bool compresseddata, bool byteswap, bool verbose, bool headerverbose, bool dataverbose, int nthreads = 1) : mCompressedData(compresseddata), mByteSwap(byteswap), mVerbose(verbose), mHeaderVerbose(headerverbose), mDataVerbose(dataverbose), mNThreads(nthreads) {}
   ~DataReaderTask() override = default;
   void init(InitContext& ic) final;
   void sendData(ProcessingContext& pc, bool blankframe = false);
   void run(ProcessingContext& pc) final;
+  void runParallel(ProcessingContext& pc);
 
  private:
   CruRawReader mReader;                  // this will do the parsing, of raw data passed directly through the flp(no compression)
+  ParallelCruRawReader mParallelReader;  // decodes all links of the TF in parallel, used for mNThreads > 1
   CompressedRawReader mCompressedReader; //this will handle the incoming compressed data from the flp
                                          // in both cases we pull the data from the vectors build message and pass on.
                                          // they will internally produce a vector of digits and a vector tracklets and associated indexing.
@@ -52,6 +55,7 @@ class DataReaderTask : public Task
   bool mDataVerbose{false};    // verbose output of data unpacking
   bool mHeaderVerbose{false};  // verbose output of headers
   bool mCompressedData{false}; // are we dealing with the compressed data from the flp (send via option)
+  int mNThreads{1};            // number of threads to decode the links of a TF with, for non compressed data
   bool mByteSwap{true};        // whether we are to byteswap the incoming data, mc is not byteswapped, raw data is (too be changed in cru at some point)
                                //  o2::header::DataDescription mDataDesc; // Data description of the incoming data
   std::string mDataDesc;
@@ -0,0 +1,117 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   ParallelCruRawReader.h
+/// @brief  Decode the cru raw data of a time frame with the links (half crus) being decoded in parallel.
+//          The payload is split into contiguous blocks of heart beat frames belonging to the same FEE ID,
+//          each block is decoded by a CruRawReader owned by the thread processing it and the results
+//          are merged per interaction record into the final output with a prefix sum over the block outputs.
+
+#ifndef O2_TRD_PARALLELCRURAWREADER
+#define O2_TRD_PARALLELCRURAWREADER
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <gsl/span>
+
+#include "CommonDataFormat/InteractionRecord.h"
+#include "DataFormatsTRD/Tracklet64.h"
+#include "DataFormatsTRD/TriggerRecord.h"
+#include "DataFormatsTRD/Digit.h"
+#include "TRDReconstruction/CruRawReader.h"
+
+namespace o2::framework
+{
+class ProcessingContext;
+}
+
+namespace o2::trd
+{
+
+class ParallelCruRawReader
+{
+ public:
+  ParallelCruRawReader() = default;
+  ~ParallelCruRawReader() = default;
+
+  void configure(bool byteswap, bool verbose, bool headerverbose, bool dataverbose)
+  {
+    mByteSwap = byteswap;
+    mVerbose = verbose;
+    mHeaderVerbose = headerverbose;
+    mDataVerbose = dataverbose;
+  }
+  void setNThreads(int nthreads) { mNThreads = nthreads > 0 ? nthreads : 1; }
+  int getNThreads() const { return mNThreads; }
+
+  /// add a buffer of raw data (e.g. one input part of the TF), the buffer is not copied and has to stay valid until run() returns
+  void addDataBuffer(const char* buffer, long size);
+  /// split the buffers by link, decode the links in parallel and prepare the merging of the results
+  void run();
+
+  int getNumberOfTracklets() const { return mTrackletOffsets.empty() ? 0 : mTrackletOffsets.back(); }
+  int getNumberOfDigits() const { return mDigitOffsets.empty() ? 0 : mDigitOffsets.back(); }
+  int getNumberOfTriggers() const { return mIRs.size(); }
+  int getNumberOfLinkBlocks() const { return mBlocks.size(); }
+  uint32_t getTrackletsFound() const { return mTotalTrackletsFound; }
+  uint32_t getDigitsFound() const { return mTotalDigitsFound; }
+
+  /// fill the merged output into pre-sized spans, the sizes have to match getNumberOf{Tracklets,Digits,Triggers}()
+  void fillOutputs(gsl::span<Tracklet64> tracklets, gsl::span<Digit> digits, gsl::span<TriggerRecord> triggers) const;
+  void getParsedObjects(std::vector<Tracklet64>& tracklets, std::vector<Digit>& digits, std::vector<TriggerRecord>& triggers) const;
+  /// create the DPL outputs with their final size and fill them in place
+  void buildDPLOutputs(o2::framework::ProcessingContext& pc) const;
+  void clear();
+
+ private:
+  // a contiguous sequence of heart beat frames of one link
+  struct LinkBlock {
+    const char* start = nullptr;
+    long size = 0;
+    uint16_t feeID = 0;
+  };
+  // the decoded data of a single link block
+  struct LinkOutput {
+    std::vector<Tracklet64> tracklets;
+    std::vector<Digit> digits;
+    std::vector<TriggerRecord> triggers;   // ranges refer to the two vectors above
+    std::vector<int> irIndex;              // index of the interaction record of each trigger in mIRs
+    uint32_t trackletsFound = 0;
+    uint32_t digitsFound = 0;
+  };
+
+  void indexLinkBlocks(const char* buffer, long size);
+  void decodeLinkBlock(CruRawReader& reader, const LinkBlock& block, LinkOutput& output);
+  void buildMergeTables();
+
+  bool mVerbose{false};
+  bool mHeaderVerbose{false};
+  bool mDataVerbose{false};
+  bool mByteSwap{false};
+  int mNThreads{1};
+
+  std::vector<LinkBlock> mBlocks;
+  std::vector<LinkOutput> mOutputs;
+  std::vector<std::unique_ptr<CruRawReader>> mReaders; // one reader per thread, each holds its own HBF payload buffer
+
+  // merging tables: the output of block b for the interaction record i goes at the offsets [i * nBlocks + b]
+  std::vector<InteractionRecord> mIRs; // sorted interaction records of all blocks
+  std::vector<int> mTrackletOffsets;   // prefix sum of tracklet counts, ordered by (interaction record, block)
+  std::vector<int> mDigitOffsets;      // prefix sum of digit counts, ordered by (interaction record, block)
+
+  uint32_t mTotalTrackletsFound{0};
+  uint32_t mTotalDigitsFound{0};
+};
+
+} // namespace o2::trd
+
+#endif
@@ -113,8 +113,7 @@ bool CruRawReader::processHBFs(int datasizealreadyread, bool verbose)
     totaldataread += offsetToNext;
     // move to next rdh
     rdh = reinterpret_cast<const o2::header::RDHAny*>(reinterpret_cast<const char*>(rdh) + offsetToNext);
-    if ((char*)(rdh) < (char*)&mHBFPayload[0] + mDataBufferSize) {
-      //if (reinterpret_cast<const o2::header::RDHAny*>(rdh) < (char*)&mHBFPayload[0] + mDataBufferSize) {
+    if ((const char*)(rdh) < mDataBuffer + mDataBufferSize) {
       if (mVerbose) {
         LOG(info) << __func__ << " " << __LINE__;
         LOG(info) << "rdh position is still inside the buffer";
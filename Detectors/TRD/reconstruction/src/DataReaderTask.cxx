@@ -86,6 +86,10 @@ void DataReaderTask::run(ProcessingContext& pc)
     }
     LOG(info) << " matched DEADBEEF";
   }
+  if (!mCompressedData && mNThreads > 1) {
+    runParallel(pc);
+    return;
+  }
   //TODO combine the previous and subsequent loops.
   /* loop over inputs routes */
   for (auto iit = pc.inputs().begin(), iend = pc.inputs().end(); iit != iend; ++iit) {
@@ -151,4 +155,36 @@ void DataReaderTask::run(ProcessingContext& pc)
   }
 }
 
+void DataReaderTask::runParallel(ProcessingContext& pc)
+{
+  // collect the payloads of all input parts without copying them, decode them with
+  // the links in parallel and send the merged data for the whole TF at once
+  auto dataReadStart = std::chrono::high_resolution_clock::now();
+  uint64_t bytesRead = 0;
+  mParallelReader.setNThreads(mNThreads);
+  mParallelReader.configure(mByteSwap, mVerbose, mHeaderVerbose, mDataVerbose);
+  for (auto iit = pc.inputs().begin(), iend = pc.inputs().end(); iit != iend; ++iit) {
+    if (!iit.isValid()) {
+      continue;
+    }
+    for (auto const& ref : iit) {
+      const auto* headerIn = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
+      if (std::string(headerIn->dataDescription.str) == std::string("DISTSUBTIMEFRAMEFLP")) {
+        continue;
+      }
+      mParallelReader.addDataBuffer(ref.payload, headerIn->payloadSize);
+      bytesRead += headerIn->payloadSize;
+    }
+  }
+  mParallelReader.run();
+  mParallelReader.buildDPLOutputs(pc);
+
+  auto dataReadTime = std::chrono::high_resolution_clock::now() - dataReadStart;
+  LOG(info) << "Processing time for Data reading  " << std::chrono::duration_cast<std::chrono::milliseconds>(dataReadTime).count() << "ms for "
+            << bytesRead << " bytes in " << mParallelReader.getNumberOfLinkBlocks() << " link blocks with " << mNThreads << " threads";
+  LOG(info) << "Digits found : " << mParallelReader.getDigitsFound();
+  LOG(info) << "Tracklets found : " << mParallelReader.getTrackletsFound();
+  mParallelReader.clear();
+}
+
 } // namespace o2::trd
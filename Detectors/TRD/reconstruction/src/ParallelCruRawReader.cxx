@@ -0,0 +1,205 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   ParallelCruRawReader.cxx
+/// @brief  TRD raw data translator, links decoded in parallel
+
+#include "TRDReconstruction/ParallelCruRawReader.h"
+#include "DetectorsRaw/RDHUtils.h"
+#include "Headers/RDHAny.h"
+
+#include "Framework/Output.h"
+#include "Framework/ProcessingContext.h"
+#include "Framework/DataAllocator.h"
+#include "Framework/Logger.h"
+
+#include <algorithm>
+#include <numeric>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace o2::trd
+{
+
+void ParallelCruRawReader::addDataBuffer(const char* buffer, long size)
+{
+  indexLinkBlocks(buffer, size);
+}
+
+void ParallelCruRawReader::indexLinkBlocks(const char* buffer, long size)
+{
+  // Walk over the RDHs of the buffer and split it into blocks of complete heart beat frames
+  // of the same link. A new block is only started after a stop RDH, so that every block
+  // can be decoded on its own.
+  long position = 0;
+  bool hbfOpen = false;
+  while (position < size) {
+    if (size - position < (long)sizeof(o2::header::RAWDataHeader)) {
+      LOG(error) << "Incomplete RDH at the end of the buffer, " << size - position << " bytes ignored";
+      break;
+    }
+    auto rdh = reinterpret_cast<const o2::header::RDHAny*>(buffer + position);
+    auto offsetToNext = o2::raw::RDHUtils::getOffsetToNext(rdh);
+    if (offsetToNext == 0 || position + offsetToNext > size) {
+      LOG(error) << "Invalid offset to next RDH (" << offsetToNext << ") at position " << position << " of " << size << ", stop indexing this buffer";
+      break;
+    }
+    uint16_t feeID = o2::raw::RDHUtils::getFEEID(rdh);
+    if (!hbfOpen && (mBlocks.empty() || mBlocks.back().feeID != feeID || mBlocks.back().start + mBlocks.back().size != buffer + position)) {
+      mBlocks.push_back({buffer + position, 0, feeID});
+    }
+    mBlocks.back().size += offsetToNext;
+    hbfOpen = !o2::raw::RDHUtils::getStop(rdh);
+    position += offsetToNext;
+  }
+}
+
+void ParallelCruRawReader::decodeLinkBlock(CruRawReader& reader, const LinkBlock& block, LinkOutput& output)
+{
+  reader.configure(mByteSwap, mVerbose, mHeaderVerbose, mDataVerbose);
+  reader.setDataBuffer(block.start);
+  reader.setDataBufferSize(block.size);
+  auto trackletsBefore = reader.getTrackletsFound();
+  auto digitsBefore = reader.getDigitsFound();
+  reader.run();
+  output.trackletsFound = reader.getTrackletsFound() - trackletsBefore;
+  output.digitsFound = reader.getDigitsFound() - digitsBefore;
+  reader.getParsedObjectsandClear(output.tracklets, output.digits, output.triggers);
+}
+
+void ParallelCruRawReader::run()
+{
+  int nBlocks = mBlocks.size();
+  mOutputs.clear();
+  mOutputs.resize(nBlocks);
+  while (mReaders.size() < static_cast<size_t>(mNThreads)) {
+    mReaders.emplace_back(std::make_unique<CruRawReader>());
+  }
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int iBlock = 0; iBlock < nBlocks; ++iBlock) {
+    int thread = 0;
+#ifdef WITH_OPENMP
+    thread = omp_get_thread_num();
+#endif
+    decodeLinkBlock(*mReaders[thread], mBlocks[iBlock], mOutputs[iBlock]);
+  }
+
+  buildMergeTables();
+  if (mVerbose) {
+    LOG(info) << "Decoded " << nBlocks << " link blocks with " << mNThreads << " threads into " << getNumberOfTriggers() << " triggers, "
+              << getNumberOfTracklets() << " tracklets and " << getNumberOfDigits() << " digits";
+  }
+}
+
+void ParallelCruRawReader::buildMergeTables()
+{
+  // Collect the interaction records seen by any of the blocks and compute for every
+  // (interaction record, block) pair the position of its data in the merged output.
+  // The output is sorted by interaction record and, within one interaction record,
+  // by the position of the block in the input, independent of the number of threads.
+  mIRs.clear();
+  mTotalTrackletsFound = 0;
+  mTotalDigitsFound = 0;
+  for (const auto& output : mOutputs) {
+    for (const auto& trigger : output.triggers) {
+      mIRs.push_back(trigger.getBCData());
+    }
+    mTotalTrackletsFound += output.trackletsFound;
+    mTotalDigitsFound += output.digitsFound;
+  }
+  std::sort(mIRs.begin(), mIRs.end());
+  mIRs.erase(std::unique(mIRs.begin(), mIRs.end()), mIRs.end());
+
+  int nBlocks = mOutputs.size();
+  int nIRs = mIRs.size();
+  std::vector<int> trackletCounts(nIRs * nBlocks, 0), digitCounts(nIRs * nBlocks, 0);
+  for (int iBlock = 0; iBlock < nBlocks; ++iBlock) {
+    auto& output = mOutputs[iBlock];
+    output.irIndex.clear();
+    for (const auto& trigger : output.triggers) {
+      int iIR = std::lower_bound(mIRs.begin(), mIRs.end(), trigger.getBCData()) - mIRs.begin();
+      output.irIndex.push_back(iIR);
+      trackletCounts[iIR * nBlocks + iBlock] += trigger.getNumberOfTracklets();
+      digitCounts[iIR * nBlocks + iBlock] += trigger.getNumberOfDigits();
+    }
+  }
+  mTrackletOffsets.assign(nIRs * nBlocks + 1, 0);
+  mDigitOffsets.assign(nIRs * nBlocks + 1, 0);
+  std::partial_sum(trackletCounts.begin(), trackletCounts.end(), mTrackletOffsets.begin() + 1);
+  std::partial_sum(digitCounts.begin(), digitCounts.end(), mDigitOffsets.begin() + 1);
+}
+
+void ParallelCruRawReader::fillOutputs(gsl::span<Tracklet64> tracklets, gsl::span<Digit> digits, gsl::span<TriggerRecord> triggers) const
+{
+  if (tracklets.size() != static_cast<size_t>(getNumberOfTracklets()) || digits.size() != static_cast<size_t>(getNumberOfDigits()) ||
+      triggers.size() != static_cast<size_t>(getNumberOfTriggers())) {
+    LOG(error) << "Output sizes do not match the decoded data: " << tracklets.size() << "/" << getNumberOfTracklets() << " tracklets, "
+               << digits.size() << "/" << getNumberOfDigits() << " digits, " << triggers.size() << "/" << getNumberOfTriggers() << " triggers";
+    return;
+  }
+  int nBlocks = mOutputs.size();
+  int nIRs = mIRs.size();
+  for (int iIR = 0; iIR < nIRs; ++iIR) {
+    int firstTracklet = mTrackletOffsets[iIR * nBlocks];
+    int firstDigit = mDigitOffsets[iIR * nBlocks];
+    triggers[iIR] = TriggerRecord(mIRs[iIR], firstDigit, mDigitOffsets[(iIR + 1) * nBlocks] - firstDigit,
+                                  firstTracklet, mTrackletOffsets[(iIR + 1) * nBlocks] - firstTracklet);
+  }
+  // every block owns a disjoint set of output ranges, so they can be copied concurrently
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int iBlock = 0; iBlock < nBlocks; ++iBlock) {
+    const auto& output = mOutputs[iBlock];
+    // the event records of a reader are unique per interaction record, so each trigger of the block has its own slot
+    for (size_t iTrig = 0; iTrig < output.triggers.size(); ++iTrig) {
+      const auto& trigger = output.triggers[iTrig];
+      int slot = output.irIndex[iTrig] * nBlocks + iBlock;
+      int trackletOut = mTrackletOffsets[slot];
+      int digitOut = mDigitOffsets[slot];
+      std::copy_n(output.tracklets.begin() + trigger.getFirstTracklet(), trigger.getNumberOfTracklets(), tracklets.begin() + trackletOut);
+      std::copy_n(output.digits.begin() + trigger.getFirstDigit(), trigger.getNumberOfDigits(), digits.begin() + digitOut);
+    }
+  }
+}
+
+void ParallelCruRawReader::getParsedObjects(std::vector<Tracklet64>& tracklets, std::vector<Digit>& digits, std::vector<TriggerRecord>& triggers) const
+{
+  tracklets.resize(getNumberOfTracklets());
+  digits.resize(getNumberOfDigits());
+  triggers.resize(getNumberOfTriggers());
+  fillOutputs(tracklets, digits, triggers);
+}
+
+void ParallelCruRawReader::buildDPLOutputs(o2::framework::ProcessingContext& pc) const
+{
+  auto& tracklets = pc.outputs().make<std::vector<Tracklet64>>(o2::framework::Output{o2::header::gDataOriginTRD, "TRACKLETS", 0, o2::framework::Lifetime::Timeframe}, getNumberOfTracklets());
+  auto& digits = pc.outputs().make<std::vector<Digit>>(o2::framework::Output{o2::header::gDataOriginTRD, "DIGITS", 0, o2::framework::Lifetime::Timeframe}, getNumberOfDigits());
+  auto& triggers = pc.outputs().make<std::vector<TriggerRecord>>(o2::framework::Output{o2::header::gDataOriginTRD, "TRKTRGRD", 0, o2::framework::Lifetime::Timeframe}, getNumberOfTriggers());
+  fillOutputs(tracklets, digits, triggers);
+  LOG(info) << "Sending data onwards with " << digits.size() << " Digits and " << tracklets.size() << " Tracklets and " << triggers.size() << " Triggers";
+}
+
+void ParallelCruRawReader::clear()
+{
+  mBlocks.clear();
+  mOutputs.clear();
+  mIRs.clear();
+  mTrackletOffsets.clear();
+  mDigitOffsets.clear();
+}
+
+} // namespace o2::trd
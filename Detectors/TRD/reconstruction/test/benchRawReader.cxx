@@ -0,0 +1,132 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   benchRawReader.cxx
+/// @brief  Throughput of the sequential and the link parallel TRD raw data decoding.
+///         The input are the raw files produced by o2-trd-trap2raw from simulated digits and tracklets.
+
+#include "TRDReconstruction/CruRawReader.h"
+#include "TRDReconstruction/ParallelCruRawReader.h"
+#include "DataFormatsTRD/Tracklet64.h"
+#include "DataFormatsTRD/TriggerRecord.h"
+#include "DataFormatsTRD/Digit.h"
+#include "fairlogger/Logger.h"
+
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::trd;
+
+std::vector<char> readRawFile(const std::string& fileName)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file.good()) {
+    LOG(fatal) << "Cannot open raw file " << fileName;
+  }
+  return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+int main(int argc, char** argv)
+{
+  bpo::variables_map vm;
+  bpo::options_description opt_general("Usage:\n  " + std::string(argv[0]) +
+                                       " [options] file1.raw [file2.raw ...]\n"
+                                       "Measure the TRD raw data decoding throughput on raw files produced by o2-trd-trap2raw\n");
+  bpo::options_description opt_hidden("");
+  bpo::options_description opt_all;
+  bpo::positional_options_description opt_pos;
+
+  try {
+    auto add_option = opt_general.add_options();
+    add_option("help,h", "Print this help message");
+    add_option("nthreads,n", bpo::value<std::vector<int>>()->multitoken()->default_value(std::vector<int>{1, 2, 4, 8}, "1 2 4 8"), "number of threads to run the parallel decoder with");
+    add_option("repetitions,r", bpo::value<int>()->default_value(5), "number of times the input is decoded per configuration");
+    add_option("byteswap,b", bpo::value<bool>()->default_value(false)->implicit_value(true), "byteswap the data, as needed for data from the CRU");
+    opt_hidden.add_options()("input", bpo::value<std::vector<std::string>>(), "raw input files");
+    opt_all.add(opt_general).add(opt_hidden);
+    opt_pos.add("input", -1);
+    bpo::store(bpo::command_line_parser(argc, argv).options(opt_all).positional(opt_pos).run(), vm);
+
+    if (vm.count("help") || !vm.count("input")) {
+      std::cout << opt_general << std::endl;
+      exit(0);
+    }
+    bpo::notify(vm);
+  } catch (bpo::error& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl
+              << std::endl;
+    std::cerr << opt_general << std::endl;
+    exit(1);
+  }
+
+  std::vector<std::vector<char>> buffers;
+  double totalBytes = 0;
+  for (const auto& fileName : vm["input"].as<std::vector<std::string>>()) {
+    buffers.emplace_back(readRawFile(fileName));
+    totalBytes += buffers.back().size();
+  }
+  int repetitions = vm["repetitions"].as<int>();
+  bool byteswap = vm["byteswap"].as<bool>();
+  LOG(info) << "Read " << buffers.size() << " raw files with " << totalBytes / 1024 / 1024 << " MB in total";
+
+  // the sequential reader as used by the DataReaderTask
+  auto reader = std::make_unique<CruRawReader>();
+  reader->configure(byteswap, false, false, false);
+  std::vector<Tracklet64> tracklets;
+  std::vector<Digit> digits;
+  std::vector<TriggerRecord> triggers;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int iRep = 0; iRep < repetitions; ++iRep) {
+    tracklets.clear();
+    digits.clear();
+    triggers.clear();
+    for (const auto& buffer : buffers) {
+      reader->setDataBuffer(buffer.data());
+      reader->setDataBufferSize(buffer.size());
+      reader->run();
+      reader->getParsedObjectsandClear(tracklets, digits, triggers);
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+  LOG(info) << "sequential : " << tracklets.size() << " tracklets, " << digits.size() << " digits, "
+            << totalBytes * repetitions / 1024 / 1024 / elapsed.count() << " MB/s";
+  auto nTrackletsSequential = tracklets.size();
+  auto nDigitsSequential = digits.size();
+
+  for (auto nThreads : vm["nthreads"].as<std::vector<int>>()) {
+    ParallelCruRawReader parallelReader;
+    parallelReader.configure(byteswap, false, false, false);
+    parallelReader.setNThreads(nThreads);
+    start = std::chrono::high_resolution_clock::now();
+    for (int iRep = 0; iRep < repetitions; ++iRep) {
+      parallelReader.clear();
+      for (const auto& buffer : buffers) {
+        parallelReader.addDataBuffer(buffer.data(), buffer.size());
+      }
+      parallelReader.run();
+      parallelReader.getParsedObjects(tracklets, digits, triggers);
+    }
+    elapsed = std::chrono::high_resolution_clock::now() - start;
+    LOG(info) << "parallel, " << nThreads << " threads : " << tracklets.size() << " tracklets, " << digits.size() << " digits in "
+              << parallelReader.getNumberOfLinkBlocks() << " link blocks, " << totalBytes * repetitions / 1024 / 1024 / elapsed.count() << " MB/s";
+    if (tracklets.size() != nTrackletsSequential || digits.size() != nDigitsSequential) {
+      LOG(error) << "parallel decoding found a different number of tracklets or digits than the sequential decoding";
+    }
+  }
+  return 0;
+}
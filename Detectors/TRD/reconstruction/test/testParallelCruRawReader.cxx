@@ -0,0 +1,201 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testParallelCruRawReader.cxx
+/// \brief checks that the link parallel decoding gives the output of the sequential CruRawReader
+
+#define BOOST_TEST_MODULE Test TRD ParallelCruRawReader
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "TRDReconstruction/CruRawReader.h"
+#include "TRDReconstruction/ParallelCruRawReader.h"
+#include "DataFormatsTRD/RawData.h"
+#include "DataFormatsTRD/Constants.h"
+#include "DataFormatsTRD/Tracklet64.h"
+#include "DataFormatsTRD/TriggerRecord.h"
+#include "DataFormatsTRD/Digit.h"
+#include "DetectorsRaw/RDHUtils.h"
+#include "Headers/RAWDataHeader.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace o2::trd
+{
+
+using RDHUtils = o2::raw::RDHUtils;
+
+// the data of one link: a single mcm with tracklets followed by its digits in the non zero suppressed format, padded to 256 bit
+void addLinkData(std::vector<uint32_t>& link, int supermodule, int stack, int layer, int side, std::mt19937& rng)
+{
+  std::uniform_int_distribution<int> distN(1, 3), distPID(0, 0xfe), distADC(1, 900);
+  const int nTracklets = distN(rng);
+  TrackletMCMHeader mcmHeader;
+  mcmHeader.word = 0;
+  mcmHeader.oneb = 1;
+  mcmHeader.onea = 1;
+  mcmHeader.padrow = rng() % 16;
+  mcmHeader.col = rng() % 4;
+  mcmHeader.pid0 = distPID(rng);
+  mcmHeader.pid1 = nTracklets > 1 ? distPID(rng) : 0xff;
+  mcmHeader.pid2 = nTracklets > 2 ? distPID(rng) : 0xff;
+  link.push_back(mcmHeader.word);
+  for (int i = 0; i < nTracklets; ++i) {
+    TrackletMCMData tracklet;
+    tracklet.word = 0;
+    buildTrackletMCMData(tracklet, rng() % 0x100, rng() % 0x800, rng() % 0x80, rng() % 0x80, 0);
+    link.push_back(tracklet.word);
+  }
+  link.push_back(constants::TRACKLETENDMARKER);
+  link.push_back(constants::TRACKLETENDMARKER);
+
+  DigitHCHeader hcHeader;
+  hcHeader.word0 = 0;
+  hcHeader.word1 = 0;
+  hcHeader.supermodule = supermodule;
+  hcHeader.stack = stack;
+  hcHeader.layer = layer;
+  hcHeader.side = side;
+  hcHeader.major = 5;
+  hcHeader.numtimebins = constants::TIMEBINS;
+  link.push_back(hcHeader.word0);
+  link.push_back(hcHeader.word1);
+  DigitMCMHeader digitMCMHeader;
+  digitMCMHeader.word = 0;
+  digitMCMHeader.res = 0xc;
+  digitMCMHeader.mcm = rng() % 16;
+  digitMCMHeader.rob = rng() % 8;
+  digitMCMHeader.yearflag = 1;
+  link.push_back(digitMCMHeader.word);
+  const int nChannels = distN(rng);
+  for (int i = 0; i < nChannels * constants::TIMEBINS / 3; ++i) {
+    DigitMCMData adcs;
+    adcs.word = 0;
+    adcs.x = distADC(rng);
+    adcs.y = distADC(rng);
+    adcs.z = distADC(rng);
+    link.push_back(adcs.word);
+  }
+  link.push_back(0);
+  link.push_back(0);
+  while (link.size() % 8) {
+    link.push_back(constants::CRUPADDING32);
+  }
+}
+
+// one heart beat frame of a half cru: an open RDH with a half cru payload per trigger, followed by an empty stop RDH
+void addHBF(std::vector<char>& buffer, int supermodule, int side, int endpoint, uint32_t orbit, const std::vector<int>& bcs, std::mt19937& rng)
+{
+  const uint16_t feeID = buildTRDFeeID(supermodule, side, endpoint);
+  std::vector<uint32_t> payload;
+  for (auto bc : bcs) {
+    HalfCRUHeader cruHeader;
+    cruHeader.word12[0] = cruHeader.word12[1] = 0;
+    std::fill(std::begin(cruHeader.word47), std::end(cruHeader.word47), 0);
+    setHalfCRUHeader(cruHeader, 6, bc, 0, endpoint, 1, feeID, 0);
+    std::vector<uint32_t> links;
+    // a few of the links of the half cru carry data, the others are empty
+    for (int iLink = 0; iLink < constants::NLINKSPERHALFCRU; iLink += 4 + rng() % 3) {
+      std::vector<uint32_t> link;
+      addLinkData(link, supermodule, iLink / 6, iLink % 6, side, rng);
+      setHalfCRUHeaderLinkData(cruHeader, iLink, link.size() / 8, 0);
+      links.insert(links.end(), link.begin(), link.end());
+    }
+    auto header = reinterpret_cast<const uint32_t*>(&cruHeader);
+    payload.insert(payload.end(), header, header + sizeof(cruHeader) / 4);
+    payload.insert(payload.end(), links.begin(), links.end());
+  }
+
+  o2::header::RAWDataHeader rdh;
+  RDHUtils::setFEEID(rdh, feeID);
+  RDHUtils::setEndPointID(rdh, endpoint);
+  RDHUtils::setHeartBeatOrbit(rdh, orbit);
+  RDHUtils::setTriggerOrbit(rdh, orbit);
+  RDHUtils::setMemorySize(rdh, sizeof(rdh) + payload.size() * 4);
+  RDHUtils::setOffsetToNext(rdh, sizeof(rdh) + payload.size() * 4);
+  RDHUtils::setStop(rdh, 0);
+  auto rdhBytes = reinterpret_cast<const char*>(&rdh);
+  buffer.insert(buffer.end(), rdhBytes, rdhBytes + sizeof(rdh));
+  auto payloadBytes = reinterpret_cast<const char*>(payload.data());
+  buffer.insert(buffer.end(), payloadBytes, payloadBytes + payload.size() * 4);
+
+  RDHUtils::setMemorySize(rdh, sizeof(rdh));
+  RDHUtils::setOffsetToNext(rdh, sizeof(rdh));
+  RDHUtils::setPageCounter(rdh, 1);
+  RDHUtils::setStop(rdh, 1);
+  buffer.insert(buffer.end(), rdhBytes, rdhBytes + sizeof(rdh));
+}
+
+// a time frame of several half crus, their heart beat frames being interleaved per orbit as in the raw data of a CRU.
+// All half crus of an orbit see the same triggers, so that the sequential reader sees the triggers in increasing order.
+std::vector<char> createTimeFrame()
+{
+  std::mt19937 rng(42);
+  std::vector<char> buffer;
+  const std::vector<std::vector<int>> bcs = {{100, 2000}, {50}, {300, 1200, 3000}, {10, 20}};
+  for (uint32_t orbit = 0; orbit < 8; ++orbit) {
+    for (int supermodule = 0; supermodule < 2; ++supermodule) {
+      for (int endpoint = 0; endpoint < 2; ++endpoint) {
+        // some half crus have no data in some of the orbits, giving link blocks of several heart beat frames
+        if (orbit % 3 == 2 && (supermodule || endpoint)) {
+          continue;
+        }
+        addHBF(buffer, supermodule, 0, endpoint, 256 + orbit, bcs[orbit % bcs.size()], rng);
+      }
+    }
+  }
+  return buffer;
+}
+
+BOOST_AUTO_TEST_CASE(ParallelCruRawReaderSameOutput)
+{
+  const auto buffer = createTimeFrame();
+
+  // the readers hold a large payload buffer, they are not created on the stack
+  auto reader = std::make_unique<CruRawReader>();
+  reader->configure(false, false, false, false);
+  reader->setDataBuffer(buffer.data());
+  reader->setDataBufferSize(buffer.size());
+  reader->run();
+  std::vector<Tracklet64> tracklets;
+  std::vector<Digit> digits;
+  std::vector<TriggerRecord> triggers;
+  reader->getParsedObjectsandClear(tracklets, digits, triggers);
+  // the comparison is not trivial: all triggers are found and they have data
+  BOOST_REQUIRE_EQUAL(triggers.size(), 16u);
+  BOOST_REQUIRE_GT(tracklets.size(), triggers.size());
+  BOOST_REQUIRE_GT(digits.size(), triggers.size());
+
+  for (int nThreads : {1, 2, 4}) {
+    ParallelCruRawReader parallelReader;
+    parallelReader.configure(false, false, false, false);
+    parallelReader.setNThreads(nThreads);
+    parallelReader.addDataBuffer(buffer.data(), buffer.size());
+    parallelReader.run();
+    BOOST_CHECK_GT(parallelReader.getNumberOfLinkBlocks(), 1);
+    BOOST_CHECK_EQUAL(parallelReader.getTrackletsFound(), static_cast<uint32_t>(reader->getTrackletsFound()));
+    BOOST_CHECK_EQUAL(parallelReader.getDigitsFound(), static_cast<uint32_t>(reader->getDigitsFound()));
+    std::vector<Tracklet64> parallelTracklets;
+    std::vector<Digit> parallelDigits;
+    std::vector<TriggerRecord> parallelTriggers;
+    parallelReader.getParsedObjects(parallelTracklets, parallelDigits, parallelTriggers);
+    BOOST_CHECK(parallelTracklets == tracklets);
+    BOOST_CHECK(parallelDigits == digits);
+    BOOST_CHECK(parallelTriggers == triggers);
+  }
+}
+
+} // namespace o2::trd
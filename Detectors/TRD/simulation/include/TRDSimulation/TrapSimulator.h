@@ -98,6 +98,12 @@ class TrapSimulator
   static void setStoreClusters(bool storeClusters) { mgStoreClusters = storeClusters; }
   static bool getStoreClusters() { return mgStoreClusters; }
 
+  // If set, filter() processes all ADC channels of the MCM in lockstep per time bin
+  // instead of feeding the samples one by one through the filter*NextSample() methods.
+  // Both implementations give bit-identical results.
+  static void setVectorizedFilter(bool vectorized) { mgVectorizedFilter = vectorized; }
+  static bool getVectorizedFilter() { return mgVectorizedFilter; }
+
   int getDetector() const { return mDetector; }; // Returns Chamber ID (0-539)
   int getRobPos() const { return mRobPos; };     // Returns ROB position (0-7)
   int getMcmPos() const { return mMcmPos; };     // Returns MCM position (0-17) (16,17 are mergers)
@@ -121,6 +127,12 @@ class TrapSimulator
   void filterGain();     // Apply gain filter
   void filterTail();     // Apply tail filter
 
+  // same as above, but all ADC channels are processed in lockstep for each timebin
+  void filterVectorized();         // Apply the filter chain of filter()
+  void filterPedestalVectorized(); // Apply pedestal filter
+  void filterGainVectorized();     // Apply gain filter
+  void filterTailVectorized();     // Apply tail filter
+
   // filter initialization (resets internal registers)
   void filterPedestalInit(int baseline = 10);
   void filterGainInit();
@@ -376,6 +388,9 @@ class TrapSimulator
                      unsigned short val1i, unsigned short val2i, unsigned short val3i, unsigned short val4i, unsigned short val5i, unsigned short val6i,
                      unsigned short* const idx5o, unsigned short* const idx6o);
 
+  template <bool doPedestal, bool doGain, bool doTail>
+  void filterLockstep(); // Apply the selected filters to all ADC channels, one timebin at a time
+
   unsigned int addUintClipping(unsigned int a, unsigned int b, unsigned int nbits) const;
   // Add a and b (unsigned) with clipping to the maximum value representable by nbits
  private:
@@ -388,6 +403,8 @@ class TrapSimulator
 
   static bool mgStoreClusters; // whether to store all clusters in the tracklets
 
+  static bool mgVectorizedFilter; // whether to run the filters on all channels in lockstep
+
   bool mdebugStream = false; // whether or not to keep all the additional info for eventual dumping to a tree.
 
   bool mDataIsSet = false;
@@ -61,6 +61,7 @@ using namespace o2::trd::constants;
 bool TrapSimulator::mgApplyCut = true;
 int TrapSimulator::mgAddBaseline = 0;
 bool TrapSimulator::mgStoreClusters = false;
+bool TrapSimulator::mgVectorizedFilter = true;
 const int TrapSimulator::mgkFormatIndex = std::ios_base::xalloc();
 const std::array<unsigned short, 4> TrapSimulator::mgkFPshifts{11, 14, 17, 21};
 
@@ -1106,6 +1107,11 @@ void TrapSimulator::filter()
   // outputs to mADCF.
 
   LOG(debug) << "ENTER: " << __FILE__ << ":" << __func__ << ":" << __LINE__;
+  if (mgVectorizedFilter) {
+    filterVectorized();
+    LOG(debug) << "LEAVE: " << __FILE__ << ":" << __func__ << ":" << __LINE__;
+    return;
+  }
   // Non-linearity filter not implemented.
   filterPedestal();
   //filterGain(); // we do not use the gain filter anyway, so disable it completely
@@ -1372,6 +1378,175 @@ void TrapSimulator::filterTail()
   }
 }
 
+void TrapSimulator::filterVectorized()
+{
+  // Same filter chain as in filter(), but the pedestal and the tail
+  // filter are applied in a single pass over the timebins.
+
+  if (!checkInitialized()) {
+    return;
+  }
+  filterLockstep<true, false, true>();
+}
+
+void TrapSimulator::filterPedestalVectorized()
+{
+  // Apply pedestal filter to all channels in lockstep,
+  // reads from mADCR and outputs to mADCF as filterPedestal()
+
+  if (!checkInitialized()) {
+    return;
+  }
+  filterLockstep<true, false, false>();
+}
+
+void TrapSimulator::filterGainVectorized()
+{
+  // Apply gain filter to all channels in lockstep, data is read from mADCF
+
+  if (!checkInitialized()) {
+    return;
+  }
+  filterLockstep<false, true, false>();
+}
+
+void TrapSimulator::filterTailVectorized()
+{
+  // Apply tail cancellation filter to all channels in lockstep, data is read from mADCF
+
+  if (!checkInitialized()) {
+    return;
+  }
+  filterLockstep<false, false, true>();
+}
+
+template <bool doPedestal, bool doGain, bool doTail>
+void TrapSimulator::filterLockstep()
+{
+  //
+  // The filters keep an internal state per ADC channel, but the channels
+  // are independent of each other. Here the TRAP registers are read once
+  // per MCM and the filter registers are copied into one array per register,
+  // so that for each timebin the loops over the 21 channels do not contain
+  // any branches or function calls and can be vectorized by the compiler.
+  // The arithmetic is identical to the one in filter*NextSample(), including
+  // the truncation to unsigned short of the values passed between the stages,
+  // such that the output is bit-exact.
+  //
+
+  // pedestal filter configuration
+  const unsigned int fpnp = mTrapConfig->getTrapReg(TrapConfig::kFPNP, mDetector, mRobPos, mMcmPos);
+  const unsigned int fpShift = mgkFPshifts[mTrapConfig->getTrapReg(TrapConfig::kFPTC, mDetector, mRobPos, mMcmPos)];
+  const bool fpBypass = mTrapConfig->getTrapReg(TrapConfig::kFPBY, mDetector, mRobPos, mMcmPos) == 0; // active low
+
+  // gain filter configuration
+  std::array<unsigned int, NADCMCM> fgfExtended{};
+  std::array<unsigned int, NADCMCM> fga{};
+  unsigned int fgta = 0;
+  unsigned int fgtb = 0;
+  if (doGain) {
+    for (int adc = 0; adc < NADCMCM; adc++) {
+      fgfExtended[adc] = 0x700 + (unsigned short)mTrapConfig->getTrapReg(TrapConfig::TrapReg_t(TrapConfig::kFGF0 + adc), mDetector, mRobPos, mMcmPos);
+      fga[adc] = (unsigned short)mTrapConfig->getTrapReg(TrapConfig::TrapReg_t(TrapConfig::kFGA0 + adc), mDetector, mRobPos, mMcmPos);
+    }
+    fgta = (unsigned short)mTrapConfig->getTrapReg(TrapConfig::kFGTA, mDetector, mRobPos, mMcmPos);
+    fgtb = (unsigned short)mTrapConfig->getTrapReg(TrapConfig::kFGTB, mDetector, mRobPos, mMcmPos);
+  }
+
+  // tail filter configuration
+  const unsigned int alphaLong = 0x3ff & mTrapConfig->getTrapReg(TrapConfig::kFTAL, mDetector, mRobPos, mMcmPos);
+  const unsigned int lambdaLong = (1 << 10) | (1 << 9) | (mTrapConfig->getTrapReg(TrapConfig::kFTLL, mDetector, mRobPos, mMcmPos) & 0x1FF);
+  const unsigned int lambdaShort = (0 << 10) | (1 << 9) | (mTrapConfig->getTrapReg(TrapConfig::kFTLS, mDetector, mRobPos, mMcmPos) & 0x1FF);
+  const bool ftBypass = mTrapConfig->getTrapReg(TrapConfig::kFTBY, mDetector, mRobPos, mMcmPos) == 0; // active low
+
+  // internal filter registers
+  std::array<unsigned int, NADCMCM> pedAcc;
+  std::array<unsigned int, NADCMCM> gainCounterA;
+  std::array<unsigned int, NADCMCM> gainCounterB;
+  std::array<unsigned int, NADCMCM> tailAmplLong;
+  std::array<unsigned int, NADCMCM> tailAmplShort;
+  for (int adc = 0; adc < NADCMCM; adc++) {
+    pedAcc[adc] = mInternalFilterRegisters[adc].mPedAcc;
+    gainCounterA[adc] = mInternalFilterRegisters[adc].mGainCounterA;
+    gainCounterB[adc] = mInternalFilterRegisters[adc].mGainCounterB;
+    tailAmplLong[adc] = mInternalFilterRegisters[adc].mTailAmplLong;
+    tailAmplShort[adc] = mInternalFilterRegisters[adc].mTailAmplShort;
+  }
+
+  const std::vector<int>& input = doPedestal ? mADCR : mADCF;
+  std::array<unsigned int, NADCMCM> value; // the sample of each channel for the current timebin
+
+  for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
+    for (int adc = 0; adc < NADCMCM; adc++) {
+      value[adc] = (unsigned short)input[adc * mNTimeBin + iTimeBin];
+    }
+
+    if (doPedestal) {
+      // the accumulator is disabled in the drift time
+      const bool updateAcc = (iTimeBin == 0);
+      for (int adc = 0; adc < NADCMCM; adc++) {
+        unsigned int inpAdd = (value[adc] + fpnp) & 0xFFFF;
+        unsigned int accumulatorShifted = (pedAcc[adc] >> fpShift) & 0x3FF; // 10 bits
+        if (updateAcc) {
+          pedAcc[adc] = (pedAcc[adc] + (value[adc] & 0x3FF) - accumulatorShifted) & 0x7FFFFFFF; // 31 bits
+        }
+        unsigned int diff = inpAdd - accumulatorShifted;
+        unsigned int output = (inpAdd <= accumulatorShifted) ? 0 : ((diff > 0xFFF) ? 0xFFF : diff);
+        value[adc] = fpBypass ? value[adc] : output;
+      }
+    }
+
+    if (doGain) {
+      for (int adc = 0; adc < NADCMCM; adc++) {
+        unsigned int input12 = value[adc] & 0xFFF;
+        unsigned int corr = (input12 * fgfExtended[adc]) >> 11;
+        corr = corr > 0xFFF ? 0xFFF : corr;
+        corr = corr + fga[adc];
+        corr = corr > 0xFFF ? 0xFFF : corr;
+        // update the threshold counters, they stop when full
+        bool notFull = (gainCounterA[adc] != 0x3FFFFFF) && (gainCounterB[adc] != 0x3FFFFFF);
+        gainCounterB[adc] += (notFull && corr >= fgtb) ? 1 : 0;
+        gainCounterA[adc] += (notFull && corr < fgtb && corr >= fgta) ? 1 : 0;
+        // the gain correction itself is not applied, as in filterGainNextSample()
+        value[adc] = input12;
+      }
+    }
+
+    if (doTail) {
+      for (int adc = 0; adc < NADCMCM; adc++) {
+        unsigned int inpVolt = value[adc] & 0xFFF; // 12 bits
+        // add the present generator outputs
+        unsigned int aQ = tailAmplLong[adc] + tailAmplShort[adc];
+        aQ = aQ > 0xFFF ? 0xFFF : aQ;
+        // calculate the difference between the input and the generated signal
+        unsigned int aDiff = (inpVolt > aQ) ? inpVolt - aQ : 0;
+        // the inputs to the two generators, weighted
+        unsigned int alInpv = (aDiff * alphaLong) >> 11;
+        // the new values of the registers, used next time
+        unsigned int tmpLong = tailAmplLong[adc] + alInpv;
+        tmpLong = tmpLong > 0xFFF ? 0xFFF : tmpLong;
+        tailAmplLong[adc] = ((tmpLong * lambdaLong) >> 11) & 0xFFF;
+        unsigned int tmpShort = tailAmplShort[adc] + (aDiff - alInpv);
+        tmpShort = tmpShort > 0xFFF ? 0xFFF : tmpShort;
+        tailAmplShort[adc] = ((tmpShort * lambdaShort) >> 11) & 0xFFF;
+        value[adc] = ftBypass ? value[adc] : aDiff;
+      }
+    }
+
+    for (int adc = 0; adc < NADCMCM; adc++) {
+      mADCF[adc * mNTimeBin + iTimeBin] = value[adc];
+    }
+  }
+
+  for (int adc = 0; adc < NADCMCM; adc++) {
+    mInternalFilterRegisters[adc].mPedAcc = pedAcc[adc];
+    mInternalFilterRegisters[adc].mGainCounterA = gainCounterA[adc];
+    mInternalFilterRegisters[adc].mGainCounterB = gainCounterB[adc];
+    mInternalFilterRegisters[adc].mTailAmplLong = tailAmplLong[adc];
+    mInternalFilterRegisters[adc].mTailAmplShort = tailAmplShort[adc];
+  }
+}
+
 void TrapSimulator::zeroSupressionMapping()
 {
   //
@@ -0,0 +1,139 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// Benchmark of the TRAP filter chain, sample by sample vs. all channels in lockstep.
+// By default random digits are used, a digits file (trddigits.root) can be given
+// via the environment variable TRD_BENCH_DIGITS to run over recorded digits.
+
+#include "benchmark/benchmark.h"
+#include "DataFormatsTRD/Constants.h"
+#include "DataFormatsTRD/Digit.h"
+#include "TRDSimulation/TrapConfig.h"
+#include "TRDSimulation/TrapSimulator.h"
+
+#include <TFile.h>
+#include <TTree.h>
+
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace o2::trd;
+using namespace o2::trd::constants;
+
+// the ADC data of one MCM
+struct MCMData {
+  int det, rob, mcm;
+  std::array<ArrayADC, NADCMCM> adc{};
+};
+
+std::vector<Digit> readDigits(const char* fileName)
+{
+  std::vector<Digit> digits;
+  std::unique_ptr<TFile> file(TFile::Open(fileName));
+  if (!file || file->IsZombie()) {
+    return digits;
+  }
+  auto tree = (TTree*)file->Get("o2sim");
+  if (!tree) {
+    return digits;
+  }
+  std::vector<Digit>* digitsIn = nullptr;
+  tree->SetBranchAddress("TRDDigit", &digitsIn);
+  for (int iEntry = 0; iEntry < tree->GetEntries(); ++iEntry) {
+    tree->GetEntry(iEntry);
+    digits.insert(digits.end(), digitsIn->begin(), digitsIn->end());
+  }
+  return digits;
+}
+
+std::vector<Digit> generateDigits(int nMCMs)
+{
+  std::vector<Digit> digits;
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> noise(0, 4);
+  std::uniform_int_distribution<int> pulse(20, 800);
+  for (int iMCM = 0; iMCM < nMCMs; ++iMCM) {
+    int det = iMCM % MAXCHAMBER;
+    int rob = (iMCM / MAXCHAMBER) % 8;
+    int mcm = (iMCM / MAXCHAMBER / 8) % NMCMROB;
+    // a track crossing the MCM leaves signal in three neighbouring channels
+    int hitChannel = rng() % (NADCMCM - 2);
+    for (int channel = hitChannel; channel < hitChannel + 3; ++channel) {
+      ArrayADC adc;
+      int amplitude = pulse(rng);
+      for (int tb = 0; tb < TIMEBINS; ++tb) {
+        adc[tb] = 9 + noise(rng) + ((tb > 2) ? amplitude * 3 / (tb + 1) : 0);
+      }
+      digits.emplace_back(det, rob, mcm, channel, adc);
+    }
+  }
+  return digits;
+}
+
+std::vector<MCMData> getMCMData()
+{
+  std::vector<Digit> digits;
+  if (const char* fileName = std::getenv("TRD_BENCH_DIGITS")) {
+    digits = readDigits(fileName);
+  }
+  if (digits.empty()) {
+    digits = generateDigits(10000);
+  }
+  std::map<std::tuple<int, int, int>, MCMData> mcms;
+  for (const auto& digit : digits) {
+    auto& data = mcms[{digit.getDetector(), digit.getROB(), digit.getMCM()}];
+    data.det = digit.getDetector();
+    data.rob = digit.getROB();
+    data.mcm = digit.getMCM();
+    data.adc[digit.getChannel()] = digit.getADC();
+  }
+  std::vector<MCMData> mcmData;
+  for (auto& entry : mcms) {
+    mcmData.push_back(entry.second);
+  }
+  return mcmData;
+}
+
+static void BM_TrapFilter(benchmark::State& state)
+{
+  static const auto mcmData = getMCMData();
+  static std::unique_ptr<TrapConfig> trapConfig;
+  if (!trapConfig) {
+    trapConfig = std::make_unique<TrapConfig>();
+    for (int det = 0; det < MAXCHAMBER; ++det) {
+      trapConfig->setTrapReg(TrapConfig::kC13CPUA, TIMEBINS, det);
+      trapConfig->setTrapReg(TrapConfig::kFPBY, 1, det);
+      trapConfig->setTrapReg(TrapConfig::kFTBY, 1, det);
+    }
+  }
+  TrapSimulator::setVectorizedFilter(state.range(0));
+  auto sim = std::make_unique<TrapSimulator>();
+  for (auto _ : state) {
+    for (const auto& data : mcmData) {
+      sim->init(trapConfig.get(), data.det, data.rob, data.mcm);
+      for (int channel = 0; channel < NADCMCM; ++channel) {
+        sim->setData(channel, data.adc[channel], channel);
+      }
+      sim->filter();
+      benchmark::DoNotOptimize(sim->getDataFiltered(0, 0));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * mcmData.size());
+  state.SetLabel(state.range(0) ? "lockstep" : "scalar");
+}
+
+BENCHMARK(BM_TrapFilter)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
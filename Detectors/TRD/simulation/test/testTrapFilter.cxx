@@ -0,0 +1,100 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TRD TRAP filters
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "DataFormatsTRD/Constants.h"
+#include "TRDSimulation/TrapConfig.h"
+#include "TRDSimulation/TrapSimulator.h"
+
+#include <memory>
+#include <random>
+
+namespace o2
+{
+namespace trd
+{
+
+using namespace constants;
+
+// initialize two TRAP simulators with identical random ADC data and filter registers
+void setupSimulators(TrapConfig* cfg, TrapSimulator& scalar, TrapSimulator& vectorized, std::mt19937& rng)
+{
+  const int det = 17, rob = 3, mcm = 5;
+  scalar.init(cfg, det, rob, mcm);
+  vectorized.init(cfg, det, rob, mcm);
+  for (auto sim : {&scalar, &vectorized}) {
+    sim->filterPedestalInit();
+    sim->filterGainInit();
+    sim->filterTailInit();
+  }
+  std::uniform_int_distribution<int> noise(0, 20);
+  std::uniform_int_distribution<int> signal(0, 1023);
+  for (int adc = 0; adc < NADCMCM; ++adc) {
+    ArrayADC data;
+    bool hasSignal = (rng() % 3 == 0);
+    for (int tb = 0; tb < TIMEBINS; ++tb) {
+      data[tb] = 10 + noise(rng) + ((hasSignal && tb > 3 && tb < 12) ? signal(rng) : 0);
+    }
+    scalar.setData(adc, data, adc);
+    vectorized.setData(adc, data, adc);
+  }
+}
+
+void compareFiltered(const TrapSimulator& scalar, const TrapSimulator& vectorized)
+{
+  for (int adc = 0; adc < NADCMCM; ++adc) {
+    for (int tb = 0; tb < scalar.getNumberOfTimeBins(); ++tb) {
+      BOOST_REQUIRE_EQUAL(scalar.getDataFiltered(adc, tb), vectorized.getDataFiltered(adc, tb));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TRDTrapFilterVectorized_test)
+{
+  auto cfg = std::make_unique<TrapConfig>();
+  cfg->setTrapReg(TrapConfig::kC13CPUA, TIMEBINS, 17);
+  cfg->setTrapReg(TrapConfig::kFPBY, 1, 17); // enable pedestal filter (bypass is active low)
+  cfg->setTrapReg(TrapConfig::kFTBY, 1, 17); // enable tail filter
+  std::mt19937 rng(12345);
+
+  for (int iter = 0; iter < 100; ++iter) {
+    {
+      // full filter chain
+      TrapSimulator scalar{}, vectorized{};
+      setupSimulators(cfg.get(), scalar, vectorized, rng);
+      scalar.filterPedestal();
+      scalar.filterTail();
+      vectorized.filterVectorized();
+      compareFiltered(scalar, vectorized);
+    }
+    {
+      // individual filter stages
+      TrapSimulator scalar{}, vectorized{};
+      setupSimulators(cfg.get(), scalar, vectorized, rng);
+      scalar.filterPedestal();
+      vectorized.filterPedestalVectorized();
+      compareFiltered(scalar, vectorized);
+      scalar.filterGain();
+      vectorized.filterGainVectorized();
+      compareFiltered(scalar, vectorized);
+      scalar.filterTail();
+      vectorized.filterTailVectorized();
+      compareFiltered(scalar, vectorized);
+    }
+  }
+}
+
+} // namespace trd
+} // namespace o2
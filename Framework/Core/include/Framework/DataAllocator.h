@@ -376,6 +376,12 @@ class DataAllocator
   void snapshot(const Output& spec, const char* payload, size_t payloadSize,
                 o2::header::SerializationMethod serializationMethod = o2::header::gSerializationMethodNone);
 
+  /// Send the payload of a received message to the output without copying it: the new
+  /// message shares the buffer with @a payload (reference counted by the transport).
+  /// If the output transport differs from the one of @a payload, the payload is copied.
+  void forward(const Output& spec, FairMQMessage const& payload,
+               o2::header::SerializationMethod serializationMethod = o2::header::gSerializationMethodNone);
+
   /// make an object of type T and route to output specified by OutputRef
   /// The object is owned by the framework, returned reference can be used to fill the object.
   ///
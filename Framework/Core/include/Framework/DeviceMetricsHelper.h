@@ -33,6 +33,24 @@ struct DeviceMetricsHelper {
   /// Helper function to parse a metric string.
   static bool parseMetric(std::string_view const s, ParsedMetricMatch& results);
 
+  /// Binary encoding of the metrics, used to send them to the driver without
+  /// formatting and parsing them as text when the DriverClient allows it.
+  /// A frame starts with BINARY_METRICS_MAGIC, followed by any number of
+  /// encoded metrics.
+  static constexpr char BINARY_METRICS_MAGIC[4] = {'\0', 'M', 'T', 'B'};
+
+  /// @return true if the @a size bytes at @a frame are binary metrics
+  static bool isBinaryMetrics(char const* frame, size_t size);
+  /// Append the magic which starts a binary metrics frame to @a buffer
+  static void beginBinaryMetrics(std::string& buffer);
+  /// Append the binary encoding of the metric described by @a match to @a buffer
+  static void encodeBinaryMetric(std::string& buffer, ParsedMetricMatch const& match);
+  /// Decode the binary metric starting at @a begin, filling @a results
+  /// with pointers to the key and, for strings, to the value in the buffer.
+  /// @return the beginning of the next metric or nullptr if the metric
+  /// could not be decoded.
+  static char const* parseBinaryMetric(char const* begin, char const* end, ParsedMetricMatch& results);
+
   /// Processes a parsed metric and stores in the backend store.
   ///
   /// @matches is the regexp_matches from the metric identifying regex
@@ -55,6 +73,8 @@ struct DeviceMetricsHelper {
       return metrics.floatMetrics;
     } else if constexpr (std::is_same_v<T, uint64_t>) {
       return metrics.uint64Metrics;
+    } else if constexpr (std::is_same_v<T, StringMetric>) {
+      return metrics.stringMetrics;
     } else {
       throw runtime_error("Unhandled metric type");
     };
@@ -74,22 +94,43 @@ struct DeviceMetricsHelper {
     };
   }
 
+  /// Insert a sample in the circular buffer of the metric at @a metricIndex.
+  /// The buffer grows on demand, doubling its size up to the maximum one,
+  /// after which the oldest sample is overwritten. Overwritten numeric
+  /// samples are kept, down-sampled, in the archive of the metric.
+  template <typename T>
+  static void insertSample(DeviceMetricsInfo& metrics, size_t metricIndex, T const& value, size_t timestamp)
+  {
+    constexpr size_t capacity = std::is_same_v<T, StringMetric> ? DeviceMetricsInfo::MAX_STRING_SAMPLES : DeviceMetricsInfo::MAX_NUMERIC_SAMPLES;
+    MetricInfo& metric = metrics.metrics[metricIndex];
+    auto& store = getMetricsStore<T>(metrics)[metric.storeIdx];
+    auto& timestamps = metrics.timestamps[metricIndex];
+    if (metric.pos >= store.size()) {
+      auto size = std::min(capacity, std::max(DeviceMetricsInfo::MIN_SAMPLES, 2 * store.size()));
+      store.resize(size);
+      timestamps.resize(size);
+    }
+    if constexpr (!std::is_same_v<T, StringMetric>) {
+      if (metric.filledMetrics >= capacity) {
+        metrics.archives[metricIndex].add(timestamps[metric.pos], (float)store[metric.pos]);
+      }
+    }
+    store[metric.pos] = value;
+    timestamps[metric.pos] = timestamp;
+    metric.pos = (metric.pos + 1) % capacity;
+    metric.filledMetrics++;
+  }
+
   template <typename T>
   static auto getNumericMetricCursor(size_t metricIndex)
   {
     return [metricIndex](DeviceMetricsInfo& metrics, T value, size_t timestamp) {
-      MetricInfo& metric = metrics.metrics[metricIndex];
-
       metrics.minDomain[metricIndex] = std::min(metrics.minDomain[metricIndex], timestamp);
       metrics.maxDomain[metricIndex] = std::max(metrics.maxDomain[metricIndex], timestamp);
       metrics.max[metricIndex] = std::max(metrics.max[metricIndex], (float)value);
       metrics.min[metricIndex] = std::min(metrics.min[metricIndex], (float)value);
       metrics.changed.at(metricIndex) = true;
-      auto& store = getMetricsStore<T>(metrics);
-      size_t pos = metric.pos++ % store[metric.storeIdx].size();
-      metrics.timestamps[metricIndex][pos] = timestamp;
-      store[metric.storeIdx][pos] = value;
-      metric.filledMetrics++;
+      insertSample(metrics, metricIndex, value, timestamp);
     };
   }
 
@@ -107,7 +148,7 @@ struct DeviceMetricsHelper {
     auto& metricInfo = metrics.metrics[metricIndex];
     metricInfo.type = getMetricType<T>();
     metricInfo.storeIdx = getMetricsStore<T>(metrics).size();
-    getMetricsStore<T>(metrics).emplace_back(std::array<T, 1024>{});
+    getMetricsStore<T>(metrics).emplace_back();
     if (newMetricsCallback != nullptr) {
       newMetricsCallback(name, metricInfo, 0, metricIndex);
     }
@@ -70,17 +70,38 @@ struct ParsedMetricMatch {
   char const* endStringValue;
 };
 
+/// Down-sampled history of a numeric metric. The samples which are about to
+/// be overwritten in the circular buffer of the metric are folded here,
+/// averaging consecutive samples, so that the whole history of the metric is
+/// kept in a bounded amount of memory with a decreasing time resolution.
+struct MetricArchive {
+  static constexpr size_t MAX_SAMPLES = 256;
+  size_t stride = 1;  // How many samples are averaged in each archived one
+  size_t pending = 0; // How many samples were averaged in the last archived one, if incomplete
+  std::vector<size_t> timestamps;
+  std::vector<float> values;
+
+  void add(size_t timestamp, float value);
+};
+
 /// This struct hold information about device metrics when running
 /// in standalone mode. It's position in the holding vector is
 /// the same as the DeviceSpec in its own vector.
 struct DeviceMetricsInfo {
-  // We keep the size of each metric to 4096 bytes. No need for more
-  // for the debug GUI
-  std::vector<std::array<int, 1024>> intMetrics;
-  std::vector<std::array<uint64_t, 1024>> uint64Metrics;
-  std::vector<std::array<StringMetric, 32>> stringMetrics; // We do not keep so many strings as metrics as history is less relevant.
-  std::vector<std::array<float, 1024>> floatMetrics;
-  std::vector<std::array<size_t, 1024>> timestamps;
+  // Maximum number of samples kept in the circular buffer of each metric.
+  // The buffers grow on demand, starting from MIN_SAMPLES, so that metrics
+  // which are seldomly updated do not pay for the full history.
+  static constexpr size_t MIN_SAMPLES = 16;
+  static constexpr size_t MAX_NUMERIC_SAMPLES = 1024;
+  // We do not keep so many strings as metrics as history is less relevant.
+  static constexpr size_t MAX_STRING_SAMPLES = 32;
+
+  std::vector<std::vector<int>> intMetrics;
+  std::vector<std::vector<uint64_t>> uint64Metrics;
+  std::vector<std::vector<StringMetric>> stringMetrics;
+  std::vector<std::vector<float>> floatMetrics;
+  std::vector<std::vector<size_t>> timestamps;
+  std::vector<MetricArchive> archives;
   std::vector<float> max;
   std::vector<float> min;
   std::vector<size_t> minDomain;
@@ -51,6 +51,10 @@ class DriverClient
   /// Flush all pending events (if connected)
   virtual void flushPending() = 0;
 
+  /// Whether the messages can carry binary data, e.g. the metrics
+  /// encoded by DeviceMetricsHelper::encodeBinaryMetric.
+  virtual bool acceptsBinary() const { return false; }
+
  private:
   std::vector<DriverEventMatcher> mEventMatchers;
 };
@@ -180,6 +180,12 @@ class InputRecord
   DataRef getByPos(int pos, int part = 0) const;
 
   size_t getNofParts(int pos) const;
+
+  /// The message holding the payload of the input at @a pos, so that it can be
+  /// forwarded without a copy with DataAllocator::forward. It is nullptr if the
+  /// input store does not provide it.
+  FairMQMessage const* getPayloadMessageByPos(int pos, int part = 0) const;
+
   /// Get the object of specified type T for the binding R.
   /// If R is a string like object, we look up by name the InputSpec and
   /// return the data associated to the given label.
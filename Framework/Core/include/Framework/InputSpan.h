@@ -17,6 +17,8 @@
 extern template class std::function<o2::framework::DataRef(size_t)>;
 extern template class std::function<o2::framework::DataRef(size_t, size_t)>;
 
+class FairMQMessage;
+
 namespace o2::framework
 {
 
@@ -48,6 +50,14 @@ class InputSpan
   /// @a size is the number of elements in the span.
   InputSpan(std::function<DataRef(size_t, size_t)> getter, std::function<size_t(size_t)> nofPartsGetter, size_t size);
 
+  /// @a getter is the mapping between an element of the span referred by
+  /// index and the buffer associated.
+  /// @nofPartsGetter is the getter for the number of parts associated with an index
+  /// @payloadMessageGetter is the getter for the message holding the payload of a part
+  /// @a size is the number of elements in the span.
+  InputSpan(std::function<DataRef(size_t, size_t)> getter, std::function<size_t(size_t)> nofPartsGetter,
+            std::function<FairMQMessage const*(size_t, size_t)> payloadMessageGetter, size_t size);
+
   /// @a i-th element of the InputSpan
   DataRef get(size_t i, size_t partidx = 0) const
   {
@@ -66,6 +76,15 @@ class InputSpan
     return mNofPartsGetter(i);
   }
 
+  /// The message holding the payload of the @a i-th element, nullptr if not available
+  FairMQMessage const* getPayloadMessage(size_t i, size_t partidx = 0) const
+  {
+    if (i >= mSize || !mPayloadMessageGetter) {
+      return nullptr;
+    }
+    return mPayloadMessageGetter(i, partidx);
+  }
+
   /// Number of elements in the InputSpan
   size_t size() const
   {
@@ -237,6 +256,7 @@ class InputSpan
  private:
   std::function<DataRef(size_t, size_t)> mGetter;
   std::function<size_t(size_t)> mNofPartsGetter;
+  std::function<FairMQMessage const*(size_t, size_t)> mPayloadMessageGetter;
   size_t mSize;
 };
 
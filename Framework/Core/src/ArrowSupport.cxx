@@ -156,10 +156,12 @@ o2::framework::ServiceSpec ArrowSupport::arrowBackendSpec()
                              changed |= deviceMetrics.changed.at(index);
                              MetricInfo info = deviceMetrics.metrics.at(index);
                              auto& data = deviceMetrics.uint64Metrics.at(info.storeIdx);
-                             auto value = (int64_t)data.at((info.pos - 1) % data.size());
-                             totalBytesCreated += value;
-                             lastTimestamp = std::max(lastTimestamp, deviceMetrics.timestamps[index][(info.pos - 1) % data.size()]);
-                             firstTimestamp = std::min(lastTimestamp, firstTimestamp);
+                             if (!data.empty()) {
+                               auto value = (int64_t)data.at((info.pos - 1) % data.size());
+                               totalBytesCreated += value;
+                               lastTimestamp = std::max(lastTimestamp, deviceMetrics.timestamps[index][(info.pos - 1) % data.size()]);
+                               firstTimestamp = std::min(lastTimestamp, firstTimestamp);
+                             }
                            }
                          }
                          {
@@ -169,10 +171,12 @@ o2::framework::ServiceSpec ArrowSupport::arrowBackendSpec()
                              changed |= deviceMetrics.changed.at(index);
                              MetricInfo info = deviceMetrics.metrics.at(index);
                              auto& data = deviceMetrics.uint64Metrics.at(info.storeIdx);
-                             auto value = (int64_t)data.at((info.pos - 1) % data.size());
-                             shmOfferConsumed += value;
-                             lastTimestamp = std::max(lastTimestamp, deviceMetrics.timestamps[index][(info.pos - 1) % data.size()]);
-                             firstTimestamp = std::min(lastTimestamp, firstTimestamp);
+                             if (!data.empty()) {
+                               auto value = (int64_t)data.at((info.pos - 1) % data.size());
+                               shmOfferConsumed += value;
+                               lastTimestamp = std::max(lastTimestamp, deviceMetrics.timestamps[index][(info.pos - 1) % data.size()]);
+                               firstTimestamp = std::min(lastTimestamp, firstTimestamp);
+                             }
                            }
                          }
                          {
@@ -182,8 +186,10 @@ o2::framework::ServiceSpec ArrowSupport::arrowBackendSpec()
                              changed |= deviceMetrics.changed.at(index);
                              MetricInfo info = deviceMetrics.metrics.at(index);
                              auto& data = deviceMetrics.uint64Metrics.at(info.storeIdx);
-                             totalBytesDestroyed += (int64_t)data.at((info.pos - 1) % data.size());
-                             firstTimestamp = std::min(lastTimestamp, firstTimestamp);
+                             if (!data.empty()) {
+                               totalBytesDestroyed += (int64_t)data.at((info.pos - 1) % data.size());
+                               firstTimestamp = std::min(lastTimestamp, firstTimestamp);
+                             }
                            }
                          }
                          {
@@ -193,8 +199,10 @@ o2::framework::ServiceSpec ArrowSupport::arrowBackendSpec()
                              changed |= deviceMetrics.changed.at(index);
                              MetricInfo info = deviceMetrics.metrics.at(index);
                              auto& data = deviceMetrics.uint64Metrics.at(info.storeIdx);
-                             totalBytesExpired += (int64_t)data.at((info.pos - 1) % data.size());
-                             firstTimestamp = std::min(lastTimestamp, firstTimestamp);
+                             if (!data.empty()) {
+                               totalBytesExpired += (int64_t)data.at((info.pos - 1) % data.size());
+                               firstTimestamp = std::min(lastTimestamp, firstTimestamp);
+                             }
                            }
                          }
                          {
@@ -202,7 +210,9 @@ o2::framework::ServiceSpec ArrowSupport::arrowBackendSpec()
                            if (index < deviceMetrics.metrics.size()) {
                              MetricInfo info = deviceMetrics.metrics.at(index);
                              auto& data = deviceMetrics.uint64Metrics.at(info.storeIdx);
-                             totalMessagesCreated += (int64_t)data.at((info.pos - 1) % data.size());
+                             if (!data.empty()) {
+                               totalMessagesCreated += (int64_t)data.at((info.pos - 1) % data.size());
+                             }
                            }
                          }
                          {
@@ -210,7 +220,9 @@ o2::framework::ServiceSpec ArrowSupport::arrowBackendSpec()
                            if (index < deviceMetrics.metrics.size()) {
                              MetricInfo info = deviceMetrics.metrics.at(index);
                              auto& data = deviceMetrics.uint64Metrics.at(info.storeIdx);
-                             totalMessagesDestroyed += (int64_t)data.at((info.pos - 1) % data.size());
+                             if (!data.empty()) {
+                               totalMessagesDestroyed += (int64_t)data.at((info.pos - 1) % data.size());
+                             }
                            }
                          }
                        }
@@ -11,6 +11,7 @@
 
 #include "DPLMonitoringBackend.h"
 #include "Framework/DriverClient.h"
+#include "Framework/DeviceMetricsHelper.h"
 #include "Framework/ServiceRegistry.h"
 #include <fmt/format.h>
 #include <sstream>
@@ -45,12 +46,80 @@ void DPLMonitoringBackend::addGlobalTag(std::string_view name, std::string_view
 
 void DPLMonitoringBackend::send(std::vector<o2::monitoring::Metric>&& metrics)
 {
+  auto& client = mRegistry.get<framework::DriverClient>();
+  if (client.acceptsBinary() == false) {
+    for (auto& m : metrics) {
+      sendText(m);
+    }
+    return;
+  }
+  // All the metrics which can be encoded go to the driver in a single message
+  std::string buffer;
+  DeviceMetricsHelper::beginBinaryMetrics(buffer);
+  bool encoded = false;
   for (auto& m : metrics) {
-    send(m);
+    if (encodeBinary(buffer, m)) {
+      encoded = true;
+    } else {
+      sendText(m);
+    }
+  }
+  // Do not send a message with only the header
+  if (encoded) {
+    client.tell(buffer);
   }
 }
 
 void DPLMonitoringBackend::send(o2::monitoring::Metric const& metric)
+{
+  auto& client = mRegistry.get<framework::DriverClient>();
+  if (client.acceptsBinary()) {
+    std::string buffer;
+    DeviceMetricsHelper::beginBinaryMetrics(buffer);
+    if (encodeBinary(buffer, metric)) {
+      client.tell(buffer);
+      return;
+    }
+  }
+  sendText(metric);
+}
+
+bool DPLMonitoringBackend::encodeBinary(std::string& buffer, o2::monitoring::Metric const& metric)
+{
+  // Like for the text encoding, only single valued metrics are understood
+  // by the driver.
+  if (metric.getValuesSize() != 1) {
+    return false;
+  }
+  auto const& name = metric.getName();
+  ParsedMetricMatch match;
+  match.beginKey = name.data();
+  match.endKey = name.data() + name.size();
+  match.timestamp = convertTimestamp(metric.getTimestamp());
+  std::visit(overloaded{
+               [&match](const std::string& value) {
+                 match.type = MetricType::String;
+                 match.beginStringValue = value.data();
+                 match.endStringValue = value.data() + value.size();
+               },
+               [&match](int value) {
+                 match.type = MetricType::Int;
+                 match.intValue = value;
+               },
+               [&match](double value) {
+                 match.type = MetricType::Float;
+                 match.floatValue = value;
+               },
+               [&match](uint64_t value) {
+                 match.type = MetricType::Uint64;
+                 match.uint64Value = value;
+               }},
+             metric.getValues().front().second);
+  DeviceMetricsHelper::encodeBinaryMetric(buffer, match);
+  return true;
+}
+
+void DPLMonitoringBackend::sendText(o2::monitoring::Metric const& metric)
 {
   std::ostringstream mStream;
   mStream << "[METRIC] " << metric.getName();
@@ -48,6 +48,12 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   /// \return             timestamp as unsigned long (miliseconds from epoch)
   unsigned long convertTimestamp(const std::chrono::time_point<std::chrono::system_clock>& timestamp);
 
+  /// Append the binary encoding of @a metric to @a buffer.
+  /// \return false if the metric cannot be encoded, i.e. it has multiple values
+  bool encodeBinary(std::string& buffer, const o2::monitoring::Metric& metric);
+  /// Send the metrics as text, one per line
+  void sendText(const o2::monitoring::Metric& metric);
+
   std::string mTagString;    ///< Global tagset (common for each metric)
   const std::string mPrefix; ///< Metric prefix
   ServiceRegistry& mRegistry;
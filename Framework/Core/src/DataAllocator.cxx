@@ -256,6 +256,21 @@ void DataAllocator::snapshot(const Output& spec, const char* payload, size_t pay
   addPartToContext(std::move(payloadMessage), spec, serializationMethod);
 }
 
+void DataAllocator::forward(const Output& spec, FairMQMessage const& payload,
+                            o2::header::SerializationMethod serializationMethod)
+{
+  auto& proxy = mRegistry->get<MessageContext>().proxy();
+  FairMQMessagePtr payloadMessage(proxy.createMessage());
+  if (payloadMessage->GetType() == payload.GetType()) {
+    payloadMessage->Copy(payload);
+  } else {
+    payloadMessage = proxy.createMessage(payload.GetSize());
+    memcpy(payloadMessage->GetData(), payload.GetData(), payload.GetSize());
+  }
+
+  addPartToContext(std::move(payloadMessage), spec, serializationMethod);
+}
+
 Output DataAllocator::getOutputByBind(OutputRef&& ref)
 {
   if (ref.label.empty()) {
@@ -55,6 +55,7 @@
 #include <TClonesArray.h>
 
 #include <algorithm>
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <unordered_map>
@@ -210,6 +211,9 @@ void DataProcessingDevice::Init()
 {
   TracyAppInfo(mSpec.name.data(), mSpec.name.size());
   ZoneScopedN("DataProcessingDevice::Init");
+#if !defined(__APPLE__)
+  SignpostTracer::setProcessName(mSpec.name);
+#endif
   mRelayer = &mServiceRegistry.get<DataRelayer>();
   // If available use the ConfigurationInterface, otherwise go for
   // the command line options.
@@ -862,7 +866,10 @@ void DataProcessingDevice::handleData(DataProcessorContext& context, InputChanne
 
   auto handleValidMessages = [&info, &context = context, &relayer = *context.relayer, &reportError](std::vector<InputType> const& types) {
     static WaitBackpressurePolicy policy;
+    static std::atomic<uint64_t> relayCount = 0;
     auto& parts = info.parts;
+    auto relayId = relayCount.fetch_add(1, std::memory_order_relaxed);
+    O2_SIGNPOST_START(O2_PROBE_RELAY, relayId, parts.Size(), 0, O2_SIGNPOST_PURPLE);
     // We relay execution to make sure we have a complete set of parts
     // available.
     for (size_t pi = 0; pi < (parts.Size() / 2); ++pi) {
@@ -912,6 +919,7 @@ void DataProcessingDevice::handleData(DataProcessorContext& context, InputChanne
     if (parts.fParts.size()) {
       LOG(DEBUG) << parts.fParts.size() << " messages backpressured";
     }
+    O2_SIGNPOST_END(O2_PROBE_RELAY, relayId, parts.Size(), r, O2_SIGNPOST_PURPLE);
   };
 
   // Second part. This is the actual outer loop we want to obtain, with
@@ -1022,7 +1030,13 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     auto nofPartsGetter = [&currentSetOfInputs](size_t i) -> size_t {
       return currentSetOfInputs[i].size();
     };
-    return InputSpan{getter, nofPartsGetter, currentSetOfInputs.size()};
+    auto payloadMessageGetter = [&currentSetOfInputs](size_t i, size_t partindex) -> FairMQMessage const* {
+      if (currentSetOfInputs[i].size() > partindex) {
+        return currentSetOfInputs[i].at(partindex).payload.get();
+      }
+      return nullptr;
+    };
+    return InputSpan{getter, nofPartsGetter, payloadMessageGetter, currentSetOfInputs.size()};
   };
 
   auto markInputsAsDone = [&relayer = context.relayer](TimesliceSlot slot) -> void {
@@ -1091,6 +1105,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
                         &spec = context.deviceContext->spec,
                         &device = context.deviceContext->device, &currentSetOfInputs](TimesliceSlot slot, InputRecord& record) {
     ZoneScopedN("forward inputs");
+    O2_SIGNPOST_START(O2_PROBE_FORWARDING, slot.index, 0, 0, O2_SIGNPOST_BLUE);
     assert(record.size() == currentSetOfInputs.size());
     // we collect all messages per forward in a map and send them together
     std::unordered_map<std::string, FairMQParts> forwardedParts;
@@ -1159,6 +1174,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       // in DPL we are using subchannel 0 only
       device->Send(channelParts, channelName, 0);
     }
+    O2_SIGNPOST_END(O2_PROBE_FORWARDING, slot.index, forwardedParts.size(), 0, O2_SIGNPOST_BLUE);
   };
 
   auto switchState = [&control = context.registry->get<ControlService>(),
@@ -1204,6 +1220,8 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     }
 
     prepareAllocatorForCurrentTimeSlice(TimesliceSlot{action.slot});
+    auto timeslice = context.timingInfo->timeslice;
+    O2_SIGNPOST_START(O2_PROBE_DISPATCH, timeslice, action.slot.index, (int)action.op, O2_SIGNPOST_ORANGE);
     InputSpan span = getInputSpan(action.slot);
     InputRecord record{context.deviceContext->spec->inputs, span};
     ProcessingContext processContext{record, *context.registry, *context.allocator};
@@ -1215,6 +1233,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       context.registry->postDispatchingCallbacks(processContext);
       if (context.deviceContext->spec->forwards.empty() == false) {
         forwardInputs(action.slot, record);
+        O2_SIGNPOST_END(O2_PROBE_DISPATCH, timeslice, action.slot.index, (int)action.op, O2_SIGNPOST_ORANGE);
         continue;
       }
     }
@@ -1243,6 +1262,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       }
     };
 
+    O2_SIGNPOST_START(O2_PROBE_PROCESSING, timeslice, action.slot.index, 0, O2_SIGNPOST_GREEN);
     if (noCatch) {
       runNoCatch();
     } else {
@@ -1261,6 +1281,8 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       }
     }
 
+    O2_SIGNPOST_END(O2_PROBE_PROCESSING, timeslice, action.slot.index, 0, O2_SIGNPOST_GREEN);
+
     postUpdateStats(action, record, tStart);
     // We forward inputs only when we consume them. If we simply Process them,
     // we keep them for next message arriving.
@@ -1275,6 +1297,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     } else if (action.op == CompletionPolicy::CompletionOp::Process) {
       cleanTimers(action.slot, record);
     }
+    O2_SIGNPOST_END(O2_PROBE_DISPATCH, timeslice, action.slot.index, (int)action.op, O2_SIGNPOST_ORANGE);
   }
   // We now broadcast the end of stream if it was requested
   if (context.deviceContext->state->streaming == StreamingState::EndOfStreaming) {
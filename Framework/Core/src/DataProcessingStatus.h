@@ -16,6 +16,11 @@
 
 /// probes to be used by the DPL
 #define O2_PROBE_DATARELAYER 3
+#define O2_PROBE_DATARELAYER_READY 4 // a timeslice is ready to be dispatched
+#define O2_PROBE_RELAY 5             // relaying the messages of an input channel
+#define O2_PROBE_DISPATCH 6          // dispatching a timeslice, from its preparation to the forwarding of its inputs
+#define O2_PROBE_PROCESSING 7        // processing callbacks of a timeslice
+#define O2_PROBE_FORWARDING 8        // forwarding the inputs of a timeslice
 
 namespace o2
 {
@@ -517,6 +517,7 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
       case CompletionPolicy::CompletionOp::Consume:
       case CompletionPolicy::CompletionOp::Process:
       case CompletionPolicy::CompletionOp::Discard:
+        O2_SIGNPOST(O2_PROBE_DATARELAYER_READY, mTimesliceIndex.getTimesliceForSlot(slot).value, slot.index, (int)action, 0);
         updateCompletionResults(slot, action);
         break;
       case CompletionPolicy::CompletionOp::Wait:
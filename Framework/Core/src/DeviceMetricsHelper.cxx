@@ -112,6 +112,103 @@ bool DeviceMetricsHelper::parseMetric(std::string_view const s, ParsedMetricMatc
   return true;
 }
 
+namespace
+{
+// Fixed size part of a binary metric. It is followed by the key and, for
+// string metrics, by the value.
+struct BinaryMetricHeader {
+  uint64_t timestamp;
+  union {
+    int intValue;
+    float floatValue;
+    uint64_t uint64Value;
+    uint64_t stringSize;
+  };
+  uint8_t type;
+  uint8_t keySize;
+};
+} // namespace
+
+bool DeviceMetricsHelper::isBinaryMetrics(char const* frame, size_t size)
+{
+  return size >= sizeof(BINARY_METRICS_MAGIC) && memcmp(frame, BINARY_METRICS_MAGIC, sizeof(BINARY_METRICS_MAGIC)) == 0;
+}
+
+void DeviceMetricsHelper::beginBinaryMetrics(std::string& buffer)
+{
+  buffer.append(BINARY_METRICS_MAGIC, sizeof(BINARY_METRICS_MAGIC));
+}
+
+void DeviceMetricsHelper::encodeBinaryMetric(std::string& buffer, ParsedMetricMatch const& match)
+{
+  BinaryMetricHeader header;
+  memset(&header, 0, sizeof(header));
+  header.timestamp = match.timestamp;
+  header.type = (uint8_t)match.type;
+  header.keySize = std::min(match.endKey - match.beginKey, (ptrdiff_t)MetricLabel::MAX_METRIC_LABEL_SIZE - 1);
+  switch (match.type) {
+    case MetricType::Int:
+      header.intValue = match.intValue;
+      break;
+    case MetricType::Float:
+      header.floatValue = match.floatValue;
+      break;
+    case MetricType::Uint64:
+      header.uint64Value = match.uint64Value;
+      break;
+    case MetricType::String:
+      header.stringSize = match.endStringValue - match.beginStringValue;
+      break;
+    default:
+      throw runtime_error("Unhandled metric type");
+  }
+  buffer.append(reinterpret_cast<char const*>(&header), sizeof(header));
+  buffer.append(match.beginKey, header.keySize);
+  if (match.type == MetricType::String) {
+    buffer.append(match.beginStringValue, header.stringSize);
+  }
+}
+
+char const* DeviceMetricsHelper::parseBinaryMetric(char const* begin, char const* end, ParsedMetricMatch& match)
+{
+  BinaryMetricHeader header;
+  if (end - begin < (ptrdiff_t)sizeof(header)) {
+    return nullptr;
+  }
+  memcpy(&header, begin, sizeof(header));
+  char const* next = begin + sizeof(header);
+  if (header.keySize == 0 || end - next < header.keySize) {
+    return nullptr;
+  }
+  match.beginKey = next;
+  match.endKey = next + header.keySize;
+  match.timestamp = header.timestamp;
+  match.type = static_cast<MetricType>(header.type);
+  next = match.endKey;
+  switch (match.type) {
+    case MetricType::Int:
+      match.intValue = header.intValue;
+      break;
+    case MetricType::Float:
+      match.floatValue = header.floatValue;
+      break;
+    case MetricType::Uint64:
+      match.uint64Value = header.uint64Value;
+      break;
+    case MetricType::String:
+      if ((uint64_t)(end - next) < header.stringSize) {
+        return nullptr;
+      }
+      match.beginStringValue = next;
+      match.endStringValue = next + header.stringSize;
+      next = match.endStringValue;
+      break;
+    default:
+      return nullptr;
+  }
+  return next;
+}
+
 size_t DeviceMetricsHelper::bookMetricInfo(DeviceMetricsInfo& info, char const* name)
 {
   // Add the index by name in the correct position
@@ -156,7 +253,8 @@ size_t DeviceMetricsHelper::bookMetricInfo(DeviceMetricsInfo& info, char const*
   metricInfo.filledMetrics = 0;
 
   // Add the timestamp buffer for it
-  info.timestamps.emplace_back(std::array<size_t, 1024>{});
+  info.timestamps.emplace_back();
+  info.archives.emplace_back();
   info.max.push_back(std::numeric_limits<float>::lowest());
   info.min.push_back(std::numeric_limits<float>::max());
   info.maxDomain.push_back(std::numeric_limits<size_t>::lowest());
@@ -215,26 +313,27 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
     switch (match.type) {
       case MetricType::Int:
         metricInfo.storeIdx = info.intMetrics.size();
-        info.intMetrics.emplace_back(std::array<int, 1024>{});
+        info.intMetrics.emplace_back();
         break;
       case MetricType::String:
         metricInfo.storeIdx = info.stringMetrics.size();
-        info.stringMetrics.emplace_back(std::array<StringMetric, 32>{});
+        info.stringMetrics.emplace_back();
         break;
       case MetricType::Float:
         metricInfo.storeIdx = info.floatMetrics.size();
-        info.floatMetrics.emplace_back(std::array<float, 1024>{});
+        info.floatMetrics.emplace_back();
         break;
       case MetricType::Uint64:
         metricInfo.storeIdx = info.uint64Metrics.size();
-        info.uint64Metrics.emplace_back(std::array<uint64_t, 1024>{});
+        info.uint64Metrics.emplace_back();
         break;
 
       default:
         return false;
     };
     // Add the timestamp buffer for it
-    info.timestamps.emplace_back(std::array<size_t, 1024>{});
+    info.timestamps.emplace_back();
+    info.archives.emplace_back();
     info.max.push_back(std::numeric_limits<float>::lowest());
     info.min.push_back(std::numeric_limits<float>::max());
     info.maxDomain.push_back(std::numeric_limits<size_t>::lowest());
@@ -273,46 +372,26 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
   info.minDomain[metricIndex] = std::min(info.minDomain[metricIndex], (size_t)match.timestamp);
   info.maxDomain[metricIndex] = std::max(info.maxDomain[metricIndex], (size_t)match.timestamp);
 
+  // Save the timestamp for the current metric together with the value,
+  // so that we do not update timestamps for broken metrics
   switch (metricInfo.type) {
     case MetricType::Int: {
-      info.intMetrics[metricInfo.storeIdx][metricInfo.pos] = match.intValue;
+      insertSample(info, metricIndex, match.intValue, match.timestamp);
       info.max[metricIndex] = std::max(info.max[metricIndex], (float)match.intValue);
       info.min[metricIndex] = std::min(info.min[metricIndex], (float)match.intValue);
-      // Save the timestamp for the current metric we do it here
-      // so that we do not update timestamps for broken metrics
-      info.timestamps[metricIndex][metricInfo.pos] = match.timestamp;
-      // Update the position where to write the next metric
-      metricInfo.pos = (metricInfo.pos + 1) % info.intMetrics[metricInfo.storeIdx].size();
-      ++metricInfo.filledMetrics;
     } break;
     case MetricType::String: {
-      info.stringMetrics[metricInfo.storeIdx][metricInfo.pos] = stringValue;
-      // Save the timestamp for the current metric we do it here
-      // so that we do not update timestamps for broken metrics
-      info.timestamps[metricIndex][metricInfo.pos] = match.timestamp;
-      metricInfo.pos = (metricInfo.pos + 1) % info.stringMetrics[metricInfo.storeIdx].size();
-      ++metricInfo.filledMetrics;
+      insertSample(info, metricIndex, stringValue, match.timestamp);
     } break;
     case MetricType::Float: {
-      info.floatMetrics[metricInfo.storeIdx][metricInfo.pos] = match.floatValue;
+      insertSample(info, metricIndex, match.floatValue, match.timestamp);
       info.max[metricIndex] = std::max(info.max[metricIndex], match.floatValue);
       info.min[metricIndex] = std::min(info.min[metricIndex], match.floatValue);
-      // Save the timestamp for the current metric we do it here
-      // so that we do not update timestamps for broken metrics
-      info.timestamps[metricIndex][metricInfo.pos] = match.timestamp;
-      metricInfo.pos = (metricInfo.pos + 1) % info.floatMetrics[metricInfo.storeIdx].size();
-      ++metricInfo.filledMetrics;
     } break;
     case MetricType::Uint64: {
-      info.uint64Metrics[metricInfo.storeIdx][metricInfo.pos] = match.uint64Value;
+      insertSample(info, metricIndex, match.uint64Value, match.timestamp);
       info.max[metricIndex] = std::max(info.max[metricIndex], (float)match.uint64Value);
       info.min[metricIndex] = std::min(info.min[metricIndex], (float)match.uint64Value);
-      // Save the timestamp for the current metric we do it here
-      // so that we do not update timestamps for broken metrics
-      info.timestamps[metricIndex][metricInfo.pos] = match.timestamp;
-      // Update the position where to write the next metric
-      metricInfo.pos = (metricInfo.pos + 1) % info.uint64Metrics[metricInfo.storeIdx].size();
-      ++metricInfo.filledMetrics;
     } break;
 
     default:
@@ -45,4 +45,26 @@ std::ostream& operator<<(std::ostream& oss, MetricType const& val)
   return oss;
 }
 
+void MetricArchive::add(size_t timestamp, float value)
+{
+  if (pending != 0) {
+    // Running average of the samples in the last bucket
+    values.back() += (value - values.back()) / (pending + 1);
+  } else {
+    if (values.size() == MAX_SAMPLES) {
+      // Halve the resolution of the whole archive to make space
+      for (size_t i = 0; i < MAX_SAMPLES / 2; ++i) {
+        timestamps[i] = timestamps[2 * i];
+        values[i] = 0.5f * (values[2 * i] + values[2 * i + 1]);
+      }
+      timestamps.resize(MAX_SAMPLES / 2);
+      values.resize(MAX_SAMPLES / 2);
+      stride *= 2;
+    }
+    timestamps.push_back(timestamp);
+    values.push_back(value);
+  }
+  pending = (pending + 1) % stride;
+}
+
 } // namespace o2::framework
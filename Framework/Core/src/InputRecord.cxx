@@ -82,6 +82,15 @@ size_t InputRecord::getNofParts(int pos) const
   }
   return mSpan.getNofParts(pos);
 }
+
+FairMQMessage const* InputRecord::getPayloadMessageByPos(int pos, int part) const
+{
+  if (pos < 0 || part < 0 || static_cast<size_t>(part) >= getNofParts(pos)) {
+    return nullptr;
+  }
+  return mSpan.getPayloadMessage(pos, part);
+}
+
 size_t InputRecord::size() const
 {
   return mSpan.size();
@@ -34,4 +34,10 @@ InputSpan::InputSpan(std::function<DataRef(size_t, size_t)> getter, std::functio
 {
 }
 
+InputSpan::InputSpan(std::function<DataRef(size_t, size_t)> getter, std::function<size_t(size_t)> nofPartsGetter,
+                     std::function<FairMQMessage const*(size_t, size_t)> payloadMessageGetter, size_t size)
+  : mGetter{getter}, mNofPartsGetter{nofPartsGetter}, mPayloadMessageGetter{payloadMessageGetter}, mSize{size}
+{
+}
+
 } // namespace o2::framework
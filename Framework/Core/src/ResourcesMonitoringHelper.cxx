@@ -39,6 +39,17 @@ boost::property_tree::ptree fillNodeWithValue(const DeviceMetricsInfo& deviceMet
   unsigned int loopRange = std::min(deviceMetrics.metrics[labelIndex].filledMetrics, metricsStorage[storageIndex].size());
   boost::property_tree::ptree metricNode;
 
+  // The samples which did not fit anymore in the circular buffer, down-sampled
+  if (labelIndex < deviceMetrics.archives.size()) {
+    auto& archive = deviceMetrics.archives[labelIndex];
+    for (size_t ai = 0; ai < archive.values.size(); ++ai) {
+      boost::property_tree::ptree values;
+      values.add("timestamp", archive.timestamps[ai]);
+      values.add("value", std::to_string(archive.values[ai]));
+      metricNode.push_back(std::make_pair("", values));
+    }
+  }
+
   for (unsigned int idx = 0; idx < loopRange; ++idx) {
     boost::property_tree::ptree values;
     values.add("timestamp", deviceMetrics.timestamps[labelIndex][idx]);
@@ -41,6 +41,8 @@ class WSDriverClient : public DriverClient
   ~WSDriverClient();
   void tell(const char* msg, size_t s, bool flush = true) final;
   void flushPending() final;
+  /// Websocket frames are delivered as a whole, so they can be binary.
+  bool acceptsBinary() const final { return true; }
   void setDPLClient(std::unique_ptr<WSDPLClient>);
   void setConnection(uv_connect_t* connection) { mConnection = connection; };
   DeviceSpec const& spec() { return mSpec; }
@@ -545,6 +545,24 @@ struct ControlWebSocketHandler : public WebSocketHandler {
       updateMetricsViews(name, metric, value, metricIndex);
       hasNewMetric = true;
     };
+    // Binary metrics do not need to be parsed as text
+    if (DeviceMetricsHelper::isBinaryMetrics(frame, s)) {
+      assert(mContext.metrics);
+      ParsedMetricMatch metricMatch;
+      char const* end = frame + s;
+      char const* next = frame + sizeof(DeviceMetricsHelper::BINARY_METRICS_MAGIC);
+      while (next != end) {
+        next = DeviceMetricsHelper::parseBinaryMetric(next, end, metricMatch);
+        if (next == nullptr) {
+          LOG(error) << "Malformed binary metric received from pid " << mPid;
+          break;
+        }
+        DeviceMetricsHelper::processMetric(metricMatch, (*mContext.metrics)[mIndex], newMetricCallback);
+        didProcessMetric = true;
+      }
+      didHaveNewMetric |= hasNewMetric;
+      return;
+    }
     std::string token(frame, s);
     std::smatch match;
     ParsedConfigMatch configMatch;
@@ -1802,6 +1820,16 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           LOG(INFO) << "Dumping performance metrics to performanceMetrics.json file";
           dumpMetricsCallback(&metricDumpTimer);
         }
+#if !defined(__APPLE__)
+        // The devices wrote their signposts when exiting, merge them
+        // together with the ones of the driver in a single timeline.
+        if (SignpostTracer::traceDirectory().empty() == false) {
+          auto& directory = SignpostTracer::traceDirectory();
+          SignpostTracer::flush();
+          auto merged = SignpostTracer::mergeTraces(directory, directory + "/dpl-signposts.json");
+          LOGP(info, "Merged signposts of {} processes in {}/dpl-signposts.json", merged, directory);
+        }
+#endif
         // This is a clean exit. Before we do so, if required,
         // we dump the configuration of all the devices so that
         // we can reuse it. Notice we do not dump anything if
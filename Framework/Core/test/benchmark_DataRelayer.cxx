@@ -15,6 +15,7 @@
 #include "Framework/CompletionPolicyHelpers.h"
 #include "Framework/DataRelayer.h"
 #include "Framework/DataProcessingHeader.h"
+#include "Framework/SignpostTracer.h"
 #include "../src/DataRelayerHelpers.h"
 #include <Monitoring/Monitoring.h>
 #include <fairmq/FairMQTransportFactory.h>
@@ -118,6 +119,17 @@ static void BM_RelaySingleSlot(benchmark::State& state)
 
 BENCHMARK(BM_RelaySingleSlot);
 
+// Same as above, with the signposts of the relayer recorded, to measure
+// the overhead of the tracing compared to BM_RelaySingleSlot.
+static void BM_RelaySingleSlotTraced(benchmark::State& state)
+{
+  SignpostTracer::enable();
+  BM_RelaySingleSlot(state);
+  SignpostTracer::disable();
+}
+
+BENCHMARK(BM_RelaySingleSlotTraced);
+
 // This one will simulate a single input.
 static void BM_RelayMultipleSlots(benchmark::State& state)
 {
@@ -164,4 +164,62 @@ static void BM_ProcessMismatchedMetric(benchmark::State& state)
 
 BENCHMARK(BM_ProcessMismatchedMetric);
 
+// Load of the driver when receiving a round of updates of @a state.range(1)
+// metrics from each one of @a state.range(0) devices, as text.
+static void BM_DriverTextMetrics(benchmark::State& state)
+{
+  using namespace o2::framework;
+  std::vector<DeviceMetricsInfo> infos(state.range(0));
+  std::vector<std::string> metrics;
+  for (int i = 0; i < state.range(1); ++i) {
+    metrics.push_back("[METRIC] device/metric-" + std::to_string(i) + ",0 12 1789372894 hostname=test.cern.ch");
+  }
+  ParsedMetricMatch match;
+  size_t bytes = 0;
+  for (auto _ : state) {
+    for (auto& info : infos) {
+      for (auto& metric : metrics) {
+        DeviceMetricsHelper::parseMetric(metric, match);
+        DeviceMetricsHelper::processMetric(match, info);
+        bytes += metric.size();
+      }
+    }
+  }
+  state.SetBytesProcessed(bytes);
+  state.SetItemsProcessed(state.iterations() * infos.size() * metrics.size());
+}
+
+BENCHMARK(BM_DriverTextMetrics)->Args({200, 100})->Args({200, 1000});
+
+// Same as above, with the metrics received as a single binary frame per device.
+static void BM_DriverBinaryMetrics(benchmark::State& state)
+{
+  using namespace o2::framework;
+  std::vector<DeviceMetricsInfo> infos(state.range(0));
+  std::string frame;
+  ParsedMetricMatch match;
+  DeviceMetricsHelper::beginBinaryMetrics(frame);
+  for (int i = 0; i < state.range(1); ++i) {
+    auto metric = "[METRIC] device/metric-" + std::to_string(i) + ",0 12 1789372894 hostname=test.cern.ch";
+    DeviceMetricsHelper::parseMetric(metric, match);
+    DeviceMetricsHelper::encodeBinaryMetric(frame, match);
+  }
+  size_t bytes = 0;
+  for (auto _ : state) {
+    for (auto& info : infos) {
+      char const* end = frame.data() + frame.size();
+      char const* next = frame.data() + sizeof(DeviceMetricsHelper::BINARY_METRICS_MAGIC);
+      while (next != end) {
+        next = DeviceMetricsHelper::parseBinaryMetric(next, end, match);
+        DeviceMetricsHelper::processMetric(match, info);
+      }
+      bytes += frame.size();
+    }
+  }
+  state.SetBytesProcessed(bytes);
+  state.SetItemsProcessed(state.iterations() * infos.size() * state.range(1));
+}
+
+BENCHMARK(BM_DriverBinaryMetrics)->Args({200, 100})->Args({200, 1000});
+
 BENCHMARK_MAIN();
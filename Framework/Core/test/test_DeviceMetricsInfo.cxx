@@ -223,3 +223,92 @@ BOOST_AUTO_TEST_CASE(TestHelpers)
   BOOST_CHECK_EQUAL(metric2, 0);
   BOOST_CHECK_EQUAL(metric3, 1);
 }
+
+BOOST_AUTO_TEST_CASE(TestGrowAndArchive)
+{
+  using namespace o2::framework;
+  DeviceMetricsInfo info;
+  auto akey = DeviceMetricsHelper::createNumericMetric<int>(info, "akey");
+  // The buffers are allocated on the first sample and grow on demand
+  BOOST_CHECK_EQUAL(info.intMetrics[0].size(), 0);
+  akey(info, 0, 0);
+  BOOST_CHECK_EQUAL(info.intMetrics[0].size(), DeviceMetricsInfo::MIN_SAMPLES);
+  BOOST_CHECK_EQUAL(info.timestamps[0].size(), DeviceMetricsInfo::MIN_SAMPLES);
+  for (size_t i = 1; i < DeviceMetricsInfo::MIN_SAMPLES + 1; ++i) {
+    akey(info, i, i);
+  }
+  BOOST_CHECK_EQUAL(info.intMetrics[0].size(), 2 * DeviceMetricsInfo::MIN_SAMPLES);
+  BOOST_CHECK_EQUAL(info.intMetrics[0][DeviceMetricsInfo::MIN_SAMPLES], DeviceMetricsInfo::MIN_SAMPLES);
+  BOOST_CHECK(info.archives[0].values.empty());
+
+  // Samples which are overwritten end up in the archive, down-sampled
+  size_t total = DeviceMetricsInfo::MAX_NUMERIC_SAMPLES + 4 * MetricArchive::MAX_SAMPLES;
+  for (size_t i = DeviceMetricsInfo::MIN_SAMPLES + 1; i < total; ++i) {
+    akey(info, i, i);
+  }
+  BOOST_CHECK_EQUAL(info.intMetrics[0].size(), DeviceMetricsInfo::MAX_NUMERIC_SAMPLES);
+  BOOST_CHECK_EQUAL(info.metrics[0].filledMetrics, total);
+  BOOST_CHECK_EQUAL(info.metrics[0].pos, total % DeviceMetricsInfo::MAX_NUMERIC_SAMPLES);
+  auto& archive = info.archives[0];
+  BOOST_CHECK_EQUAL(archive.stride, 4);
+  BOOST_CHECK_EQUAL(archive.values.size(), MetricArchive::MAX_SAMPLES);
+  BOOST_CHECK_EQUAL(archive.timestamps[0], 0);
+  BOOST_CHECK_CLOSE(archive.values[0], 1.5, 0.001);
+  BOOST_CHECK_EQUAL(archive.timestamps[1], 4);
+  BOOST_CHECK_CLOSE(archive.values.back(), (total - DeviceMetricsInfo::MAX_NUMERIC_SAMPLES) - 2.5, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(TestBinaryMetrics)
+{
+  using namespace o2::framework;
+  std::string buffer;
+  DeviceMetricsHelper::beginBinaryMetrics(buffer);
+  std::vector<std::string> metrics = {
+    "[METRIC] bkey,0 12 1789372894 hostname=test.cern.ch",
+    "[METRIC] key3,2 16.5 1789372895 hostname=test.cern.ch",
+    "[METRIC] key4,3 8589934592 1789372896 hostname=test.cern.ch",
+    "[METRIC] key5,1 some_string 1789372897 hostname=test.cern.ch"};
+  ParsedMetricMatch match;
+  for (auto& metric : metrics) {
+    BOOST_REQUIRE(DeviceMetricsHelper::parseMetric(metric, match));
+    DeviceMetricsHelper::encodeBinaryMetric(buffer, match);
+  }
+  BOOST_REQUIRE(DeviceMetricsHelper::isBinaryMetrics(buffer.data(), buffer.size()));
+  BOOST_CHECK(DeviceMetricsHelper::isBinaryMetrics(metrics[0].data(), metrics[0].size()) == false);
+
+  // Decoding the binary metrics must give the same store as the text ones
+  DeviceMetricsInfo textInfo;
+  for (auto& metric : metrics) {
+    DeviceMetricsHelper::parseMetric(metric, match);
+    DeviceMetricsHelper::processMetric(match, textInfo);
+  }
+  DeviceMetricsInfo info;
+  char const* end = buffer.data() + buffer.size();
+  char const* next = buffer.data() + sizeof(DeviceMetricsHelper::BINARY_METRICS_MAGIC);
+  size_t decoded = 0;
+  while (next != end) {
+    next = DeviceMetricsHelper::parseBinaryMetric(next, end, match);
+    BOOST_REQUIRE(next != nullptr);
+    BOOST_REQUIRE(DeviceMetricsHelper::processMetric(match, info));
+    decoded++;
+  }
+  BOOST_CHECK_EQUAL(decoded, metrics.size());
+  BOOST_REQUIRE_EQUAL(info.metrics.size(), textInfo.metrics.size());
+  for (size_t mi = 0; mi < info.metrics.size(); ++mi) {
+    BOOST_CHECK_EQUAL(std::string(info.metricLabels[mi].label), std::string(textInfo.metricLabels[mi].label));
+    BOOST_CHECK_EQUAL(info.metrics[mi].type, textInfo.metrics[mi].type);
+    BOOST_CHECK_EQUAL(info.timestamps[mi][0], textInfo.timestamps[mi][0]);
+  }
+  BOOST_CHECK_EQUAL(info.intMetrics[0][0], 12);
+  BOOST_CHECK_EQUAL(info.floatMetrics[0][0], 16.5);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][0], 8589934592ull);
+  BOOST_CHECK_EQUAL(std::string(info.stringMetrics[0][0].data), "some_string");
+
+  // Truncated metrics are rejected
+  auto truncated = buffer.substr(0, buffer.size() - 1);
+  char const* last = truncated.data() + sizeof(DeviceMetricsHelper::BINARY_METRICS_MAGIC);
+  for (size_t i = 0; i < metrics.size() - 1; ++i) {
+    last = DeviceMetricsHelper::parseBinaryMetric(last, truncated.data() + truncated.size(), match);
+  }
+  BOOST_CHECK(DeviceMetricsHelper::parseBinaryMetric(last, truncated.data() + truncated.size(), match) == nullptr);
+}
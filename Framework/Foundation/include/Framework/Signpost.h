@@ -17,12 +17,27 @@
 ///
 /// * macOS 10.15 onwards os_signpost
 /// * macOS 10.14 and below (either kdebug_signpost or kdebug)
-/// * linux SystemTap
+/// * linux in-process ring buffer tracer (see SignpostTracer.h), plus SystemTap if available
 ///
 /// Supported systems will have O2_SIGNPOST_API_AVAILABLE defined.
 ///
 /// In order to use it, one must define O2_SIGNPOST_DEFINE_CONTEXT in at least one cxx file,
 /// include "Framework/Signpost.h" and invoke O2_SIGNPOST_INIT().
+/// On linux the tracer is only active when DPL_SIGNPOST_TRACE is set, otherwise
+/// a signpost costs a single relaxed atomic load.
+#if !defined(__APPLE__)
+#include "Framework/SignpostTracer.h"
+// records a signpost in the in-process tracer, if enabled. The name is the
+// stringified code, taken before macro expansion by the O2_SIGNPOST macros.
+#define O2_SIGNPOST_TRACE(type, name, arg1, arg2, arg3, arg4)                                                        \
+  do {                                                                                                               \
+    if (o2::framework::SignpostTracer::active()) {                                                                   \
+      o2::framework::SignpostTracer::record(o2::framework::SignpostEventType::type, name,                            \
+                                            (uint64_t)(arg1), (uint64_t)(arg2), (uint64_t)(arg3), (uint32_t)(arg4)); \
+    }                                                                                                                \
+  } while (false)
+#endif
+
 #if defined(__APPLE__) && __has_include(<os/signpost.h>) && (__MAC_OS_X_VERSION_MAX_ALLOWED >= __MAC_10_15)
 #include <os/signpost.h>
 #include <os/log.h>
@@ -62,10 +77,28 @@ static os_log_t gDPLLog;
 #define O2_SIGNPOST_API_AVAILABLE
 #elif (!defined(__APPLE__)) && __has_include(<sys/sdt.h>) // Dtrace support is being dropped by Apple
 #include <sys/sdt.h>
-#define O2_SIGNPOST_INIT()
-#define O2_SIGNPOST(code, arg1, arg2, arg3, arg4) STAP_PROBE4(dpl, probe##code, arg1, arg2, arg3, arg4)
-#define O2_SIGNPOST_START(code, arg1, arg2, arg3, arg4) STAP_PROBE4(dpl, start_probe##code, arg1, arg2, arg3, arg4)
-#define O2_SIGNPOST_END(code, arg1, arg2, arg3, arg4) STAP_PROBE4(dpl, stop_probe##code, arg1, arg2, arg3, arg4)
+#define O2_SIGNPOST_INIT() o2::framework::SignpostTracer::initFromEnvironment()
+#define O2_SIGNPOST(code, arg1, arg2, arg3, arg4)            \
+  do {                                                       \
+    STAP_PROBE4(dpl, probe##code, arg1, arg2, arg3, arg4);   \
+    O2_SIGNPOST_TRACE(Event, #code, arg1, arg2, arg3, arg4); \
+  } while (false)
+#define O2_SIGNPOST_START(code, arg1, arg2, arg3, arg4)          \
+  do {                                                           \
+    STAP_PROBE4(dpl, start_probe##code, arg1, arg2, arg3, arg4); \
+    O2_SIGNPOST_TRACE(Start, #code, arg1, arg2, arg3, arg4);     \
+  } while (false)
+#define O2_SIGNPOST_END(code, arg1, arg2, arg3, arg4)           \
+  do {                                                          \
+    STAP_PROBE4(dpl, stop_probe##code, arg1, arg2, arg3, arg4); \
+    O2_SIGNPOST_TRACE(End, #code, arg1, arg2, arg3, arg4);      \
+  } while (false)
+#define O2_SIGNPOST_API_AVAILABLE
+#elif !defined(__APPLE__) // linux without SystemTap, only the in-process tracer
+#define O2_SIGNPOST_INIT() o2::framework::SignpostTracer::initFromEnvironment()
+#define O2_SIGNPOST(code, arg1, arg2, arg3, arg4) O2_SIGNPOST_TRACE(Event, #code, arg1, arg2, arg3, arg4)
+#define O2_SIGNPOST_START(code, arg1, arg2, arg3, arg4) O2_SIGNPOST_TRACE(Start, #code, arg1, arg2, arg3, arg4)
+#define O2_SIGNPOST_END(code, arg1, arg2, arg3, arg4) O2_SIGNPOST_TRACE(End, #code, arg1, arg2, arg3, arg4)
 #define O2_SIGNPOST_API_AVAILABLE
 #else // by default we do not do anything
 #define O2_SIGNPOST_INIT()
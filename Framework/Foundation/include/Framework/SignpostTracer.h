@@ -0,0 +1,151 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_SIGNPOSTTRACER_H_
+#define O2_FRAMEWORK_SIGNPOSTTRACER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace o2::framework
+{
+
+enum struct SignpostEventType : uint8_t {
+  Event = 0,
+  Start = 1,
+  End = 2
+};
+
+/// One signpost as recorded in memory. The name is the stringified
+/// signpost code, i.e. a string literal which lives as long as the process.
+struct SignpostRecord {
+  uint64_t timestamp = 0; // ns, CLOCK_MONOTONIC, hence comparable between processes of the same node
+  uint64_t id = 0;
+  uint64_t arg2 = 0;
+  uint64_t arg3 = 0;
+  const char* name = nullptr;
+  uint32_t color = 0;
+  SignpostEventType type = SignpostEventType::Event;
+};
+
+/// Ring buffer of the signposts of a single thread. Only the owning thread
+/// writes, so pushing is lock free and never blocks: once the buffer is full
+/// the oldest records are overwritten. Other threads may take a snapshot at
+/// any time, the records overwritten meanwhile are left out of it.
+class SignpostRingBuffer
+{
+ public:
+  SignpostRingBuffer(size_t capacity, uint32_t tid);
+
+  void push(SignpostRecord const& record)
+  {
+    // mClaimed announces the record being written to a concurrent snapshot(),
+    // mHead publishes it once complete
+    auto head = mHead.load(std::memory_order_relaxed);
+    mClaimed.store(head + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    uint64_t words[RecordWords];
+    std::memcpy(words, &record, sizeof(SignpostRecord));
+    auto& slot = mRecords[head & mMask];
+    for (size_t i = 0; i < RecordWords; ++i) {
+      slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    mHead.store(head + 1, std::memory_order_release);
+  }
+
+  /// The records still in the buffer, oldest first.
+  std::vector<SignpostRecord> snapshot() const;
+  /// Number of records which were overwritten before being read.
+  uint64_t overwritten() const;
+  uint32_t tid() const { return mTid; }
+
+ private:
+  static_assert(std::is_trivially_copyable_v<SignpostRecord> && sizeof(SignpostRecord) % sizeof(uint64_t) == 0);
+  static constexpr size_t RecordWords = sizeof(SignpostRecord) / sizeof(uint64_t);
+  // a record stored as words which a snapshot can read while they are overwritten
+  struct Slot {
+    std::atomic<uint64_t> words[RecordWords];
+  };
+  std::unique_ptr<Slot[]> mRecords;
+  uint64_t mSize;
+  uint64_t mMask;
+  std::atomic<uint64_t> mHead = 0;    // number of records written
+  std::atomic<uint64_t> mClaimed = 0; // number of records written or being written
+  uint32_t mTid;
+};
+
+/// The signposts of one process, as stored on disk by the devices and
+/// read back by the driver.
+struct SignpostTrace {
+  struct Entry {
+    uint64_t timestamp = 0;
+    uint64_t id = 0;
+    uint64_t arg2 = 0;
+    uint64_t arg3 = 0;
+    uint32_t tid = 0;
+    uint32_t color = 0;
+    uint32_t name = 0; // index in names
+    SignpostEventType type = SignpostEventType::Event;
+  };
+  int pid = 0;
+  std::string process;
+  std::vector<std::string> names;
+  std::vector<Entry> entries;
+};
+
+/// In-process signpost tracer used by the O2_SIGNPOST macros on Linux.
+///
+/// Tracing is enabled by setting DPL_SIGNPOST_TRACE to a directory. Every
+/// process then writes its signposts at exit to
+/// <directory>/dpl-signposts-<pid>.bin and the driver merges them into a
+/// Chrome / Perfetto JSON timeline <directory>/dpl-signposts.json.
+/// DPL_SIGNPOST_TRACE_SIZE sets the number of records kept per thread.
+struct SignpostTracer {
+  static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+
+  static bool active() { return gActive.load(std::memory_order_relaxed); }
+  static void enable(size_t capacityPerThread = DEFAULT_CAPACITY);
+  static void disable();
+  /// Enable the tracing if requested by the environment, to be invoked once
+  /// per process (done by O2_SIGNPOST_INIT).
+  static void initFromEnvironment();
+  static void setProcessName(std::string const& name);
+  /// Directory the traces are written to, empty if not configured.
+  static std::string const& traceDirectory();
+
+  static void record(SignpostEventType type, const char* name, uint64_t id, uint64_t arg2, uint64_t arg3, uint32_t color);
+
+  /// The records of all the threads of this process.
+  static SignpostTrace collect();
+  /// Write the trace of this process to the trace directory. Only the first
+  /// invocation writes, it is done automatically at exit.
+  static void flush();
+
+  static void writeTrace(std::ostream& out, SignpostTrace const& trace);
+  static bool readTrace(std::istream& in, SignpostTrace& trace);
+  /// Chrome trace event format, which can be loaded in Perfetto or chrome://tracing.
+  static void writeChromeTrace(std::ostream& out, std::vector<SignpostTrace> const& traces);
+  /// Merge all the traces found in the trace directory into a single
+  /// JSON timeline. Returns the number of processes merged.
+  static int mergeTraces(std::string const& directory, std::string const& output);
+
+ private:
+  static inline std::atomic<bool> gActive = false;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_SIGNPOSTTRACER_H_
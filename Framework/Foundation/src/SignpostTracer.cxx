@@ -0,0 +1,399 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/SignpostTracer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <istream>
+#include <unordered_map>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace o2::framework
+{
+
+namespace
+{
+constexpr uint32_t TRACE_MAGIC = 0x5053324f; // "O2SP"
+constexpr uint32_t TRACE_VERSION = 1;
+constexpr char const* TRACE_PREFIX = "dpl-signposts-";
+constexpr char const* TRACE_SUFFIX = ".bin";
+
+struct TracerState {
+  std::mutex mutex; // guards the registration of the buffers, not their filling
+  std::vector<std::unique_ptr<SignpostRingBuffer>> buffers;
+  size_t capacity = SignpostTracer::DEFAULT_CAPACITY;
+  std::string process;
+  std::string directory;
+  std::atomic<bool> flushed = false; // flush() runs at exit and may be invoked explicitly before
+};
+
+TracerState& state()
+{
+  static TracerState gState;
+  return gState;
+}
+
+thread_local SignpostRingBuffer* tBuffer = nullptr;
+
+uint32_t threadId()
+{
+#if defined(__linux__)
+  return syscall(SYS_gettid);
+#else
+  uint64_t tid = 0;
+  pthread_threadid_np(nullptr, &tid);
+  return tid;
+#endif
+}
+
+SignpostRingBuffer* registerThread()
+{
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.buffers.emplace_back(std::make_unique<SignpostRingBuffer>(s.capacity, threadId()));
+  return s.buffers.back().get();
+}
+
+uint64_t now()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+template <typename T>
+void writePOD(std::ostream& out, T const& value)
+{
+  out.write(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readPOD(std::istream& in, T& value)
+{
+  return (bool)in.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+void writeString(std::ostream& out, std::string const& s)
+{
+  writePOD(out, (uint32_t)s.size());
+  out.write(s.data(), s.size());
+}
+
+bool readString(std::istream& in, std::string& s)
+{
+  uint32_t size = 0;
+  if (!readPOD(in, size)) {
+    return false;
+  }
+  s.resize(size);
+  return (bool)in.read(s.data(), size);
+}
+
+void writeJSONString(std::ostream& out, std::string const& s)
+{
+  out << '"';
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if ((unsigned char)c < 0x20) {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", c);
+      out << buf;
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+char const* chromeColor(uint32_t color)
+{
+  // reserved color names of the trace viewer matching the O2_SIGNPOST_* colors
+  switch (color) {
+    case 0:
+      return "thread_state_iowait"; // blue
+    case 1:
+      return "good"; // green
+    case 2:
+      return "thread_state_unknown"; // purple
+    case 3:
+      return "bad"; // orange
+    case 4:
+      return "terrible"; // red
+    default:
+      return nullptr;
+  }
+}
+} // namespace
+
+SignpostRingBuffer::SignpostRingBuffer(size_t capacity, uint32_t tid)
+  : mTid{tid}
+{
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  mRecords = std::make_unique<Slot[]>(size);
+  mSize = size;
+  mMask = size - 1;
+}
+
+std::vector<SignpostRecord> SignpostRingBuffer::snapshot() const
+{
+  // The owner keeps pushing while the records are copied. Those up to the head
+  // loaded first are complete (release / acquire on mHead), but the owner may
+  // overwrite the oldest ones meanwhile. As with a seqlock, the claimed count
+  // is loaded after the copy and the records which the owner may have reached
+  // are dropped.
+  auto head = mHead.load(std::memory_order_acquire);
+  auto begin = head - std::min<uint64_t>(head, mSize);
+  std::vector<SignpostRecord> result(head - begin);
+  uint64_t words[RecordWords];
+  for (auto i = begin; i < head; ++i) {
+    auto& slot = mRecords[i & mMask];
+    for (size_t w = 0; w < RecordWords; ++w) {
+      words[w] = slot.words[w].load(std::memory_order_relaxed);
+    }
+    std::memcpy(&result[i - begin], words, sizeof(SignpostRecord));
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  auto claimed = mClaimed.load(std::memory_order_relaxed);
+  auto firstValid = claimed > mSize ? claimed - mSize : 0;
+  if (firstValid > begin) {
+    result.erase(result.begin(), result.begin() + std::min(firstValid, head) - begin);
+  }
+  return result;
+}
+
+uint64_t SignpostRingBuffer::overwritten() const
+{
+  auto head = mHead.load(std::memory_order_acquire);
+  return head > mSize ? head - mSize : 0;
+}
+
+void SignpostTracer::enable(size_t capacityPerThread)
+{
+  auto& s = state();
+  {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.capacity = capacityPerThread;
+  }
+  gActive.store(true, std::memory_order_relaxed);
+}
+
+void SignpostTracer::disable()
+{
+  gActive.store(false, std::memory_order_relaxed);
+}
+
+void SignpostTracer::initFromEnvironment()
+{
+  auto directory = getenv("DPL_SIGNPOST_TRACE");
+  if (directory == nullptr || directory[0] == '\0') {
+    return;
+  }
+  auto& s = state();
+  s.directory = directory;
+  auto size = getenv("DPL_SIGNPOST_TRACE_SIZE");
+  enable(size ? std::max(1l, atol(size)) : DEFAULT_CAPACITY);
+  static std::once_flag registered;
+  std::call_once(registered, []() { atexit(SignpostTracer::flush); });
+}
+
+void SignpostTracer::setProcessName(std::string const& name)
+{
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.process = name;
+}
+
+std::string const& SignpostTracer::traceDirectory()
+{
+  return state().directory;
+}
+
+void SignpostTracer::record(SignpostEventType type, const char* name, uint64_t id, uint64_t arg2, uint64_t arg3, uint32_t color)
+{
+  if (tBuffer == nullptr) {
+    tBuffer = registerThread();
+  }
+  tBuffer->push(SignpostRecord{now(), id, arg2, arg3, name, color, type});
+}
+
+SignpostTrace SignpostTracer::collect()
+{
+  auto& s = state();
+  SignpostTrace trace;
+  trace.pid = getpid();
+  std::unordered_map<std::string, uint32_t> nameIndex;
+  std::lock_guard<std::mutex> lock(s.mutex);
+  trace.process = s.process;
+  for (auto& buffer : s.buffers) {
+    for (auto& record : buffer->snapshot()) {
+      auto name = nameIndex.emplace(record.name ? record.name : "", trace.names.size());
+      if (name.second) {
+        trace.names.push_back(name.first->first);
+      }
+      trace.entries.push_back({record.timestamp, record.id, record.arg2, record.arg3, buffer->tid(), record.color, name.first->second, record.type});
+    }
+  }
+  std::stable_sort(trace.entries.begin(), trace.entries.end(), [](auto const& a, auto const& b) { return a.timestamp < b.timestamp; });
+  return trace;
+}
+
+void SignpostTracer::flush()
+{
+  auto& s = state();
+  if (s.directory.empty() || s.flushed.exchange(true)) {
+    return;
+  }
+  auto trace = collect();
+  std::string filename = s.directory + "/" + TRACE_PREFIX + std::to_string(trace.pid) + TRACE_SUFFIX;
+  std::ofstream out(filename, std::ios::binary);
+  if (!out) {
+    fprintf(stderr, "Unable to write signpost trace %s\n", filename.c_str());
+    return;
+  }
+  writeTrace(out, trace);
+}
+
+void SignpostTracer::writeTrace(std::ostream& out, SignpostTrace const& trace)
+{
+  writePOD(out, TRACE_MAGIC);
+  writePOD(out, TRACE_VERSION);
+  writePOD(out, (int32_t)trace.pid);
+  writeString(out, trace.process);
+  writePOD(out, (uint32_t)trace.names.size());
+  for (auto& name : trace.names) {
+    writeString(out, name);
+  }
+  writePOD(out, (uint64_t)trace.entries.size());
+  out.write(reinterpret_cast<char const*>(trace.entries.data()), trace.entries.size() * sizeof(SignpostTrace::Entry));
+}
+
+bool SignpostTracer::readTrace(std::istream& in, SignpostTrace& trace)
+{
+  uint32_t magic = 0, version = 0, nnames = 0;
+  int32_t pid = 0;
+  uint64_t nentries = 0;
+  if (!readPOD(in, magic) || magic != TRACE_MAGIC || !readPOD(in, version) || version != TRACE_VERSION) {
+    return false;
+  }
+  if (!readPOD(in, pid) || !readString(in, trace.process) || !readPOD(in, nnames)) {
+    return false;
+  }
+  trace.pid = pid;
+  trace.names.resize(nnames);
+  for (auto& name : trace.names) {
+    if (!readString(in, name)) {
+      return false;
+    }
+  }
+  if (!readPOD(in, nentries)) {
+    return false;
+  }
+  trace.entries.resize(nentries);
+  return (bool)in.read(reinterpret_cast<char*>(trace.entries.data()), nentries * sizeof(SignpostTrace::Entry));
+}
+
+void SignpostTracer::writeChromeTrace(std::ostream& out, std::vector<SignpostTrace> const& traces)
+{
+  // timestamps are given relative to the first signpost, in microseconds
+  uint64_t origin = UINT64_MAX;
+  for (auto& trace : traces) {
+    for (auto& entry : trace.entries) {
+      origin = std::min(origin, entry.timestamp);
+    }
+  }
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  auto separator = [&out, &first]() {
+    if (!first) {
+      out << ",\n";
+    }
+    first = false;
+  };
+  char buffer[64];
+  for (auto& trace : traces) {
+    separator();
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << trace.pid << ",\"args\":{\"name\":";
+    writeJSONString(out, trace.process.empty() ? std::to_string(trace.pid) : trace.process);
+    out << "}}";
+    for (auto& entry : trace.entries) {
+      separator();
+      out << "{\"name\":";
+      writeJSONString(out, entry.name < trace.names.size() ? trace.names[entry.name] : "");
+      out << ",\"cat\":\"dpl\",\"pid\":" << trace.pid << ",\"tid\":" << entry.tid;
+      snprintf(buffer, sizeof(buffer), "%.3f", (entry.timestamp - origin) / 1000.);
+      out << ",\"ts\":" << buffer;
+      switch (entry.type) {
+        case SignpostEventType::Start:
+        case SignpostEventType::End:
+          // async events, matched by name and id within the process
+          out << ",\"ph\":\"" << (entry.type == SignpostEventType::Start ? 'b' : 'e') << "\",\"id2\":{\"local\":\"0x" << std::hex << entry.id << std::dec << "\"}";
+          break;
+        default:
+          out << ",\"ph\":\"i\",\"s\":\"t\"";
+      }
+      if (auto color = chromeColor(entry.color)) {
+        out << ",\"cname\":\"" << color << "\"";
+      }
+      out << ",\"args\":{\"id\":" << entry.id << ",\"arg2\":" << entry.arg2 << ",\"arg3\":" << entry.arg3 << "}}";
+    }
+  }
+  out << "]}\n";
+}
+
+int SignpostTracer::mergeTraces(std::string const& directory, std::string const& output)
+{
+  std::vector<SignpostTrace> traces;
+  auto dir = opendir(directory.c_str());
+  if (dir == nullptr) {
+    return 0;
+  }
+  auto prefixSize = strlen(TRACE_PREFIX);
+  auto suffixSize = strlen(TRACE_SUFFIX);
+  while (auto file = readdir(dir)) {
+    std::string name = file->d_name;
+    if (name.size() <= prefixSize + suffixSize || name.compare(0, prefixSize, TRACE_PREFIX) != 0 || name.compare(name.size() - suffixSize, suffixSize, TRACE_SUFFIX) != 0) {
+      continue;
+    }
+    std::ifstream in(directory + "/" + name, std::ios::binary);
+    SignpostTrace trace;
+    if (readTrace(in, trace)) {
+      traces.emplace_back(std::move(trace));
+    } else {
+      fprintf(stderr, "Unable to read signpost trace %s\n", name.c_str());
+    }
+  }
+  closedir(dir);
+  std::sort(traces.begin(), traces.end(), [](auto const& a, auto const& b) { return a.pid < b.pid; });
+  std::ofstream out(output);
+  writeChromeTrace(out, traces);
+  return traces.size();
+}
+
+} // namespace o2::framework
@@ -0,0 +1,64 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <benchmark/benchmark.h>
+#include "Framework/SignpostTracer.h"
+
+using namespace o2::framework;
+
+// cost of a signpost with the tracing disabled, i.e. what every probe costs in production
+static void BM_SignpostDisabled(benchmark::State& state)
+{
+  SignpostTracer::disable();
+  uint64_t id = 0;
+  for (auto _ : state) {
+    if (SignpostTracer::active()) {
+      SignpostTracer::record(SignpostEventType::Start, "O2_PROBE_BENCH", id, 1, 2, 0);
+    }
+    benchmark::DoNotOptimize(++id);
+  }
+}
+BENCHMARK(BM_SignpostDisabled);
+
+// cost of a recorded signpost, once per thread (the ring buffers are independent)
+static void BM_SignpostEnabled(benchmark::State& state)
+{
+  if (state.thread_index() == 0) {
+    SignpostTracer::enable();
+  }
+  uint64_t id = 0;
+  for (auto _ : state) {
+    if (SignpostTracer::active()) {
+      SignpostTracer::record(SignpostEventType::Start, "O2_PROBE_BENCH", id, 1, 2, 0);
+    }
+    benchmark::DoNotOptimize(++id);
+  }
+  if (state.thread_index() == 0) {
+    SignpostTracer::disable();
+  }
+}
+BENCHMARK(BM_SignpostEnabled)->Threads(1)->Threads(4);
+
+// snapshot of a full buffer of the default size, as done at exit while the other threads may still push
+static void BM_SignpostSnapshot(benchmark::State& state)
+{
+  SignpostRingBuffer buffer(SignpostTracer::DEFAULT_CAPACITY, 1);
+  for (uint64_t i = 0; i < SignpostTracer::DEFAULT_CAPACITY; ++i) {
+    buffer.push(SignpostRecord{i, i, 0, 0, "O2_PROBE_BENCH", 0, SignpostEventType::Event});
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(buffer.snapshot());
+  }
+  state.SetItemsProcessed(state.iterations() * SignpostTracer::DEFAULT_CAPACITY);
+}
+BENCHMARK(BM_SignpostSnapshot);
+
+BENCHMARK_MAIN();
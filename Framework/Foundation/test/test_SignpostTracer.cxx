@@ -0,0 +1,105 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework SignpostTracer
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "Framework/SignpostTracer.h"
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestRingBufferOverwrite)
+{
+  SignpostRingBuffer buffer(5, 1);
+  for (uint64_t i = 0; i < 20; ++i) {
+    buffer.push(SignpostRecord{i, i, 0, 0, "test", 0, SignpostEventType::Event});
+  }
+  // the capacity is rounded up to the next power of two and the oldest records are dropped
+  auto records = buffer.snapshot();
+  BOOST_REQUIRE_EQUAL(records.size(), 8);
+  BOOST_CHECK_EQUAL(buffer.overwritten(), 12);
+  for (size_t i = 0; i < records.size(); ++i) {
+    BOOST_CHECK_EQUAL(records[i].id, 12 + i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestSnapshotWhileWriting)
+{
+  // the records taken while the owner wraps around the buffer are never torn or out of order
+  SignpostRingBuffer buffer(64, 1);
+  std::atomic<bool> done = false;
+  std::thread writer([&buffer, &done]() {
+    for (uint64_t i = 0; i < 2000000; ++i) {
+      buffer.push(SignpostRecord{i, i, i, i, "test", 0, SignpostEventType::Event});
+    }
+    done = true;
+  });
+  bool consistent = true;
+  while (!done) {
+    auto records = buffer.snapshot();
+    for (size_t i = 0; i < records.size(); ++i) {
+      auto& record = records[i];
+      consistent &= record.timestamp == record.id && record.arg2 == record.id && record.arg3 == record.id;
+      consistent &= i == 0 || record.id == records[i - 1].id + 1;
+    }
+  }
+  writer.join();
+  BOOST_CHECK(consistent);
+  BOOST_CHECK_EQUAL(buffer.snapshot().size(), 64);
+}
+
+BOOST_AUTO_TEST_CASE(TestTracerRoundTrip)
+{
+  BOOST_CHECK(SignpostTracer::active() == false);
+  SignpostTracer::enable(128);
+  SignpostTracer::setProcessName("test \"device\"");
+  SignpostTracer::record(SignpostEventType::Start, "O2_PROBE_TEST", 42, 1, 2, 0);
+  std::thread other([]() {
+    SignpostTracer::record(SignpostEventType::Event, "O2_PROBE_OTHER", 7, 0, 0, 4);
+  });
+  other.join();
+  SignpostTracer::record(SignpostEventType::End, "O2_PROBE_TEST", 42, 3, 4, 0);
+  SignpostTracer::disable();
+
+  auto trace = SignpostTracer::collect();
+  BOOST_REQUIRE_EQUAL(trace.entries.size(), 3);
+  BOOST_CHECK_EQUAL(trace.names.size(), 2);
+  BOOST_CHECK(trace.entries[0].type == SignpostEventType::Start);
+  BOOST_CHECK(trace.entries[2].type == SignpostEventType::End);
+  BOOST_CHECK_EQUAL(trace.names[trace.entries[1].name], "O2_PROBE_OTHER");
+  BOOST_CHECK(trace.entries[0].tid != trace.entries[1].tid);
+  for (size_t i = 1; i < trace.entries.size(); ++i) {
+    BOOST_CHECK(trace.entries[i - 1].timestamp <= trace.entries[i].timestamp);
+  }
+
+  std::stringstream binary;
+  SignpostTracer::writeTrace(binary, trace);
+  SignpostTrace readBack;
+  BOOST_REQUIRE(SignpostTracer::readTrace(binary, readBack));
+  BOOST_CHECK_EQUAL(readBack.pid, trace.pid);
+  BOOST_CHECK_EQUAL(readBack.process, trace.process);
+  BOOST_REQUIRE_EQUAL(readBack.entries.size(), trace.entries.size());
+  BOOST_CHECK_EQUAL(readBack.entries[2].arg3, 4);
+
+  std::stringstream json;
+  SignpostTracer::writeChromeTrace(json, {readBack});
+  auto s = json.str();
+  BOOST_CHECK(s.find("\"traceEvents\"") != std::string::npos);
+  BOOST_CHECK(s.find("\"ph\":\"b\"") != std::string::npos);
+  BOOST_CHECK(s.find("\"ph\":\"e\"") != std::string::npos);
+  BOOST_CHECK(s.find("\"id2\":{\"local\":\"0x2a\"}") != std::string::npos);
+  BOOST_CHECK(s.find("test \\\"device\\\"") != std::string::npos);
+}
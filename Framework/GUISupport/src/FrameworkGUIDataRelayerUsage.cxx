@@ -114,6 +114,11 @@ void displayDataRelayer(DeviceMetricsInfo const& metrics,
     MetricInfo const& metricInfo = metrics.metrics[viewIndex.indexes[idx]];
     assert(metrics.intMetrics.size() > metricInfo.storeIdx);
     auto& data = metrics.intMetrics[metricInfo.storeIdx];
+    // the buffers grow with the first sample, a slot without any is shown as empty
+    static const int noSample = 0;
+    if (data.empty()) {
+      return noSample;
+    }
     return data[(metricInfo.pos - 1) % data.size()];
   };
   auto getValue = [](int const& item) -> int { return item; };
@@ -144,6 +149,9 @@ void displayDataRelayer(DeviceMetricsInfo const& metrics,
       MetricInfo const& metricInfo = metrics.metrics[variablesIndex.indexes[idx]];
       assert(metricInfo.storeIdx < metrics.stringMetrics.size());
       auto& data = metrics.stringMetrics[metricInfo.storeIdx];
+      if (data.empty()) {
+        continue;
+      }
       char const* value = data[(metricInfo.pos - 1) % data.size()].data;
       if (strncmp("null", value, 4) == 0) {
         continue;
@@ -483,6 +483,11 @@ void metricsTableRow(std::vector<MetricIndex> metricIndex,
     auto& info = metricsInfos[index.deviceIndex].metrics[index.metricIndex];
 
     ImGui::TableNextColumn();
+    // The buffers of the metrics grow on demand, so they might not have
+    // reached the row yet.
+    if (row >= metricsInfo.timestamps[index.metricIndex].size()) {
+      continue;
+    }
     auto time = metricsInfo.timestamps[index.metricIndex][row];
     switch (info.type) {
       case MetricType::Int: {
@@ -734,9 +739,8 @@ void displayMetrics(gui::WorkspaceGUIState& state,
           visibleMetrics++;
           auto& metric = metricInfo.metrics[mi];
           auto& timestamps = metricInfo.timestamps[mi];
-
-          for (size_t ti = 0; ti != metricInfo.timestamps.size(); ++ti) {
-            size_t minRangePos = (metric.pos + ti) % metricInfo.timestamps.size();
+          for (size_t ti = 0; ti != timestamps.size(); ++ti) {
+            size_t minRangePos = (metric.pos + ti) % timestamps.size();
             size_t curMinTime = timestamps[minRangePos];
             if (curMinTime == 0) {
               continue;
@@ -746,9 +750,12 @@ void displayMetrics(gui::WorkspaceGUIState& state,
               break;
             }
           }
-          size_t maxRangePos = (size_t)(metric.pos) - 1 % metricInfo.timestamps.size();
-          size_t curMaxTime = timestamps[maxRangePos];
-          maxTime = std::max(maxTime, curMaxTime);
+          // The buffers of the metrics are allocated on the first sample
+          if (timestamps.empty() == false) {
+            size_t maxRangePos = ((size_t)(metric.pos) - 1) % timestamps.size();
+            size_t curMaxTime = timestamps[maxRangePos];
+            maxTime = std::max(maxTime, curMaxTime);
+          }
           visibleMetricsIndex.push_back(MetricIndex{si, di, mi, gmi});
         }
         gmi++;
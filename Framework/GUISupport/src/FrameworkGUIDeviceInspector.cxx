@@ -53,10 +53,13 @@ void deviceInfoTable(DeviceInfo const& info, DeviceMetricsInfo const& metrics)
   if (info.queriesViewIndex.indexes.empty() == false && ImGui::CollapsingHeader("Inputs:", ImGuiTreeNodeFlags_DefaultOpen)) {
     for (size_t i = 0; i < info.queriesViewIndex.indexes.size(); ++i) {
       auto& metric = metrics.metrics[info.queriesViewIndex.indexes[i]];
-      ImGui::Text("%zu: %s", i, metrics.stringMetrics[metric.storeIdx][0].data);
+      auto& data = metrics.stringMetrics[metric.storeIdx];
+      // the buffer stays empty until the query has been reported once
+      char const* query = data.empty() ? "<not yet known>" : data[0].data;
+      ImGui::Text("%zu: %s", i, query);
       if (ImGui::IsItemHovered()) {
         ImGui::BeginTooltip();
-        ImGui::Text("%zu: %s", i, metrics.stringMetrics[metric.storeIdx][0].data);
+        ImGui::Text("%zu: %s", i, query);
         ImGui::EndTooltip();
       }
     }
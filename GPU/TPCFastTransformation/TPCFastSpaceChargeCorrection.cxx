@@ -19,6 +19,7 @@
 #if !defined(GPUCA_GPUCODE)
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 #include "ChebyshevFit1D.h"
 #include "Spline2DHelper.h"
 #endif
@@ -232,6 +233,89 @@ void TPCFastSpaceChargeCorrection::print() const
   }
 }
 
+#if !defined(GPUCA_GPUCODE)
+
+namespace
+{
+/// Hermite interpolation at the segment [knotL, knotR], see Spline1DSpec::interpolateU().
+/// uu is the distance from the left knot, li the inverse length of the segment
+inline float interpolateHermite(float Sl, float Dl, float Sr, float Dr, float uu, float li)
+{
+  float v = uu * li; // scaled u
+  float df = (Sr - Sl) * li;
+  float a = Dl + Dr - df - df;
+  float b = df - Dl - a;
+  return ((a * v + b) * v + Dl) * uu + Sl;
+}
+} // namespace
+
+void TPCFastSpaceChargeCorrection::getCorrection(int slice, int row, int n, const float* u, const float* v, float* dx, float* du, float* dv) const
+{
+  /// Same as getCorrection() for n clusters of one TPC row.
+  ///
+  /// All clusters of the row share the spline scenario and the spline data, so they are looked up once.
+  /// The clusters are processed in blocks: first the knots are found for each cluster,
+  /// then the 2D spline is evaluated with the loops over the clusters innermost, such that the compiler can vectorize them.
+  /// The arithmetic is the same as in Spline2DSpec::interpolateU().
+
+  constexpr int BlockSize = 32;
+  constexpr int nYdim = 3;
+  constexpr int nYdim2 = nYdim * 2;
+  constexpr int nYdim4 = nYdim * 4;
+
+  const SplineType& spline = getSpline(slice, row);
+  const float* splineData = getSplineData(slice, row);
+  const auto& gridU = spline.getGridX1();
+  const auto& gridV = spline.getGridX2();
+  const int nu = gridU.getNumberOfKnots();
+
+  int offset[BlockSize];               // offset of the spline parameters at the knot {u0, v0}
+  float uu[BlockSize], uLi[BlockSize]; // distance to the left u knot and inverse length of the u segment
+  float vv[BlockSize], vLi[BlockSize]; // distance to the left v knot and inverse length of the v segment
+  float parU[nYdim4][BlockSize];       // { {Y1,Y2,Y3,Y1'v,Y2'v,Y3'v}(v0), {Y1,Y2,Y3,Y1'v,Y2'v,Y3'v}(v1) } at u
+
+  for (int i0 = 0; i0 < n; i0 += BlockSize) {
+    const int nb = std::min(BlockSize, n - i0);
+
+    for (int i = 0; i < nb; i++) {
+      float su = 0, sv = 0;
+      mGeo.convUVtoScaledUV(slice, row, u[i0 + i], v[i0 + i], su, sv);
+      su *= gridU.getUmax();
+      sv *= gridV.getUmax();
+      int iu = gridU.getLeftKnotIndexForU(su);
+      int iv = gridV.getLeftKnotIndexForU(sv);
+      const auto& knotU = gridU.getKnots()[iu];
+      const auto& knotV = gridV.getKnots()[iv];
+      offset[i] = (nu * iv + iu) * nYdim4;
+      uu[i] = su - knotU.u;
+      uLi[i] = knotU.Li;
+      vv[i] = sv - knotV.u;
+      vLi[i] = knotV.Li;
+    }
+
+    // interpolation in u at v0 and v1
+    for (int k = 0; k < nYdim2; k++) {
+      for (int i = 0; i < nb; i++) {
+        const float* par00 = splineData + offset[i]; // values { {Y1,Y2,Y3}, {Y1,Y2,Y3}'v, {Y1,Y2,Y3}'u, {Y1,Y2,Y3}''vu } at {u0, v0}
+        const float* par10 = par00 + nYdim4;         // values { ... } at {u1, v0}
+        const float* par01 = par00 + nYdim4 * nu;    // values { ... } at {u0, v1}
+        const float* par11 = par01 + nYdim4;         // values { ... } at {u1, v1}
+        parU[k][i] = interpolateHermite(par00[k], par00[nYdim2 + k], par10[k], par10[nYdim2 + k], uu[i], uLi[i]);
+        parU[nYdim2 + k][i] = interpolateHermite(par01[k], par01[nYdim2 + k], par11[k], par11[nYdim2 + k], uu[i], uLi[i]);
+      }
+    }
+
+    // interpolation in v
+    for (int i = 0; i < nb; i++) {
+      dx[i0 + i] = interpolateHermite(parU[0][i], parU[nYdim][i], parU[nYdim2][i], parU[nYdim2 + nYdim][i], vv[i], vLi[i]);
+      du[i0 + i] = interpolateHermite(parU[1][i], parU[nYdim + 1][i], parU[nYdim2 + 1][i], parU[nYdim2 + nYdim + 1][i], vv[i], vLi[i]);
+      dv[i0 + i] = interpolateHermite(parU[2][i], parU[nYdim + 2][i], parU[nYdim2 + 2][i], parU[nYdim2 + nYdim + 2][i], vv[i], vLi[i]);
+    }
+  }
+}
+
+#endif // GPUCA_GPUCODE
+
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
 
 void TPCFastSpaceChargeCorrection::startConstruction(const TPCFastTransformGeo& geo, int numberOfSplineScenarios)
@@ -421,88 +505,98 @@ GPUd() void TPCFastSpaceChargeCorrection::setNoCorrection()
   }   // slice
 }
 
-void TPCFastSpaceChargeCorrection::initMaxDriftLength(bool prn)
+void TPCFastSpaceChargeCorrection::initMaxDriftLength(bool prn, int nThreads)
 {
+  /// The (slice, row) pairs are independent and processed in parallel with nThreads threads.
+
   double tpcR2min = mGeo.getRowInfo(0).x - 1.;
   tpcR2min = tpcR2min * tpcR2min;
   double tpcR2max = mGeo.getRowInfo(mGeo.getNumberOfRows() - 1).x;
   tpcR2max = tpcR2max / cos(2 * M_PI / mGeo.getNumberOfSlicesA() / 2) + 1.;
   tpcR2max = tpcR2max * tpcR2max;
 
-  ChebyshevFit1D chebFitter;
+  const int nRows = mGeo.getNumberOfRows();
 
-  for (int slice = 0; slice < mGeo.getNumberOfSlices(); slice++) {
-    if (prn) {
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+  for (int sliceRow = 0; sliceRow < mGeo.getNumberOfSlices() * nRows; sliceRow++) {
+    const int slice = sliceRow / nRows;
+    const int row = sliceRow % nRows;
+    if (prn && row == 0) {
       std::cout << "init MaxDriftLength for slice " << slice << std::endl;
     }
     double vLength = (slice < mGeo.getNumberOfSlicesA()) ? mGeo.getTPCzLengthA() : mGeo.getTPCzLengthC();
-    SliceInfo& sliceInfo = getSliceInfo(slice);
-    sliceInfo.vMax = 0.f;
-
-    for (int row = 0; row < mGeo.getNumberOfRows(); row++) {
-      RowActiveArea& area = getSliceRowInfo(slice, row).activeArea;
-      area.cvMax = 0;
-      area.vMax = 0;
-      mGeo.convPadToU(row, 0., area.cuMin);
-      area.cuMax = -area.cuMin;
-      chebFitter.reset(4, 0., mGeo.getRowInfo(row).maxPad);
-      double x = mGeo.getRowInfo(row).x;
-      for (int pad = 0; pad < mGeo.getRowInfo(row).maxPad; pad++) {
-        float u = 0;
-        mGeo.convPadToU(row, pad, u);
-        float v0 = 0;
-        float v1 = 1.1 * vLength;
-        float vLastValid = -1;
-        float cvLastValid = -1;
-        while (v1 - v0 > 0.1) {
-          float v = 0.5 * (v0 + v1);
-          float dx, du, dv;
-          getCorrection(slice, row, u, v, dx, du, dv);
-          double cx = x + dx;
-          double cu = u + du;
-          double cv = v + dv;
-          double r2 = cx * cx + cu * cu;
-          if (cv < 0) {
-            v0 = v;
-          } else if (cv <= vLength && r2 >= tpcR2min && r2 <= tpcR2max) {
-            v0 = v;
-            vLastValid = v;
-            cvLastValid = cv;
-          } else {
-            v1 = v;
-          }
-        }
-        if (vLastValid > 0.) {
-          chebFitter.addMeasurement(pad, vLastValid);
-        }
-        if (area.vMax < vLastValid) {
-          area.vMax = vLastValid;
-        }
-        if (area.cvMax < cvLastValid) {
-          area.cvMax = cvLastValid;
+    ChebyshevFit1D chebFitter;
+    RowActiveArea& area = getSliceRowInfo(slice, row).activeArea;
+    area.cvMax = 0;
+    area.vMax = 0;
+    mGeo.convPadToU(row, 0., area.cuMin);
+    area.cuMax = -area.cuMin;
+    chebFitter.reset(4, 0., mGeo.getRowInfo(row).maxPad);
+    double x = mGeo.getRowInfo(row).x;
+    for (int pad = 0; pad < mGeo.getRowInfo(row).maxPad; pad++) {
+      float u = 0;
+      mGeo.convPadToU(row, pad, u);
+      float v0 = 0;
+      float v1 = 1.1 * vLength;
+      float vLastValid = -1;
+      float cvLastValid = -1;
+      while (v1 - v0 > 0.1) {
+        float v = 0.5 * (v0 + v1);
+        float dx, du, dv;
+        getCorrection(slice, row, u, v, dx, du, dv);
+        double cx = x + dx;
+        double cu = u + du;
+        double cv = v + dv;
+        double r2 = cx * cx + cu * cu;
+        if (cv < 0) {
+          v0 = v;
+        } else if (cv <= vLength && r2 >= tpcR2min && r2 <= tpcR2max) {
+          v0 = v;
+          vLastValid = v;
+          cvLastValid = cv;
+        } else {
+          v1 = v;
         }
       }
-      chebFitter.fit();
-      for (int i = 0; i < 5; i++) {
-        area.maxDriftLengthCheb[i] = chebFitter.getCoefficients()[i];
+      if (vLastValid > 0.) {
+        chebFitter.addMeasurement(pad, vLastValid);
+      }
+      if (area.vMax < vLastValid) {
+        area.vMax = vLastValid;
+      }
+      if (area.cvMax < cvLastValid) {
+        area.cvMax = cvLastValid;
       }
+    }
+    chebFitter.fit();
+    for (int i = 0; i < 5; i++) {
+      area.maxDriftLengthCheb[i] = chebFitter.getCoefficients()[i];
+    }
+  } // slice, row
+
+  for (int slice = 0; slice < mGeo.getNumberOfSlices(); slice++) {
+    SliceInfo& sliceInfo = getSliceInfo(slice);
+    sliceInfo.vMax = 0.f;
+    for (int row = 0; row < nRows; row++) {
+      const RowActiveArea& area = getSliceRowInfo(slice, row).activeArea;
       if (sliceInfo.vMax < area.vMax) {
         sliceInfo.vMax = area.vMax;
       }
-    } // row
-  }   // slice
+    }
+  }
 }
 
-void TPCFastSpaceChargeCorrection::initInverse(bool prn)
+void TPCFastSpaceChargeCorrection::initInverse(bool prn, int nThreads)
 {
+  /// The (slice, row) pairs are independent and processed in parallel with nThreads threads.
 
-  initMaxDriftLength(prn);
+  initMaxDriftLength(prn, nThreads);
 
-  Spline2DHelper<float> helper;
-  std::vector<double> dataPointF;
-  std::vector<float> splineParameters;
-
-  ChebyshevFit1D chebFitterX, chebFitterU, chebFitterV;
+  // the helpers keep the least-squares matrices of the spline scenarios, they are shared by all the rows of a scenario
+  std::vector<Spline2DHelper<float>> helpers(mNumberOfScenarios);
+  for (int i = 0; i < mNumberOfScenarios; i++) {
+    helpers[i].setSpline(mScenarioPtr[i], 3, 3);
+  }
 
   double tpcR2min = mGeo.getRowInfo(0).x - 1.;
   tpcR2min = tpcR2min * tpcR2min;
@@ -510,185 +604,190 @@ void TPCFastSpaceChargeCorrection::initInverse(bool prn)
   tpcR2max = tpcR2max / cos(2 * M_PI / mGeo.getNumberOfSlicesA() / 2) + 1.;
   tpcR2max = tpcR2max * tpcR2max;
 
-  for (int slice = 0; slice < mGeo.getNumberOfSlices(); slice++) {
-    //std::cout << "inverse transform for slice " << slice << std::endl;
+  const int nRows = mGeo.getNumberOfRows();
+
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+  for (int sliceRow = 0; sliceRow < mGeo.getNumberOfSlices() * nRows; sliceRow++) {
+    const int slice = sliceRow / nRows;
+    const int row = sliceRow % nRows;
     double vLength = (slice < mGeo.getNumberOfSlicesA()) ? mGeo.getTPCzLengthA() : mGeo.getTPCzLengthC();
-    for (int row = 0; row < mGeo.getNumberOfRows(); row++) {
-      const SplineType& spline = getSpline(slice, row);
-      helper.setSpline(spline, 3, 3);
+    const SplineType& spline = getSpline(slice, row);
+    const Spline2DHelper<float>& helper = helpers[mRowInfoPtr[row].splineScenarioID];
+    std::vector<double> dataPointF;
+    std::vector<float> splineParameters;
+    ChebyshevFit1D chebFitterX, chebFitterU, chebFitterV;
 
-      float u0, u1, v0, v1;
-      mGeo.convScaledUVtoUV(slice, row, 0., 0., u0, v0);
-      mGeo.convScaledUVtoUV(slice, row, 1., 1., u1, v1);
+    float u0, u1, v0, v1;
+    mGeo.convScaledUVtoUV(slice, row, 0., 0., u0, v0);
+    mGeo.convScaledUVtoUV(slice, row, 1., 1., u1, v1);
 
-      double x = mGeo.getRowInfo(row).x;
-      double stepU = (u1 - u0) / (1. * (helper.getNumberOfDataPointsU1() - 1));
-      double stepV = (v1 - v0) / (1. * (helper.getNumberOfDataPointsU2() - 1));
+    double x = mGeo.getRowInfo(row).x;
+    double stepU = (u1 - u0) / (1. * (helper.getNumberOfDataPointsU1() - 1));
+    double stepV = (v1 - v0) / (1. * (helper.getNumberOfDataPointsU2() - 1));
 
-      if (prn) {
-        std::cout << "u0 " << u0 << " u1 " << u1 << " v0 " << v0 << " v1 " << v1 << std::endl;
-      }
-      RowActiveArea& area = getSliceRowInfo(slice, row).activeArea;
-      area.cuMin = 1.e10;
-      area.cuMax = -1.e10;
-
-      v1 = area.vMax;
-      stepV = (v1 - v0) / (1. * (helper.getNumberOfDataPointsU2() - 1));
-      if (stepV < 1.f) {
-        stepV = 1.f;
-      }
-      int nCheb = helper.getNumberOfDataPointsU2();
-      nCheb = 20;
-      chebFitterV.reset(nCheb - 1, 0, vLength);
-
-      struct Entry {
-        double cu, cv, dx, du, dv;
-      };
-      std::vector<Entry> dataRowsV[helper.getNumberOfDataPointsU2()];
-
-      for (double u = u0; u < u1 + stepU; u += stepU) {
-        chebFitterV.reset();
-        //double vvMax = 0;
-        for (double v = v0; v < v1 + stepV; v += stepV) {
-          float dx, du, dv;
-          getCorrection(slice, row, u, v, dx, du, dv);
-          double cx = x + dx;
-          double cu = u + du;
-          double cv = v + dv;
-          double r2 = cx * cx + cu * cu;
-          if (cv < 0 || cv > vLength || r2 < tpcR2min || r2 > tpcR2max) {
-            continue;
-          }
-          if (cu < area.cuMin) {
-            area.cuMin = cu;
-          }
-          if (cu > area.cuMax) {
-            area.cuMax = cu;
-          }
-          //if (v > vvMax) {
-          //vvMax = v;
-          //}
-          if (prn) {
-            std::cout << "measurement cu " << cu << " cv " << cv << " dx " << dx << " du " << du << " dv " << dv << std::endl;
-          }
-          chebFitterV.addMeasurement(cv, dv);
-        } // v
-        if (prn) {
-          std::cout << "u " << u << " nmeas " << chebFitterV.getNmeasurements() << std::endl;
-        }
-        if (chebFitterV.getNmeasurements() < 1) {
+    if (prn) {
+      std::cout << "u0 " << u0 << " u1 " << u1 << " v0 " << v0 << " v1 " << v1 << std::endl;
+    }
+    RowActiveArea& area = getSliceRowInfo(slice, row).activeArea;
+    area.cuMin = 1.e10;
+    area.cuMax = -1.e10;
+
+    v1 = area.vMax;
+    stepV = (v1 - v0) / (1. * (helper.getNumberOfDataPointsU2() - 1));
+    if (stepV < 1.f) {
+      stepV = 1.f;
+    }
+    int nCheb = helper.getNumberOfDataPointsU2();
+    nCheb = 20;
+    chebFitterV.reset(nCheb - 1, 0, vLength);
+
+    struct Entry {
+      double cu, cv, dx, du, dv;
+    };
+    std::vector<Entry> dataRowsV[helper.getNumberOfDataPointsU2()];
+
+    for (double u = u0; u < u1 + stepU; u += stepU) {
+      chebFitterV.reset();
+      //double vvMax = 0;
+      for (double v = v0; v < v1 + stepV; v += stepV) {
+        float dx, du, dv;
+        getCorrection(slice, row, u, v, dx, du, dv);
+        double cx = x + dx;
+        double cu = u + du;
+        double cv = v + dv;
+        double r2 = cx * cx + cu * cu;
+        if (cv < 0 || cv > vLength || r2 < tpcR2min || r2 > tpcR2max) {
           continue;
         }
-        chebFitterV.fit();
-        if (prn) {
-          std::cout << "slice " << slice << " row " << row << " u " << u << std::endl;
-          std::cout << "n cheb " << nCheb << " n measurements " << chebFitterV.getNmeasurements()
-                    << std::endl;
-          for (int i = 0; i < nCheb; i++) {
-            std::cout << i << " " << chebFitterV.getCoefficients()[i] << " ";
-          }
-          std::cout << std::endl;
-          //exit(0);
+        if (cu < area.cuMin) {
+          area.cuMin = cu;
         }
-        // TODO: refit with extra measurements close to cv == data points cv
-
-        // fill data for cv data rows
-        double drow = area.cvMax / (helper.getNumberOfDataPointsU2() - 1);
-        for (int i = 0; i < helper.getNumberOfDataPointsU2(); i++) {
-          double cv = i * drow;
-          double dvCheb = chebFitterV.eval(cv);
-          double v = cv - dvCheb;
-          // weighted combination between cheb and nominal
-          //if (v < 0 || v > vvMax) {
-          //continue;
-          //}
-
-          float dx, du, dv;
-          getCorrection(slice, row, u, v, dx, du, dv);
-          //std::cout<<" u "<<u<<" cv0 "<<cv<<" v "<<v<<" cu "<<u+du<<" cv "<<v+dv<<std::endl;
-          double cu = u + du;
-          cv = v + dv;
-          double cx = x + dx;
-          double r2 = cx * cx + cu * cu;
-
-          //if (cv < 0 || cv > vLength || r2 < tpcR2min || r2 > tpcR2max) {
-          //continue;
-          //}
-          Entry e{cu, cv, dx, du, dv};
-          dataRowsV[i].push_back(e);
+        if (cu > area.cuMax) {
+          area.cuMax = cu;
         }
-      } // u
-
+        //if (v > vvMax) {
+        //vvMax = v;
+        //}
+        if (prn) {
+          std::cout << "measurement cu " << cu << " cv " << cv << " dx " << dx << " du " << du << " dv " << dv << std::endl;
+        }
+        chebFitterV.addMeasurement(cv, dv);
+      } // v
       if (prn) {
-        std::cout << " cuMin " << area.cuMin << " cuMax " << area.cuMax << " cvMax " << area.cvMax << std::endl;
+        std::cout << "u " << u << " nmeas " << chebFitterV.getNmeasurements() << std::endl;
       }
-      if (area.cuMax - area.cuMin < 0.2) {
-        area.cuMax = .1;
-        area.cuMin = -.1;
+      if (chebFitterV.getNmeasurements() < 1) {
+        continue;
       }
-      if (area.cvMax < 0.1) {
-        area.cvMax = .1;
+      chebFitterV.fit();
+      if (prn) {
+        std::cout << "slice " << slice << " row " << row << " u " << u << std::endl;
+        std::cout << "n cheb " << nCheb << " n measurements " << chebFitterV.getNmeasurements()
+                  << std::endl;
+        for (int i = 0; i < nCheb; i++) {
+          std::cout << i << " " << chebFitterV.getCoefficients()[i] << " ";
+        }
+        std::cout << std::endl;
+        //exit(0);
       }
-      SliceRowInfo& info = mSliceRowInfoPtr[slice * mGeo.getNumberOfRows() + row];
-      info.CorrU0 = area.cuMin;
-      info.scaleCorrUtoGrid = (spline.getGridX1().getNumberOfKnots() - 1) / (area.cuMax - area.cuMin);
-      info.scaleCorrVtoGrid = (spline.getGridX2().getNumberOfKnots() - 1) / area.cvMax;
-
-      dataPointF.resize(helper.getNumberOfDataPoints() * 3);
-
-      // fit u(cu)
-      nCheb = helper.getNumberOfDataPointsU1();
-      nCheb = 20;
-      chebFitterX.reset(nCheb - 1, area.cuMin, area.cuMax);
-      chebFitterU.reset(nCheb - 1, area.cuMin, area.cuMax);
-      chebFitterV.reset(nCheb - 1, area.cuMin, area.cuMax);
+      // TODO: refit with extra measurements close to cv == data points cv
 
+      // fill data for cv data rows
       double drow = area.cvMax / (helper.getNumberOfDataPointsU2() - 1);
-      double dcol = (area.cuMax - area.cuMin) / (helper.getNumberOfDataPointsU1() - 1);
-      for (int iv = 0; iv < helper.getNumberOfDataPointsU2(); iv++) {
-        double cv = iv * drow;
-        double* dataPointFrow = &dataPointF[iv * helper.getNumberOfDataPointsU1() * 3];
-        for (int iu = 0; iu < helper.getNumberOfDataPointsU1(); iu++) {
-          dataPointFrow[iu * 3 + 0] = 0;
-          dataPointFrow[iu * 3 + 1] = 0;
-          dataPointFrow[iu * 3 + 2] = 0;
-        }
-        chebFitterX.reset();
-        chebFitterU.reset();
-        chebFitterV.reset();
-        for (unsigned int i = 0; i < dataRowsV[iv].size(); i++) {
-          chebFitterX.addMeasurement(dataRowsV[iv][i].cu, dataRowsV[iv][i].dx);
-          chebFitterU.addMeasurement(dataRowsV[iv][i].cu, dataRowsV[iv][i].du);
-          chebFitterV.addMeasurement(dataRowsV[iv][i].cu, dataRowsV[iv][i].dv);
-        }
-        if (chebFitterU.getNmeasurements() < 1) {
-          continue;
-        }
+      for (int i = 0; i < helper.getNumberOfDataPointsU2(); i++) {
+        double cv = i * drow;
+        double dvCheb = chebFitterV.eval(cv);
+        double v = cv - dvCheb;
+        // weighted combination between cheb and nominal
+        //if (v < 0 || v > vvMax) {
+        //continue;
+        //}
+
+        float dx, du, dv;
+        getCorrection(slice, row, u, v, dx, du, dv);
+        //std::cout<<" u "<<u<<" cv0 "<<cv<<" v "<<v<<" cu "<<u+du<<" cv "<<v+dv<<std::endl;
+        double cu = u + du;
+        cv = v + dv;
+        double cx = x + dx;
+        double r2 = cx * cx + cu * cu;
+
+        //if (cv < 0 || cv > vLength || r2 < tpcR2min || r2 > tpcR2max) {
+        //continue;
+        //}
+        Entry e{cu, cv, dx, du, dv};
+        dataRowsV[i].push_back(e);
+      }
+    } // u
 
-        chebFitterX.fit();
-        chebFitterU.fit();
-        chebFitterV.fit();
-
-        // fill data points
-        for (int iu = 0; iu < helper.getNumberOfDataPointsU1(); iu++) {
-          double cu = area.cuMin + iu * dcol;
-          dataPointFrow[iu * 3 + 0] = chebFitterX.eval(cu);
-          dataPointFrow[iu * 3 + 1] = chebFitterU.eval(cu);
-          dataPointFrow[iu * 3 + 2] = chebFitterV.eval(cu);
-        } // iu
-      }   // iv
-
-      splineParameters.resize(spline.getNumberOfParameters());
-      helper.approximateFunction(splineParameters.data(), dataPointF.data());
-      float* splineX = getSplineData(slice, row, 1);
-      float* splineUV = getSplineData(slice, row, 2);
-      for (int i = 0; i < spline.getNumberOfParameters() / 3; i++) {
-        splineX[i] = splineParameters[3 * i + 0];
-        splineUV[2 * i + 0] = splineParameters[3 * i + 1];
-        splineUV[2 * i + 1] = splineParameters[3 * i + 2];
+    if (prn) {
+      std::cout << " cuMin " << area.cuMin << " cuMax " << area.cuMax << " cvMax " << area.cvMax << std::endl;
+    }
+    if (area.cuMax - area.cuMin < 0.2) {
+      area.cuMax = .1;
+      area.cuMin = -.1;
+    }
+    if (area.cvMax < 0.1) {
+      area.cvMax = .1;
+    }
+    SliceRowInfo& info = mSliceRowInfoPtr[slice * mGeo.getNumberOfRows() + row];
+    info.CorrU0 = area.cuMin;
+    info.scaleCorrUtoGrid = (spline.getGridX1().getNumberOfKnots() - 1) / (area.cuMax - area.cuMin);
+    info.scaleCorrVtoGrid = (spline.getGridX2().getNumberOfKnots() - 1) / area.cvMax;
+
+    dataPointF.resize(helper.getNumberOfDataPoints() * 3);
+
+    // fit u(cu)
+    nCheb = helper.getNumberOfDataPointsU1();
+    nCheb = 20;
+    chebFitterX.reset(nCheb - 1, area.cuMin, area.cuMax);
+    chebFitterU.reset(nCheb - 1, area.cuMin, area.cuMax);
+    chebFitterV.reset(nCheb - 1, area.cuMin, area.cuMax);
+
+    double drow = area.cvMax / (helper.getNumberOfDataPointsU2() - 1);
+    double dcol = (area.cuMax - area.cuMin) / (helper.getNumberOfDataPointsU1() - 1);
+    for (int iv = 0; iv < helper.getNumberOfDataPointsU2(); iv++) {
+      double cv = iv * drow;
+      double* dataPointFrow = &dataPointF[iv * helper.getNumberOfDataPointsU1() * 3];
+      for (int iu = 0; iu < helper.getNumberOfDataPointsU1(); iu++) {
+        dataPointFrow[iu * 3 + 0] = 0;
+        dataPointFrow[iu * 3 + 1] = 0;
+        dataPointFrow[iu * 3 + 2] = 0;
       }
-    } // row
-  }   // slice
+      chebFitterX.reset();
+      chebFitterU.reset();
+      chebFitterV.reset();
+      for (unsigned int i = 0; i < dataRowsV[iv].size(); i++) {
+        chebFitterX.addMeasurement(dataRowsV[iv][i].cu, dataRowsV[iv][i].dx);
+        chebFitterU.addMeasurement(dataRowsV[iv][i].cu, dataRowsV[iv][i].du);
+        chebFitterV.addMeasurement(dataRowsV[iv][i].cu, dataRowsV[iv][i].dv);
+      }
+      if (chebFitterU.getNmeasurements() < 1) {
+        continue;
+      }
+
+      chebFitterX.fit();
+      chebFitterU.fit();
+      chebFitterV.fit();
+
+      // fill data points
+      for (int iu = 0; iu < helper.getNumberOfDataPointsU1(); iu++) {
+        double cu = area.cuMin + iu * dcol;
+        dataPointFrow[iu * 3 + 0] = chebFitterX.eval(cu);
+        dataPointFrow[iu * 3 + 1] = chebFitterU.eval(cu);
+        dataPointFrow[iu * 3 + 2] = chebFitterV.eval(cu);
+      } // iu
+    }   // iv
+
+    splineParameters.resize(spline.getNumberOfParameters());
+    helper.approximateFunction(splineParameters.data(), dataPointF.data());
+    float* splineX = getSplineData(slice, row, 1);
+    float* splineUV = getSplineData(slice, row, 2);
+    for (int i = 0; i < spline.getNumberOfParameters() / 3; i++) {
+      splineX[i] = splineParameters[3 * i + 0];
+      splineUV[2 * i + 0] = splineParameters[3 * i + 1];
+      splineUV[2 * i + 1] = splineParameters[3 * i + 2];
+    }
+  } // slice, row
 }
 
 double TPCFastSpaceChargeCorrection::testInverse(bool prn)
@@ -135,11 +135,11 @@ class TPCFastSpaceChargeCorrection : public FlatObject
   GPUd() const float* getSplineData(int slice, int row, int iSpline = 0) const;
 
 #if !defined(GPUCA_GPUCODE)
-  /// Initialise max drift length
-  GPUh() void initMaxDriftLength(bool prn = 0);
+  /// Initialise max drift length, the slices and rows are processed with nThreads threads
+  GPUh() void initMaxDriftLength(bool prn = 0, int nThreads = 1);
 
-  /// Initialise inverse transformations
-  GPUh() void initInverse(bool prn = 0);
+  /// Initialise inverse transformations, the slices and rows are processed with nThreads threads
+  GPUh() void initInverse(bool prn = 0, int nThreads = 1);
 
 #endif
 
@@ -147,6 +147,11 @@ class TPCFastSpaceChargeCorrection : public FlatObject
   ///
   GPUd() int getCorrection(int slice, int row, float u, float v, float& dx, float& du, float& dv) const;
 
+#if !defined(GPUCA_GPUCODE)
+  /// Batched correction of n clusters of the same slice and row, gives the same results as getCorrection()
+  void getCorrection(int slice, int row, int n, const float* u, const float* v, float* dx, float* du, float* dv) const;
+#endif
+
   /// inverse correction: Corrected U and V -> coorrected X
   GPUd() void getCorrectionInvCorrectedX(int slice, int row, float corrU, float corrV, float& corrX) const;
 
@@ -173,6 +178,9 @@ class TPCFastSpaceChargeCorrection : public FlatObject
   /// Gives the time stamp of the current calibaration parameters
   long int getTimeStamp() const { return mTimeStamp; }
 
+  /// Gives the number of spline scenarios
+  GPUd() int getNumberOfScenarios() const { return mNumberOfScenarios; }
+
   /// Gives TPC row info
   GPUd() const RowInfo& getRowInfo(int row) const { return mRowInfoPtr[row]; }
 
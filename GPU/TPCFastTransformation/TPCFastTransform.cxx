@@ -22,6 +22,7 @@
 
 #if !defined(GPUCA_GPUCODE)
 #include <iostream>
+#include <algorithm>
 #endif
 
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
@@ -152,6 +153,49 @@ void TPCFastTransform::print() const
 #endif
 }
 
+#if !defined(GPUCA_GPUCODE)
+
+void TPCFastTransform::Transform(int slice, int row, int n, const float* pad, const float* time, float* x, float* y, float* z, float vertexTime) const
+{
+  /// Same as Transform() for n clusters of one TPC row.
+  ///
+  /// The clusters are processed in blocks: the drift coordinates of the block are computed first,
+  /// then they are corrected with one call of the batched TPCFastSpaceChargeCorrection::getCorrection()
+  /// and at the end they are converted to the local coordinates.
+
+  constexpr int BlockSize = 256;
+  float u[BlockSize], v[BlockSize], dx[BlockSize], du[BlockSize], dv[BlockSize];
+
+  const float rowX = getGeometry().getRowInfo(row).x;
+
+  for (int i0 = 0; i0 < n; i0 += BlockSize) {
+    const int nb = std::min(BlockSize, n - i0);
+    for (int i = 0; i < nb; i++) {
+      convPadTimeToUV(slice, row, pad[i0 + i], time[i0 + i], u[i], v[i], vertexTime);
+    }
+    if (mApplyCorrection) {
+      mCorrection.getCorrection(slice, row, nb, u, v, dx, du, dv);
+      for (int i = 0; i < nb; i++) {
+        x[i0 + i] = rowX + dx[i];
+        u[i] += du[i];
+        v[i] += dv[i];
+      }
+    } else {
+      for (int i = 0; i < nb; i++) {
+        x[i0 + i] = rowX;
+      }
+    }
+    for (int i = 0; i < nb; i++) {
+      getGeometry().convUVtoLocal(slice, u[i], v[i], y[i0 + i], z[i0 + i]);
+      float dzTOF = 0;
+      getTOFcorrection(slice, row, x[i0 + i], y[i0 + i], z[i0 + i], dzTOF);
+      z[i0 + i] += dzTOF;
+    }
+  }
+}
+
+#endif // GPUCA_GPUCODE
+
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE) && !defined(GPUCA_ALIROOT_LIB)
 
 int TPCFastTransform::writeToFile(std::string outFName, std::string name)
@@ -131,6 +131,12 @@ class TPCFastTransform : public FlatObject
   ///
   GPUd() void Transform(int slice, int row, float pad, float time, float& x, float& y, float& z, float vertexTime = 0) const;
 
+#if !defined(GPUCA_GPUCODE)
+  /// Transforms n clusters of the same slice and row, gives the same results as Transform() for each cluster.
+  /// The clusters of a row share the correction spline, which is evaluated for many clusters at once.
+  void Transform(int slice, int row, int n, const float* pad, const float* time, float* x, float* y, float* z, float vertexTime = 0) const;
+#endif
+
   /// Transformation in the time frame
   GPUd() void TransformInTimeFrame(int slice, int row, float pad, float time, float& x, float& y, float& z, float maxTimeBin) const;
 
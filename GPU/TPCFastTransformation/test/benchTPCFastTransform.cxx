@@ -0,0 +1,164 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  benchTPCFastTransform.cxx
+/// \brief Transformation of TPC clusters to local coordinates with the space charge correction,
+///        cluster by cluster compared to the batched transformation of the clusters of each TPC row.
+///        The maximum deviation of the batched transformation from the single one is reported as a counter.
+
+#include "benchmark/benchmark.h"
+#include "TPCFastTransform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace GPUCA_NAMESPACE::gpu;
+
+struct Setup {
+  static constexpr int NRows = 152;
+  static constexpr int NClustersPerRow = 200;
+
+  std::unique_ptr<TPCFastTransform> transform = std::make_unique<TPCFastTransform>();
+  std::vector<float> pad, time; // clusters sorted by slice and row
+  std::vector<int> rowOffset;   // index of the first cluster of each slice and row
+  std::vector<float> x, y, z;   // reference output of the single transformation
+
+  Setup()
+  {
+    TPCFastTransformGeo geo;
+    geo.startConstruction(NRows);
+    geo.setTPCzLength(250.f, 250.f);
+    geo.setTPCalignmentZ(0.f);
+    for (int row = 0; row < NRows; row++) {
+      const float padWidth = (row < 63) ? 0.42f : 0.6f;
+      const float xRow = 85.f + 1.05f * row;
+      const int nPads = 2 * int(xRow * std::tan(M_PI / 18.) / padWidth);
+      geo.setTPCrow(row, xRow, nPads, padWidth);
+    }
+    geo.finishConstruction();
+
+    // row scenarios as in TPCFastTransformHelperO2
+    const int nScenarios = NRows / 10 + 1;
+    TPCFastSpaceChargeCorrection correction;
+    correction.startConstruction(geo, nScenarios);
+    for (int row = 0; row < NRows; row++) {
+      correction.setRowScenarioID(row, std::min(row / 10, nScenarios - 1));
+    }
+    for (int scenario = 0; scenario < nScenarios; scenario++) {
+      TPCFastSpaceChargeCorrection::SplineType spline;
+      spline.recreate(8, 20);
+      correction.setSplineScenario(scenario, spline);
+    }
+    correction.finishConstruction();
+
+    const float vDrift = 0.516f; // cm per time bin
+    transform->startConstruction(correction);
+    transform->setCalibration(0, 0.f, vDrift, 0.f, 0.f, vDrift / 5996.f, 0.f);
+    transform->finishConstruction();
+
+    // corrections of the order of 1 cm
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> distPar(-1.f, 1.f);
+    auto& corr = transform->getCorrection();
+    for (int slice = 0; slice < geo.getNumberOfSlices(); slice++) {
+      for (int row = 0; row < NRows; row++) {
+        float* data = corr.getSplineData(slice, row);
+        for (int i = 0; i < corr.getSpline(slice, row).getNumberOfParameters(); i++) {
+          data[i] = distPar(rng);
+        }
+      }
+    }
+
+    std::uniform_real_distribution<float> distTime(0.f, 250.f / vDrift);
+    for (int slice = 0; slice < geo.getNumberOfSlices(); slice++) {
+      for (int row = 0; row < NRows; row++) {
+        rowOffset.push_back(pad.size());
+        std::uniform_real_distribution<float> distPad(0.f, geo.getRowInfo(row).maxPad);
+        for (int i = 0; i < NClustersPerRow; i++) {
+          pad.push_back(distPad(rng));
+          time.push_back(distTime(rng));
+        }
+      }
+    }
+    rowOffset.push_back(pad.size());
+
+    x.resize(pad.size());
+    y.resize(pad.size());
+    z.resize(pad.size());
+    for (int slice = 0; slice < geo.getNumberOfSlices(); slice++) {
+      for (int row = 0; row < NRows; row++) {
+        for (int i = rowOffset[slice * NRows + row]; i < rowOffset[slice * NRows + row + 1]; i++) {
+          transform->Transform(slice, row, pad[i], time[i], x[i], y[i], z[i]);
+        }
+      }
+    }
+  }
+};
+
+Setup& getSetup()
+{
+  static Setup setup;
+  return setup;
+}
+
+static void BM_Transform(benchmark::State& state)
+{
+  auto& setup = getSetup();
+  const int nSlices = setup.transform->getGeometry().getNumberOfSlices();
+  for (auto _ : state) {
+    for (int slice = 0; slice < nSlices; slice++) {
+      for (int row = 0; row < Setup::NRows; row++) {
+        for (int i = setup.rowOffset[slice * Setup::NRows + row]; i < setup.rowOffset[slice * Setup::NRows + row + 1]; i++) {
+          float x, y, z;
+          setup.transform->Transform(slice, row, setup.pad[i], setup.time[i], x, y, z);
+          benchmark::DoNotOptimize(x);
+          benchmark::DoNotOptimize(y);
+          benchmark::DoNotOptimize(z);
+        }
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * setup.pad.size());
+}
+
+static void BM_TransformBatch(benchmark::State& state)
+{
+  auto& setup = getSetup();
+  const int nSlices = setup.transform->getGeometry().getNumberOfSlices();
+  std::vector<float> x(setup.pad.size()), y(setup.pad.size()), z(setup.pad.size());
+  for (auto _ : state) {
+    for (int slice = 0; slice < nSlices; slice++) {
+      for (int row = 0; row < Setup::NRows; row++) {
+        const int first = setup.rowOffset[slice * Setup::NRows + row];
+        const int n = setup.rowOffset[slice * Setup::NRows + row + 1] - first;
+        setup.transform->Transform(slice, row, n, &setup.pad[first], &setup.time[first], &x[first], &y[first], &z[first]);
+      }
+    }
+    benchmark::DoNotOptimize(x.data());
+    benchmark::DoNotOptimize(y.data());
+    benchmark::DoNotOptimize(z.data());
+  }
+  state.SetItemsProcessed(state.iterations() * setup.pad.size());
+
+  float maxDeviation = 0;
+  for (size_t i = 0; i < x.size(); ++i) {
+    maxDeviation = std::max({maxDeviation, std::abs(x[i] - setup.x[i]), std::abs(y[i] - setup.y[i]), std::abs(z[i] - setup.z[i])});
+  }
+  state.counters["max_deviation_cm"] = maxDeviation;
+}
+
+BENCHMARK(BM_Transform)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TransformBatch)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,146 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTPCFastTransform.cxx
+/// \brief checks that the batched transformation of the clusters of a TPC row gives the results of the single one
+
+#define BOOST_TEST_MODULE Test TPC Fast Transform Batch
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "TPCFastTransform.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace o2::gpu
+{
+
+static constexpr int NRows = 152;
+
+// numbers of clusters of a row: none, below, at and above the block sizes of the batched correction (32) and transformation (256)
+static const std::vector<int> NClusters = {0, 1, 7, 31, 32, 33, 63, 100, 255, 256, 257, 300, 513};
+
+// a synthetic transformation with corrections of the order of 1 cm, as in benchTPCFastTransform
+std::unique_ptr<TPCFastTransform> createTransform()
+{
+  TPCFastTransformGeo geo;
+  geo.startConstruction(NRows);
+  geo.setTPCzLength(250.f, 250.f);
+  geo.setTPCalignmentZ(0.f);
+  for (int row = 0; row < NRows; row++) {
+    const float padWidth = (row < 63) ? 0.42f : 0.6f;
+    const float xRow = 85.f + 1.05f * row;
+    const int nPads = 2 * int(xRow * std::tan(M_PI / 18.) / padWidth);
+    geo.setTPCrow(row, xRow, nPads, padWidth);
+  }
+  geo.finishConstruction();
+
+  const int nScenarios = NRows / 10 + 1;
+  TPCFastSpaceChargeCorrection correction;
+  correction.startConstruction(geo, nScenarios);
+  for (int row = 0; row < NRows; row++) {
+    correction.setRowScenarioID(row, std::min(row / 10, nScenarios - 1));
+  }
+  for (int scenario = 0; scenario < nScenarios; scenario++) {
+    TPCFastSpaceChargeCorrection::SplineType spline;
+    spline.recreate(8 + scenario % 3, 20 - scenario % 5);
+    correction.setSplineScenario(scenario, spline);
+  }
+  correction.finishConstruction();
+
+  auto transform = std::make_unique<TPCFastTransform>();
+  const float vDrift = 0.516f;
+  transform->startConstruction(correction);
+  transform->setCalibration(0, 0.f, vDrift, 0.f, 0.f, vDrift / 5996.f, 0.f);
+  transform->finishConstruction();
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> distPar(-1.f, 1.f);
+  auto& corr = transform->getCorrection();
+  for (int slice = 0; slice < geo.getNumberOfSlices(); slice++) {
+    for (int row = 0; row < NRows; row++) {
+      float* data = corr.getSplineData(slice, row);
+      for (int i = 0; i < corr.getSpline(slice, row).getNumberOfParameters(); i++) {
+        data[i] = distPar(rng);
+      }
+    }
+  }
+  return transform;
+}
+
+// the batched code does the same arithmetic, the tolerance only allows for a different contraction to fused multiply-adds
+int countDifferent(const std::vector<float>& batch, const std::vector<float>& single)
+{
+  int nDiff = 0;
+  for (size_t i = 0; i < batch.size(); i++) {
+    nDiff += !(std::abs(batch[i] - single[i]) <= 1.e-6f * (1.f + std::abs(single[i])));
+  }
+  return nDiff;
+}
+
+BOOST_AUTO_TEST_CASE(TPCFastTransformBatch_test)
+{
+  const auto transform = createTransform();
+  const auto& geo = transform->getGeometry();
+  const auto& correction = transform->getCorrection();
+  const float maxTime = 250.f / 0.516f;
+
+  std::mt19937 rng(2);
+  int nChecked = 0, nDiffCorrection = 0, nDiffTransform = 0, nCorrected = 0;
+  for (int slice = 0; slice < geo.getNumberOfSlices(); slice++) {
+    for (int row = 0; row < NRows; row++) {
+      // every row gets each number of clusters in turn
+      const int n = NClusters[(slice * NRows + row) % NClusters.size()];
+      std::uniform_real_distribution<float> distPad(0.f, geo.getRowInfo(row).maxPad);
+      std::uniform_real_distribution<float> distTime(0.f, maxTime);
+      std::vector<float> pad(n), time(n), u(n), v(n);
+      for (int i = 0; i < n; i++) {
+        pad[i] = distPad(rng);
+        time[i] = distTime(rng);
+        transform->convPadTimeToUV(slice, row, pad[i], time[i], u[i], v[i], 0.f);
+      }
+
+      // the outputs beyond n are not touched
+      std::vector<float> dx(n + 1, -1.f), du(n + 1, -1.f), dv(n + 1, -1.f);
+      std::vector<float> dxs(n + 1, -1.f), dus(n + 1, -1.f), dvs(n + 1, -1.f);
+      correction.getCorrection(slice, row, n, u.data(), v.data(), dx.data(), du.data(), dv.data());
+      for (int i = 0; i < n; i++) {
+        correction.getCorrection(slice, row, u[i], v[i], dxs[i], dus[i], dvs[i]);
+        nCorrected += dxs[i] != 0.f;
+      }
+      nDiffCorrection += countDifferent(dx, dxs) + countDifferent(du, dus) + countDifferent(dv, dvs);
+
+      std::vector<float> x(n + 1, -1.f), y(n + 1, -1.f), z(n + 1, -1.f);
+      std::vector<float> xs(n + 1, -1.f), ys(n + 1, -1.f), zs(n + 1, -1.f);
+      transform->Transform(slice, row, n, pad.data(), time.data(), x.data(), y.data(), z.data());
+      for (int i = 0; i < n; i++) {
+        transform->Transform(slice, row, pad[i], time[i], xs[i], ys[i], zs[i]);
+      }
+      nDiffTransform += countDifferent(x, xs) + countDifferent(y, ys) + countDifferent(z, zs);
+      nChecked += n;
+    }
+  }
+  // the comparison is not trivial: the clusters are corrected
+  BOOST_CHECK_GT(nChecked, 0);
+  BOOST_CHECK_GT(nCorrected, nChecked / 2);
+  BOOST_CHECK_EQUAL(nDiffCorrection, 0);
+  BOOST_CHECK_EQUAL(nDiffTransform, 0);
+
+  // no clusters, no output
+  transform->Transform(0, 0, 0, nullptr, nullptr, nullptr, nullptr, nullptr);
+  correction.getCorrection(0, 0, 0, nullptr, nullptr, nullptr, nullptr, nullptr);
+}
+
+} // namespace o2::gpu
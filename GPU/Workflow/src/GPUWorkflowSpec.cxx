@@ -41,6 +41,7 @@
 #include "DetectorsBase/MatLayerCylSet.h"
 #include "DetectorsBase/Propagator.h"
 #include "DetectorsBase/GeometryManager.h"
+#include "DetectorsBase/GeometryImage.h"
 #include "DetectorsRaw/HBFUtils.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include "TPCBase/RDHUtils.h"
@@ -247,7 +248,7 @@ DataProcessorSpec getGPURecoWorkflowSpec(gpuworkflow::CompletionPolicyData* poli
       }
 
       if (confParam.matLUTFile.size()) {
-        config.configCalib.matLUT = o2::base::MatLayerCylSet::loadFromFile(confParam.matLUTFile.c_str(), "MatBud");
+        config.configCalib.matLUT = o2::base::GeometryImage::loadMatLUT(confParam.matLUTFile.c_str(), "MatBud");
       }
 
       if (confParam.dEdxFile.size()) {
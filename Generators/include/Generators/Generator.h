@@ -92,6 +92,13 @@ class Generator : public FairGenerator
   /** notification methods **/
   virtual void notifyEmbedding(const o2::dataformats::MCEventHeader* eventHeader){};
 
+  /** concurrent generation methods.
+      A generator which can generate concurrently fully determines its next event from the seed
+      given to setEventSeed and does not use gRandom (nor any other global state) in generateEvent,
+      importParticles and the triggers, such that several instances can run in parallel threads. **/
+  virtual bool canGenerateConcurrently() const { return false; };
+  virtual void setEventSeed(unsigned int seed){};
+
   void setTriggerOkHook(std::function<void(std::vector<TParticle> const& p, int eventCount)> f) { mTriggerOkHook = f; }
   void setTriggerFalseHook(std::function<void(std::vector<TParticle> const& p, int eventCount)> f) { mTriggerFalseHook = f; }
 
@@ -108,6 +115,7 @@ class Generator : public FairGenerator
   Bool_t addTracks(FairPrimaryGenerator* primGen);
   Bool_t boostEvent();
   Bool_t triggerEvent();
+  bool hasTriggers() const { return !mTriggers.empty() || !mDeepTriggers.empty(); };
 
   /** generator interface **/
   void* mInterface = nullptr;
@@ -43,12 +43,19 @@ class GeneratorPythia8 : public Generator
   Bool_t generateEvent() override;
   Bool_t importParticles() override { return importParticles(mPythia.event); };
 
+  /** concurrent generation: each instance has its own random engine. It is opt-in, as the configuration
+      may involve global state, and excluded with user hooks and triggers, which may use gRandom **/
+  bool canGenerateConcurrently() const override { return mConcurrent && !mHasUserHooks && !hasTriggers(); };
+  void setEventSeed(unsigned int seed) override { mPythia.rndm.init(1 + seed % 900000000); }; // Pythia8 seeds are in [1, 900000000]
+
   /** setters **/
   void setConfig(std::string val) { mConfig = val; };
   void setHooksFileName(std::string val) { mHooksFileName = val; };
   void setHooksFuncName(std::string val) { mHooksFuncName = val; };
+  void setConcurrent(bool val) { mConcurrent = val; };
   void setUserHooks(Pythia8::UserHooks* hooks)
   {
+    mHasUserHooks = hooks != nullptr;
 #if PYTHIA_VERSION_INTEGER < 8300
     mPythia.setUserHooksPtr(hooks);
 #else
@@ -104,6 +111,8 @@ class GeneratorPythia8 : public Generator
   std::string mConfig;
   std::string mHooksFileName;
   std::string mHooksFuncName;
+  bool mConcurrent = false;   //!
+  bool mHasUserHooks = false; //!
 
   ClassDefOverride(GeneratorPythia8, 1);
 
@@ -33,6 +33,7 @@ struct GeneratorPythia8Param : public o2::conf::ConfigurableParamHelper<Generato
   std::string config = "";
   std::string hooksFileName = "";
   std::string hooksFuncName = "";
+  bool concurrent = false; // the instances may generate in parallel in the primary server
   O2ParamDef(GeneratorPythia8Param, "GeneratorPythia8");
 };
 
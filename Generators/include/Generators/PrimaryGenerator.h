@@ -15,6 +15,7 @@
 #define ALICEO2_EVENTGEN_PRIMARYGENERATOR_H_
 
 #include "FairPrimaryGenerator.h"
+#include "TRandom3.h"
 
 class TFile;
 class TTree;
@@ -71,6 +72,22 @@ class PrimaryGenerator : public FairPrimaryGenerator
   /** Public embedding methods **/
   Bool_t embedInto(TString fname);
 
+  /** Public concurrent generation methods.
+      In concurrent mode several primary generators run in parallel threads: gRandom is replaced by
+      a random engine of this primary generator, seeded with the event seed, and its use is serialised
+      with a lock shared by all primary generators. The generators which can generate concurrently
+      release the lock while generating and triggering. **/
+  bool canGenerateConcurrently();
+  void setConcurrentMode(bool val) { mConcurrentMode = val; };
+  void setEventSeed(unsigned int seed) { mEventSeed = seed; };
+  bool isConcurrentMode() const { return mConcurrentMode; };
+  void acquireSharedState();
+  void releaseSharedState();
+
+  /** seed of the event eventID (counting from 1) in concurrent mode, it only depends on the initial seed
+      and on the event number such that the events do not depend on the number of primary generators **/
+  static unsigned int getEventSeed(int initialSeed, int eventID);
+
  protected:
   /** copy constructor **/
   PrimaryGenerator(const PrimaryGenerator&) = default;
@@ -83,6 +100,9 @@ class PrimaryGenerator : public FairPrimaryGenerator
   /** set interaction vertex position **/
   void setInteractionVertex(const o2::dataformats::MCEventHeader* event);
 
+  /** generate event, embedding it if requested **/
+  Bool_t generateEvent(FairGenericStack* pStack);
+
   /** embedding members **/
   TFile* mEmbedFile = nullptr;
   TTree* mEmbedTree = nullptr;
@@ -90,6 +110,13 @@ class PrimaryGenerator : public FairPrimaryGenerator
   Int_t mEmbedIndex = 0;
   o2::dataformats::MCEventHeader* mEmbedEvent = nullptr;
 
+  /** concurrent generation members **/
+  bool mConcurrentMode = false;      //!
+  unsigned int mEventSeed = 0;       //!
+  TRandom3 mRandom;                  //!
+  TRandom* mSavedRandom = nullptr;   //!
+  bool mSharedStateAcquired = false; //!
+
   ClassDefOverride(PrimaryGenerator, 2);
 
 }; /** class PrimaryGenerator **/
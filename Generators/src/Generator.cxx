@@ -61,6 +61,20 @@ Bool_t
 {
   /** read event **/
 
+  /** concurrent generation: release the shared state while generating and triggering.
+      It is taken back when leaving the loop normally; after an exception it stays released
+      and the primary generator has nothing to release while unwinding **/
+  auto o2primGen = dynamic_cast<PrimaryGenerator*>(primGen);
+  auto releasedPrimGen = o2primGen && o2primGen->isConcurrentMode() && canGenerateConcurrently() ? o2primGen : nullptr;
+  auto reacquireSharedState = [releasedPrimGen]() {
+    if (releasedPrimGen) {
+      releasedPrimGen->acquireSharedState();
+    }
+  };
+  if (releasedPrimGen) {
+    releasedPrimGen->releaseSharedState();
+  }
+
   /** endless generate-and-trigger loop **/
   while (true) {
     mReadEventCounter++;
@@ -70,11 +84,13 @@ Bool_t
 
     /** generate event **/
     if (!generateEvent()) {
+      reacquireSharedState();
       return kFALSE;
     }
 
     /** import particles **/
     if (!importParticles()) {
+      reacquireSharedState();
       return kFALSE;
     }
 
@@ -86,6 +102,7 @@ Bool_t
       mTriggerFalseHook(mParticles, mReadEventCounter);
     }
   }
+  reacquireSharedState();
 
   /** add tracks **/
   if (!addTracks(primGen)) {
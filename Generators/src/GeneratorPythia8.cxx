@@ -44,6 +44,7 @@ GeneratorPythia8::GeneratorPythia8() : Generator("ALICEo2", "ALICEo2 Pythia8 Gen
   setConfig(param.config);
   setHooksFileName(param.hooksFileName);
   setHooksFuncName(param.hooksFuncName);
+  setConcurrent(param.concurrent);
 }
 
 /*****************************************************************/
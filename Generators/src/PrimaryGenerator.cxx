@@ -25,6 +25,9 @@
 #include "TDatabasePDG.h"
 #include "TVirtualMC.h"
 
+#include <cstdint>
+#include <mutex>
+
 using o2::dataformats::MCEventHeader;
 
 namespace o2
@@ -32,6 +35,30 @@ namespace o2
 namespace eventgen
 {
 
+namespace
+{
+// lock of the global state (gRandom) used during the generation by all primary generators
+std::mutex& getSharedStateMutex()
+{
+  static std::mutex sharedStateMutex;
+  return sharedStateMutex;
+}
+
+// holds the shared state of a primary generator in concurrent mode until the end of the scope,
+// the state released in between (e.g. by the generators) is not released twice
+class SharedStateGuard
+{
+ public:
+  SharedStateGuard(PrimaryGenerator& primGen) : mPrimGen(primGen) { mPrimGen.acquireSharedState(); }
+  ~SharedStateGuard() { mPrimGen.releaseSharedState(); }
+  SharedStateGuard(const SharedStateGuard&) = delete;
+  SharedStateGuard& operator=(const SharedStateGuard&) = delete;
+
+ private:
+  PrimaryGenerator& mPrimGen;
+};
+} // namespace
+
 /*****************************************************************/
 
 PrimaryGenerator::~PrimaryGenerator()
@@ -78,6 +105,92 @@ Bool_t PrimaryGenerator::GenerateEvent(FairGenericStack* pStack)
 {
   /** generate event **/
 
+  if (!mConcurrentMode) {
+    return generateEvent(pStack);
+  }
+
+  /** concurrent generation: the event is fully determined by the event seed **/
+  SharedStateGuard sharedStateGuard(*this);
+  mRandom.SetSeed(mEventSeed);
+  auto genList = GetListOfGenerators();
+  for (int igen = 0; igen < genList->GetEntries(); ++igen) {
+    auto o2gen = dynamic_cast<Generator*>(genList->At(igen));
+    if (o2gen) {
+      o2gen->setEventSeed(mEventSeed + igen);
+    }
+  }
+  return generateEvent(pStack);
+}
+
+/*****************************************************************/
+
+bool PrimaryGenerator::canGenerateConcurrently()
+{
+  /** all generators must be able to generate concurrently, embedding is sequential **/
+
+  if (mEmbedTree) {
+    return false;
+  }
+  auto genList = GetListOfGenerators();
+  if (!genList || genList->GetEntries() == 0) {
+    return false;
+  }
+  for (int igen = 0; igen < genList->GetEntries(); ++igen) {
+    auto o2gen = dynamic_cast<Generator*>(genList->At(igen));
+    if (!o2gen || !o2gen->canGenerateConcurrently()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*****************************************************************/
+
+void PrimaryGenerator::acquireSharedState()
+{
+  /** lock the state shared by the primary generators and use our random engine **/
+
+  if (mSharedStateAcquired) {
+    return;
+  }
+  getSharedStateMutex().lock();
+  mSharedStateAcquired = true;
+  mSavedRandom = gRandom;
+  gRandom = &mRandom;
+}
+
+/*****************************************************************/
+
+void PrimaryGenerator::releaseSharedState()
+{
+  /** restore gRandom and unlock the state shared by the primary generators **/
+
+  if (!mSharedStateAcquired) {
+    return;
+  }
+  gRandom = mSavedRandom;
+  mSharedStateAcquired = false;
+  getSharedStateMutex().unlock();
+}
+
+/*****************************************************************/
+
+unsigned int PrimaryGenerator::getEventSeed(int initialSeed, int eventID)
+{
+  /** splitmix64 finalizer of the initial seed and the event number **/
+
+  uint64_t h = (uint64_t(uint32_t(initialSeed)) << 32) | uint32_t(eventID);
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  return uint32_t(h ^ (h >> 31));
+}
+
+/*****************************************************************/
+
+Bool_t PrimaryGenerator::generateEvent(FairGenericStack* pStack)
+{
+  /** generate event **/
+
   /** normal generation if no embedding **/
   if (!mEmbedTree) {
     return FairPrimaryGenerator::GenerateEvent(pStack);
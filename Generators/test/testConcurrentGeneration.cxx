@@ -0,0 +1,112 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testConcurrentGeneration.cxx
+/// \brief checks that the events generated concurrently do not depend on the number of generators
+
+#define BOOST_TEST_MODULE Test Generators ConcurrentGeneration
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "Generators/GeneratorPythia8.h"
+#include "Generators/PrimaryGenerator.h"
+#include "SimulationDataFormat/MCEventHeader.h"
+#include "SimulationDataFormat/Stack.h"
+#include "CommonUtils/ConfigurableParam.h"
+#include <TParticle.h>
+#include <TROOT.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int InitialSeed = 1234;
+constexpr int NEvents = 12;
+
+// a primary generator with its event header and stack, as a slot of the primary server
+struct GeneratorSlot {
+  o2::dataformats::MCEventHeader eventHeader;
+  o2::data::Stack stack;
+  std::unique_ptr<o2::eventgen::PrimaryGenerator> primGen;
+
+  GeneratorSlot() : primGen(std::make_unique<o2::eventgen::PrimaryGenerator>())
+  {
+    auto pythia = new o2::eventgen::GeneratorPythia8();
+    pythia->readString("Beams:idA = 2212");
+    pythia->readString("Beams:idB = 2212");
+    pythia->readString("Beams:eCM = 13600.");
+    pythia->readString("SoftQCD:inelastic = on");
+    pythia->readString("Next:numberCount = 0");
+    pythia->setConcurrent(true);
+    primGen->AddGenerator(pythia);
+    primGen->SetEvent(&eventHeader);
+    primGen->Init();
+    primGen->setConcurrentMode(true);
+    stack.setExternalMode(true);
+  }
+};
+
+// the primaries of the events, generated by nGenerators slots running in parallel threads
+std::vector<std::vector<TParticle>> generate(int nGenerators)
+{
+  std::vector<std::unique_ptr<GeneratorSlot>> slots;
+  for (int i = 0; i < nGenerators; ++i) {
+    slots.push_back(std::make_unique<GeneratorSlot>());
+  }
+  BOOST_REQUIRE(slots[0]->primGen->canGenerateConcurrently());
+
+  // event eventID is generated by slot (eventID - 1) % nGenerators, as in the primary server
+  std::vector<std::vector<TParticle>> events(NEvents);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nGenerators; ++i) {
+    threads.emplace_back([&slot = *slots[i], &events, i, nGenerators]() {
+      for (int eventID = i + 1; eventID <= NEvents; eventID += nGenerators) {
+        slot.stack.Reset();
+        slot.primGen->setEventSeed(o2::eventgen::PrimaryGenerator::getEventSeed(InitialSeed, eventID));
+        slot.primGen->GenerateEvent(&slot.stack);
+        events[eventID - 1] = slot.stack.getPrimaries();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return events;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(ConcurrentGenerationSameEvents)
+{
+  ROOT::EnableThreadSafety();
+  // the vertex smearing uses gRandom, which is replaced by the random engine of the primary generator
+  o2::conf::ConfigurableParam::updateFromString("Diamond.width[0]=0.01;Diamond.width[1]=0.01;Diamond.width[2]=6.");
+
+  const auto reference = generate(1);
+  const auto events = generate(3);
+  BOOST_REQUIRE_EQUAL(events.size(), reference.size());
+  int nDiff = 0;
+  for (int i = 0; i < NEvents; ++i) {
+    BOOST_CHECK(!reference[i].empty());
+    BOOST_REQUIRE_EQUAL(events[i].size(), reference[i].size());
+    for (size_t j = 0; j < events[i].size(); ++j) {
+      const auto& p = events[i][j];
+      const auto& ref = reference[i][j];
+      nDiff += p.GetPdgCode() != ref.GetPdgCode() || p.Px() != ref.Px() || p.Py() != ref.Py() || p.Pz() != ref.Pz() ||
+               p.Vx() != ref.Vx() || p.Vy() != ref.Vy() || p.Vz() != ref.Vz();
+    }
+  }
+  BOOST_CHECK_EQUAL(nDiff, 0);
+
+  // the events differ from each other: they are seeded per event
+  BOOST_CHECK(reference[0].size() != reference[1].size() || reference[0][0].Vz() != reference[1][0].Vz());
+}
@@ -169,12 +169,9 @@ DataProcessorSpec getSimReaderSpec(SubspecRange range, const std::vector<std::st
         qedInteractionSampler.init();
         qedInteractionSampler.print();
         std::vector<o2::InteractionTimeRecord> qedinteractionrecords;
-        o2::InteractionTimeRecord t;
         LOG(INFO) << "GENERATING COL TIMES";
-        t = qedInteractionSampler.generateCollisionTime();
-        while ((t = qedInteractionSampler.generateCollisionTime()) < last) {
-          qedinteractionrecords.push_back(t);
-        }
+        qedInteractionSampler.generateCollisionTime(); // the first record is skipped
+        qedInteractionSampler.generateCollisionTimes(last, qedinteractionrecords);
         LOG(INFO) << "DONE GENERATING COL TIMES";
 
         // get digitization context and add QED stuff
@@ -125,6 +125,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
       } else {
         LOG(INFO) << "Using constant space-charge distortions.";
       }
+      auto readSpaceChargeLUT = ic.options().get<std::string>("readSpaceChargeLUT");
       auto readSpaceChargeString = ic.options().get<std::string>("readSpaceCharge");
       std::vector<std::string> readSpaceCharge;
       std::stringstream ssSpaceCharge(readSpaceChargeString);
@@ -133,7 +134,13 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
         getline(ssSpaceCharge, substr, ',');
         readSpaceCharge.push_back(substr);
       }
-      if (readSpaceCharge[0].size() != 0) { // use pre-calculated space-charge object
+      if (readSpaceChargeLUT.size() != 0) { // use memory-mapped lookup table of the global distortions
+        if (std::filesystem::exists(readSpaceChargeLUT)) {
+          mDigitizer.setUseSCDistortions(readSpaceChargeLUT);
+        } else {
+          LOG(ERROR) << "Space-charge distortion lookup table not found!";
+        }
+      } else if (readSpaceCharge[0].size() != 0) { // use pre-calculated space-charge object
         if (std::filesystem::exists(readSpaceCharge[0])) {
           TFile fileSC(readSpaceCharge[0].data(), "READ");
           mDigitizer.setUseSCDistortions(fileSC);
@@ -484,6 +491,7 @@ o2::framework::DataProcessorSpec getTPCDigitizerSpec(int channel, bool writeGRP,
     Options{{"distortionType", VariantType::Int, 0, {"Distortion type to be used. 0 = no distortions (default), 1 = realistic distortions (not implemented yet), 2 = constant distortions"}},
             {"initialSpaceChargeDensity", VariantType::String, "", {"Path to root file containing TH3 with initial space-charge density and name of the TH3 (comma separated)"}},
             {"readSpaceCharge", VariantType::String, "", {"Path to root file containing pre-calculated space-charge object and name of the object (comma separated)"}},
+            {"readSpaceChargeLUT", VariantType::String, "", {"Path to a lookup table of the global distortions written by SpaceCharge::writeDistortionLookupTable. It is memory-mapped and shared by all digitizer lanes and takes precedence over readSpaceCharge"}},
             {"TPCtriggered", VariantType::Bool, false, {"Impose triggered RO mode (default: continuous)"}}}};
 }
 
@@ -0,0 +1,89 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @brief Generation of collision contexts for consecutive ranges of timeframes
+
+#ifndef ALICEO2_CHUNKEDCONTEXTGENERATOR_H
+#define ALICEO2_CHUNKEDCONTEXTGENERATOR_H
+
+#include "SimulationDataFormat/DigitizationContext.h"
+#include "Steer/InteractionSampler.h"
+#include <TRandom3.h>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace steer
+{
+
+/// Generates the collision context of a long sequence of timeframes chunk by chunk: the collisions of a range of
+/// timeframes are sampled, assigned their constituents and interleaved with the QED events on the fly, so that only
+/// the current chunk is kept in memory. The sampling state carries over from one chunk to the next: the chunks are
+/// the consecutive parts of the context which would be generated for the whole sequence at once.
+class ChunkedContextGenerator
+{
+ public:
+  /// the sampler of the hadronic collisions, its first IR is the start of the first timeframe
+  InteractionSampler& getInteractionSampler() { return mSampler; }
+  /// the sampler of the QED events
+  InteractionSampler& getQEDInteractionSampler() { return mQEDSampler; }
+
+  /// set the simulation prefixes of the sources (0 for the background, > 0 for the signals) and their number of events
+  void setSources(std::vector<std::string> const& prefixes, std::vector<int> const& nEvents);
+
+  /// enable the QED interleaving with the prefix and number of events of the QED production
+  void setQEDSource(std::string const& prefix, int nEvents);
+
+  /// draw the constituents randomly (with possible repetition) instead of round robin
+  void setRandomEventSequence(bool b, unsigned int seed = 0)
+  {
+    mSampleCollisionsRandomly = b;
+    mRandom.SetSeed(seed);
+  }
+
+  void setOrbitsPerTF(uint32_t n) { mOrbitsPerTF = n; }
+  uint32_t getOrbitsPerTF() const { return mOrbitsPerTF; }
+
+  /// (re-)initialize the samplers and start from the first timeframe
+  void init();
+
+  /// fill the context with the collisions of the next nTF timeframes
+  /// returns the number of hadronic collisions
+  size_t fillNextChunk(DigitizationContext& context, uint32_t nTF = 1);
+
+  /// first orbit of the next chunk
+  uint32_t getNextOrbit() const { return mNextOrbit; }
+
+ private:
+  EventPart getBackground();
+  EventPart getSignal();
+
+  InteractionSampler mSampler;
+  InteractionSampler mQEDSampler;
+  std::vector<std::string> mPrefixes;
+  std::vector<int> mNEvents;     ///< number of events per source
+  std::vector<int> mNextEntries; ///< next entry per source for the round robin
+  int mNextSignal = 0;           ///< next signal source for the round robin
+  std::string mQEDPrefix;
+  int mNQEDEvents = 0;
+  int mNextQEDEntry = 0;
+  bool mSampleCollisionsRandomly = false;
+  TRandom3 mRandom{0};
+  uint32_t mOrbitsPerTF = 256;
+  uint32_t mNextOrbit = 0;
+  std::vector<o2::InteractionTimeRecord> mQEDRecords; ///< QED records of the current chunk
+};
+
+} // namespace steer
+} // namespace o2
+
+#endif
@@ -33,6 +33,9 @@ class InteractionSampler
   static constexpr float Sec2NanoSec = 1.e9; // s->ns conversion
   const o2::InteractionTimeRecord& generateCollisionTime();
   void generateCollisionTimes(std::vector<o2::InteractionTimeRecord>& dest);
+  /// append the interaction records preceding end, the next call continues from there
+  /// returns the number of records added
+  size_t generateCollisionTimes(const o2::InteractionRecord& end, std::vector<o2::InteractionTimeRecord>& dest);
 
   void init();
 
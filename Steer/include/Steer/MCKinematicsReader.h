@@ -15,6 +15,8 @@
 #include "SimulationDataFormat/MCEventHeader.h"
 #include "SimulationDataFormat/TrackReference.h"
 #include "SimulationDataFormat/MCTruthContainer.h"
+#include "SimulationDataFormat/MCTrackFlatFile.h"
+#include <memory>
 #include <vector>
 
 class TChain;
@@ -63,6 +65,8 @@ class MCKinematicsReader
 
   /// query an MC track given a basic label object
   /// returns nullptr if no track was found
+  /// When the flat kinematics file of a source is present (written by the hit merger next to the kinematics file),
+  /// the track is returned in place from the memory-mapped file, without loading the event.
   MCTrack const* getTrack(o2::MCCompLabel const&) const;
 
   /// query an MC track given source, event, track IDs
@@ -115,12 +119,16 @@ class MCKinematicsReader
   void loadHeadersForSource(int source) const;
   void loadTrackRefsForSource(int source) const;
   void initIndexedTrackRefs(std::vector<o2::TrackReference>& refs, o2::dataformats::MCTruthContainer<o2::TrackReference>& indexedrefs) const;
+  void initFlatTracks(std::vector<std::string> const& prefixes);
 
   DigitizationContext const* mDigitizationContext = nullptr;
 
   // chains for each source
   std::vector<TChain*> mInputChains;
 
+  // memory-mapped flat kinematics for each source (nullptr if not available)
+  std::vector<std::unique_ptr<o2::dataformats::MCTrackFlatFile>> mFlatTracks; //!
+
   // a vector of tracks foreach source and each collision
   mutable std::vector<std::vector<std::vector<o2::MCTrack>*>> mTracks;                                       // the in-memory track container
   mutable std::vector<std::vector<o2::dataformats::MCEventHeader>> mHeaders;                                 // the in-memory header container
@@ -139,6 +147,9 @@ inline MCTrack const* MCKinematicsReader::getTrack(o2::MCCompLabel const& label)
 
 inline MCTrack const* MCKinematicsReader::getTrack(int source, int event, int track) const
 {
+  if (mFlatTracks[source]) {
+    return mFlatTracks[source]->getTrack(event, track);
+  }
   return &getTracks(source, event)[track];
 }
 
@@ -0,0 +1,137 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Steer/ChunkedContextGenerator.h"
+#include <FairLogger.h>
+#include <stdexcept>
+
+using namespace o2::steer;
+
+//_________________________________________________
+void ChunkedContextGenerator::setSources(std::vector<std::string> const& prefixes, std::vector<int> const& nEvents)
+{
+  if (prefixes.empty() || prefixes.size() != nEvents.size()) {
+    throw std::runtime_error("ChunkedContextGenerator: one number of events per simulation prefix is needed");
+  }
+  for (auto n : nEvents) {
+    if (n <= 0) {
+      throw std::runtime_error("ChunkedContextGenerator: every source needs events");
+    }
+  }
+  mPrefixes = prefixes;
+  mNEvents = nEvents;
+}
+
+//_________________________________________________
+void ChunkedContextGenerator::setQEDSource(std::string const& prefix, int nEvents)
+{
+  if (nEvents <= 0) {
+    throw std::runtime_error("ChunkedContextGenerator: no QED events");
+  }
+  mQEDPrefix = prefix;
+  mNQEDEvents = nEvents;
+}
+
+//_________________________________________________
+void ChunkedContextGenerator::init()
+{
+  mSampler.init();
+  mNextOrbit = mSampler.getFirstIR().orbit;
+  if (mNQEDEvents > 0) {
+    // QED events range over the same bunch crossings as the hadronic ones
+    if (!mQEDSampler.getBunchFilling().getNBunches()) {
+      mQEDSampler.setBunchFilling(mSampler.getBunchFilling());
+    }
+    mQEDSampler.setFirstIR(mSampler.getFirstIR());
+    mQEDSampler.init();
+  }
+  mNextEntries.assign(mNEvents.size(), 0);
+  mNextSignal = 0;
+  mNextQEDEntry = 0;
+}
+
+//_________________________________________________
+EventPart ChunkedContextGenerator::getBackground()
+{
+  if (mSampleCollisionsRandomly) {
+    return EventPart(0, int(mNEvents[0] * mRandom.Rndm()));
+  }
+  EventPart e(0, mNextEntries[0]);
+  if (++mNextEntries[0] == mNEvents[0]) {
+    mNextEntries[0] = 0;
+  }
+  return e;
+}
+
+//_________________________________________________
+EventPart ChunkedContextGenerator::getSignal()
+{
+  const int nsignalids = mNEvents.size() - 1;
+  if (mSampleCollisionsRandomly) {
+    const auto sourceID = 1 + int(mRandom.Rndm() * nsignalids);
+    return EventPart(sourceID, int(mRandom.Rndm() * mNEvents[sourceID]));
+  }
+  const auto sourceID = mNextSignal + 1;
+  EventPart e(sourceID, mNextEntries[sourceID]);
+  if (++mNextEntries[sourceID] == mNEvents[sourceID]) {
+    mNextEntries[sourceID] = 0;
+  }
+  if (++mNextSignal == nsignalids) {
+    mNextSignal = 0;
+  }
+  return e;
+}
+
+//_________________________________________________
+size_t ChunkedContextGenerator::fillNextChunk(DigitizationContext& context, uint32_t nTF)
+{
+  if (mNEvents.empty()) {
+    throw std::runtime_error("ChunkedContextGenerator: no sources set");
+  }
+  if (mNextEntries.size() != mNEvents.size()) {
+    init();
+  }
+  const o2::InteractionRecord end(0, mNextOrbit + nTF * mOrbitsPerTF);
+
+  auto& records = context.getEventRecords();
+  records.clear();
+  mSampler.generateCollisionTimes(end, records);
+
+  // constituents: for the moment one background and one signal as in the HitProcessingManager
+  const bool withSignal = mNEvents.size() > 1;
+  auto& parts = context.getEventParts();
+  parts.resize(records.size());
+  for (auto& collisionParts : parts) {
+    collisionParts.clear();
+    collisionParts.emplace_back(getBackground());
+    if (withSignal) {
+      collisionParts.emplace_back(getSignal());
+    }
+  }
+  context.setNCollisions(records.size());
+  context.setMaxNumberParts(withSignal ? 2 : 1);
+  context.setFirstOrbitForSampling(mNextOrbit);
+  context.getBunchFilling() = mSampler.getBunchFilling();
+  context.setMuPerBC(mSampler.getMuPerBC());
+  context.setSimPrefixes(mPrefixes);
+
+  if (mNQEDEvents > 0) {
+    mQEDRecords.clear();
+    mQEDSampler.generateCollisionTimes(end, mQEDRecords);
+    context.fillQED(mQEDPrefix, mQEDRecords, mNQEDEvents, mNextQEDEntry);
+    mNextQEDEntry = (mNextQEDEntry + mQEDRecords.size()) % mNQEDEvents;
+  }
+
+  LOG(DEBUG) << "Context for orbits " << mNextOrbit << " to " << end.orbit << ": " << records.size() << " collisions, "
+             << mQEDRecords.size() << " QED events";
+  mNextOrbit = end.orbit;
+  return records.size();
+}
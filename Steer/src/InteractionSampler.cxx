@@ -111,6 +111,36 @@ const o2::InteractionTimeRecord& InteractionSampler::generateCollisionTime()
   return mIR;
 }
 
+//_________________________________________________
+size_t InteractionSampler::generateCollisionTimes(const o2::InteractionRecord& end, std::vector<o2::InteractionTimeRecord>& dest)
+{
+  // append the interaction records preceding end, a whole bunch crossing at a time.
+  // The first bunch crossing at or after end stays cached for the next call
+  if (mIntRate < 0) {
+    init();
+  }
+  const auto size0 = dest.size();
+  const auto nBC = end.differenceInBC(mIR);
+  if (nBC > 0) {
+    const double expected = mIntRate * nBC * o2::constants::lhc::LHCBunchSpacingNS / Sec2NanoSec;
+    dest.reserve(size0 + size_t(expected + 5 * std::sqrt(expected)) + 1);
+  }
+  while (true) {
+    if (mIntBCCache < 1) {
+      mIntBCCache = simulateInteractingBC();
+    }
+    if (!(static_cast<const o2::InteractionRecord&>(mIR) < end)) {
+      break;
+    }
+    for (; mIntBCCache > 0; mIntBCCache--) {
+      mIR.timeInBCNS = mTimeInBC.back();
+      mTimeInBC.pop_back();
+      dest.push_back(mIR);
+    }
+  }
+  return dest.size() - size0;
+}
+
 //_________________________________________________
 int InteractionSampler::simulateInteractingBC()
 {
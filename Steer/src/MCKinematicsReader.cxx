@@ -14,6 +14,7 @@
 #include "SimulationDataFormat/MCEventHeader.h"
 #include "SimulationDataFormat/TrackReference.h"
 #include <TChain.h>
+#include <filesystem>
 #include <vector>
 #include "FairLogger.h"
 
@@ -50,8 +51,36 @@ void MCKinematicsReader::initIndexedTrackRefs(std::vector<o2::TrackReference>& r
   }
 }
 
+void MCKinematicsReader::initFlatTracks(std::vector<std::string> const& prefixes)
+{
+  mFlatTracks.resize(prefixes.size());
+  for (int source = 0; source < prefixes.size(); ++source) {
+    const auto flatfile = o2::base::NameConf::getMCKinematicsFlatFileName(prefixes[source]);
+    std::error_code ec;
+    if (!std::filesystem::exists(flatfile, ec)) {
+      continue;
+    }
+    auto flat = std::make_unique<o2::dataformats::MCTrackFlatFile>();
+    if (!flat->open(flatfile)) {
+      continue;
+    }
+    // a flat file not matching the kinematics file is left over from a previous simulation
+    auto chain = mInputChains[source];
+    if (chain && chain->GetEntries() != flat->getNEvents()) {
+      LOG(WARN) << "Ignoring " << flatfile << " with " << flat->getNEvents() << " events while the kinematics has " << chain->GetEntries();
+      continue;
+    }
+    LOG(INFO) << "Reading MCTracks of source " << source << " from " << flatfile;
+    mFlatTracks[source] = std::move(flat);
+  }
+}
+
 void MCKinematicsReader::initTracksForSource(int source) const
 {
+  if (mFlatTracks[source]) {
+    mTracks[source].resize(mFlatTracks[source]->getNEvents(), nullptr);
+    return;
+  }
   auto chain = mInputChains[source];
   if (chain) {
     // todo: get name from NameConfig
@@ -62,6 +91,11 @@ void MCKinematicsReader::initTracksForSource(int source) const
 
 void MCKinematicsReader::loadTracksForSourceAndEvent(int source, int event) const
 {
+  if (mFlatTracks[source]) {
+    auto tracks = mFlatTracks[source]->getTracks(event);
+    mTracks[source][event] = new std::vector<o2::MCTrack>(tracks.begin(), tracks.end());
+    return;
+  }
   auto chain = mInputChains[source];
   if (chain) {
     // todo: get name from NameConfig
@@ -153,6 +187,7 @@ bool MCKinematicsReader::initFromDigitContext(std::string_view name)
   mTracks.resize(mInputChains.size());
   mHeaders.resize(mInputChains.size());
   mIndexedTrackRefs.resize(mInputChains.size());
+  initFlatTracks(mDigitizationContext->getSimPrefixes());
 
   // actual loading will be done only if someone asks
   // the first time for a particular source ...
@@ -171,6 +206,7 @@ bool MCKinematicsReader::initFromKinematics(std::string_view name)
   mTracks.resize(1);
   mHeaders.resize(1);
   mIndexedTrackRefs.resize(1);
+  initFlatTracks({std::string(name)});
   mInitialized = true;
 
   return true;
@@ -239,6 +239,7 @@ void O2MCApplication::attachSubEventInfo(FairMQParts& parts, o2::data::SubEventI
 }
 
 // helper function to fetch data from FairRootManager branch and serialize it
+// (flat for trivially copyable types if configured, TMessage otherwise)
 // returns handle to container
 template <typename T>
 const T* attachBranch(std::string const& name, FairMQChannel& channel, FairMQParts& parts)
@@ -251,7 +252,7 @@ const T* attachBranch(std::string const& name, FairMQChannel& channel, FairMQPar
   }
   auto data = mgr->InitObjectAs<const T*>(name.c_str());
   if (data) {
-    o2::base::attachTMessage(*data, channel, parts);
+    o2::base::attachData(*data, channel, parts);
   }
   return data;
 }
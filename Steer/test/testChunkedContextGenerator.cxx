@@ -0,0 +1,89 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test ChunkedContextGenerator class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include "Steer/ChunkedContextGenerator.h"
+
+namespace o2
+{
+using o2::steer::ChunkedContextGenerator;
+using o2::steer::DigitizationContext;
+using o2::steer::EventPart;
+
+void setupGenerator(ChunkedContextGenerator& generator)
+{
+  generator.setOrbitsPerTF(8);
+  generator.getInteractionSampler().setInteractionRate(50e3);
+  generator.getInteractionSampler().setFirstIR({0, 16});
+  generator.getQEDInteractionSampler().setInteractionRate(200e3);
+  generator.setSources({"bg", "sig1", "sig2"}, {7, 3, 5});
+  generator.setQEDSource("qed", 11);
+}
+
+bool sameParts(std::vector<EventPart> const& a, std::vector<EventPart> const& b)
+{
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](EventPart const& p1, EventPart const& p2) {
+    return p1.sourceID == p2.sourceID && p1.entryID == p2.entryID;
+  });
+}
+
+BOOST_AUTO_TEST_CASE(ChunkedContextGenerator_test)
+{
+  // the context of 12 timeframes at once
+  ChunkedContextGenerator generatorWhole;
+  setupGenerator(generatorWhole);
+  gRandom->SetSeed(5);
+  generatorWhole.init();
+  DigitizationContext whole;
+  generatorWhole.fillNextChunk(whole, 12);
+  BOOST_CHECK(whole.getNCollisions() > 0);
+  BOOST_CHECK(whole.isQEDProvided());
+
+  // ... and in chunks of 3 timeframes
+  ChunkedContextGenerator generatorChunks;
+  setupGenerator(generatorChunks);
+  gRandom->SetSeed(5);
+  generatorChunks.init();
+  DigitizationContext chunk;
+  size_t collision = 0, record = 0;
+  int qedEntry = 0;
+  for (int i = 0; i < 4; ++i) {
+    const auto firstOrbit = generatorChunks.getNextOrbit();
+    BOOST_CHECK_EQUAL(firstOrbit, 16 + i * 24);
+    generatorChunks.fillNextChunk(chunk, 3);
+    BOOST_CHECK_EQUAL(chunk.getFirstOrbitForSampling(), firstOrbit);
+    BOOST_CHECK_EQUAL(chunk.getNCollisions(), chunk.getEventRecords().size());
+    for (size_t j = 0; j < chunk.getEventRecords().size(); ++j, ++collision) {
+      BOOST_CHECK(chunk.getEventRecords()[j] == whole.getEventRecords()[collision]);
+      BOOST_CHECK(sameParts(chunk.getEventParts()[j], whole.getEventParts()[collision]));
+    }
+    const auto& records = chunk.getEventRecords(true);
+    BOOST_CHECK(std::is_sorted(records.begin(), records.end()));
+    for (size_t j = 0; j < records.size(); ++j, ++record) {
+      BOOST_CHECK(records[j].orbit >= firstOrbit && records[j].orbit < firstOrbit + 24);
+      BOOST_CHECK(records[j] == whole.getEventRecords(true)[record]);
+      const auto& parts = chunk.getEventParts(true)[j];
+      BOOST_CHECK(sameParts(parts, whole.getEventParts(true)[record]));
+      // QED events are taken round robin across the chunks
+      if (EventPart::isQED(parts[0])) {
+        BOOST_CHECK_EQUAL(parts[0].entryID, qedEntry);
+        qedEntry = (qedEntry + 1) % 11;
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(collision, whole.getEventRecords().size());
+  BOOST_CHECK_EQUAL(record, whole.getEventRecords(true).size());
+}
+} // namespace o2
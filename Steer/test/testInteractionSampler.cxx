@@ -84,5 +84,26 @@ BOOST_AUTO_TEST_CASE(InteractionSampler)
   }
   sampler1.print();
   sampler1.getBunchFilling().print();
+
+  printf("\nTesting sampling up to given interaction records\n");
+  // sampling range by range gives the same sequence as sampling one by one
+  gRandom->SetSeed(123);
+  Sampler samplerRange;
+  samplerRange.setFirstIR({0, 10});
+  samplerRange.init();
+  gRandom->SetSeed(123);
+  Sampler samplerSingle;
+  samplerSingle.setFirstIR({0, 10});
+  samplerSingle.init();
+  std::vector<o2::InteractionTimeRecord> rangeRecords;
+  for (uint32_t orbit = 12; orbit < 200; orbit += 7) {
+    const o2::InteractionRecord end(0, orbit);
+    samplerRange.generateCollisionTimes(end, rangeRecords);
+    BOOST_CHECK(rangeRecords.empty() || rangeRecords.back().orbit < orbit);
+  }
+  for (const auto& rec : rangeRecords) {
+    BOOST_CHECK(rec == samplerSingle.generateCollisionTime());
+  }
+  BOOST_CHECK(samplerRange.generateCollisionTime() == samplerSingle.generateCollisionTime());
 }
 } // namespace o2
@@ -21,6 +21,7 @@
 
 #include <boost/property_tree/ptree_fwd.hpp>
 #include <string>
+#include <vector>
 
 namespace o2::utilities
 {
@@ -38,6 +39,16 @@ class DataSamplingCondition
   virtual void configure(const boost::property_tree::ptree&) = 0;
   /// \brief Makes decision whether to pass a data sample or not.
   virtual bool decide(const o2::framework::DataRef&) = 0;
+  /// \brief Makes decisions for a batch of data samples, typically all the matching messages of one timeslice.
+  /// Only the samples with a positive decision so far are evaluated, the others are left untouched.
+  virtual void decideBatch(const std::vector<o2::framework::DataRef>& dataRefs, std::vector<bool>& decisions)
+  {
+    for (size_t i = 0; i < dataRefs.size(); ++i) {
+      if (decisions[i]) {
+        decisions[i] = decide(dataRefs[i]);
+      }
+    }
+  }
 };
 
 } // namespace o2::utilities
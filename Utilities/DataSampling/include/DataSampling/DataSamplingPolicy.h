@@ -76,6 +76,8 @@ class DataSamplingPolicy
   bool match(const framework::ConcreteDataMatcher& input) const;
   /// \brief Returns true if user-defined conditions of sampling are fulfilled.
   bool decide(const o2::framework::DataRef&);
+  /// \brief Makes the decisions for a batch of data samples at once, typically all the matching messages of one timeslice.
+  void decide(const std::vector<o2::framework::DataRef>&, std::vector<bool>& decisions);
   /// \brief Returns Output for given InputSpec to pass data forward.
   framework::Output prepareOutput(const framework::ConcreteDataMatcher& input, framework::Lifetime lifetime = framework::Lifetime::Timeframe) const;
 
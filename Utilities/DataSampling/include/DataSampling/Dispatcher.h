@@ -20,12 +20,16 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <chrono>
 
+#include "Framework/ConcreteDataMatcher.h"
 #include "Framework/DataProcessorSpec.h"
+#include "Framework/DataRef.h"
 #include "Framework/DeviceSpec.h"
 #include "Framework/Task.h"
 
 class FairMQDevice;
+class FairMQMessage;
 
 namespace o2::monitoring
 {
@@ -66,12 +70,29 @@ class Dispatcher : public framework::Task
   DataSamplingHeader prepareDataSamplingHeader(const DataSamplingPolicy& policy, const framework::DeviceSpec& spec);
   header::Stack extractAdditionalHeaders(const char* inputHeaderStack) const;
   void reportStats(monitoring::Monitoring& monitoring) const;
-  void send(framework::DataAllocator& dataAllocator, const framework::DataRef& inputData, framework::Output&& output) const;
+  /// An input message of the current timeslice, with the message holding its payload if available
+  struct SampledInput {
+    framework::DataRef ref;
+    FairMQMessage const* payloadMessage = nullptr;
+    framework::ConcreteDataMatcher matcher;
+  };
+  void send(framework::DataAllocator& dataAllocator, const SampledInput& input, framework::Output&& output);
 
   std::string mName;
   std::string mReconfigurationSource;
   // policies should be shared between all pipeline threads
   std::vector<std::shared_ptr<DataSamplingPolicy>> mPolicies;
+
+  // buffers reused in each invocation
+  std::vector<SampledInput> mInputs;
+  std::vector<framework::DataRef> mBatch;
+  std::vector<size_t> mBatchInputs;
+  std::vector<bool> mDecisions;
+
+  // stats
+  uint64_t mBytesPassed = 0;
+  uint64_t mBytesCopied = 0;
+  std::chrono::steady_clock::duration mProcessingTime{0};
 };
 
 } // namespace o2::utilities
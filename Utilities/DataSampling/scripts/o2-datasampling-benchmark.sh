@@ -17,6 +17,27 @@ function kill_benchmark() {
 
 RESULTS_FILE='data-sampling-benchmark-'$(date +"%y-%m-%d_%H%M")
 
+# Print the values of a metric found in the benchmark output
+# \param 1 : log file
+# \param 2 : metric name
+function extract_metric() {
+  grep -o "$2"',[0-9] [0-9]\{1,\}' $1 | sed -e "s/$2"',[0-9]\{1,\} //'
+}
+
+# Print the time spent by the Dispatchers per GB of sampled data, i.e. the fraction of a CPU core they need for each
+# GB/s of sampled input. It uses the last values of the metrics reported by each Dispatcher.
+# \param 1 : log file
+# \param 2 : number of dispatchers
+function dispatcher_overhead() {
+  local time_us=$(extract_metric $1 Dispatcher_processing_time_us | tail -n $2 | awk '{ s += $1 } END { print s }')
+  local bytes=$(extract_metric $1 Dispatcher_bytes_passed | tail -n $2 | awk '{ s += $1 } END { print s }')
+  if [ -z "$time_us" ] || [ -z "$bytes" ] || [ "$bytes" == "0" ]; then
+    echo 'n/a'
+  else
+    awk -v t=$time_us -v b=$bytes 'BEGIN { printf "%.4f", t * 1e3 / b }'
+  fi
+}
+
 # Run the benchmark with given parameters
 # \param 1 : fractions array name
 # \param 2 : payload sizes array name
@@ -71,7 +92,7 @@ function benchmark() {
   printf "Warm up cycles:         %s\n" "$warm_up_cycles" >> $results_filename
   printf "Available memory [B]:   %s\n" "$available_memory_bytes" >> $results_filename
   printf "Memory soft limit [MB]: %s\n" "$memory_soft_limit_mbytes" >> $results_filename
-  echo "fraction       , payload size   , nb producers   , nb dispatchers , messages per second" >> $results_filename
+  echo "fraction       , payload size   , nb producers   , nb dispatchers , messages per second , dispatcher s/GB" >> $results_filename
 
   local common_args="--run -b --infologger-severity info --shm-segment-size "$available_memory_bytes" --test-duration "$test_duration" --throttling "$memory_soft_limit_mbytes
   if [[ $fill == "yes" ]]; then
@@ -101,15 +122,16 @@ function benchmark() {
               # fixme: we assume that the metrics are produced in even (10s) time intervals and all are printed,
               #        we should at least be able notice when something doesn't seem right
 
-              metrics=
-              mapfile -t metrics < \
-                <( timeout -k 60s $test_duration_timeout o2-testworkflows-datasampling-benchmark $common_args --payload-size $payload_size --producers $nb_producers --dispatchers $nb_dispatchers --sampling-fraction $fraction \
-                 | grep -o 'Dispatcher_messages_evaluated,[0-9] [0-9]\{1,\}' \
-                 | sed -e 's/Dispatcher_messages_evaluated,[0-9]\{1,\} //'   \
-                 | tail -n +$((warm_up_cycles * nb_dispatchers + 1)) )
+              local log_file=$(mktemp)
+              timeout -k 60s $test_duration_timeout o2-testworkflows-datasampling-benchmark $common_args --payload-size $payload_size --producers $nb_producers --dispatchers $nb_dispatchers --sampling-fraction $fraction > $log_file
 
               pkill -9 -f o2-testworkflows-datasampling-benchmark
 
+              metrics=
+              mapfile -t metrics < <( extract_metric $log_file Dispatcher_messages_evaluated | tail -n +$((warm_up_cycles * nb_dispatchers + 1)) )
+              dispatcher_seconds_per_gb=$(dispatcher_overhead $log_file $nb_dispatchers)
+              rm -f $log_file
+
               if [ ${#metrics[@]} -ge $(( 2 * nb_dispatchers )) ]; then
 
                 total_start=0
@@ -136,7 +158,8 @@ function benchmark() {
               fi
             done
 
-            printf "%20s" "$messages_per_second" >> $results_filename
+            printf "%20s," "$messages_per_second" >> $results_filename
+            printf "%17s" "$dispatcher_seconds_per_gb" >> $results_filename
             printf "\n" >> $results_filename
 
             echo "Dispatcher_messages_evaluated metrics:"
@@ -146,6 +169,7 @@ function benchmark() {
               echo $metrics
             fi
             printf 'Messages per second: %s\n' "${messages_per_second}"
+            printf 'Dispatcher processing time per GB of sampled data [s]: %s\n' "${dispatcher_seconds_per_gb}"
           done
         done
       done
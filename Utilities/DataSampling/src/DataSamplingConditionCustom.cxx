@@ -74,6 +74,11 @@ class DataSamplingConditionCustom : public DataSamplingCondition
   {
     return mCondition->decide(dataRef);
   }
+  /// \brief Invokes decideBatch() of a custom condition
+  void decideBatch(const std::vector<o2::framework::DataRef>& dataRefs, std::vector<bool>& decisions) override
+  {
+    mCondition->decideBatch(dataRefs, decisions);
+  }
 
  private:
   std::unique_ptr<DataSamplingCondition> mCondition;
@@ -54,6 +54,15 @@ class DataSamplingConditionPayloadSize : public DataSamplingCondition
 
     return header->payloadSize >= mLowerLimit && header->payloadSize <= mUpperLimit;
   }
+  /// \brief Makes positive decisions for the samples with the payload size within given limits
+  void decideBatch(const std::vector<o2::framework::DataRef>& dataRefs, std::vector<bool>& decisions) override
+  {
+    for (size_t i = 0; i < dataRefs.size(); ++i) {
+      const auto* header = get<DataHeader*>(dataRefs[i].header);
+      assert(header);
+      decisions[i] = decisions[i] && header->payloadSize >= mLowerLimit && header->payloadSize <= mUpperLimit;
+    }
+  }
 
  private:
   size_t mLowerLimit;
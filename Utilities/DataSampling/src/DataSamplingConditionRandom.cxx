@@ -72,6 +72,23 @@ class DataSamplingConditionRandom : public DataSamplingCondition
     mCurrentTimesliceID = dpHeader->startTime + 1;
     return mLastDecision;
   }
+  /// \brief Makes the decision once for all the samples of the same timeslice.
+  void decideBatch(const std::vector<o2::framework::DataRef>& dataRefs, std::vector<bool>& decisions) override
+  {
+    const DataProcessingHeader* lastHeader = nullptr;
+    for (size_t i = 0; i < dataRefs.size(); ++i) {
+      if (!decisions[i]) {
+        continue;
+      }
+      const auto* dpHeader = get<DataProcessingHeader*>(dataRefs[i].header);
+      if (lastHeader == nullptr || dpHeader->startTime != lastHeader->startTime) {
+        decisions[i] = decide(dataRefs[i]);
+        lastHeader = dpHeader;
+      } else {
+        decisions[i] = mLastDecision;
+      }
+    }
+  }
 
  private:
   uint32_t mThreshold;
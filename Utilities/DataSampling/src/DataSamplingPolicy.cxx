@@ -121,6 +121,17 @@ bool DataSamplingPolicy::decide(const o2::framework::DataRef& dataRef)
   return decision;
 }
 
+void DataSamplingPolicy::decide(const std::vector<o2::framework::DataRef>& dataRefs, std::vector<bool>& decisions)
+{
+  decisions.assign(dataRefs.size(), true);
+  for (auto& condition : mConditions) {
+    condition->decideBatch(dataRefs, decisions);
+  }
+
+  mTotalAcceptedMessages += std::count(decisions.begin(), decisions.end(), true);
+  mTotalEvaluatedMessages += dataRefs.size();
+}
+
 Output DataSamplingPolicy::prepareOutput(const ConcreteDataMatcher& input, Lifetime lifetime) const
 {
   auto result = mPaths.find(input);
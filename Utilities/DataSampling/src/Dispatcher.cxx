@@ -21,7 +21,7 @@
 #include "Framework/DataSpecUtils.h"
 #include "Framework/Logger.h"
 #include "Framework/ConfigParamRegistry.h"
-#include "Framework/InputRecordWalker.h"
+#include "Framework/InputRecord.h"
 #include "Framework/Monitoring.h"
 
 #include <Configuration/ConfigurationInterface.h>
@@ -74,30 +74,58 @@ void Dispatcher::init(InitContext& ctx)
 
 void Dispatcher::run(ProcessingContext& ctx)
 {
-  for (const auto& input : InputRecordWalker(ctx.inputs())) {
-
-    const auto* inputHeader = header::get<header::DataHeader*>(input.header);
-    ConcreteDataMatcher inputMatcher{inputHeader->dataOrigin, inputHeader->dataDescription, inputHeader->subSpecification};
-
-    for (auto& policy : mPolicies) {
-      // todo: consider getting the outputSpec in match to improve performance
-      // todo: consider matching (and deciding) in completion policy to save some time
-
-      if (policy->match(inputMatcher) && policy->decide(input)) {
-        // We copy every header which is not DataHeader or DataProcessingHeader,
-        // so that custom data-dependent headers are passed forward,
-        // and we add a DataSamplingHeader.
-        header::Stack headerStack{
-          std::move(extractAdditionalHeaders(input.header)),
-          std::move(prepareDataSamplingHeader(*policy.get(), ctx.services().get<const DeviceSpec>()))};
-
-        Output output = policy->prepareOutput(inputMatcher, input.spec->lifetime);
-        output.metaHeader = std::move(header::Stack{std::move(output.metaHeader), std::move(headerStack)});
-        send(ctx.outputs(), input, std::move(output));
+  auto start = std::chrono::steady_clock::now();
+  auto& inputs = ctx.inputs();
+
+  // We gather all the messages of this timeslice first, so that each policy can make its decisions at once.
+  mInputs.clear();
+  for (size_t pos = 0; pos < inputs.size(); ++pos) {
+    for (size_t part = 0; part < inputs.getNofParts(pos); ++part) {
+      auto input = inputs.getByPos(pos, part);
+      if (input.header == nullptr) {
+        continue;
       }
+      const auto* inputHeader = header::get<header::DataHeader*>(input.header);
+      mInputs.push_back({input,
+                         inputs.getPayloadMessageByPos(pos, part),
+                         ConcreteDataMatcher{inputHeader->dataOrigin, inputHeader->dataDescription, inputHeader->subSpecification}});
     }
   }
 
+  for (auto& policy : mPolicies) {
+    // todo: consider matching (and deciding) in completion policy to save some time
+    mBatch.clear();
+    mBatchInputs.clear();
+    for (size_t i = 0; i < mInputs.size(); ++i) {
+      if (policy->match(mInputs[i].matcher)) {
+        mBatch.push_back(mInputs[i].ref);
+        mBatchInputs.push_back(i);
+      }
+    }
+    if (mBatch.empty()) {
+      continue;
+    }
+    policy->decide(mBatch, mDecisions);
+
+    for (size_t b = 0; b < mBatch.size(); ++b) {
+      if (!mDecisions[b]) {
+        continue;
+      }
+      auto& input = mInputs[mBatchInputs[b]];
+      // We copy every header which is not DataHeader or DataProcessingHeader,
+      // so that custom data-dependent headers are passed forward,
+      // and we add a DataSamplingHeader.
+      header::Stack headerStack{
+        std::move(extractAdditionalHeaders(input.ref.header)),
+        std::move(prepareDataSamplingHeader(*policy.get(), ctx.services().get<const DeviceSpec>()))};
+
+      Output output = policy->prepareOutput(input.matcher, input.ref.spec->lifetime);
+      output.metaHeader = std::move(header::Stack{std::move(output.metaHeader), std::move(headerStack)});
+      send(ctx.outputs(), input, std::move(output));
+    }
+  }
+
+  mProcessingTime += std::chrono::steady_clock::now() - start;
   if (ctx.inputs().isValid("timer-stats")) {
     reportStats(ctx.services().get<Monitoring>());
   }
@@ -115,6 +143,9 @@ void Dispatcher::reportStats(Monitoring& monitoring) const
 
   monitoring.send({dispatcherTotalEvaluatedMessages, "Dispatcher_messages_evaluated"});
   monitoring.send({dispatcherTotalAcceptedMessages, "Dispatcher_messages_passed"});
+  monitoring.send({mBytesPassed, "Dispatcher_bytes_passed"});
+  monitoring.send({mBytesCopied, "Dispatcher_bytes_copied"});
+  monitoring.send({static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(mProcessingTime).count()), "Dispatcher_processing_time_us"});
 }
 
 DataSamplingHeader Dispatcher::prepareDataSamplingHeader(const DataSamplingPolicy& policy, const DeviceSpec& spec)
@@ -146,10 +177,17 @@ header::Stack Dispatcher::extractAdditionalHeaders(const char* inputHeaderStack)
   return headerStack;
 }
 
-void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, Output&& output) const
+void Dispatcher::send(DataAllocator& dataAllocator, const SampledInput& input, Output&& output)
 {
-  const auto* inputHeader = header::get<header::DataHeader*>(inputData.header);
-  dataAllocator.snapshot(output, inputData.payload, inputHeader->payloadSize, inputHeader->payloadSerializationMethod);
+  const auto* inputHeader = header::get<header::DataHeader*>(input.ref.header);
+  if (input.payloadMessage != nullptr) {
+    // The sampled message shares the payload with the input, only the headers are new.
+    dataAllocator.forward(output, *input.payloadMessage, inputHeader->payloadSerializationMethod);
+  } else {
+    dataAllocator.snapshot(output, input.ref.payload, inputHeader->payloadSize, inputHeader->payloadSerializationMethod);
+    mBytesCopied += inputHeader->payloadSize;
+  }
+  mBytesPassed += inputHeader->payloadSize;
 }
 
 void Dispatcher::registerPolicy(std::unique_ptr<DataSamplingPolicy>&& policy)
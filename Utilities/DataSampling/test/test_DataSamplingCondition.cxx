@@ -129,3 +129,46 @@ BOOST_AUTO_TEST_CASE(DataSamplingConditionNConsecutive)
     BOOST_CHECK_EQUAL(conditionNConsecutive->decide(dr), t.second);
   }
 }
+
+BOOST_AUTO_TEST_CASE(DataSamplingConditionBatch)
+{
+  boost::property_tree::ptree config;
+  config.put("fraction", "0.5");
+  config.put("seed", "943753948");
+  config.put("upperLimit", 500);
+  config.put("lowerLimit", 30);
+
+  auto conditionRandom = DataSamplingConditionFactory::create("random");
+  auto conditionRandomBatch = DataSamplingConditionFactory::create("random");
+  auto conditionPayloadSize = DataSamplingConditionFactory::create("payloadSize");
+  conditionRandom->configure(config);
+  conditionRandomBatch->configure(config);
+  conditionPayloadSize->configure(config);
+
+  // batches of messages of one timeslice, each with a different payload size
+  for (DataProcessingHeader::StartTime id = 1; id < 50; id++) {
+    std::vector<o2::header::Stack> headerStacks;
+    headerStacks.reserve(4);
+    std::vector<DataRef> dataRefs;
+    for (size_t payloadSize : {10, 100, 1000, 300}) {
+      DataHeader dh;
+      dh.payloadSize = payloadSize;
+      headerStacks.emplace_back(dh, DataProcessingHeader{id, 0});
+    }
+    for (auto& headerStack : headerStacks) {
+      dataRefs.push_back(DataRef{nullptr, reinterpret_cast<const char*>(headerStack.data()), nullptr});
+    }
+
+    std::vector<bool> decisions(dataRefs.size(), true);
+    conditionRandomBatch->decideBatch(dataRefs, decisions);
+    bool expected = conditionRandom->decide(dataRefs[0]);
+    for (size_t i = 0; i < dataRefs.size(); i++) {
+      BOOST_CHECK_EQUAL(decisions[i], expected);
+    }
+
+    // the negative decisions are kept
+    decisions = {true, true, true, false};
+    conditionPayloadSize->decideBatch(dataRefs, decisions);
+    BOOST_CHECK(decisions == std::vector<bool>({false, true, false, false}));
+  }
+}
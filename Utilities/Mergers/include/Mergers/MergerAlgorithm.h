@@ -19,6 +19,8 @@
 
 #include "Mergers/MergeInterface.h"
 
+#include <vector>
+
 class TObject;
 
 namespace o2::mergers::algorithm
@@ -26,6 +28,15 @@ namespace o2::mergers::algorithm
 
 /// \brief A function which merges TObjects
 void merge(TObject* const target, TObject* const other);
+
+/// \brief A function which merges many TObjects into the target at once
+///
+/// Members of TCollections are matched by their position (falling back to the name) once for all the
+/// objects. Histograms with the same binning (TH1, TH2, TH3 with float or double contents) are added
+/// bin by bin, with these additions split among nThreads threads if Mergers are built with OpenMP.
+/// Any other object is merged with its own Merge() method, one by one. The result is the same as
+/// merging the objects one after the other, the merged objects are not modified.
+void merge(TObject* const target, std::vector<TObject*> const& others, size_t nThreads = 1);
 void deleteTCollections(TObject* obj);
 
 } // namespace o2::mergers::algorithm
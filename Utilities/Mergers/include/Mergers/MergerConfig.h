@@ -29,6 +29,12 @@ enum class InputObjectsTimespan {
   LastDifference // Mergers expect objects' differences (what has changed since the previous were sent).
 };
 
+enum class InputObjectsFormat {
+  ROOT,        // Mergers expect ROOT-serialized TObjects or objects inheriting MergeInterface.
+  SparseDeltas // After a ROOT-serialized object, producers send only the bins which changed, see SparseDelta.h.
+               // Applies only to InputObjectsTimespan::LastDifference.
+};
+
 enum class MergedObjectTimespan {
   // Merged object should be an sum of differences received since the beginning
   // or a sum of latest versions of objects received on each input.
@@ -60,10 +66,12 @@ struct ConfigEntry {
 // \brief MergerAlgorithm configuration structure. Default configuration should work in most cases, out of the box.
 struct MergerConfig {
   ConfigEntry<InputObjectsTimespan> inputObjectTimespan = {InputObjectsTimespan::FullHistory};
+  ConfigEntry<InputObjectsFormat> inputObjectsFormat = {InputObjectsFormat::ROOT};
   ConfigEntry<MergedObjectTimespan, int> mergedObjectTimespan = {MergedObjectTimespan::FullHistory};
   ConfigEntry<PublicationDecision> publicationDecision = {PublicationDecision::EachNSeconds, 10};
   ConfigEntry<TopologySize, int> topologySize = {TopologySize::NumberOfLayers, 1};
   std::string monitoringUrl = "infologger:///debug?qc";
+  size_t mergingThreads = 1; // Threads used to add the bins of large histograms, if built with OpenMP.
 };
 
 } // namespace o2::mergers
@@ -0,0 +1,102 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_SPARSEDELTA_H
+#define O2_SPARSEDELTA_H
+
+/// \file SparseDelta.h
+/// \brief Flat transport of the histogram bins which changed since the previous publication
+///
+/// A sparse delta message is a flat, messageable buffer (no ROOT serialization) with the layout:
+///   SparseDeltaHeader
+///   nHistograms times:
+///     SparseHistogramDelta
+///     char     name[nameSize]            padded to 8 bytes
+///     uint32_t bins[nChanged]            padded to 8 bytes, global bin numbers as in TH1::GetBin()
+///     double   contents[nChanged]        differences of the bin contents
+///     double   sumw2[nChanged]           differences of the sums of squared weights, if hasSumw2
+/// Producers publish their objects once with ROOT and then only the sparse deltas, which Mergers add in place
+/// to the histograms with the same names. It applies to TH1, TH2 and TH3 with float or double contents
+/// (not profiles), alone or in (nested) TCollections.
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Framework/DataRef.h"
+
+class TObject;
+
+namespace o2::mergers
+{
+
+struct SparseDeltaHeader {
+  static constexpr uint32_t MAGIC = 0x544c4453; // "SDLT"
+  uint32_t magic = MAGIC;
+  uint32_t nHistograms = 0;
+};
+
+struct SparseHistogramDelta {
+  static constexpr int NSTAT = 13; // TH1::kNstat
+  uint32_t nameSize = 0;
+  uint32_t nCells = 0; // TH1::GetNcells() of the histogram, has to match on the Merger side
+  uint32_t nChanged = 0;
+  uint32_t hasSumw2 = 0;
+  double entries = 0;
+  double stats[NSTAT] = {0}; // differences of TH1::GetStats()
+};
+
+/// \brief Producer-side encoder of sparse deltas.
+///
+/// It keeps the contents of the histograms as of the previous publication, so that producers which accumulate
+/// their data can send only what has changed. Producers which reset their objects after each publication
+/// should call reset() at the same time.
+class SparseDeltaEncoder
+{
+ public:
+  /// \brief Writes the changes of the histograms in object since the previous invocation to buffer.
+  ///
+  /// Returns false at the first invocation: the object should be then published as a ROOT object.
+  /// Throws if the object contains anything but supported histograms or if its layout has changed.
+  bool encode(TObject const* object, std::vector<char>& buffer);
+  /// \brief Sets the previous contents to zero, keeping the binning.
+  void reset();
+  /// \brief Forgets the previous publication, the next object has to be published as a ROOT object.
+  void clear() { mPrevious.clear(); }
+
+ private:
+  struct Snapshot {
+    std::vector<double> contents;
+    std::vector<double> sumw2;
+    double entries = 0;
+    double stats[SparseHistogramDelta::NSTAT] = {0};
+  };
+  std::unordered_map<std::string, Snapshot> mPrevious;
+};
+
+namespace sparse_delta_helpers
+{
+
+/// \brief Checks if the DataRef contains sparse deltas
+bool isSparseDelta(const framework::DataRef& ref);
+
+/// \brief Adds the deltas to the histograms of the target with the same names, in place
+void apply(TObject* target, const char* buffer, size_t size);
+
+/// \brief Resets all the histograms of the object, including these in (nested) TCollections
+void resetHistograms(TObject* object);
+
+} // namespace sparse_delta_helpers
+
+} // namespace o2::mergers
+
+#endif //O2_SPARSEDELTA_H
@@ -133,12 +133,14 @@ void FullHistoryMerger::mergeCache()
   if (std::holds_alternative<TObjectPtr>(mMergedObject)) {
 
     auto target = std::get<TObjectPtr>(mMergedObject);
+    std::vector<TObject*> others;
+    others.reserve(mCache.size());
     for (auto& [name, entry] : mCache) {
       (void)name;
-      auto other = std::get<TObjectPtr>(entry);
-      algorithm::merge(target.get(), other.get());
-      mObjectsMerged++;
+      others.push_back(std::get<TObjectPtr>(entry).get());
     }
+    algorithm::merge(target.get(), others, mConfig.mergingThreads);
+    mObjectsMerged += others.size();
 
   } else if (std::holds_alternative<MergeInterfacePtr>(mMergedObject)) {
     auto target = std::get<MergeInterfacePtr>(mMergedObject);
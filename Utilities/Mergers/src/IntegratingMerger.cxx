@@ -18,6 +18,7 @@
 
 #include "Mergers/MergerAlgorithm.h"
 #include "Mergers/MergerBuilder.h"
+#include "Mergers/SparseDelta.h"
 
 #include <Monitoring/MonitoringFactory.h>
 
@@ -47,16 +48,24 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
   // we have to avoid mistaking the timer input with data inputs.
   auto* timerHeader = ctx.inputs().get("timer-publish").header;
 
+  // TObjects received in this invocation are merged all at once.
+  std::vector<TObjectPtr> others;
   for (const DataRef& ref : InputRecordWalker(ctx.inputs())) {
     if (ref.header != timerHeader) {
-      if (std::holds_alternative<std::monostate>(mMergedObject)) {
+      if (mConfig.inputObjectsFormat.value == InputObjectsFormat::SparseDeltas && sparse_delta_helpers::isSparseDelta(ref)) {
+        // Deltas are added in place, they need the object published by the producer beforehand.
+        if (!std::holds_alternative<TObjectPtr>(mMergedObject)) {
+          LOG(WARNING) << "Received a sparse delta before the object it applies to, dropping it";
+          continue;
+        }
+        sparse_delta_helpers::apply(std::get<TObjectPtr>(mMergedObject).get(), ref.payload, DataRefUtils::getPayloadSize(ref));
+
+      } else if (std::holds_alternative<std::monostate>(mMergedObject)) {
         mMergedObject = object_store_helpers::extractObjectFrom(ref);
 
       } else if (std::holds_alternative<TObjectPtr>(mMergedObject)) {
         // We expect that if the first object was TObject, then all should.
-        auto other = TObjectPtr(framework::DataRefUtils::as<TObject>(ref).release(), algorithm::deleteTCollections);
-        auto target = std::get<TObjectPtr>(mMergedObject);
-        algorithm::merge(target.get(), other.get());
+        others.emplace_back(framework::DataRefUtils::as<TObject>(ref).release(), algorithm::deleteTCollections);
 
       } else if (std::holds_alternative<MergeInterfacePtr>(mMergedObject)) {
         // We expect that if the first object inherited MergeInterface, then all should.
@@ -68,6 +77,13 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
       mDeltasMerged++;
     }
   }
+  if (!others.empty()) {
+    std::vector<TObject*> otherPtrs;
+    for (auto& other : others) {
+      otherPtrs.push_back(other.get());
+    }
+    algorithm::merge(std::get<TObjectPtr>(mMergedObject).get(), otherPtrs, mConfig.mergingThreads);
+  }
 
   if (ctx.inputs().isValid("timer-publish")) {
     mCyclesSinceReset++;
@@ -83,7 +99,12 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
 // I am not calling it reset(), because it does not have to be performed during the FairMQs reset.
 void IntegratingMerger::clear()
 {
-  mMergedObject = std::monostate{};
+  if (mConfig.inputObjectsFormat.value == InputObjectsFormat::SparseDeltas && std::holds_alternative<TObjectPtr>(mMergedObject)) {
+    // Producers keep sending only the sparse deltas, so we keep the objects they apply to.
+    sparse_delta_helpers::resetHistograms(std::get<TObjectPtr>(mMergedObject).get());
+  } else {
+    mMergedObject = std::monostate{};
+  }
   mCyclesSinceReset = 0;
   mTotalDeltasMerged = 0;
   mDeltasMerged = 0;
@@ -26,11 +26,21 @@
 #include <THnSparse.h>
 #include <TObjArray.h>
 #include <TGraph.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+#include <TProfile3D.h>
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
 
 namespace o2::mergers::algorithm
 {
 
-void merge(TObject* const target, TObject* const other)
+namespace
+{
+
+void checkPair(TObject* const target, TObject* const other)
 {
   if (target == nullptr) {
     throw std::runtime_error("Merging target is nullptr");
@@ -41,57 +51,236 @@ void merge(TObject* const target, TObject* const other)
   if (other == target) {
     throw std::runtime_error("Merging target and the other object point to the same address");
   }
-  // fixme: should we check if names match?
+}
 
-  // We expect that both objects follow the same structure, but we allow to add missing objects to TCollections.
-  // First we check if an object contains a MergeInterface, as it should overlap default Merge() methods of TObject.
+// Merges an object which is not a collection with its own Merge() method.
+void mergeSingle(TObject* const target, TObject* const other)
+{
   if (auto custom = dynamic_cast<MergeInterface*>(target)) {
-
     custom->merge(dynamic_cast<MergeInterface* const>(other));
+    return;
+  }
 
-  } else if (auto targetCollection = dynamic_cast<TCollection*>(target)) {
+  Long64_t errorCode = 0;
+  TObjArray otherCollection;
+  otherCollection.SetOwner(false);
+  otherCollection.Add(other);
 
-    auto otherCollection = dynamic_cast<TCollection*>(other);
-    if (otherCollection == nullptr) {
-      throw std::runtime_error(std::string("The target object '") + target->GetName() +
-                               "' is a TCollection, while the other object '" + other->GetName() + "' is not.");
+  if (target->InheritsFrom(TH1::Class())) {
+    // this includes TH1, TH2, TH3
+    errorCode = reinterpret_cast<TH1*>(target)->Merge(&otherCollection);
+  } else if (target->InheritsFrom(THnBase::Class())) {
+    // this includes THn and THnSparse
+    errorCode = reinterpret_cast<THnBase*>(target)->Merge(&otherCollection);
+  } else if (target->InheritsFrom(TTree::Class())) {
+    errorCode = reinterpret_cast<TTree*>(target)->Merge(&otherCollection);
+  } else if (target->InheritsFrom(TGraph::Class())) {
+    errorCode = reinterpret_cast<TGraph*>(target)->Merge(&otherCollection);
+  } else {
+    throw std::runtime_error("Object with type '" + std::string(target->ClassName()) + "' is not one of the mergeable types.");
+  }
+  if (errorCode == -1) {
+    throw std::runtime_error("Merging object of type '" + std::string(target->ClassName()) + "' failed.");
+  }
+}
+
+bool sameBinning(TAxis const* a, TAxis const* b)
+{
+  if (a->GetNbins() != b->GetNbins() || a->GetXmin() != b->GetXmin() || a->GetXmax() != b->GetXmax()) {
+    return false;
+  }
+  // alphanumeric bins are merged by label and restricted ranges change how the statistics are computed
+  if (a->GetLabels() != nullptr || b->GetLabels() != nullptr || a->TestBit(TAxis::kAxisRange) || b->TestBit(TAxis::kAxisRange)) {
+    return false;
+  }
+  auto edgesA = a->GetXbins();
+  auto edgesB = b->GetXbins();
+  return edgesA->GetSize() == edgesB->GetSize() &&
+         std::equal(edgesA->GetArray(), edgesA->GetArray() + edgesA->GetSize(), edgesB->GetArray());
+}
+
+// Histograms which can be merged by adding their bins, i.e. the same TH1, TH2 or TH3 class with float or
+// double contents and the same binning. Profiles keep more than the bin contents and are excluded.
+bool isBinWiseAddable(TObject* target, TObject* other)
+{
+  if (target->IsA() != other->IsA() || !target->InheritsFrom(TH1::Class())) {
+    return false;
+  }
+  if (dynamic_cast<TArrayD*>(target) == nullptr && dynamic_cast<TArrayF*>(target) == nullptr) {
+    return false;
+  }
+  if (target->InheritsFrom(TProfile::Class()) || target->InheritsFrom(TProfile2D::Class()) || target->InheritsFrom(TProfile3D::Class())) {
+    return false;
+  }
+  auto h1 = static_cast<TH1*>(target);
+  auto h2 = static_cast<TH1*>(other);
+  if (h1->GetBuffer() != nullptr || h2->GetBuffer() != nullptr || h1->TestBit(TH1::kIsAverage) || h2->TestBit(TH1::kIsAverage)) {
+    return false;
+  }
+  return h1->GetNcells() == h2->GetNcells() && h1->GetSumw2N() == h2->GetSumw2N() &&
+         sameBinning(h1->GetXaxis(), h2->GetXaxis()) &&
+         sameBinning(h1->GetYaxis(), h2->GetYaxis()) &&
+         sameBinning(h1->GetZaxis(), h2->GetZaxis());
+}
+
+// The histograms to be added into one target histogram
+struct BinWiseAddition {
+  TH1* target = nullptr;
+  std::vector<TH1*> others;
+  Double_t stats[TH1::kNstat] = {0};
+  Double_t entries = 0;
+};
+
+// A range of bins of one BinWiseAddition, the unit of work of the threads
+struct BinRange {
+  size_t addition;
+  size_t begin;
+  size_t end;
+};
+
+constexpr size_t BINS_PER_RANGE = 1 << 15;
+
+template <typename T>
+void addBins(T* __restrict__ target, T const* __restrict__ other, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; ++i) {
+    target[i] += other[i];
+  }
+}
+
+void addBinRange(BinWiseAddition& addition, size_t begin, size_t end)
+{
+  auto target = addition.target;
+  bool sumw2 = target->GetSumw2N() != 0;
+  for (auto other : addition.others) {
+    if (auto targetArray = dynamic_cast<TArrayD*>(target)) {
+      addBins(targetArray->GetArray(), dynamic_cast<TArrayD*>(other)->GetArray(), begin, end);
+    } else {
+      addBins(dynamic_cast<TArrayF*>(target)->GetArray(), dynamic_cast<TArrayF*>(other)->GetArray(), begin, end);
+    }
+    if (sumw2) {
+      addBins(target->GetSumw2()->GetArray(), other->GetSumw2()->GetArray(), begin, end);
     }
+  }
+}
 
-    auto otherIterator = otherCollection->MakeIterator();
-    while (auto otherObject = otherIterator->Next()) {
-      TObject* targetObject = targetCollection->FindObject(otherObject->GetName());
-      if (targetObject) {
-        // That might be another collection or a concrete object to be merged, we walk on the collection recursively.
-        merge(targetObject, otherObject);
-      } else {
-        // We prefer to clone instead of passing the pointer in order to simplify deleting the `other`.
-        targetCollection->Add(otherObject->Clone());
+// Walks the target and the others in parallel. Objects missing in the target collections are cloned,
+// the histograms which can be added bin by bin are collected in additions, anything else is merged.
+void mergeRecursively(TObject* const target, std::vector<TObject*> const& others, std::vector<BinWiseAddition>& additions)
+{
+  for (auto other : others) {
+    checkPair(target, other);
+  }
+  if (others.empty()) {
+    return;
+  }
+
+  // We expect that both objects follow the same structure, but we allow to add missing objects to TCollections.
+  // First we check if an object contains a MergeInterface, as it should overlap default Merge() methods of TObject.
+  if (dynamic_cast<MergeInterface*>(target)) {
+    for (auto other : others) {
+      mergeSingle(target, other);
+    }
+  } else if (auto targetCollection = dynamic_cast<TCollection*>(target)) {
+    // The members of the other collections to be merged into each member of the target,
+    // in the order of the target.
+    std::vector<std::pair<TObject*, std::vector<TObject*>>> members;
+    std::unordered_map<TObject*, size_t> memberIndex;
+    for (auto other : others) {
+      auto otherCollection = dynamic_cast<TCollection*>(other);
+      if (otherCollection == nullptr) {
+        throw std::runtime_error(std::string("The target object '") + target->GetName() +
+                                 "' is a TCollection, while the other object '" + other->GetName() + "' is not.");
+      }
+      std::vector<TObject*> missing;
+      TIter targetIterator(targetCollection);
+      TIter otherIterator(otherCollection);
+      while (auto otherObject = otherIterator()) {
+        // Collections usually have the same layout, so the object at the same position is tried first.
+        TObject* targetObject = targetIterator();
+        if (targetObject == nullptr || strcmp(targetObject->GetName(), otherObject->GetName()) != 0) {
+          targetObject = targetCollection->FindObject(otherObject->GetName());
+        }
+        if (targetObject) {
+          auto [it, inserted] = memberIndex.emplace(targetObject, members.size());
+          if (inserted) {
+            members.emplace_back(targetObject, std::vector<TObject*>{});
+          }
+          members[it->second].second.push_back(otherObject);
+        } else {
+          // We prefer to clone instead of passing the pointer in order to simplify deleting the `other`.
+          missing.push_back(otherObject->Clone());
+        }
+      }
+      for (auto clone : missing) {
+        targetCollection->Add(clone);
       }
     }
-    delete otherIterator;
+    for (auto& [targetObject, otherObjects] : members) {
+      // That might be another collection or a concrete object to be merged, we walk on the collection recursively.
+      mergeRecursively(targetObject, otherObjects, additions);
+    }
+  } else if (std::all_of(others.begin(), others.end(), [target](TObject* other) { return isBinWiseAddable(target, other); })) {
+    BinWiseAddition addition;
+    addition.target = static_cast<TH1*>(target);
+    addition.target->GetStats(addition.stats);
+    addition.entries = addition.target->GetEntries();
+    for (auto other : others) {
+      auto histogram = static_cast<TH1*>(other);
+      Double_t stats[TH1::kNstat] = {0};
+      histogram->GetStats(stats);
+      for (int i = 0; i < TH1::kNstat; ++i) {
+        addition.stats[i] += stats[i];
+      }
+      addition.entries += histogram->GetEntries();
+      addition.others.push_back(histogram);
+    }
+    additions.push_back(std::move(addition));
   } else {
-    Long64_t errorCode = 0;
-    TObjArray otherCollection;
-    otherCollection.SetOwner(false);
-    otherCollection.Add(other);
-
-    if (target->InheritsFrom(TH1::Class())) {
-      // this includes TH1, TH2, TH3
-      errorCode = reinterpret_cast<TH1*>(target)->Merge(&otherCollection);
-    } else if (target->InheritsFrom(THnBase::Class())) {
-      // this includes THn and THnSparse
-      errorCode = reinterpret_cast<THnBase*>(target)->Merge(&otherCollection);
-    } else if (target->InheritsFrom(TTree::Class())) {
-      errorCode = reinterpret_cast<TTree*>(target)->Merge(&otherCollection);
-    } else if (target->InheritsFrom(TGraph::Class())) {
-      errorCode = reinterpret_cast<TGraph*>(target)->Merge(&otherCollection);
-    } else {
-      throw std::runtime_error("Object with type '" + std::string(target->ClassName()) + "' is not one of the mergeable types.");
+    for (auto other : others) {
+      mergeSingle(target, other);
     }
-    if (errorCode == -1) {
-      throw std::runtime_error("Merging object of type '" + std::string(target->ClassName()) + "' failed.");
+  }
+}
+
+} // namespace
+
+void merge(TObject* const target, TObject* const other)
+{
+  merge(target, std::vector<TObject*>{other});
+}
+
+void merge(TObject* const target, std::vector<TObject*> const& others, size_t nThreads)
+{
+  if (target == nullptr) {
+    throw std::runtime_error("Merging target is nullptr");
+  }
+  // fixme: should we check if names match?
+
+  std::vector<BinWiseAddition> additions;
+  mergeRecursively(target, others, additions);
+
+  // The bins of all the histograms are split in ranges which are added in parallel.
+  std::vector<BinRange> ranges;
+  for (size_t ai = 0; ai < additions.size(); ++ai) {
+    size_t cells = additions[ai].target->GetNcells();
+    for (size_t begin = 0; begin < cells; begin += BINS_PER_RANGE) {
+      ranges.push_back({ai, begin, std::min(cells, begin + BINS_PER_RANGE)});
     }
   }
+  [[maybe_unused]] bool parallel = nThreads > 1 && ranges.size() > 1;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads) if (parallel)
+#endif
+  for (int ri = 0; ri < (int)ranges.size(); ++ri) {
+    auto& range = ranges[ri];
+    addBinRange(additions[range.addition], range.begin, range.end);
+  }
+
+  for (auto& addition : additions) {
+    addition.target->PutStats(addition.stats);
+    addition.target->SetEntries(addition.entries);
+  }
 }
 
 void deleteTCollections(TObject* obj)
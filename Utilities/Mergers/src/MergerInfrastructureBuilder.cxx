@@ -73,6 +73,9 @@ std::string MergerInfrastructureBuilder::validateConfig()
   if (mConfig.inputObjectTimespan.value == InputObjectsTimespan::FullHistory && mConfig.mergedObjectTimespan.value == MergedObjectTimespan::LastDifference) {
     error += preamble + "MergedObjectTimespan::LastDifference does not apply to InputObjectsTimespan::FullHistory\n";
   }
+  if (mConfig.inputObjectTimespan.value == InputObjectsTimespan::FullHistory && mConfig.inputObjectsFormat.value == InputObjectsFormat::SparseDeltas) {
+    error += preamble + "InputObjectsFormat::SparseDeltas does not apply to InputObjectsTimespan::FullHistory\n";
+  }
 
   for (const auto& input : mInputs) {
     if (DataSpecUtils::match(input, mOutputSpec)) {
@@ -0,0 +1,327 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file SparseDelta.cxx
+/// \brief Implementation of the sparse delta transport for Mergers
+
+#include "Mergers/SparseDelta.h"
+#include "Framework/DataRefUtils.h"
+#include "Headers/DataHeader.h"
+
+#include <TH1.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+#include <TProfile3D.h>
+#include <TCollection.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace o2::mergers
+{
+
+static_assert(SparseHistogramDelta::NSTAT == TH1::kNstat, "SparseHistogramDelta has to keep all the TH1 statistics");
+
+namespace
+{
+
+constexpr size_t ALIGNMENT = 8;
+
+size_t padded(size_t size)
+{
+  return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+bool isSupported(TObject const* object)
+{
+  if (!object->InheritsFrom(TH1::Class())) {
+    return false;
+  }
+  if (dynamic_cast<TArrayD const*>(object) == nullptr && dynamic_cast<TArrayF const*>(object) == nullptr) {
+    return false;
+  }
+  if (object->InheritsFrom(TProfile::Class()) || object->InheritsFrom(TProfile2D::Class()) || object->InheritsFrom(TProfile3D::Class())) {
+    return false;
+  }
+  auto histogram = static_cast<TH1 const*>(object);
+  return histogram->GetBuffer() == nullptr && !histogram->TestBit(TH1::kIsAverage);
+}
+
+void collectHistograms(TObject const* object, std::vector<TH1 const*>& histograms)
+{
+  if (auto collection = dynamic_cast<TCollection const*>(object)) {
+    TIter next(collection);
+    while (auto member = next()) {
+      collectHistograms(member, histograms);
+    }
+  } else if (isSupported(object)) {
+    histograms.push_back(static_cast<TH1 const*>(object));
+  } else {
+    throw std::runtime_error(std::string("Object '") + object->GetName() + "' of type '" + object->ClassName() + "' cannot be sent as a sparse delta.");
+  }
+}
+
+TH1* findHistogram(TObject* object, const std::string& name)
+{
+  if (auto collection = dynamic_cast<TCollection*>(object)) {
+    TIter next(collection);
+    while (auto member = next()) {
+      if (auto histogram = findHistogram(member, name)) {
+        return histogram;
+      }
+    }
+    return nullptr;
+  }
+  return name == object->GetName() && object->InheritsFrom(TH1::Class()) ? static_cast<TH1*>(object) : nullptr;
+}
+
+// The changed bins of one histogram
+struct Changes {
+  std::vector<uint32_t> bins;
+  std::vector<double> contents;
+  std::vector<double> sumw2;
+};
+
+template <typename T>
+void findChanges(T const* contents, double const* sumw2, size_t nCells, std::vector<double>& previousContents,
+                 std::vector<double>& previousSumw2, Changes& changes)
+{
+  for (size_t i = 0; i < nCells; ++i) {
+    double content = contents[i];
+    bool changed = content != previousContents[i];
+    if (sumw2 != nullptr) {
+      changed = changed || sumw2[i] != previousSumw2[i];
+    }
+    if (changed) {
+      changes.bins.push_back(i);
+      changes.contents.push_back(content - previousContents[i]);
+      previousContents[i] = content;
+      if (sumw2 != nullptr) {
+        changes.sumw2.push_back(sumw2[i] - previousSumw2[i]);
+        previousSumw2[i] = sumw2[i];
+      }
+    }
+  }
+}
+
+template <typename T>
+void addChanges(T* contents, double* sumw2, bool contentsAsSumw2, uint32_t const* bins, double const* deltas, double const* sumw2Deltas, size_t nChanged)
+{
+  for (size_t i = 0; i < nChanged; ++i) {
+    contents[bins[i]] += deltas[i];
+    if (sumw2Deltas != nullptr) {
+      sumw2[bins[i]] += sumw2Deltas[i];
+    } else if (contentsAsSumw2) {
+      // the producer does not store the errors, i.e. it fills with unit weights
+      sumw2[bins[i]] += deltas[i];
+    }
+  }
+}
+
+template <typename T>
+void append(std::vector<char>& buffer, T const* data, size_t count)
+{
+  auto bytes = reinterpret_cast<const char*>(data);
+  buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+  buffer.resize(padded(buffer.size()));
+}
+
+} // namespace
+
+bool SparseDeltaEncoder::encode(TObject const* object, std::vector<char>& buffer)
+{
+  std::vector<TH1 const*> histograms;
+  collectHistograms(object, histograms);
+
+  if (mPrevious.empty()) {
+    for (auto histogram : histograms) {
+      auto& previous = mPrevious[histogram->GetName()];
+      previous.contents.resize(histogram->GetNcells());
+      for (int i = 0; i < histogram->GetNcells(); ++i) {
+        previous.contents[i] = histogram->GetBinContent(i);
+      }
+      if (histogram->GetSumw2N() != 0) {
+        auto sumw2 = histogram->GetSumw2()->GetArray();
+        previous.sumw2.assign(sumw2, sumw2 + histogram->GetNcells());
+      }
+      previous.entries = histogram->GetEntries();
+      histogram->GetStats(previous.stats);
+    }
+    if (mPrevious.size() != histograms.size()) {
+      mPrevious.clear();
+      throw std::runtime_error("Histograms sent as sparse deltas need unique names.");
+    }
+    return false;
+  }
+
+  if (mPrevious.size() != histograms.size()) {
+    throw std::runtime_error("The number of histograms changed since the previous sparse delta.");
+  }
+
+  buffer.clear();
+  SparseDeltaHeader header;
+  header.nHistograms = histograms.size();
+  append(buffer, &header, 1);
+
+  Changes changes;
+  for (auto histogram : histograms) {
+    auto it = mPrevious.find(histogram->GetName());
+    size_t nCells = histogram->GetNcells();
+    bool hasSumw2 = histogram->GetSumw2N() != 0;
+    if (it == mPrevious.end() || it->second.contents.size() != nCells || it->second.sumw2.empty() == hasSumw2) {
+      throw std::runtime_error(std::string("Histogram '") + histogram->GetName() + "' changed its layout since the previous sparse delta.");
+    }
+    auto& previous = it->second;
+
+    changes.bins.clear();
+    changes.contents.clear();
+    changes.sumw2.clear();
+    double const* sumw2 = hasSumw2 ? histogram->GetSumw2()->GetArray() : nullptr;
+    if (auto array = dynamic_cast<TArrayD const*>(histogram)) {
+      findChanges(array->GetArray(), sumw2, nCells, previous.contents, previous.sumw2, changes);
+    } else {
+      findChanges(dynamic_cast<TArrayF const*>(histogram)->GetArray(), sumw2, nCells, previous.contents, previous.sumw2, changes);
+    }
+
+    SparseHistogramDelta delta;
+    std::string name = histogram->GetName();
+    delta.nameSize = name.size();
+    delta.nCells = nCells;
+    delta.nChanged = changes.bins.size();
+    delta.hasSumw2 = hasSumw2;
+    double entries = histogram->GetEntries();
+    delta.entries = entries - previous.entries;
+    previous.entries = entries;
+    double stats[SparseHistogramDelta::NSTAT] = {0};
+    histogram->GetStats(stats);
+    for (int i = 0; i < SparseHistogramDelta::NSTAT; ++i) {
+      delta.stats[i] = stats[i] - previous.stats[i];
+      previous.stats[i] = stats[i];
+    }
+
+    append(buffer, &delta, 1);
+    append(buffer, name.data(), name.size());
+    append(buffer, changes.bins.data(), changes.bins.size());
+    append(buffer, changes.contents.data(), changes.contents.size());
+    append(buffer, changes.sumw2.data(), changes.sumw2.size());
+  }
+  return true;
+}
+
+void SparseDeltaEncoder::reset()
+{
+  for (auto& [name, previous] : mPrevious) {
+    std::fill(previous.contents.begin(), previous.contents.end(), 0);
+    std::fill(previous.sumw2.begin(), previous.sumw2.end(), 0);
+    std::fill(std::begin(previous.stats), std::end(previous.stats), 0);
+    previous.entries = 0;
+  }
+}
+
+namespace sparse_delta_helpers
+{
+
+bool isSparseDelta(const framework::DataRef& ref)
+{
+  auto header = o2::header::get<const o2::header::DataHeader*>(ref.header);
+  if (header == nullptr || header->payloadSerializationMethod != o2::header::gSerializationMethodNone ||
+      header->payloadSize < sizeof(SparseDeltaHeader)) {
+    return false;
+  }
+  uint32_t magic;
+  std::memcpy(&magic, ref.payload, sizeof(magic));
+  return magic == SparseDeltaHeader::MAGIC;
+}
+
+void apply(TObject* target, const char* buffer, size_t size)
+{
+  const static std::string errorPrefix = "Could not apply sparse delta: ";
+  if (target == nullptr) {
+    throw std::runtime_error(errorPrefix + "target is nullptr");
+  }
+  size_t offset = 0;
+  auto next = [&](size_t bytes) {
+    if (offset + bytes > size) {
+      throw std::runtime_error(errorPrefix + "the message is truncated");
+    }
+    auto position = buffer + offset;
+    offset += padded(bytes);
+    return position;
+  };
+
+  auto header = reinterpret_cast<SparseDeltaHeader const*>(next(sizeof(SparseDeltaHeader)));
+  if (header->magic != SparseDeltaHeader::MAGIC) {
+    throw std::runtime_error(errorPrefix + "it is not a sparse delta");
+  }
+  for (uint32_t h = 0; h < header->nHistograms; ++h) {
+    auto delta = reinterpret_cast<SparseHistogramDelta const*>(next(sizeof(SparseHistogramDelta)));
+    std::string name(next(delta->nameSize), delta->nameSize);
+    auto bins = reinterpret_cast<uint32_t const*>(next(delta->nChanged * sizeof(uint32_t)));
+    auto contents = reinterpret_cast<double const*>(next(delta->nChanged * sizeof(double)));
+    auto sumw2 = delta->hasSumw2 ? reinterpret_cast<double const*>(next(delta->nChanged * sizeof(double))) : nullptr;
+
+    TH1* histogram = findHistogram(target, name);
+    if (histogram == nullptr || !isSupported(histogram)) {
+      throw std::runtime_error(errorPrefix + "no supported histogram named '" + name + "' in the target");
+    }
+    if ((uint32_t)histogram->GetNcells() != delta->nCells) {
+      throw std::runtime_error(errorPrefix + "histogram '" + name + "' has " + std::to_string(histogram->GetNcells()) +
+                               " cells, while the delta has " + std::to_string(delta->nCells));
+    }
+    for (uint32_t i = 0; i < delta->nChanged; ++i) {
+      if (bins[i] >= delta->nCells) {
+        throw std::runtime_error(errorPrefix + "bin out of range in histogram '" + name + "'");
+      }
+    }
+    // The statistics are read before the bins change: ROOT recomputes them from the bin contents
+    // when fTsumw is 0, which would already include the delta.
+    double stats[SparseHistogramDelta::NSTAT] = {0};
+    histogram->GetStats(stats);
+    for (int i = 0; i < SparseHistogramDelta::NSTAT; ++i) {
+      stats[i] += delta->stats[i];
+    }
+    double entries = histogram->GetEntries() + delta->entries;
+
+    if (sumw2 != nullptr && histogram->GetSumw2N() == 0) {
+      histogram->Sumw2();
+    }
+
+    double* targetSumw2 = histogram->GetSumw2N() != 0 ? histogram->GetSumw2()->GetArray() : nullptr;
+    bool contentsAsSumw2 = targetSumw2 != nullptr && sumw2 == nullptr;
+    if (auto array = dynamic_cast<TArrayD*>(histogram)) {
+      addChanges(array->GetArray(), targetSumw2, contentsAsSumw2, bins, contents, sumw2, delta->nChanged);
+    } else {
+      addChanges(dynamic_cast<TArrayF*>(histogram)->GetArray(), targetSumw2, contentsAsSumw2, bins, contents, sumw2, delta->nChanged);
+    }
+
+    histogram->PutStats(stats);
+    histogram->SetEntries(entries);
+  }
+}
+
+void resetHistograms(TObject* object)
+{
+  if (auto collection = dynamic_cast<TCollection*>(object)) {
+    TIter next(collection);
+    while (auto member = next()) {
+      resetHistograms(member);
+    }
+  } else if (auto histogram = dynamic_cast<TH1*>(object)) {
+    histogram->Reset();
+  }
+}
+
+} // namespace sparse_delta_helpers
+
+} // namespace o2::mergers
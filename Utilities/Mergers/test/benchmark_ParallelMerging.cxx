@@ -0,0 +1,97 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_ParallelMerging.cxx
+/// \brief Merging a QC-like collection of large histograms coming from many producers:
+///        one by one with ROOT's Merge() versus all at once with algorithm::merge
+
+#include <benchmark/benchmark.h>
+
+#include "Mergers/MergerAlgorithm.h"
+
+#include <TObjArray.h>
+#include <TH1.h>
+#include <TH2.h>
+#include <TF2.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace o2::mergers;
+
+// A collection of TH2F of 500x500 bins, as published by one producer
+std::unique_ptr<TObjArray> makeCollection(size_t histograms, TF2& uni)
+{
+  auto collection = std::make_unique<TObjArray>();
+  collection->SetOwner(true);
+  for (size_t i = 0; i < histograms; i++) {
+    auto h = new TH2F(("histo" + std::to_string(i)).c_str(), "histo", 500, 0, 1000000, 500, 0, 1000000);
+    h->FillRandom("uni", 10000);
+    collection->Add(h);
+  }
+  return collection;
+}
+
+std::vector<std::unique_ptr<TObjArray>> makeCollections(size_t producers, size_t histograms)
+{
+  TF2 uni("uni", "1", 0, 1000000, 0, 1000000);
+  std::vector<std::unique_ptr<TObjArray>> collections;
+  for (size_t p = 0; p < producers; p++) {
+    collections.push_back(makeCollection(histograms, uni));
+  }
+  return collections;
+}
+
+// How merging was done before: each collection on its own, each histogram found by name and merged with TH1::Merge
+static void BM_MergeOneByOne(benchmark::State& state)
+{
+  auto collections = makeCollections(state.range(0), state.range(1));
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::unique_ptr<TObjArray> target{static_cast<TObjArray*>(collections[0]->Clone())};
+    target->SetOwner(true);
+    state.ResumeTiming();
+    for (size_t ci = 1; ci < collections.size(); ++ci) {
+      TIter otherIterator(collections[ci].get());
+      while (auto otherObject = otherIterator()) {
+        auto targetObject = static_cast<TH1*>(target->FindObject(otherObject->GetName()));
+        TObjArray otherCollection;
+        otherCollection.Add(otherObject);
+        targetObject->Merge(&otherCollection);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (collections.size() - 1) * state.range(1));
+}
+
+// All the collections at once, with bins added by state.range(2) threads
+static void BM_MergeAtOnce(benchmark::State& state)
+{
+  auto collections = makeCollections(state.range(0), state.range(1));
+  std::vector<TObject*> others;
+  for (size_t ci = 1; ci < collections.size(); ++ci) {
+    others.push_back(collections[ci].get());
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::unique_ptr<TObjArray> target{static_cast<TObjArray*>(collections[0]->Clone())};
+    target->SetOwner(true);
+    state.ResumeTiming();
+    algorithm::merge(target.get(), others, state.range(2));
+  }
+  state.SetItemsProcessed(state.iterations() * others.size() * state.range(1));
+}
+
+BENCHMARK(BM_MergeOneByOne)->Args({16, 50})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MergeAtOnce)->Args({16, 50, 1})->Args({16, 50, 2})->Args({16, 50, 4})->Args({16, 50, 8})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
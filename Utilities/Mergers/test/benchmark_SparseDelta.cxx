@@ -0,0 +1,105 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_SparseDelta.cxx
+/// \brief Transporting the differences of a collection of histograms from a producer to a Merger:
+///        ROOT-serialized objects merged with algorithm::merge versus sparse deltas applied in place
+
+#include <benchmark/benchmark.h>
+
+#include "Mergers/MergerAlgorithm.h"
+#include "Mergers/ObjectStore.h"
+#include "Mergers/SparseDelta.h"
+#include "Framework/TMessageSerializer.h"
+
+#include <TObjArray.h>
+#include <TH2.h>
+#include <TMessage.h>
+#include <TRandom.h>
+
+#include <memory>
+#include <vector>
+
+using namespace o2::mergers;
+
+// A collection of TH2F of 500x500 bins, as published by one producer
+std::unique_ptr<TObjArray> makeCollection(size_t histograms)
+{
+  auto collection = std::make_unique<TObjArray>();
+  collection->SetOwner(true);
+  for (size_t i = 0; i < histograms; i++) {
+    collection->Add(new TH2F(("histo" + std::to_string(i)).c_str(), "histo", 500, 0, 1000000, 500, 0, 1000000));
+  }
+  return collection;
+}
+
+void fill(TObjArray* collection, size_t entries)
+{
+  TIter next(collection);
+  while (auto histogram = static_cast<TH2F*>(next())) {
+    for (size_t e = 0; e < entries; ++e) {
+      histogram->Fill(gRandom->Uniform(0, 1000000), gRandom->Uniform(0, 1000000));
+    }
+  }
+}
+
+// The producer resets its objects after each publication and sends them with ROOT serialization,
+// the Merger deserializes and merges them.
+static void BM_FullObjects(benchmark::State& state)
+{
+  auto producer = makeCollection(state.range(0));
+  auto merged = makeCollection(state.range(0));
+  size_t bytes = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    producer = makeCollection(state.range(0));
+    fill(producer.get(), state.range(1));
+    state.ResumeTiming();
+
+    TMessage message(kMESS_OBJECT);
+    message.WriteObject(producer.get());
+    bytes += message.Length();
+
+    o2::framework::FairTMessage ftm(message.Buffer(), message.BufferSize());
+    TObjectPtr received{static_cast<TObject*>(ftm.ReadObjectAny(ftm.GetClass())), algorithm::deleteTCollections};
+    algorithm::merge(merged.get(), received.get());
+  }
+  state.counters["bytes_per_cycle"] = benchmark::Counter(bytes / (double)state.iterations());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The producer accumulates its objects and sends only the bins which changed, which the Merger adds in place.
+static void BM_SparseDeltas(benchmark::State& state)
+{
+  auto producer = makeCollection(state.range(0));
+  auto merged = makeCollection(state.range(0));
+  SparseDeltaEncoder encoder;
+  std::vector<char> buffer;
+  encoder.encode(producer.get(), buffer);
+  size_t bytes = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    fill(producer.get(), state.range(1));
+    state.ResumeTiming();
+
+    encoder.encode(producer.get(), buffer);
+    bytes += buffer.size();
+    sparse_delta_helpers::apply(merged.get(), buffer.data(), buffer.size());
+  }
+  state.counters["bytes_per_cycle"] = benchmark::Counter(bytes / (double)state.iterations());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 20 histograms with 250k bins, filled with 100, 10k and 100k entries per cycle
+BENCHMARK(BM_FullObjects)->Args({20, 100})->Args({20, 10000})->Args({20, 100000})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SparseDeltas)->Args({20, 100})->Args({20, 10000})->Args({20, 100000})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
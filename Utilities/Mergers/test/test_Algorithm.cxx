@@ -329,3 +329,102 @@ BOOST_AUTO_TEST_CASE(Deleting)
   // I am afraid we can't check more than that.
   BOOST_CHECK_NO_THROW(algorithm::deleteTCollections(main));
 }
+
+BOOST_AUTO_TEST_CASE(MergerManyHistogramsBinWise)
+{
+  // Histograms with the same binning are added bin by bin, the result must match TH1::Merge
+  auto makeHistograms = [](const char* name) {
+    std::vector<TH1*> histograms;
+    histograms.push_back(new TH1D(name, name, 100000, 0, 1));
+    histograms.push_back(new TH2F((std::string(name) + "2d").c_str(), name, 300, 0, 1, 300, 0, 1));
+    histograms.back()->Sumw2();
+    return histograms;
+  };
+  auto reference = makeHistograms("reference");
+  auto target = makeHistograms("target");
+  std::vector<std::vector<TH1*>> others;
+  for (int oi = 0; oi < 5; ++oi) {
+    others.push_back(makeHistograms(("other" + std::to_string(oi)).c_str()));
+  }
+  for (size_t hi = 0; hi < target.size(); ++hi) {
+    for (int i = 0; i < 1000; ++i) {
+      reference[hi]->Fill(0.001 * i, 0.002 * i);
+      target[hi]->Fill(0.001 * i, 0.002 * i);
+    }
+    for (size_t oi = 0; oi < others.size(); ++oi) {
+      for (int i = 0; i < 1000; ++i) {
+        others[oi][hi]->Fill(0.0005 * i * (oi + 1), 0.0003 * i + 0.1 * oi);
+      }
+      TObjArray list;
+      list.Add(others[oi][hi]);
+      reference[hi]->Merge(&list);
+    }
+    std::vector<TObject*> otherObjects;
+    for (auto& other : others) {
+      otherObjects.push_back(other[hi]);
+    }
+    BOOST_CHECK_NO_THROW(algorithm::merge(target[hi], otherObjects, 4));
+
+    BOOST_CHECK_EQUAL(target[hi]->GetEntries(), reference[hi]->GetEntries());
+    BOOST_CHECK_CLOSE(target[hi]->GetMean(), reference[hi]->GetMean(), 1e-9);
+    BOOST_CHECK_CLOSE(target[hi]->GetStdDev(), reference[hi]->GetStdDev(), 1e-9);
+    for (int bin = 0; bin < target[hi]->GetNcells(); ++bin) {
+      BOOST_REQUIRE_EQUAL(target[hi]->GetBinContent(bin), reference[hi]->GetBinContent(bin));
+      BOOST_REQUIRE_EQUAL(target[hi]->GetBinError(bin), reference[hi]->GetBinError(bin));
+    }
+  }
+  for (auto& histograms : others) {
+    for (auto h : histograms) {
+      delete h;
+    }
+  }
+  for (size_t hi = 0; hi < target.size(); ++hi) {
+    delete target[hi];
+    delete reference[hi];
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MergerManyCollections)
+{
+  // Collections with different layouts are merged as if merged one by one
+  TObjArray* target = new TObjArray();
+  target->SetOwner(true);
+  target->Add(new TH1F("a", "a", bins, min, max));
+  target->Add(new TH1F("b", "b", bins, min, max));
+  target->Add(new CustomMergeableTObject("custom", 9000));
+
+  std::vector<TObject*> others;
+  for (int oi = 0; oi < 3; ++oi) {
+    auto* other = new TList();
+    other->SetOwner(true);
+    // Different order, a histogram of a different type and one missing in the target
+    other->Add(new TH1F("b", "b", bins, min, max));
+    other->Add(new TH1D("a", "a", bins, min, max));
+    other->Add(new CustomMergeableTObject("custom", 1));
+    other->Add(new TH1F("c", "c", bins, min, max));
+    static_cast<TH1*>(other->At(0))->Fill(1);
+    static_cast<TH1*>(other->At(1))->Fill(2);
+    static_cast<TH1*>(other->At(3))->Fill(3);
+    others.push_back(other);
+  }
+
+  BOOST_CHECK_NO_THROW(algorithm::merge(target, others, 2));
+  for (auto other : others) {
+    delete other;
+  }
+
+  BOOST_REQUIRE_EQUAL(target->GetEntries(), 4);
+  auto a = dynamic_cast<TH1F*>(target->FindObject("a"));
+  auto b = dynamic_cast<TH1F*>(target->FindObject("b"));
+  auto c = dynamic_cast<TH1F*>(target->FindObject("c"));
+  BOOST_REQUIRE(a && b && c);
+  BOOST_CHECK_EQUAL(a->GetBinContent(a->FindBin(2)), 3);
+  BOOST_CHECK_EQUAL(b->GetBinContent(b->FindBin(1)), 3);
+  BOOST_CHECK_EQUAL(c->GetBinContent(c->FindBin(3)), 3);
+  BOOST_CHECK_EQUAL(c->GetEntries(), 3);
+  auto custom = dynamic_cast<CustomMergeableTObject*>(target->FindObject("custom"));
+  BOOST_REQUIRE(custom != nullptr);
+  BOOST_CHECK_EQUAL(custom->getSecret(), 9003);
+
+  delete target;
+}
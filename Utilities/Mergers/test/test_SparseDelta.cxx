@@ -0,0 +1,179 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Utilities MergerSparseDelta
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "Mergers/SparseDelta.h"
+#include "Headers/DataHeader.h"
+#include "Framework/DataRef.h"
+
+#include <TObjArray.h>
+#include <TH1F.h>
+#include <TH2D.h>
+#include <TH1I.h>
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+
+using namespace o2::framework;
+using namespace o2::mergers;
+
+void checkEqual(TH1* a, TH1* b)
+{
+  BOOST_REQUIRE_EQUAL(a->GetNcells(), b->GetNcells());
+  for (int i = 0; i < a->GetNcells(); ++i) {
+    BOOST_CHECK_EQUAL(a->GetBinContent(i), b->GetBinContent(i));
+    BOOST_CHECK_CLOSE(a->GetBinError(i), b->GetBinError(i), 1e-9);
+  }
+  BOOST_CHECK_EQUAL(a->GetEntries(), b->GetEntries());
+  BOOST_CHECK_CLOSE(a->GetMean(), b->GetMean(), 1e-9);
+  BOOST_CHECK_CLOSE(a->GetStdDev(), b->GetStdDev(), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(SparseDeltaCumulativeProducer)
+{
+  TObjArray producer;
+  producer.SetOwner(true);
+  auto h1 = new TH1F("h1", "h1", 100, 0, 100);
+  auto h2 = new TH2D("h2", "h2", 50, 0, 50, 50, 0, 50);
+  h2->Sumw2();
+  producer.Add(h1);
+  producer.Add(h2);
+  h1->Fill(5);
+  h2->Fill(1, 1, 2.);
+
+  SparseDeltaEncoder encoder;
+  std::vector<char> buffer;
+  // the first publication is the object itself
+  BOOST_CHECK(encoder.encode(&producer, buffer) == false);
+  std::unique_ptr<TObjArray> merged(dynamic_cast<TObjArray*>(producer.Clone()));
+  merged->SetOwner(true);
+
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    for (int i = 0; i < 10; ++i) {
+      h1->Fill(10 * cycle + i);
+      h2->Fill(cycle, i, 0.5 * i);
+    }
+    BOOST_REQUIRE(encoder.encode(&producer, buffer));
+    sparse_delta_helpers::apply(merged.get(), buffer.data(), buffer.size());
+  }
+  checkEqual(dynamic_cast<TH1*>(merged->FindObject("h1")), h1);
+  checkEqual(dynamic_cast<TH1*>(merged->FindObject("h2")), h2);
+
+  // nothing changed, only the headers are sent
+  BOOST_REQUIRE(encoder.encode(&producer, buffer));
+  BOOST_CHECK_LT(buffer.size(), 2 * (sizeof(SparseHistogramDelta) + 8) + sizeof(SparseDeltaHeader) + 8);
+}
+
+BOOST_AUTO_TEST_CASE(SparseDeltaResettingProducer)
+{
+  TH1F producer("histo", "histo", 1000, 0, 1000);
+  TH1F reference("histo", "histo", 1000, 0, 1000);
+  TH1F merged("histo", "histo", 1000, 0, 1000);
+
+  SparseDeltaEncoder encoder;
+  std::vector<char> buffer;
+  BOOST_CHECK(encoder.encode(&producer, buffer) == false);
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    producer.Reset();
+    encoder.reset();
+    for (int i = 0; i < 5; ++i) {
+      producer.Fill(100 * cycle + i);
+      reference.Fill(100 * cycle + i);
+    }
+    BOOST_REQUIRE(encoder.encode(&producer, buffer));
+    sparse_delta_helpers::apply(&merged, buffer.data(), buffer.size());
+  }
+  checkEqual(&merged, &reference);
+
+  sparse_delta_helpers::resetHistograms(&merged);
+  BOOST_CHECK_EQUAL(merged.GetEntries(), 0);
+  BOOST_CHECK_EQUAL(merged.GetBinContent(1), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SparseDeltaTargetWithoutEntriesInRange)
+{
+  // the merged histogram has entries, but only in the underflow bin, so ROOT computes its statistics from the bins
+  TH1F producer("histo", "histo", 10, 0, 10);
+  producer.Fill(-1);
+
+  SparseDeltaEncoder encoder;
+  std::vector<char> buffer;
+  BOOST_CHECK(encoder.encode(&producer, buffer) == false);
+  std::unique_ptr<TH1F> merged(dynamic_cast<TH1F*>(producer.Clone()));
+
+  producer.Fill(3);
+  producer.Fill(4, 2.);
+  BOOST_REQUIRE(encoder.encode(&producer, buffer));
+  sparse_delta_helpers::apply(merged.get(), buffer.data(), buffer.size());
+  checkEqual(merged.get(), &producer);
+
+  double mergedStats[SparseHistogramDelta::NSTAT] = {0};
+  double producerStats[SparseHistogramDelta::NSTAT] = {0};
+  merged->GetStats(mergedStats);
+  producer.GetStats(producerStats);
+  // sum of weights, of squared weights, of w * x and of w * x^2, the rest is unused for 1D histograms
+  for (int i = 0; i < 4; ++i) {
+    BOOST_CHECK_CLOSE(mergedStats[i], producerStats[i], 1e-9);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SparseDeltaErrors)
+{
+  SparseDeltaEncoder encoder;
+  std::vector<char> buffer;
+
+  TH1I unsupported("histo", "histo", 10, 0, 10);
+  BOOST_CHECK_THROW(encoder.encode(&unsupported, buffer), std::runtime_error);
+
+  TH1F producer("histo", "histo", 10, 0, 10);
+  BOOST_CHECK(encoder.encode(&producer, buffer) == false);
+  producer.Fill(1);
+  BOOST_REQUIRE(encoder.encode(&producer, buffer));
+
+  TH1F otherBinning("histo", "histo", 20, 0, 10);
+  BOOST_CHECK_THROW(sparse_delta_helpers::apply(&otherBinning, buffer.data(), buffer.size()), std::runtime_error);
+  TH1F otherName("other", "other", 10, 0, 10);
+  BOOST_CHECK_THROW(sparse_delta_helpers::apply(&otherName, buffer.data(), buffer.size()), std::runtime_error);
+  TH1F target("histo", "histo", 10, 0, 10);
+  BOOST_CHECK_THROW(sparse_delta_helpers::apply(&target, buffer.data(), buffer.size() - 8), std::runtime_error);
+  BOOST_CHECK_EQUAL(target.GetEntries(), 0);
+
+  BOOST_CHECK_THROW(encoder.encode(&otherBinning, buffer), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(SparseDeltaDataRef)
+{
+  TH1F producer("histo", "histo", 10, 0, 10);
+  SparseDeltaEncoder encoder;
+  std::vector<char> buffer;
+  encoder.encode(&producer, buffer);
+  producer.Fill(1);
+  encoder.encode(&producer, buffer);
+
+  o2::header::DataHeader dh;
+  dh.payloadSerializationMethod = o2::header::gSerializationMethodNone;
+  dh.payloadSize = buffer.size();
+  DataRef ref;
+  ref.header = reinterpret_cast<char const*>(dh.data());
+  ref.payload = buffer.data();
+  BOOST_CHECK(sparse_delta_helpers::isSparseDelta(ref));
+
+  dh.payloadSerializationMethod = o2::header::gSerializationMethodROOT;
+  BOOST_CHECK(sparse_delta_helpers::isSparseDelta(ref) == false);
+
+  std::vector<char> notADelta(64, 0);
+  dh.payloadSerializationMethod = o2::header::gSerializationMethodNone;
+  ref.payload = notADelta.data();
+  BOOST_CHECK(sparse_delta_helpers::isSparseDelta(ref) == false);
+}
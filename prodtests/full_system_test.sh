@@ -46,6 +46,7 @@ RUNFIRSTORBIT=${RUNFIRSTORBIT:-0}
 FIRSTSAMPLEDORBIT=${FIRSTSAMPLEDORBIT:-0}
 FST_GENERATOR=${FST_GENERATOR:-pythia8hi}
 FST_MC_ENGINE=${FST_MC_ENGINE:-TGeant4}
+SHAREDGEOMETRY=${SHAREDGEOMETRY:-0} # Publish the material LUT and ITS/MFT matrices to shared memory, for all reconstruction devices to attach
 
 [ "$FIRSTSAMPLEDORBIT" -lt "$RUNFIRSTORBIT" ] && FIRSTSAMPLEDORBIT=$RUNFIRSTORBIT
 
@@ -58,6 +59,7 @@ JOBUTILS_MONITORMEM=ON
 # prepare some metrics file for the monitoring system
 METRICFILE=metrics.dat
 CONFIG="full_system_test_N${NEvents}"
+[ "0$SHAREDGEOMETRY" == "01" ] && CONFIG+="_sharedgeometry"
 HOST=`hostname`
 
 # include header information such as tested alidist tag and O2 tag
@@ -125,6 +127,14 @@ if [ "0$DISABLE_PROCESSING" == "01" ]; then
   exit 0
 fi
 
+if [ "0$SHAREDGEOMETRY" == "01" ]; then
+  # the devices attach to this image instead of loading the LUT file and extracting the matrices from TGeo
+  GEOMETRYIMAGE=o2geometryimage_$$
+  o2-geometry-image --publish --name $GEOMETRYIMAGE > geometryimage.log 2>&1 || { echo "Failed to publish the geometry image"; exit 1; }
+  trap 'o2-geometry-image --remove --name $GEOMETRYIMAGE' EXIT
+  export ALICEO2_GEOMETRY_IMAGE=$GEOMETRYIMAGE
+fi
+
 # We run the workflow in both CPU-only and With-GPU mode
 STAGES="NOGPU"
 if [ $ENABLE_GPU_TEST != "0" ]; then
@@ -189,6 +199,10 @@ for STAGE in $STAGES; do
     echo "maxmem_${STAGE},${TAG} value=${maxmem}" >> ${METRICFILE}
     echo "avgmem_${STAGE},${TAG} value=${avgmem}" >> ${METRICFILE}
 
+    # startup: total time the devices spent getting the material LUT (from the file or the geometry image)
+    matluttime=`grep -e "Material LUT taken from" ${logfile} | awk '{for (i = 1; i < NF; i++) if ($(i + 1) == "ms") t += $i} END {printf "%f", t}'`
+    echo "matluttime_${STAGE},${TAG} value=${matluttime}" >> ${METRICFILE}
+
     # some physics quantities
     tpctracks=`grep "gpu-reconstruction" ${logfile} | grep -e "found.*track" | awk '//{print $4}'`
     echo "tpctracks_${STAGE},${TAG} value=${tpctracks}" >> ${METRICFILE}
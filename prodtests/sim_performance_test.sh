@@ -10,6 +10,8 @@
 NEVENTS=${1:-"2"}
 # generator / take from second argument or default
 GEN=${2:-"pythia8pp"}
+# number of parallel event generators in the primary server / take from third argument or default
+NGENERATORS=${3:-"4"}
 
 # STARTSEED
 SEED=1234
@@ -137,5 +139,17 @@ echo "exceptioncount,${TAG} value=${EXCEPTIONCOUNT} " >> metrics.dat
 
 done # end loop over configurations engines
 
+### ------ event-parallel generation in the primary server
+### only the beam pipe is transported such that the walltime is dominated by the event generation
+GENCONFIG="${GEN}_N${NEVENTS}_PIPE"
+TAG="conf=${GENCONFIG},host=${HOST}${ALIDISTCOMMIT:+,alidist=$ALIDISTCOMMIT}${O2COMMIT:+,o2=$O2COMMIT}"
+gen_time_metrics="walltime_generation,${TAG} "
+for NGEN in 1 ${NGENERATORS}; do
+  SECONDS=0
+  o2-sim -n ${NEVENTS} -g ${GEN} -m PIPE --seed $SEED -j ${NGENERATORS} --nGenerators ${NGEN} --configKeyValues "GeneratorPythia8.concurrent=true" -o o2sim_${GENCONFIG}_G${NGEN} > log_${GENCONFIG}_G${NGEN} 2>&1
+  gen_time_metrics="${gen_time_metrics}ngen${NGEN}=${SECONDS},"
+done
+echo ${gen_time_metrics%,} >> metrics.dat
+
 # remove empty DPL files
 find ./ -size 0 -exec rm {} ';'
@@ -23,6 +23,7 @@
 #include <SimulationDataFormat/MCEventHeader.h>
 #include <SimulationDataFormat/Stack.h>
 #include <SimulationDataFormat/PrimaryChunk.h>
+#include <SimulationDataFormat/MCTrackFlatFile.h>
 #include <DetectorsCommonDataFormats/DetID.h>
 #include <DetectorsCommonDataFormats/NameConf.h>
 #include <gsl/gsl>
@@ -39,6 +40,7 @@
 #include <cassert>
 #include "FairSystemInfo.h"
 #include "Steer/InteractionSampler.h"
+#include "SimConfig/HitMergerParams.h"
 
 #include "O2HitMerger.h"
 #include "O2SimDevice.h"
@@ -63,6 +65,12 @@
 #include <vector>
 #include <csignal>
 #include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <deque>
+#include <chrono>
+#include <functional>
 #include <filesystem>
 
 #include "SimPublishChannelHelper.h"
@@ -109,14 +117,25 @@ class O2HitMerger : public FairMQDevice
   /// Default destructor
   ~O2HitMerger() override
   {
+    stopFlusher();
     FairSystemInfo sysinfo;
     LOG(INFO) << "TIME-STAMP " << mTimer.RealTime() << "\t";
     mTimer.Continue();
     LOG(INFO) << "MEM-STAMP " << sysinfo.GetCurrentMemory() / (1024. * 1024) << " "
               << sysinfo.GetMaxMemory() << " MB\n";
+    LOG(INFO) << "BUFFER-STAMP max buffered " << mMaxBufferedBytesSeen / (1024. * 1024) << " MB; backpressure applied "
+              << mBackpressureCount << " times for " << mBackpressureTime << " s";
   }
 
  private:
+  // the data of an event received in the flat format: the messages are kept as they arrived
+  // (indexed by the entry of the subevent in the event tree) and merged in place at flush time
+  struct FlatEventData {
+    std::vector<o2::base::FlatMessage> mctracks;
+    std::vector<o2::base::FlatMessage> trackrefs;
+    std::vector<o2::base::FlatHitStore> hits; // indexed by DetID
+  };
+
   /// Overloads the InitTask() method of FairMQDevice
   void InitTask() final
   {
@@ -125,17 +144,28 @@ class O2HitMerger : public FairMQDevice
     ROOT::EnableThreadSafety();
 
     std::string outfilename("o2sim_merged_hits.root"); // default name
+    std::string flatfilename("o2sim_merged_hits.dat"); // default name
     // query the sim config ... which is used to extract the filenames
     if (o2::devices::O2SimDevice::querySimConfig(fChannels.at("o2sim-primserv-info").at(0))) {
       outfilename = o2::base::NameConf::getMCKinematicsFileName(o2::conf::SimConfig::Instance().getOutPrefix().c_str());
+      flatfilename = o2::base::NameConf::getMCKinematicsFlatFileName(o2::conf::SimConfig::Instance().getOutPrefix());
       mNExpectedEvents = o2::conf::SimConfig::Instance().getNEvents();
+      // the merger parameters are given together with the other configurable params
+      o2::conf::ConfigurableParam::updateFromFile(o2::conf::SimConfig::Instance().getConfigFile());
+      o2::conf::ConfigurableParam::updateFromString(o2::conf::SimConfig::Instance().getKeyValueString());
     }
     mAsService = o2::conf::SimConfig::Instance().asService();
 
+    auto& mergerparams = o2::conf::HitMergerParams::Instance();
+    mNFlushThreads = std::max(1, mergerparams.nFlushThreads);
+    mMaxBufferedBytes = mergerparams.maxBufferedMB > 0 ? size_t(mergerparams.maxBufferedMB) * 1024 * 1024 : 0;
+    LOG(INFO) << "HIT MERGER FLUSHING WITH " << mNFlushThreads << " THREADS; MAX BUFFERED MB " << mergerparams.maxBufferedMB;
+
     mOutFileName = outfilename.c_str();
     mOutFile = new TFile(outfilename.c_str(), "RECREATE");
     mOutTree = new TTree("o2sim", "o2sim");
     mOutTree->SetDirectory(mOutFile);
+    openFlatKinematics(flatfilename);
 
     // detectors init only once
     if (mDetectorInstances.size() == 0) {
@@ -214,6 +244,7 @@ class O2HitMerger : public FairMQDevice
     mOutFile = new TFile(outfilename.c_str(), "RECREATE");
     mOutTree = new TTree("o2sim", "o2sim");
     mOutTree->SetDirectory(mOutFile);
+    openFlatKinematics(o2::base::NameConf::getMCKinematicsFlatFileName(reconfig.outputPrefix));
 
     // reinit detectorInstance files (also make sure they are closed before continuing)
     initHitFiles(reconfig.outputPrefix);
@@ -222,6 +253,12 @@ class O2HitMerger : public FairMQDevice
     mPartsCheckSum.clear();
     mEventToTTreeMap.clear();
     mEventToTMemFileMap.clear();
+    mEventToDetTTreeMap.clear();
+    mEventToDetTMemFileMap.clear();
+    mEventBufferedBytes.clear();
+    mBufferedBytes = 0;
+    mFlushableEvents.clear();
+    mNextFlushID = 1;
     mEntries = 0;
     mEventChecksum = 0;
     return true;
@@ -248,7 +285,7 @@ class O2HitMerger : public FairMQDevice
     return checksum == nparts * (nparts + 1) / 2;
   }
 
-  void consumeHits(int eventID, FairMQParts& data, int& index)
+  void consumeHits(int eventID, int entry, FairMQParts& data, int& index)
   {
     auto detIDmessage = std::move(data.At(index++));
     // this should be a detector ID
@@ -258,16 +295,49 @@ class O2HitMerger : public FairMQDevice
       LOG(DEBUG2) << "I1 " << ptr[0] << " NAME " << id.getName() << " MB "
                   << data.At(index)->GetSize() / 1024. / 1024.;
 
-      TTree* tree = mEventToTTreeMap[eventID];
-
       // get the detector that can interpret it
       auto detector = mDetectorInstances[id].get();
       if (detector) {
+        // flat hits are kept in their messages until the event is flushed
+        if (detector->adoptFlatHits(data, index, getFlatEventData(eventID).hits[id], entry)) {
+          return;
+        }
+        // every detector has its own tree per event, so that the detectors can be flushed independently
+        TTree* tree = getOrMakeDetectorEventTree(eventID, id);
         detector->fillHitBranch(*tree, data, index);
       }
     }
   }
 
+  FlatEventData& getFlatEventData(int eventID)
+  {
+    const std::lock_guard<std::mutex> lock(mMapsMtx);
+    auto& flatdata = mEventToFlatDataMap[eventID];
+    flatdata.hits.resize(mDetectorInstances.size());
+    return flatdata;
+  }
+
+  TTree* getOrMakeDetectorEventTree(int eventID, int detID)
+  {
+    const std::lock_guard<std::mutex> lock(mMapsMtx);
+    auto& trees = mEventToDetTTreeMap[eventID];
+    auto& files = mEventToDetTMemFileMap[eventID];
+    if (trees.size() == 0) {
+      trees.resize(mDetectorInstances.size(), nullptr);
+      files.resize(mDetectorInstances.size(), nullptr);
+    }
+    if (!trees[detID]) {
+      std::stringstream str;
+      str << "memfile" << eventID << "_" << o2::detectors::DetID::getName(detID);
+      files[detID] = new TMemFile(str.str().c_str(), "RECREATE");
+      std::stringstream trname;
+      trname << "o2sim" << eventID << "_" << o2::detectors::DetID::getName(detID);
+      trees[detID] = new TTree(trname.str().c_str(), trname.str().c_str());
+      trees[detID]->SetDirectory(files[detID]);
+    }
+    return trees[detID];
+  }
+
   template <typename T>
   void fillBranch(int eventID, std::string const& name, T* ptr)
   {
@@ -298,12 +368,30 @@ class O2HitMerger : public FairMQDevice
   template <typename T>
   void consumeData(int eventID, std::string name, FairMQParts& data, int& index)
   {
+    if (o2::base::isFlatMessage(data, index)) {
+      // adopt the message as it is, the entries of the event are merged from there at flush time
+      auto& flatdata = getFlatEventData(eventID);
+      auto& entries = name == "MCTrack" ? flatdata.mctracks : flatdata.trackrefs;
+      int entry = getCurrentEntry(eventID);
+      if ((int)entries.size() <= entry) {
+        entries.resize(entry + 1);
+      }
+      entries[entry] = o2::base::adoptFlatMessage(data, index++);
+      return;
+    }
     auto decodeddata = o2::base::decodeTMessage<T*>(data, index);
     fillBranch(eventID, name, decodeddata);
     delete decodeddata;
     index++;
   }
 
+  // the entry (subevent) of the event tree the data of the currently treated part goes to
+  int getCurrentEntry(int eventID)
+  {
+    const std::lock_guard<std::mutex> lock(mMapsMtx);
+    return mEventToTTreeMap[eventID]->GetEntries();
+  }
+
   // fills a special branch of SubEventInfos in order to keep
   // track of which entry corresponds to which event etc.
   // also creates the MCEventHeader branch expected for physics analysis
@@ -348,6 +436,9 @@ class O2HitMerger : public FairMQDevice
   bool ConditionalRun() override
   {
     auto& channel = fChannels.at("simdata").at(0);
+    // do not take more data from the workers while too much is waiting to be flushed;
+    // the workers then block on sending once the socket buffers are full
+    waitForBufferSpace();
     FairMQParts request;
     auto bytes = channel.Receive(request);
     if (bytes < 0) {
@@ -368,6 +459,11 @@ class O2HitMerger : public FairMQDevice
   {
     bool expectmore = true;
     int index = 0;
+    // the size of the incoming data is what we keep buffered for this event until it is flushed
+    size_t partbytes = 0;
+    for (int i = 0; i < data.Size(); ++i) {
+      partbytes += data.At(i)->GetSize();
+    }
     auto infoptr = o2::base::decodeTMessage<o2::data::SubEventInfo*>(data, index++);
     o2::data::SubEventInfo& info = *infoptr;
     auto accum = insertAdd<uint32_t, uint32_t>(mPartsCheckSum, info.eventID, (uint32_t)info.part);
@@ -375,29 +471,33 @@ class O2HitMerger : public FairMQDevice
     LOG(INFO) << "SIMDATA channel got " << data.Size() << " parts for event " << info.eventID << " part " << info.part << " out of " << info.nparts;
 
     fillSubEventInfoEntry(info);
+    const int entry = getCurrentEntry(info.eventID);
     consumeData<std::vector<o2::MCTrack>>(info.eventID, "MCTrack", data, index);
     consumeData<std::vector<o2::TrackReference>>(info.eventID, "TrackRefs", data, index);
     while (index < data.Size()) {
-      consumeHits(info.eventID, data, index);
+      consumeHits(info.eventID, entry, data, index);
     }
     // set the number of entries in the tree
-    auto tree = mEventToTTreeMap[info.eventID];
-    auto memfile = mEventToTMemFileMap[info.eventID];
-    tree->SetEntries(tree->GetEntries() + 1);
-    LOG(INFO) << "tree has file " << tree->GetDirectory()->GetFile()->GetName();
-    // memfile->Write("", TObject::kOverwrite);
+    {
+      const std::lock_guard<std::mutex> lock(mMapsMtx);
+      auto tree = mEventToTTreeMap[info.eventID];
+      tree->SetEntries(tree->GetEntries() + 1);
+      // the detector trees follow the event tree, also when a detector did not send data with this part
+      for (auto dettree : mEventToDetTTreeMap[info.eventID]) {
+        if (dettree) {
+          dettree->SetEntries(tree->GetEntries());
+        }
+      }
+      LOG(INFO) << "tree has file " << tree->GetDirectory()->GetFile()->GetName();
+    }
+    accountBufferedBytes(info.eventID, partbytes);
     mEntries++;
 
     if (isDataComplete<uint32_t>(accum, info.nparts)) {
       LOG(INFO) << "EVERYTHING IS HERE FOR EVENT " << info.eventID << "\n";
 
-      // check if previous flush finished
-      if (mMergerIOThread.joinable()) {
-        mMergerIOThread.join();
-      }
-
-      // start hit merging and flushing in a separate thread in order not to block
-      mMergerIOThread = std::thread([info, this]() { mergeAndFlushData(info.eventID); });
+      // hand the event to the flushing thread in order not to block
+      scheduleFlush(info.eventID);
 
       mEventChecksum += info.eventID;
       // we also need to check if we have all events
@@ -405,9 +505,8 @@ class O2HitMerger : public FairMQDevice
         LOG(INFO) << "ALL EVENTS HERE; CHECKSUM " << mEventChecksum;
 
         // flush remaining data and close file
-        if (mMergerIOThread.joinable()) {
-          mMergerIOThread.join();
-        }
+        stopFlusher();
+        mFlatKinematics.close();
 
         expectmore = false;
       }
@@ -427,13 +526,144 @@ class O2HitMerger : public FairMQDevice
 
   void cleanEvent(int eventID)
   {
-    // remove tree for that eventID
-    const std::lock_guard<std::mutex> lock(mMapsMtx);
-    // mEventToTMemFileMap[eventID]->Close();
-    delete mEventToTTreeMap[eventID];
-    delete mEventToTMemFileMap[eventID];
-    mEventToTTreeMap.erase(eventID);
-    mEventToTMemFileMap.erase(eventID); // remove memfile
+    {
+      // remove tree for that eventID
+      const std::lock_guard<std::mutex> lock(mMapsMtx);
+      // mEventToTMemFileMap[eventID]->Close();
+      delete mEventToTTreeMap[eventID];
+      delete mEventToTMemFileMap[eventID];
+      mEventToTTreeMap.erase(eventID);
+      mEventToTMemFileMap.erase(eventID); // remove memfile
+      for (auto dettree : mEventToDetTTreeMap[eventID]) {
+        delete dettree;
+      }
+      for (auto detfile : mEventToDetTMemFileMap[eventID]) {
+        delete detfile;
+      }
+      mEventToDetTTreeMap.erase(eventID);
+      mEventToDetTMemFileMap.erase(eventID);
+      mEventToFlatDataMap.erase(eventID); // releases the adopted messages
+    }
+    releaseBufferedBytes(eventID);
+  }
+
+  void accountBufferedBytes(int eventID, size_t bytes)
+  {
+    const std::lock_guard<std::mutex> lock(mFlushMtx);
+    mEventBufferedBytes[eventID] += bytes;
+    mBufferedBytes += bytes;
+    mMaxBufferedBytesSeen = std::max(mMaxBufferedBytesSeen, mBufferedBytes);
+  }
+
+  void releaseBufferedBytes(int eventID)
+  {
+    {
+      const std::lock_guard<std::mutex> lock(mFlushMtx);
+      auto iter = mEventBufferedBytes.find(eventID);
+      if (iter != mEventBufferedBytes.end()) {
+        mBufferedBytes -= iter->second;
+        mEventBufferedBytes.erase(iter);
+      }
+    }
+    mFlushCV.notify_all();
+  }
+
+  // blocks the receiving of new data as long as more than mMaxBufferedBytes are waiting to be flushed
+  // and the flushing thread is making progress; if the flusher is idle the buffered events wait for an
+  // earlier event which still has to arrive, so we must keep on receiving
+  void waitForBufferSpace()
+  {
+    if (mMaxBufferedBytes == 0) {
+      return;
+    }
+    std::unique_lock<std::mutex> lock(mFlushMtx);
+    auto canReceive = [this]() { return mBufferedBytes <= mMaxBufferedBytes || (mFlushQueue.empty() && !mFlushing); };
+    if (canReceive()) {
+      return;
+    }
+    mBackpressureCount++;
+    auto start = std::chrono::steady_clock::now();
+    auto timeout = std::chrono::seconds(std::max(1, o2::conf::HitMergerParams::Instance().backpressureTimeout));
+    while (!mFlushCV.wait_for(lock, timeout, canReceive)) {
+      LOG(WARN) << "Hit merger waiting for flush; " << mBufferedBytes / (1024. * 1024) << " MB buffered";
+    }
+    mBackpressureTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  // queues a complete event for merging and flushing, starting the flushing thread if needed
+  void scheduleFlush(int eventID)
+  {
+    {
+      const std::lock_guard<std::mutex> lock(mFlushMtx);
+      mFlushQueue.push_back(eventID);
+      if (!mMergerIOThread.joinable()) {
+        mStopFlusher = false;
+        mMergerIOThread = std::thread([this]() { flushLoop(); });
+      }
+    }
+    mFlushCV.notify_all();
+  }
+
+  void flushLoop()
+  {
+    std::unique_lock<std::mutex> lock(mFlushMtx);
+    while (true) {
+      mFlushCV.wait(lock, [this]() { return !mFlushQueue.empty() || mStopFlusher; });
+      if (mFlushQueue.empty()) {
+        break; // stop requested and nothing left to do
+      }
+      auto eventID = mFlushQueue.front();
+      mFlushQueue.pop_front();
+      mFlushing = true;
+      lock.unlock();
+      mergeAndFlushData(eventID);
+      lock.lock();
+      mFlushing = false;
+      mFlushCV.notify_all();
+    }
+  }
+
+  // the flat kinematics file gets the same events as the kinematics tree (if requested)
+  void openFlatKinematics(std::string const& filename)
+  {
+    mFlatKinematics.close();
+    if (o2::conf::HitMergerParams::Instance().flatKinematics) {
+      mFlatKinematics.open(filename);
+    }
+  }
+
+  // waits until all queued events are treated and terminates the flushing thread
+  void stopFlusher()
+  {
+    {
+      const std::lock_guard<std::mutex> lock(mFlushMtx);
+      mStopFlusher = true;
+    }
+    mFlushCV.notify_all();
+    if (mMergerIOThread.joinable()) {
+      mMergerIOThread.join();
+    }
+    const std::lock_guard<std::mutex> lock(mFlushMtx);
+    mStopFlusher = false;
+  }
+
+  // runs the tasks on up to mNFlushThreads threads (the calling one included)
+  void runParallel(std::vector<std::function<void()>> const& tasks)
+  {
+    std::atomic<int> next{0};
+    auto worker = [&tasks, &next]() {
+      for (int i = next++; i < (int)tasks.size(); i = next++) {
+        tasks[i]();
+      }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < std::min<int>(mNFlushThreads, tasks.size()); ++i) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : threads) {
+      t.join();
+    }
   }
 
   template <typename T>
@@ -442,13 +672,52 @@ class O2HitMerger : public FairMQDevice
     std::copy(from.begin(), from.end(), std::back_inserter(to));
   }
 
-  void reorderAndMergeMCTRacks(TTree& origin, TTree& target, const std::vector<int>& nprimaries, const std::vector<int>& nsubevents)
+  // reads the entries (subevents) of a branch of an in-memory event tree
+  template <typename T>
+  class TreeEntryReader
+  {
+   public:
+    TreeEntryReader(TTree& tree, const char* brname) : mBranch(tree.GetBranch(brname))
+    {
+      if (mBranch) {
+        mBranch->SetAddress(&mData);
+      }
+    }
+    ~TreeEntryReader()
+    {
+      if (mBranch) {
+        mBranch->ResetAddress();
+      }
+      delete mData;
+    }
+    gsl::span<const T> operator()(int entry)
+    {
+      delete mData;
+      mData = nullptr;
+      if (mBranch) {
+        mBranch->GetEntry(entry);
+      }
+      return mData ? gsl::span<const T>(*mData) : gsl::span<const T>();
+    }
+
+   private:
+    TBranch* mBranch = nullptr;
+    std::vector<T>* mData = nullptr;
+  };
+
+  // reads the entries (subevents) from flat messages adopted for an event.
+  // The entries point into the received message buffers, hence they are read-only:
+  // the merging copies the data to its output before modifying it.
+  template <typename T>
+  static auto flatEntryReader(std::vector<o2::base::FlatMessage> const& messages)
+  {
+    return [&messages](int entry) { return entry < (int)messages.size() ? messages[entry].asSpan<const T>() : gsl::span<const T>(); };
+  }
+
+  template <typename EntryReader>
+  void reorderAndMergeMCTRacks(EntryReader&& getEntry, int entries, TTree& target, const std::vector<int>& nprimaries, const std::vector<int>& nsubevents)
   {
-    std::vector<MCTrack>* incomingdata = nullptr;
     auto targetdata = new std::vector<MCTrack>;
-    auto originbr = origin.GetBranch("MCTrack");
-    originbr->SetAddress(&incomingdata);
-    const auto entries = origin.GetEntries();
     //
     // loop over subevents to store the primary events
     //
@@ -456,19 +725,16 @@ class O2HitMerger : public FairMQDevice
     for (auto entry = entries - 1; entry >= 0; --entry) {
       int index = nsubevents[entry];
       nprimTot += nprimaries[index];
-      printf("merge %lld %5d %5d %5d \n", entry, index, nsubevents[entry], nsubevents[index]);
-      originbr->GetEntry(index);
+      printf("merge %d %5d %5d %5d \n", entry, index, nsubevents[entry], nsubevents[index]);
+      auto incomingdata = getEntry(index);
       for (Int_t i = 0; i < nprimaries[index]; i++) {
-        auto& track = incomingdata->at(i);
+        targetdata->push_back(incomingdata[i]);
+        auto& track = targetdata->back();
         if (track.isTransported()) { // reset daughters only if track was transported, it will be fixed below
           track.SetFirstDaughterTrackId(-1);
           track.SetLastDaughterTrackId(-1);
         }
-        targetdata->push_back(track);
       }
-      incomingdata->clear();
-      delete incomingdata;
-      incomingdata = nullptr;
     }
     //
     // loop a second time to store the secondaries and fix the mother track IDs
@@ -478,22 +744,19 @@ class O2HitMerger : public FairMQDevice
     for (auto entry = entries - 1; entry >= 0; --entry) {
       int index = nsubevents[entry];
 
-      originbr->GetEntry(index);
+      auto incomingdata = getEntry(index);
 
-      Int_t npart = (int)(incomingdata->size());
+      Int_t npart = (int)(incomingdata.size());
       Int_t nprim = nprimaries[index];
       idelta1 -= nprim;
 
       for (Int_t i = nprim; i < npart; i++) {
-        auto& track = incomingdata->at(i);
-        Int_t cId = track.getMotherTrackId();
+        Int_t cId = incomingdata[i].getMotherTrackId();
         if (cId >= nprim) {
           cId += idelta1;
         } else {
           cId += idelta0;
         }
-        track.SetMotherTrackId(cId);
-        track.SetFirstDaughterTrackId(-1);
 
         Int_t hwm = (int)(targetdata->size());
         auto& mother = targetdata->at(cId);
@@ -502,13 +765,17 @@ class O2HitMerger : public FairMQDevice
         }
         mother.SetLastDaughterTrackId(hwm);
 
-        targetdata->push_back(track);
+        targetdata->push_back(incomingdata[i]);
+        auto& track = targetdata->back();
+        track.SetMotherTrackId(cId);
+        track.SetFirstDaughterTrackId(-1);
       }
       idelta0 += nprim;
       idelta1 += npart;
-      incomingdata->clear();
-      delete incomingdata;
-      incomingdata = nullptr;
+    }
+
+    if (mFlatKinematics.isOpen()) {
+      mFlatKinematics.addEvent(*targetdata);
     }
 
     //
@@ -517,11 +784,11 @@ class O2HitMerger : public FairMQDevice
     targetbr->SetAddress(&targetdata);
     targetbr->Fill();
     targetbr->ResetAddress();
-    targetdata->clear();
+    delete targetdata;
   }
 
-  template <typename T>
-  void remapTrackIdsAndMerge(std::string brname, TTree& origin, TTree& target,
+  template <typename T, typename EntryReader>
+  void remapTrackIdsAndMerge(std::string brname, EntryReader&& getEntry, int entries, TTree& target,
                              const std::vector<int>& trackoffsets, const std::vector<int>& nprimaries, const std::vector<int>& subevOrdered)
   {
     //
@@ -529,16 +796,12 @@ class O2HitMerger : public FairMQDevice
     // The offset calculated as the sum of the number of entries in the particle list of the previous subevents.
     // This method is called by O2HitMerger::mergeAndFlushData(int)
     //
-    T* incomingdata = nullptr;
-    auto targetdata = new T;
-    auto originbr = origin.GetBranch(brname.c_str());
-    originbr->SetAddress(&incomingdata);
-    const auto entries = origin.GetEntries();
+    auto targetdata = new std::vector<T>;
 
     if (entries == 1) {
-      // nothing to do in case there is only one entry
-      originbr->GetEntry(0);
-      targetdata = incomingdata;
+      // nothing to remap in case there is only one entry
+      auto incomingdata = getEntry(0);
+      targetdata->assign(incomingdata.begin(), incomingdata.end());
     } else {
       // loop over subevents
       Int_t nprimTot = 0;
@@ -550,24 +813,20 @@ class O2HitMerger : public FairMQDevice
       for (auto entry = entries - 1; entry >= 0; --entry) {
         Int_t index = subevOrdered[entry];
         Int_t nprim = nprimaries[index];
-        originbr->GetEntry(index);
         idelta1 -= nprim;
-        for (auto& data : *incomingdata) {
-          updateTrackIdWithOffset(data, nprim, idelta0, idelta1);
+        for (auto const& data : getEntry(index)) {
           targetdata->push_back(data);
+          updateTrackIdWithOffset(targetdata->back(), nprim, idelta0, idelta1);
         }
-        incomingdata->clear();
         idelta0 += nprim;
         idelta1 += trackoffsets[index];
-        delete incomingdata;
-        incomingdata = nullptr;
       }
     }
     auto targetbr = o2::base::getOrMakeBranch(target, brname.c_str(), &targetdata);
     targetbr->SetAddress(&targetdata);
     targetbr->Fill();
     targetbr->ResetAddress();
-    targetdata->clear();
+    delete targetdata;
   }
 
   void updateTrackIdWithOffset(MCTrack& track, Int_t nprim, Int_t idelta0, Int_t idelta1)
@@ -644,10 +903,13 @@ class O2HitMerger : public FairMQDevice
 
   // This method goes over the tree containing data for a given event; potentially merges
   // it and flushes it into the actual output file.
-  // The method can be called asynchronously to data collection
+  // The method is called from the flushing thread, asynchronously to data collection;
+  // the kinematics and the hits of the different detectors are merged and written in parallel
   bool mergeAndFlushData(int eventID)
   {
     auto checkIfNextFlushable = [this]() -> bool {
+      // the flushed event is done with, its flag is not kept for the whole run
+      mFlushableEvents.erase(mNextFlushID);
       mNextFlushID++;
       return mFlushableEvents.find(mNextFlushID) != mFlushableEvents.end() && mFlushableEvents[mNextFlushID] == true;
     };
@@ -659,19 +921,36 @@ class O2HitMerger : public FairMQDevice
     while (canflush == true) {
       auto flusheventID = mNextFlushID;
       LOG(INFO) << "Merge and flush event " << flusheventID;
-      auto tree = mEventToTTreeMap[flusheventID];
+      TTree* tree = nullptr;
+      std::vector<TTree*> dettrees;
+      FlatEventData* flatdata = nullptr;
+      {
+        const std::lock_guard<std::mutex> lock(mMapsMtx);
+        auto iter = mEventToTTreeMap.find(flusheventID);
+        tree = iter != mEventToTTreeMap.end() ? iter->second : nullptr;
+        auto detiter = mEventToDetTTreeMap.find(flusheventID);
+        if (detiter != mEventToDetTTreeMap.end()) {
+          dettrees = detiter->second;
+        }
+        auto flatiter = mEventToFlatDataMap.find(flusheventID);
+        flatdata = flatiter != mEventToFlatDataMap.end() ? &flatiter->second : nullptr;
+      }
+      dettrees.resize(mDetectorInstances.size(), nullptr);
       if (!tree) {
         LOG(INFO) << "NO TTREE FOUND FOR EVENT " << flusheventID;
         if (!checkIfNextFlushable()) {
           return false;
         }
+        continue;
       }
 
       if (tree->GetEntries() == 0 || mNExpectedEvents == 0) {
         LOG(INFO) << "NO ENTRY IN TTREE FOUND FOR EVENT " << flusheventID;
+        cleanEvent(flusheventID);
         if (!checkIfNextFlushable()) {
           return false;
         }
+        continue;
       }
 
       TStopwatch timer;
@@ -712,15 +991,10 @@ class O2HitMerger : public FairMQDevice
           if (!checkIfNextFlushable()) {
             return true;
           }
+          continue;
         }
       }
 
-      // put the event headers into the new TTree
-      auto headerbr = o2::base::getOrMakeBranch(*mOutTree, "MCEventHeader.", &eventheader);
-      headerbr->SetAddress(&eventheader);
-      headerbr->Fill();
-      headerbr->ResetAddress();
-
       // attention: We need to make sure that we write everything in the same event order
       // but iteration over keys of a standard map in C++ is ordered
 
@@ -734,9 +1008,32 @@ class O2HitMerger : public FairMQDevice
         printf("HitMerger entry: %lld nprimry: %5d trackoffset: %5d \n", entry, nprimaries[entry], trackoffsets[entry]);
       }
 
-      reorderAndMergeMCTRacks(*tree, *mOutTree, nprimaries, subevOrdered);
-      Int_t ioffset = 0;
-      remapTrackIdsAndMerge<std::vector<o2::TrackReference>>("TrackRefs", *tree, *mOutTree, trackoffsets, nprimaries, subevOrdered);
+      // every task below only touches its own output tree/file and its own input tree
+      std::vector<std::function<void()>> tasks;
+      tasks.emplace_back([&]() {
+        // put the event headers into the new TTree
+        auto headerbr = o2::base::getOrMakeBranch(*mOutTree, "MCEventHeader.", &eventheader);
+        headerbr->SetAddress(&eventheader);
+        headerbr->Fill();
+        headerbr->ResetAddress();
+
+        // the kinematics come either as adopted flat messages or in the event tree
+        if (flatdata && !flatdata->mctracks.empty()) {
+          reorderAndMergeMCTRacks(flatEntryReader<o2::MCTrack>(flatdata->mctracks), entries, *mOutTree, nprimaries, subevOrdered);
+        } else {
+          reorderAndMergeMCTRacks(TreeEntryReader<o2::MCTrack>(*tree, "MCTrack"), entries, *mOutTree, nprimaries, subevOrdered);
+        }
+        if (flatdata && !flatdata->trackrefs.empty()) {
+          remapTrackIdsAndMerge<o2::TrackReference>("TrackRefs", flatEntryReader<o2::TrackReference>(flatdata->trackrefs), entries, *mOutTree, trackoffsets, nprimaries, subevOrdered);
+        } else {
+          remapTrackIdsAndMerge<o2::TrackReference>("TrackRefs", TreeEntryReader<o2::TrackReference>(*tree, "TrackRefs"), entries, *mOutTree, trackoffsets, nprimaries, subevOrdered);
+        }
+
+        // increase the entry count in the tree
+        mOutTree->SetEntries(mOutTree->GetEntries() + 1);
+        LOG(INFO) << "outtree has file " << mOutTree->GetDirectory()->GetFile()->GetName();
+        mOutFile->Write("", TObject::kOverwrite);
+      });
 
       // c) do the merge procedure for all hits ... delegate this to detector specific functions
       // since they know about types; number of branches; etc.
@@ -744,18 +1041,19 @@ class O2HitMerger : public FairMQDevice
       for (int id = 0; id < mDetectorInstances.size(); ++id) {
         auto& det = mDetectorInstances[id];
         if (det) {
-          auto hittree = mDetectorToTTreeMap[id];
-          det->mergeHitEntries(*tree, *hittree, trackoffsets, nprimaries, subevOrdered);
-          hittree->SetEntries(hittree->GetEntries() + 1);
-          LOG(INFO) << "flushing tree to file " << hittree->GetDirectory()->GetFile()->GetName();
-          mDetectorOutFiles[id]->Write("", TObject::kOverwrite);
+          tasks.emplace_back([&, id]() {
+            auto hittree = mDetectorToTTreeMap[id];
+            const bool mergedflat = flatdata && !flatdata->hits[id].empty() && det->mergeFlatHitEntries(flatdata->hits[id], *hittree, trackoffsets, nprimaries, subevOrdered);
+            if (!mergedflat && dettrees[id]) {
+              det->mergeHitEntries(*dettrees[id], *hittree, trackoffsets, nprimaries, subevOrdered);
+            }
+            hittree->SetEntries(hittree->GetEntries() + 1);
+            LOG(INFO) << "flushing tree to file " << hittree->GetDirectory()->GetFile()->GetName();
+            mDetectorOutFiles[id]->Write("", TObject::kOverwrite);
+          });
         }
       }
-
-      // increase the entry count in the tree
-      mOutTree->SetEntries(mOutTree->GetEntries() + 1);
-      LOG(INFO) << "outtree has file " << mOutTree->GetDirectory()->GetFile()->GetName();
-      mOutFile->Write("", TObject::kOverwrite);
+      runParallel(tasks);
 
       cleanEvent(flusheventID);
       LOG(INFO) << "Merge/flush for event " << flusheventID << " took " << timer.RealTime();
@@ -770,16 +1068,34 @@ class O2HitMerger : public FairMQDevice
   std::string mOutFileName; //!
 
   // structures for the final flush
-  TFile* mOutFile;                                     //! outfile for kinematics
-  TTree* mOutTree;                                     //! tree (kinematics) associated to mOutFile
-  std::unordered_map<int, TFile*> mDetectorOutFiles;   //! outfiles per detector for hits
-  std::unordered_map<int, TTree*> mDetectorToTTreeMap; //! the trees
+  TFile* mOutFile;                                          //! outfile for kinematics
+  TTree* mOutTree;                                          //! tree (kinematics) associated to mOutFile
+  o2::dataformats::MCTrackFlatFile::Writer mFlatKinematics; //! flat copy of the MCTracks of mOutTree (optional)
+  std::unordered_map<int, TFile*> mDetectorOutFiles;        //! outfiles per detector for hits
+  std::unordered_map<int, TTree*> mDetectorToTTreeMap;      //! the trees
 
   // intermediate structures to collect data per event
   std::unordered_map<int, TTree*> mEventToTTreeMap;       //! in memory trees to collect / presort incoming data per event
   std::unordered_map<int, TMemFile*> mEventToTMemFileMap; //! files associated to the TTrees
+  std::unordered_map<int, std::vector<TTree*>> mEventToDetTTreeMap;       //! in memory trees per event and detector (indexed by DetID)
+  std::unordered_map<int, std::vector<TMemFile*>> mEventToDetTMemFileMap; //! files associated to the detector TTrees
+  std::unordered_map<int, FlatEventData> mEventToFlatDataMap;             //! adopted flat messages per event (instead of the trees)
   std::thread mMergerIOThread;                            //! a thread used to do hit merging and IO flushing asynchronously
   std::mutex mMapsMtx;                                    //!
+
+  // flushing queue and buffer bookkeeping (guarded by mFlushMtx)
+  std::mutex mFlushMtx;                                //!
+  std::condition_variable mFlushCV;                    //! signals new events to flush, finished flushes and freed buffers
+  std::deque<int> mFlushQueue;                         //! complete events handed to the flushing thread
+  bool mFlushing = false;                              //! the flushing thread is treating an event
+  bool mStopFlusher = false;                           //! the flushing thread should terminate when the queue is empty
+  std::unordered_map<int, size_t> mEventBufferedBytes; //! bytes received per event not yet flushed
+  size_t mBufferedBytes = 0;                           //! total bytes received and not yet flushed
+  size_t mMaxBufferedBytes = 0;                        //! limit above which we stop receiving (0 = no limit)
+  size_t mMaxBufferedBytesSeen = 0;                    //! high watermark of mBufferedBytes
+  int mBackpressureCount = 0;                          //! number of times the receiving was paused
+  double mBackpressureTime = 0.;                       //! total time the receiving was paused
+  int mNFlushThreads = 1;                              //! number of threads merging/writing in parallel
   int mEntries = 0;         //! counts the number of entries in the branches
   int mEventChecksum = 0;   //! checksum for events
   int mNExpectedEvents = 0; //! number of events that we expect to receive
@@ -24,6 +24,7 @@
 #include <TMessage.h>
 #include <TClass.h>
 #include <SimulationDataFormat/PrimaryChunk.h>
+#include <DetectorsBase/Detector.h>
 #include <Generators/GeneratorFromFile.h>
 #include <Generators/PrimaryGenerator.h>
 #include <SimConfig/SimConfig.h>
@@ -31,6 +32,7 @@
 #include <CommonUtils/RngHelper.h>
 #include "Field/MagneticField.h"
 #include <TGeoGlobalMagField.h>
+#include <TDatabasePDG.h>
 #include <typeinfo>
 #include <thread>
 #include <TROOT.h>
@@ -38,6 +40,8 @@
 #include <fstream>
 #include <iostream>
 #include <atomic>
+#include <memory>
+#include <vector>
 #include "PrimaryServerState.h"
 #include "SimPublishChannelHelper.h"
 #include <chrono>
@@ -60,6 +64,11 @@ class O2PrimaryServerDevice final : public FairMQDevice
       if (mGeneratorThread.joinable()) {
         mGeneratorThread.join();
       }
+      for (auto& slot : mGeneratorSlots) {
+        if (slot->thread.joinable()) {
+          slot->thread.join();
+        }
+      }
       if (mControlThread.joinable()) {
         mControlThread.join();
       }
@@ -89,55 +98,135 @@ class O2PrimaryServerDevice final : public FairMQDevice
     //
     // Not using cached instances for external kinematics since these might change input filenames etc.
     // and are in any case quickly setup.
-    mPrimGen = nullptr;
+    std::vector<o2::eventgen::PrimaryGenerator*> primGens;
     if (conf.getGenerator().compare("extkin") != 0 || conf.getGenerator().compare("extkinO2") != 0) {
       auto iter = mPrimGeneratorCache.find(conf.getGenerator());
       if (iter != mPrimGeneratorCache.end()) {
-        mPrimGen = iter->second;
-        LOG(INFO) << "Found cached generator for " << conf.getGenerator();
+        primGens = iter->second;
+        LOG(INFO) << "Found " << primGens.size() << " cached generator(s) for " << conf.getGenerator();
       }
     }
 
-    if (mPrimGen == nullptr) {
-      mPrimGen = new o2::eventgen::PrimaryGenerator;
-      o2::eventgen::GeneratorFactory::setPrimaryGenerator(conf, mPrimGen);
+    // the generator farm: several generator instances produce events in parallel, which is only
+    // possible when the generators can generate concurrently (and without embedding)
+    if (primGens.empty()) {
+      primGens.push_back(createPrimaryGenerator());
+    }
+    // the generators which can generate concurrently are always seeded per event, such that the events
+    // are the same whatever the number of generators; the others keep their sequential random stream
+    const bool concurrent = primGens[0]->canGenerateConcurrently();
+    int nGenerators = std::max(1, conf.getNGenerators());
+    if (nGenerators > 1 && !concurrent) {
+      LOG(WARNING) << "Generator " << conf.getGenerator() << " cannot generate concurrently; using 1 instead of " << nGenerators << " generators";
+      nGenerators = 1;
+    }
+    while ((int)primGens.size() < nGenerators) {
+      primGens.push_back(createPrimaryGenerator());
+    }
+    mPrimGeneratorCache[conf.getGenerator()] = primGens;
+    if (nGenerators > 1) {
+      // make sure the PDG database is loaded before the generators use it concurrently
+      TDatabasePDG::Instance()->GetParticle(2212);
+    }
 
-      auto embedinto_filename = conf.getEmbedIntoFileName();
-      if (!embedinto_filename.empty()) {
-        mPrimGen->embedInto(embedinto_filename);
+    for (auto& slot : mGeneratorSlots) {
+      if (slot->thread.joinable()) {
+        slot->thread.join();
+      }
+    }
+    mGeneratorSlots.resize(nGenerators);
+    for (int i = 0; i < nGenerators; ++i) {
+      auto& slot = mGeneratorSlots[i];
+      if (!slot) {
+        slot = std::make_unique<GeneratorSlot>();
+        slot->stack = std::make_unique<o2::data::Stack>();
+        slot->stack->setExternalMode(true);
       }
+      slot->primGen = primGens[i];
+      slot->primGen->SetEvent(&slot->eventHeader);
+      slot->primGen->setConcurrentMode(concurrent);
+    }
 
-      mPrimGen->Init();
+    LOG(INFO) << "Generator initialization took " << timer.CpuTime() << "s";
+    LOG(INFO) << "Generating events with " << nGenerators << " generator(s)";
+    for (int eventID = 1; eventID <= std::min(nGenerators, mMaxEvents); ++eventID) {
+      launchEventGeneration(eventID); // generate the first events
+    }
+  }
 
-      mPrimGeneratorCache[conf.getGenerator()] = mPrimGen;
+  // creates and initializes a primary generator according to the configuration
+  o2::eventgen::PrimaryGenerator* createPrimaryGenerator()
+  {
+    const auto& conf = mSimConfig;
+    auto primGen = new o2::eventgen::PrimaryGenerator;
+    o2::eventgen::GeneratorFactory::setPrimaryGenerator(conf, primGen);
+
+    auto embedinto_filename = conf.getEmbedIntoFileName();
+    if (!embedinto_filename.empty()) {
+      primGen->embedInto(embedinto_filename);
     }
-    mPrimGen->SetEvent(&mEventHeader);
 
-    LOG(INFO) << "Generator initialization took " << timer.CpuTime() << "s";
-    if (mMaxEvents > 0) {
-      generateEvent(); // generate a first event
+    primGen->Init();
+    return primGen;
+  }
+
+  // The generator farm: event eventID is generated by slot (eventID - 1) % nGenerators,
+  // each slot generating its next event asynchronously while the previous ones are served
+  struct GeneratorSlot {
+    o2::eventgen::PrimaryGenerator* primGen = nullptr; // the primary generator of this slot
+    o2::dataformats::MCEventHeader eventHeader;
+    std::unique_ptr<o2::data::Stack> stack; // the stack which is filled
+    std::thread thread;                     //! the thread generating the next event of this slot
+  };
+
+  // the generator farm slot producing the event eventID (counting from 1)
+  GeneratorSlot& getGeneratorSlot(int eventID)
+  {
+    return *mGeneratorSlots[(eventID - 1) % mGeneratorSlots.size()];
+  }
+
+  // starts the asynchronous generation of an event in its generator farm slot
+  void launchEventGeneration(int eventID)
+  {
+    auto& slot = getGeneratorSlot(eventID);
+    waitForEventGeneration(eventID);
+    slot.thread = std::thread(&O2PrimaryServerDevice::generateEvent, this, eventID);
+  }
+
+  // waits until the generation of an event in its generator farm slot is finished
+  void waitForEventGeneration(int eventID)
+  {
+    auto& slot = getGeneratorSlot(eventID);
+    if (slot.thread.joinable()) {
+      try {
+        slot.thread.join();
+      } catch (std::exception const& e) {
+        LOG(WARN) << "Exception during thread join ..ignoring";
+      }
     }
   }
 
   // function generating one event
-  void generateEvent(/*bool changeState = false*/)
+  void generateEvent(int eventID /*, bool changeState = false*/)
   {
     bool changeState = false;
-    LOG(INFO) << "Event generation started ";
+    auto& slot = getGeneratorSlot(eventID);
+    LOG(INFO) << "Event generation started for event " << eventID;
     if (changeState) {
       stateTransition(O2PrimaryServerState::WaitingEvent, "GENEVENT");
     }
     TStopwatch timer;
     timer.Start();
     try {
-      mStack->Reset();
-      mPrimGen->GenerateEvent(mStack);
+      slot.stack->Reset();
+      slot.primGen->setEventSeed(o2::eventgen::PrimaryGenerator::getEventSeed(mInitialSeed, eventID));
+      slot.primGen->GenerateEvent(slot.stack.get());
     } catch (std::exception const& e) {
       LOG(ERROR) << " Exception occurred during event gen ";
     }
     timer.Stop();
-    LOG(INFO) << "Event generation took " << timer.CpuTime() << "s"
-              << " and produced " << mStack->getPrimaries().size() << " primaries ";
+    LOG(INFO) << "Event generation took " << timer.RealTime() << "s"
+              << " and produced " << slot.stack->getPrimaries().size() << " primaries ";
     if (changeState) {
       stateTransition(O2PrimaryServerState::ReadyToServe, "GENEVENT");
     }
@@ -204,9 +293,6 @@ class O2PrimaryServerDevice final : public FairMQDevice
     // from now on mSimConfig should be used within this process
     mSimConfig = conf;
 
-    mStack = new o2::data::Stack();
-    mStack->setExternalMode(true);
-
     // MC ENGINE
     LOG(INFO) << "ENGINE SET TO " << vm["mcEngine"].as<std::string>();
     // CHUNK SIZE
@@ -400,19 +486,14 @@ class O2PrimaryServerDevice final : public FairMQDevice
     LOG(INFO) << "Received request for work " << mEventCounter << " " << mMaxEvents << " " << mNeedNewEvent << " available " << workavailable;
     if (mNeedNewEvent) {
       // we need a newly generated event now
-      if (mGeneratorThread.joinable()) {
-        try {
-          mGeneratorThread.join();
-        } catch (std::exception const& e) {
-          LOG(WARN) << "Exception during thread join ..ignoring";
-        }
-      }
+      waitForEventGeneration(mEventCounter + 1);
       mNeedNewEvent = false;
       mPartCounter = 0;
       mEventCounter++;
     }
 
-    auto& prims = mStack->getPrimaries();
+    auto& slot = getGeneratorSlot(mEventCounter);
+    auto& prims = slot.stack->getPrimaries();
     auto numberofparts = (int)std::ceil(prims.size() / (1. * mChunkGranularity));
     // number of parts should be at least 1 (even if empty)
     numberofparts = std::max(1, numberofparts);
@@ -427,7 +508,7 @@ class O2PrimaryServerDevice final : public FairMQDevice
     i.nparts = numberofparts;
     i.seed = mEventCounter + mInitialSeed;
     i.index = m.mParticles.size();
-    i.mMCEventHeader = mEventHeader;
+    i.mMCEventHeader = slot.eventHeader;
     m.mSubEventInfo = i;
 
     if (workavailable) {
@@ -442,11 +523,18 @@ class O2PrimaryServerDevice final : public FairMQDevice
         endindex = 0;
       }
 
+      // the particles either go into the PrimaryChunk or, as plain data, into a separate message part
+      const bool flat = o2::base::useFlatTransport();
+      std::vector<o2::data::FlatParticle> flatparticles;
       for (int index = startindex; index < endindex; ++index) {
-        m.mParticles.emplace_back(prims[index]);
+        if (flat) {
+          flatparticles.emplace_back(prims[index]);
+        } else {
+          m.mParticles.emplace_back(prims[index]);
+        }
       }
 
-      LOG(INFO) << "Sending " << m.mParticles.size() << " particles";
+      LOG(INFO) << "Sending " << (flat ? flatparticles.size() : m.mParticles.size()) << " particles";
       LOG(INFO) << "treating ev " << mEventCounter << " part " << i.part << " out of " << i.nparts;
 
       // feedback to driver if new event started
@@ -458,8 +546,11 @@ class O2PrimaryServerDevice final : public FairMQDevice
       mPartCounter++;
       if (mPartCounter == numberofparts) {
         mNeedNewEvent = true;
-        // start generation of a new event
-        mGeneratorThread = std::thread(&O2PrimaryServerDevice::generateEvent, this);
+        // start generation of the next event of this generator
+        const int nextEventID = mEventCounter + mGeneratorSlots.size();
+        if (nextEventID <= mMaxEvents) {
+          launchEventGeneration(nextEventID);
+        }
       }
 
       TMessage* tmsg = new TMessage(kMESS_OBJECT);
@@ -470,6 +561,9 @@ class O2PrimaryServerDevice final : public FairMQDevice
       std::unique_ptr<FairMQMessage> message(channel.NewMessage(tmsg->Buffer(), tmsg->BufferSize(), free_tmessage, tmsg));
 
       reply.AddPart(std::move(message));
+      if (flat) {
+        o2::base::attachFlatMessage(flatparticles, channel, reply);
+      }
     }
 
     // send answer
@@ -542,10 +636,7 @@ class O2PrimaryServerDevice final : public FairMQDevice
 
  private:
   o2::conf::SimConfig mSimConfig = o2::conf::SimConfig::Instance(); // local sim config object
-  o2::eventgen::PrimaryGenerator* mPrimGen = nullptr;               // the current primary generator
-  o2::dataformats::MCEventHeader mEventHeader;
-  o2::data::Stack* mStack = nullptr; // the stack which is filled (pointer since constructor to be called only init method)
-  int mChunkGranularity = 500;       // how many primaries to send to a worker
+  int mChunkGranularity = 500; // how many primaries to send to a worker
   int mPartCounter = 0;
   bool mNeedNewEvent = true;
   int mMaxEvents = 2;
@@ -554,16 +645,17 @@ class O2PrimaryServerDevice final : public FairMQDevice
   int mEventCounter = 0;
 
   std::thread mGeneratorThread; //! a thread used to concurrently init the particle generator
-                                //  or to generate events
   std::thread mControlThread;   //! a thread used to wait for control commands
 
+  std::vector<std::unique_ptr<GeneratorSlot>> mGeneratorSlots;
+
   // Keeps various generators instantiated in memory
   // useful when running simulation as a service (when generators
   // change between batches)
   // TODO: some care needs to be taken (or the user warned) that the caching is based on generator name
   //       and that parameter-based reconfiguration is not yet implemented (for which we would need to hash all
   //       configuration parameters as well)
-  std::map<std::string, o2::eventgen::PrimaryGenerator*> mPrimGeneratorCache;
+  std::map<std::string, std::vector<o2::eventgen::PrimaryGenerator*>> mPrimGeneratorCache;
 
   std::atomic<O2PrimaryServerState> mState{O2PrimaryServerState::Initializing};
   std::atomic<int> mWaitingControlInput{0};
@@ -24,6 +24,7 @@
 #include "TMessage.h"
 #include <SimulationDataFormat/Stack.h>
 #include <SimulationDataFormat/PrimaryChunk.h>
+#include <DetectorsBase/Detector.h>
 #include <TRandom.h>
 #include <SimConfig/SimConfig.h>
 #include <cstring>
@@ -231,6 +232,13 @@ class O2SimDevice final : public FairMQDevice
           // wrap incoming bytes as a TMessageWrapper which offers "adoption" of a buffer
           auto message = new TMessageWrapper(payload->GetData(), payload->GetSize());
           auto chunk = static_cast<o2::data::PrimaryChunk*>(message->ReadObjectAny(message->GetClass()));
+          // the particles may come as flat array in a third part
+          if (o2::base::isFlatMessage(reply, 2)) {
+            auto flatmessage = o2::base::adoptFlatMessage(reply, 2);
+            for (auto const& particle : flatmessage.asSpan<o2::data::FlatParticle>()) {
+              chunk->mParticles.emplace_back(particle.toTParticle());
+            }
+          }
 
           bool goon = true;
           // no particles and eventID == -1 --> indication for no more work
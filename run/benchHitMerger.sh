@@ -0,0 +1,40 @@
+#!/bin/bash
+# Benchmark of the hit merger (O2HitMerger) with many simulation workers.
+# Runs the same simulation with different HitMergerParams settings and reports
+# for each the wall time, the time spent in merging/flushing, the peak memory
+# of the merger and how often the workers were throttled (backpressure).
+# Comparing flatTransport=true/false measures the flat transport against the TMessage path.
+#
+# usage: benchHitMerger.sh [NWORKERS=32] [NEVENTS=64] [GENERATOR=pythia8pp]
+# extra settings can be benchmarked by setting CONFIGS, e.g.
+#   CONFIGS="HitMergerParams.nFlushThreads=1;HitMergerParams.maxBufferedMB=0 HitMergerParams.nFlushThreads=8" ./benchHitMerger.sh
+
+NWORKERS=${1:-32}
+NEVENTS=${2:-64}
+GENERATOR=${3:-pythia8pp}
+MODULES=${MODULES:-"all"}
+CONFIGS=${CONFIGS:-"HitMergerParams.nFlushThreads=1;HitMergerParams.maxBufferedMB=0 HitMergerParams.nFlushThreads=4 HitMergerParams.nFlushThreads=4;HitMergerParams.flatTransport=true HitMergerParams.nFlushThreads=8;HitMergerParams.maxBufferedMB=2048"}
+
+printf "%-70s %10s %12s %12s %14s %14s\n" "config" "wall(s)" "flush(s)" "maxflush(s)" "mergermem(MB)" "backpressure"
+
+iconf=0
+for conf in ${CONFIGS}; do
+  dir=benchHitMerger_${iconf}
+  rm -rf ${dir} && mkdir -p ${dir}
+  pushd ${dir} > /dev/null
+
+  start=$(date +%s.%N)
+  o2-sim -j ${NWORKERS} -n ${NEVENTS} -g ${GENERATOR} -m ${MODULES} --seed 1 --configKeyValues "${conf}" > simlog 2>&1
+  end=$(date +%s.%N)
+
+  mergerlog=o2sim_mergerlog
+  flush=$(grep "Merge/flush for event" ${mergerlog} | awk '{s += $NF} END {printf "%.2f", s}')
+  maxflush=$(grep "Merge/flush for event" ${mergerlog} | awk '{if ($NF > m) m = $NF} END {printf "%.2f", m}')
+  mem=$(grep "MEM-STAMP" ${mergerlog} | tail -n 1 | awk '{print $(NF-1)}')
+  backpressure=$(grep "BUFFER-STAMP" ${mergerlog} | tail -n 1 | sed -e 's/.*applied //' -e 's/ times for /x\//' -e 's/ s$/s/')
+
+  printf "%-70s %10.2f %12s %12s %14s %14s\n" "${conf}" $(echo "${end} - ${start}" | bc) "${flush}" "${maxflush}" "${mem}" "${backpressure}"
+
+  popd > /dev/null
+  iconf=$((iconf + 1))
+done